@@ -0,0 +1,102 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockItemCatalogCommandlet.h"
+
+#include "Engine/AssetManager.h"
+#include "Item/RockItemDefinition.h"
+#include "Item/ItemRegistry/RockItemCatalog.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogRockItemCatalog, Log, All);
+
+URockItemCatalogCommandlet::URockItemCatalogCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 URockItemCatalogCommandlet::Main(const FString& Params)
+{
+	const bool bVerifyOnly = FParse::Param(*Params, TEXT("verify"));
+
+	UAssetManager& AssetManager = UAssetManager::Get();
+	TArray<FPrimaryAssetId> PrimaryAssetIds;
+	AssetManager.GetPrimaryAssetIdList(FPrimaryAssetType(TEXT("RockItemDefinition")), PrimaryAssetIds);
+
+	TArray<URockItemDefinition*> Definitions;
+	Definitions.Reserve(PrimaryAssetIds.Num());
+	// Hashed before anything is skipped, the registry checks against the unfiltered asset list
+	TArray<FSoftObjectPath> SourceAssetPaths;
+	SourceAssetPaths.Reserve(PrimaryAssetIds.Num());
+	for (const FPrimaryAssetId& AssetId : PrimaryAssetIds)
+	{
+		const FSoftObjectPath AssetPath = AssetManager.GetPrimaryAssetPath(AssetId);
+		SourceAssetPaths.Add(AssetPath);
+		URockItemDefinition* ItemDef = Cast<URockItemDefinition>(AssetPath.TryLoad());
+		if (!ItemDef || ItemDef->ItemId.IsNone())
+		{
+			UE_LOG(LogRockItemCatalog, Warning, TEXT("Skipping '%s', not a valid item definition."), *AssetId.ToString());
+			continue;
+		}
+		Definitions.Add(ItemDef);
+	}
+
+	// Dense IDs are the catalog order, keep it independent of asset registry enumeration order.
+	Definitions.Sort([](const URockItemDefinition& A, const URockItemDefinition& B) { return A.ItemId.LexicalLess(B.ItemId); });
+
+	FRockItemCatalog Catalog;
+	Catalog.SourceHash = FRockItemCatalog::HashSourceAssets(MoveTemp(SourceAssetPaths));
+	for (const URockItemDefinition* ItemDef : Definitions)
+	{
+		if (Catalog.Find(ItemDef->ItemId))
+		{
+			UE_LOG(LogRockItemCatalog, Error, TEXT("Duplicate ItemId '%s' on '%s'. Ignoring it."), *ItemDef->ItemId.ToString(), *GetPathNameSafe(ItemDef));
+			continue;
+		}
+		Catalog.AddEntry(FRockItemCatalogEntry::FromDefinition(ItemDef, INDEX_NONE));
+	}
+
+	const FString Filename = FRockItemCatalog::GetCatalogFilename();
+	if (bVerifyOnly)
+	{
+		FRockItemCatalog Existing;
+		if (!Existing.LoadFromFile(Filename))
+		{
+			UE_LOG(LogRockItemCatalog, Error, TEXT("Could not read catalog '%s'."), *Filename);
+			return 1;
+		}
+
+		int32 NumErrors = 0;
+		if (Existing.Num() != Catalog.Num())
+		{
+			UE_LOG(LogRockItemCatalog, Error, TEXT("Catalog has %d entries, assets have %d."), Existing.Num(), Catalog.Num());
+			++NumErrors;
+		}
+		if (Existing.SourceHash != Catalog.SourceHash)
+		{
+			UE_LOG(LogRockItemCatalog, Error, TEXT("Catalog was built from a different set of item definition assets."));
+			++NumErrors;
+		}
+		for (const URockItemDefinition* ItemDef : Definitions)
+		{
+			const FRockItemCatalogEntry* Entry = Existing.Find(ItemDef->ItemId);
+			FString Mismatch = TEXT("missing from catalog");
+			if (!Entry || !Entry->MatchesDefinition(ItemDef, Mismatch))
+			{
+				UE_LOG(LogRockItemCatalog, Error, TEXT("'%s': %s"), *ItemDef->ItemId.ToString(), *Mismatch);
+				++NumErrors;
+			}
+		}
+		UE_LOG(LogRockItemCatalog, Display, TEXT("Verified catalog '%s': %d error(s)."), *Filename, NumErrors);
+		return NumErrors > 0 ? 1 : 0;
+	}
+
+	if (!Catalog.SaveToFile(Filename))
+	{
+		UE_LOG(LogRockItemCatalog, Error, TEXT("Failed to write catalog '%s'."), *Filename);
+		return 1;
+	}
+	UE_LOG(LogRockItemCatalog, Display, TEXT("Wrote %d item definitions to '%s'."), Catalog.Num(), *Filename);
+	return 0;
+}
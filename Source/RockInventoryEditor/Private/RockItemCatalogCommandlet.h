@@ -0,0 +1,22 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "RockItemCatalogCommandlet.generated.h"
+
+/**
+ * Emits the cooked item catalog consumed by URockItemRegistrySubsystem.
+ * Intended to run as a pre-cook build step:
+ *   UnrealEditor-Cmd <Project> -run=RockItemCatalog            writes the catalog
+ *   UnrealEditor-Cmd <Project> -run=RockItemCatalog -verify    fails if the existing catalog doesn't match the assets
+ */
+UCLASS()
+class URockItemCatalogCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	URockItemCatalogCommandlet();
+	virtual int32 Main(const FString& Params) override;
+};
@@ -7,6 +7,9 @@
 #include "Library/RockInventoryLibrary.h"
 #include "Misc/DataValidation.h"
 #include "Net/UnrealNetwork.h"
+#include "Persistence/RockInventoryPersistenceSubsystem.h"
+#include "UObject/StrongObjectPtr.h"
+#include "World/RockInventoryWorldContainer.h"
 
 #define LOCTEXT_NAMESPACE "RockInventoryComponent"
 
@@ -26,23 +29,104 @@ void URockInventoryComponent::BeginPlay()
 	Super::BeginPlay();
 
 	// Only server should instantiate the inventory. The client will receive it via replication
-	if (GetOwner()->HasAuthority())
+	// Already set when adopted before BeginPlay, see DropInventoryAsContainer
+	if (GetOwner()->HasAuthority() && !Inventory)
 	{
-		Inventory = NewObject<URockInventory>(this); // ?? RF_Transient
-		Inventory->Owner = this;
-		Inventory->Init(InventoryConfig);
+		// Only an id that came from a save can have anything to recover
+		const bool bRecover = bRecoverOnBeginPlay && PersistentId.IsValid();
+		CreateInventory(PersistentId);
+		URockInventoryPersistenceSubsystem* Persistence = UWorld::GetSubsystem<URockInventoryPersistenceSubsystem>(GetWorld());
+		if (bRecover && Persistence)
+		{
+			Persistence->RecoverInventory(Inventory);
+		}
 	}
 }
 
 void URockInventoryComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
-	if (Inventory)
+	DetachInventory();
+}
+
+void URockInventoryComponent::CreateInventory(const FGuid& InPersistentId)
+{
+	Inventory = NewObject<URockInventory>(this); // ?? RF_Transient
+	Inventory->Owner = this;
+	// Init only generates one if unset
+	Inventory->PersistentId = InPersistentId;
+	Inventory->Init(InventoryConfig);
+	PersistentId = Inventory->GetPersistentId();
+	if (URockInventoryPersistenceSubsystem* Persistence = UWorld::GetSubsystem<URockInventoryPersistenceSubsystem>(GetWorld()))
 	{
-		Inventory->UnregisterReplicationWithOwner();
-		RemoveReplicatedSubObject(Inventory);
+		Persistence->TrackInventory(Inventory);
+	}
+}
+
+URockInventory* URockInventoryComponent::DetachInventory()
+{
+	URockInventory* Detached = Inventory;
+	if (Detached)
+	{
+		if (URockInventoryPersistenceSubsystem* Persistence = UWorld::GetSubsystem<URockInventoryPersistenceSubsystem>(GetWorld()))
+		{
+			Persistence->ReleaseInventory(Detached);
+		}
+		Detached->UnregisterReplicationWithOwner();
+		RemoveReplicatedSubObject(Detached);
 		Inventory = nullptr;
 	}
+	return Detached;
+}
+
+void URockInventoryComponent::AdoptInventory(URockInventory* InInventory)
+{
+	// Deliberately not tracked by persistence: nothing respawns the container with this id to recover it, so its snapshots
+	// would only pile up. A crash loses what's left in the container rather than duplicating it
+	// The runtime instances are outered to the inventory and move along
+	InInventory->Rename(nullptr, this, REN_DontCreateRedirectors);
+	InInventory->Owner = this;
+	InInventory->PersistentId = FGuid::NewGuid();
+	PersistentId = InInventory->PersistentId;
+	Inventory = InInventory;
+	// One pass over the items re-registers every runtime instance (and nested inventory) with the new owner
+	Inventory->RegisterReplicationWithOwner();
+}
+
+FRockWorldItemSpawnHandle URockInventoryComponent::DropInventoryAsContainer(
+	const FTransform& Transform, TSubclassOf<ARockInventoryWorldContainer> ContainerClass)
+{
+	URockWorldItemSpawnSubsystem* Spawner = UWorld::GetSubsystem<URockWorldItemSpawnSubsystem>(GetWorld());
+	if (!GetOwner()->HasAuthority() || !Inventory || !Spawner)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("DropInventoryAsContainer - Server only, with an inventory"));
+		return FRockWorldItemSpawnHandle();
+	}
+	UClass* Class = ContainerClass ? ContainerClass.Get() : ARockInventoryWorldContainer::StaticClass();
+
+	// Saves the current contents under the old id before they leave
+	const FGuid KeptPersistentId = Inventory->GetPersistentId();
+	// Rooted while queued, this component may well be destroyed (its owner died) before the container spawns
+	TStrongObjectPtr<URockInventory> Dropped(DetachInventory());
+	const FRockWorldItemSpawnHandle Handle = Spawner->QueueActorSpawn(Class, Transform, [Dropped](AActor* Actor)
+	{
+		// Adopted before BeginPlay, so the container doesn't create an inventory of its own
+		ARockInventoryWorldContainer* Container = Cast<ARockInventoryWorldContainer>(Actor);
+		if (!Container || !Container->InventoryComponent)
+		{
+			UE_LOG(LogRockInventory, Error, TEXT("DropInventoryAsContainer - %s has no inventory component, the dropped items are lost"), *GetNameSafe(Actor));
+			return;
+		}
+		Container->InventoryComponent->AdoptInventory(Dropped.Get());
+	});
+
+	CreateInventory(KeptPersistentId);
+	// Otherwise a crash before the next autosave restores the dropped items from the last snapshot or the journal
+	if (URockInventoryPersistenceSubsystem* Persistence = UWorld::GetSubsystem<URockInventoryPersistenceSubsystem>(GetWorld()))
+	{
+		Persistence->SaveInventoryNow(Inventory);
+	}
+	return Handle;
 }
 
 void URockInventoryComponent::OnRep_Inventory(URockInventory* OldInventory)
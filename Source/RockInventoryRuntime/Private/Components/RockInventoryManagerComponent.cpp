@@ -3,9 +3,18 @@
 #include "Components/RockInventoryManagerComponent.h"
 
 #include "RockInventoryLogging.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
 #include "Inventory/RockInventory.h"
+#include "Inventory/RockInventoryShadowState.h"
+#include "Persistence/RockInventoryPersistenceSubsystem.h"
+#include "Transactions/Core/RockInventoryTransactionQueueSubsystem.h"
+#include "TimerManager.h"
 #include "Transactions/Core/RockInventoryTransaction.h"
 #include "Transactions/Implementations/RockMoveItemTransaction.h"
+#include "World/RockWorldItemCluster.h"
+#include "World/RockWorldItemClusterSubsystem.h"
+#include "World/RockWorldItemGridSubsystem.h"
 
 URockInventoryManagerComponent::URockInventoryManagerComponent(const FObjectInitializer& ObjectInitializer): Super(ObjectInitializer),
 	CurrentTransactionIndex(-1),
@@ -17,25 +26,336 @@ URockInventoryManagerComponent::URockInventoryManagerComponent(const FObjectInit
 	ClearHistory();
 }
 
+void URockInventoryManagerComponent::BeginPlay()
+{
+	Super::BeginPlay();
+	TransactionHistory.Configure(MaxHistoryLength, HistoryMemoryBudgetKB * 1024);
+	RateLimiter.Configure();
+}
+
 void URockInventoryManagerComponent::Client_TransactionResult_Implementation(int32 ClientTransactionID, bool bSuccess)
 {
-	// If we ever receive a bSuccess == false
-	// we need to clear history and refresh everything!
-	// Since our prediction is wrong and the state could be out of sync
-	bHasPendingPredictiveMove = false;
+	const int32 PendingIndex = PendingPredictions.IndexOfByPredicate([ClientTransactionID](const FRockPredictedTransaction& Prediction)
+	{
+		return Prediction.TransactionID == ClientTransactionID;
+	});
+	if (PendingIndex == INDEX_NONE)
+	{
+		// Not predicted (or dropped by a replay), replication brings the outcome
+		return;
+	}
+
+	const FRockPredictedTransaction Resolved = MoveTemp(PendingPredictions[PendingIndex]);
+	PendingPredictions.RemoveAt(PendingIndex);
+	// The inventories replicate through their owners' channels, not this one, so the outcome may arrive before or after this answer.
+	// Until any replication reached it, the shadows can't contain it yet
+	const bool bConfirmedBeforeReplication = bSuccess && !Resolved.bReplayedOnReplicatedState;
+	if (bConfirmedBeforeReplication && PendingPredictions.IsEmpty())
+	{
+		// The live state already is what the server has
+		ReleasePredictionShadows();
+		return;
+	}
+	if (!bSuccess)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("Client_TransactionResult - Predicted transaction %d was rejected, rolling back"), ClientTransactionID);
+		// Local undo records were built on top of the rejected state
+		ClearHistory();
+		// Rolling back only restores what we last heard from the server, which may itself be stale
+		RequestResyncForTransaction(Resolved.Transaction);
+	}
+
+	RewindPredictions();
+	if (bConfirmedBeforeReplication)
+	{
+		// Becomes part of the confirmed state. Replication bringing it later overwrites those entries with the same data
+		ApplyPrediction(Resolved);
+		for (TPair<TObjectPtr<URockInventory>, FRockInventoryShadowState>& Shadow : PredictionShadows)
+		{
+			if (Shadow.Key)
+			{
+				Shadow.Key->CaptureShadowState(Shadow.Value);
+			}
+		}
+	}
+	// Otherwise it isn't applied again: the replicated state under it may hold its outcome changed further by the server,
+	// and if the outcome hasn't replicated yet, it's missing until it does
+	ReplayPredictions();
+}
+
+bool URockInventoryManagerComponent::PredictMoveItem(const FRockMoveItemTransaction& ItemTransaction, FRockMoveItemUndoTransaction& OutUndo)
+{
+	if (PendingPredictions.Num() >= MaxPendingPredictions)
+	{
+		// Too much in flight already, this one waits on replication
+		OutUndo.bSuccess = true;
+		return true;
+	}
+
+	CapturePredictionShadow(ItemTransaction.SourceInventory);
+	CapturePredictionShadow(ItemTransaction.TargetInventory);
+	{
+		FRockInventoryPredictionScope PredictionScope(ItemTransaction.SourceInventory, ItemTransaction.TargetInventory);
+		OutUndo = ItemTransaction.Execute();
+	}
+	if (!OutUndo.bSuccess)
+	{
+		// Nothing was touched, the move validates before it changes anything
+		if (PendingPredictions.IsEmpty())
+		{
+			ReleasePredictionShadows();
+		}
+		return false;
+	}
+
+	FRockPredictedTransaction& Prediction = PendingPredictions.AddDefaulted_GetRef();
+	Prediction.TransactionID = ItemTransaction.TransactionID;
+	Prediction.Transaction = FInstancedStruct::Make(ItemTransaction);
+	Prediction.PostSourceFingerprint = OutUndo.PostMoveSourceFingerprint;
+	Prediction.PostTargetFingerprint = OutUndo.PostMoveTargetFingerprint;
+	return true;
+}
+
+bool URockInventoryManagerComponent::ApplyPrediction(const FRockPredictedTransaction& Prediction)
+{
+	if (const FRockMoveItemTransaction* MoveTransaction = Prediction.Transaction.GetPtr<FRockMoveItemTransaction>())
+	{
+		// Replication brought the server's outcome before its answer, applying it again would move the items twice
+		if (MoveTransaction->SourceInventory && MoveTransaction->TargetInventory
+			&& MoveTransaction->SourceInventory->GetItemBySlotHandle(MoveTransaction->SourceSlotHandle).GetFingerprint() == Prediction.PostSourceFingerprint
+			&& MoveTransaction->TargetInventory->GetItemBySlotHandle(MoveTransaction->TargetSlotHandle).GetFingerprint() == Prediction.PostTargetFingerprint)
+		{
+			return true;
+		}
+		if (!MoveTransaction->CanExecute())
+		{
+			return false;
+		}
+		FRockInventoryPredictionScope PredictionScope(MoveTransaction->SourceInventory, MoveTransaction->TargetInventory);
+		return MoveTransaction->Execute().bSuccess;
+	}
+	return false;
+}
+
+void URockInventoryManagerComponent::CapturePredictionShadow(URockInventory* Inventory)
+{
+	// Only the first prediction against an inventory sees its confirmed state, later ones build on top of it
+	if (!Inventory || PredictionShadows.Contains(Inventory))
+	{
+		return;
+	}
+	Inventory->CaptureShadowState(PredictionShadows.Add(Inventory));
+	Inventory->OnDataReplicated.AddUObject(this, &URockInventoryManagerComponent::OnPredictedInventoryReplicated);
+}
+
+void URockInventoryManagerComponent::RewindPredictions()
+{
+	for (const TPair<TObjectPtr<URockInventory>, FRockInventoryShadowState>& Shadow : PredictionShadows)
+	{
+		if (Shadow.Key)
+		{
+			Shadow.Key->RestoreShadowState(Shadow.Value);
+		}
+	}
+}
+
+void URockInventoryManagerComponent::ReplayPredictions()
+{
+	for (int32 Index = 0; Index < PendingPredictions.Num();)
+	{
+		if (ApplyPrediction(PendingPredictions[Index]))
+		{
+			++Index;
+			continue;
+		}
+		// Built on something that didn't happen. The server will most likely reject it as well
+		UE_LOG(LogRockInventory, Log, TEXT("ReplayPredictions - Predicted transaction %d no longer applies, dropping it"),
+			PendingPredictions[Index].TransactionID);
+		RequestResyncForTransaction(PendingPredictions[Index].Transaction);
+		PendingPredictions.RemoveAt(Index);
+	}
+	if (PendingPredictions.IsEmpty())
+	{
+		ReleasePredictionShadows();
+	}
+}
+
+void URockInventoryManagerComponent::ReleasePredictionShadows()
+{
+	for (const TPair<TObjectPtr<URockInventory>, FRockInventoryShadowState>& Shadow : PredictionShadows)
+	{
+		if (Shadow.Key)
+		{
+			Shadow.Key->OnDataReplicated.RemoveAll(this);
+		}
+	}
+	PredictionShadows.Reset();
+}
+
+void URockInventoryManagerComponent::OnPredictedInventoryReplicated(
+	URockInventory* Inventory, TConstArrayView<int32> ItemIndices, TConstArrayView<int32> SlotIndices)
+{
+	FRockInventoryShadowState* Shadow = PredictionShadows.Find(Inventory);
+	if (!Shadow)
+	{
+		return;
+	}
+	// Replication just overwrote some of our predicted entries with confirmed ones (e.g. another player looting the same crate).
+	// Take them as the new base and put the pending predictions back on top
+	Inventory->RebaseShadowState(*Shadow, ItemIndices, SlotIndices);
+	for (FRockPredictedTransaction& Prediction : PendingPredictions)
+	{
+		Prediction.bReplayedOnReplicatedState = true;
+	}
+	RewindPredictions();
+	ReplayPredictions();
+}
+
+void URockInventoryManagerComponent::RequestResyncForTransaction(const FInstancedStruct& Transaction)
+{
+	if (const FRockMoveItemTransaction* MoveTransaction = Transaction.GetPtr<FRockMoveItemTransaction>())
+	{
+		if (MoveTransaction->SourceInventory)
+		{
+			RequestResync(MoveTransaction->SourceInventory,
+				MoveTransaction->SourceInventory->GetSectionIndexBySlotHandle(MoveTransaction->SourceSlotHandle));
+		}
+		if (MoveTransaction->TargetInventory)
+		{
+			RequestResync(MoveTransaction->TargetInventory,
+				MoveTransaction->TargetInventory->GetSectionIndexBySlotHandle(MoveTransaction->TargetSlotHandle));
+		}
+	}
+}
+
+void URockInventoryManagerComponent::RequestResync(URockInventory* Inventory, int32 SectionIndex)
+{
+	if (!Inventory)
+	{
+		return;
+	}
+	// Sections from 32 up are always sent, so they don't need a bit
+	const uint32 SectionMask = SectionIndex >= 0 && SectionIndex < 32 ? 1u << SectionIndex : FRockInventoryResyncData::AllSections;
+	Server_RequestResync(Inventory, SectionMask);
+}
+
+bool URockInventoryManagerComponent::CanAccessInventory(URockInventory* Inventory) const
+{
+	// Same reach as looting a world item, see FRockLootWorldItemTransaction
+	constexpr float MaxAccessDistance = 1000.0f;
+
+	const AActor* InventoryActor = Inventory ? Inventory->GetOwningActor() : nullptr;
+	const AActor* Requester = GetOwner();
+	if (!InventoryActor || !Requester)
+	{
+		return false;
+	}
+	if (InventoryActor->IsOwnedBy(Requester))
+	{
+		return true;
+	}
+	const AController* Controller = Cast<AController>(Requester);
+	const AActor* Body = Controller && Controller->GetPawn() ? Controller->GetPawn() : Requester;
+	return Body->GetDistanceTo(InventoryActor) <= MaxAccessDistance;
+}
+
+bool URockInventoryManagerComponent::CanClientRequest(
+	const TCHAR* Context, const FRockItemTransactionBase& Transaction, URockInventory* InventoryA, URockInventory* InventoryB) const
+{
+	if (Transaction.Instigator.Get() != GetOwner())
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("%s - %s sent a transaction instigated by %s"),
+			Context, *GetNameSafe(GetOwner()), *GetNameSafe(Transaction.Instigator.Get()));
+		return false;
+	}
+	for (URockInventory* Inventory : {InventoryA, InventoryB})
+	{
+		if (Inventory && !CanAccessInventory(Inventory))
+		{
+			UE_LOG(LogRockInventory, Warning, TEXT("%s - %s may not access %s"), Context, *GetNameSafe(GetOwner()), *GetNameSafe(Inventory));
+			return false;
+		}
+	}
+	return true;
+}
+
+void URockInventoryManagerComponent::Server_RequestResync_Implementation(URockInventory* Inventory, uint32 SectionMask)
+{
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("Server_RequestResync - Not authority!"));
+		return;
+	}
+	if (!ConsumeRateLimit(ERockRateLimitedRequest::Resync))
+	{
+		return;
+	}
+	if (!Inventory || SectionMask == 0)
+	{
+		return;
+	}
+	if (!CanAccessInventory(Inventory))
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("Server_RequestResync - %s may not access %s"), *GetNameSafe(GetOwner()), *GetNameSafe(Inventory));
+		return;
+	}
+	if (uint32* PendingMask = PendingResyncSections.Find(Inventory))
+	{
+		*PendingMask |= SectionMask;
+		return;
+	}
+	if (PendingResyncSections.Num() >= MaxPendingResyncs)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("Server_RequestResync - Too many pending resyncs, dropping %s"), *GetNameSafe(Inventory));
+		return;
+	}
+	PendingResyncSections.Add(Inventory, SectionMask);
+
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	if (TimerManager.IsTimerActive(ResyncTimerHandle))
+	{
+		return;
+	}
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double Delay = LastResyncTime + ResyncMinInterval - Now;
+	if (LastResyncTime <= 0.0 || Delay <= 0.0)
+	{
+		// Still wait for the end of the frame, the other requests of a rollback are likely in the same packet
+		ResyncTimerHandle = TimerManager.SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &ThisClass::FlushResyncRequests));
+		return;
+	}
+	TimerManager.SetTimer(ResyncTimerHandle, FTimerDelegate::CreateUObject(this, &ThisClass::FlushResyncRequests), Delay, false);
+}
+
+void URockInventoryManagerComponent::FlushResyncRequests()
+{
+	LastResyncTime = GetWorld()->GetTimeSeconds();
+	TMap<TObjectPtr<URockInventory>, uint32> Requests = MoveTemp(PendingResyncSections);
+	PendingResyncSections.Reset();
 
-	if (bSuccess)
+	for (const TPair<TObjectPtr<URockInventory>, uint32>& Request : Requests)
 	{
-		// At this time, we shouldn't ever have more than 1 predictive move. As that complicates unwinding a lot of things.
-		// PendingServerTransactions.Remove(ClientTransactionID);
+		if (!IsValid(Request.Key))
+		{
+			continue;
+		}
+		FRockInventoryResyncData ResyncData;
+		Request.Key->BuildResyncData(Request.Value, ResyncData);
+		UE_LOG(LogRockInventory, Verbose, TEXT("FlushResyncRequests - Resyncing %s, sections 0x%08x, %d slots, %d items"),
+			*GetNameSafe(Request.Key), Request.Value, ResyncData.Slots.Num(), ResyncData.Items.Num());
+		Client_InventoryResync(ResyncData);
 	}
-	else
+}
+
+void URockInventoryManagerComponent::Client_InventoryResync_Implementation(const FRockInventoryResyncData& ResyncData)
+{
+	if (!ResyncData.Inventory)
 	{
-		// UH OH. Clear history, prevent any further transactions until we've resynced
-		bAwaitingServerSync = true;
-		// ensureMsgf(false, TEXT("ClientTransactionResult_Implementation - Not yet implemented"));
-		// Request a redownload of the inventory of the relevant inventory and slots.
+		return;
 	}
+	// Also reaches OnPredictedInventoryReplicated, which replays whatever is still pending on top
+	ResyncData.Inventory->ApplyResyncData(ResyncData);
+	OnInventoryResynced.Broadcast(ResyncData.Inventory);
 }
 
 void URockInventoryManagerComponent::LootWorldItem(const FRockLootWorldItemTransaction& ItemTransaction)
@@ -60,24 +380,9 @@ void URockInventoryManagerComponent::LootWorldItem(const FRockLootWorldItemTrans
 		{
 			// TODO: If undo/redo isn't predicted, do we even need to add it to local client history?
 
-			// Remove any redoable transactions
-			// We are about to add to the history, so we need to remove any redoable transactions ahead of 'this one'
-			if (TransactionHistoryData.Num() > 0 && CurrentTransactionIndex < TransactionHistoryData.Num() - 1)
-			{
-				TransactionHistoryData.RemoveAt(CurrentTransactionIndex + 1, TransactionHistoryData.Num() - CurrentTransactionIndex - 1);
-			}
-
 			FRockInventoryTransactionRecord TransactionRecord;
 			TransactionRecord.Set<FRockLootWorldItemTransaction, FRockLootWorldItemUndoTransaction>(ItemTransaction, Undo);
-			TransactionHistoryData.Add(TransactionRecord);
-
-			CurrentTransactionIndex = TransactionHistoryData.Num() - 1;
-			// Trim history if needed
-			if (TransactionHistoryData.Num() > MaxHistoryLength)
-			{
-				TransactionHistoryData.RemoveAt(0);
-				CurrentTransactionIndex--;
-			}
+			AddToHistory(MoveTemp(TransactionRecord));
 		}
 		else
 		{
@@ -98,18 +403,92 @@ void URockInventoryManagerComponent::Server_LootWorldItem_Implementation(FRockLo
 		UE_LOG(LogRockInventory, Warning, TEXT("Server_AddItem - Not authority!"));
 		return;
 	}
-	// If we can't execute, don't execute and don't add to history
-	if (!ItemTransaction.CanExecute())
+	if (!ConsumeRateLimit(ERockRateLimitedRequest::LootWorldItem))
 	{
+		Client_TransactionResult(ItemTransaction.TransactionID, false);
 		return;
 	}
-	const FRockLootWorldItemUndoTransaction& Undo = ItemTransaction.Execute();
+	SubmitServerLootWorldItem(ItemTransaction);
+}
 
+void URockInventoryManagerComponent::SubmitServerLootWorldItem(FRockLootWorldItemTransaction& ItemTransaction)
+{
+	if (URockInventoryTransactionQueueSubsystem* Queue = GetTransactionQueue())
+	{
+		if (!Queue->Enqueue(this, FInstancedStruct::Make(ItemTransaction)))
+		{
+			Client_TransactionResult(ItemTransaction.TransactionID, false);
+		}
+		return;
+	}
 	FRockInventoryTransactionRecord TransactionRecord;
-	TransactionRecord.Set<FRockLootWorldItemTransaction, FRockLootWorldItemUndoTransaction>(ItemTransaction, Undo);
-	TransactionHistoryData.Add(TransactionRecord);
+	const ERockTransactionExecuteResult Result = ExecuteServerLootWorldItem(ItemTransaction, TransactionRecord);
+	// If we can't execute, don't execute and don't add to history
+	if (Result != ERockTransactionExecuteResult::Rejected)
+	{
+		AddToHistory(MoveTemp(TransactionRecord));
+	}
+	// Rejections are answered too, the client may have predicted the transaction
+	Client_TransactionResult(ItemTransaction.TransactionID, Result == ERockTransactionExecuteResult::Succeeded);
+}
+
+void URockInventoryManagerComponent::LootClusteredWorldItem(
+	const FRockLootWorldItemTransaction& ItemTransaction, ARockWorldItemCluster* Cluster, int32 EntryId)
+{
+	if (!ItemTransaction.Instigator.IsValid() || !ItemTransaction.TargetInventory || !Cluster || !Cluster->FindEntry(EntryId))
+	{
+		return;
+	}
+	Server_LootClusteredWorldItem(ItemTransaction, Cluster, EntryId);
+}
+
+void URockInventoryManagerComponent::Server_LootClusteredWorldItem_Implementation(
+	FRockLootWorldItemTransaction ItemTransaction, ARockWorldItemCluster* Cluster, int32 EntryId)
+{
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("Server_LootClusteredWorldItem - Not authority!"));
+		return;
+	}
+	if (!ConsumeRateLimit(ERockRateLimitedRequest::LootWorldItem))
+	{
+		Client_TransactionResult(ItemTransaction.TransactionID, false);
+		return;
+	}
+	URockWorldItemClusterSubsystem* Clusters = UWorld::GetSubsystem<URockWorldItemClusterSubsystem>(GetWorld());
+	AActor* WorldItem = Clusters ? Clusters->PromoteItem(Cluster, EntryId) : nullptr;
+	if (!WorldItem)
+	{
+		// Most likely someone else got to it first
+		Client_TransactionResult(ItemTransaction.TransactionID, false);
+		return;
+	}
+	ItemTransaction.SourceWorldItemActor = WorldItem;
+	SubmitServerLootWorldItem(ItemTransaction);
+}
 
-	Client_TransactionResult(ItemTransaction.TransactionID, Undo.bSuccess);
+ERockTransactionExecuteResult URockInventoryManagerComponent::ExecuteServerLootWorldItem(
+	FRockLootWorldItemTransaction& ItemTransaction, FRockInventoryTransactionRecord& OutRecord)
+{
+	if (!ItemTransaction.CanExecute())
+	{
+		return ERockTransactionExecuteResult::Rejected;
+	}
+	const FRockLootWorldItemUndoTransaction& Undo = ItemTransaction.Execute();
+	OutRecord.Set<FRockLootWorldItemTransaction, FRockLootWorldItemUndoTransaction>(ItemTransaction, Undo);
+	// Whatever is left (full inventory, partial loot) goes back into its cluster instead of staying a promoted actor.
+	// The undo only needs the inventory side
+	URockWorldItemClusterSubsystem* Clusters = UWorld::GetSubsystem<URockWorldItemClusterSubsystem>(GetWorld());
+	if (Clusters && IsValid(ItemTransaction.SourceWorldItemActor))
+	{
+		Clusters->DemoteWorldItem(ItemTransaction.SourceWorldItemActor);
+	}
+	if (!Undo.bSuccess)
+	{
+		return ERockTransactionExecuteResult::Failed;
+	}
+	JournalTransaction(ItemTransaction.TargetInventory);
+	return ERockTransactionExecuteResult::Succeeded;
 }
 
 
@@ -123,9 +502,10 @@ bool URockInventoryManagerComponent::MoveItem(const FRockMoveItemTransaction& It
 
 	Undo.bSuccess = true;
 
-	if (bEnablePredictiveExecution && ItemTransaction.AttemptPredict())
+	// The authority executes it for real right away in Server_MoveItem
+	if (GetOwnerRole() != ROLE_Authority && bEnablePredictiveExecution && ItemTransaction.AttemptPredict())
 	{
-		Undo = ItemTransaction.Execute();
+		PredictMoveItem(ItemTransaction, Undo);
 	}
 
 	if (Undo.bSuccess)
@@ -134,24 +514,9 @@ bool URockInventoryManagerComponent::MoveItem(const FRockMoveItemTransaction& It
 		{
 			// TODO: If undo/redo isn't predicted, do we even need to add it to local client history?
 
-			// Remove any redoable transactions
-			// We are about to add to the history, so we need to remove any redoable transactions ahead of 'this one'
-			if (TransactionHistoryData.Num() > 0 && CurrentTransactionIndex < TransactionHistoryData.Num() - 1)
-			{
-				TransactionHistoryData.RemoveAt(CurrentTransactionIndex + 1, TransactionHistoryData.Num() - CurrentTransactionIndex - 1);
-			}
-
 			FRockInventoryTransactionRecord TransactionRecord;
 			TransactionRecord.Set<FRockMoveItemTransaction, FRockMoveItemUndoTransaction>(ItemTransaction, Undo);
-			TransactionHistoryData.Add(TransactionRecord);
-
-			CurrentTransactionIndex = TransactionHistoryData.Num() - 1;
-			// Trim history if needed
-			if (TransactionHistoryData.Num() > MaxHistoryLength)
-			{
-				TransactionHistoryData.RemoveAt(0);
-				CurrentTransactionIndex--;
-			}
+			AddToHistory(MoveTemp(TransactionRecord));
 		}
 		else
 		{
@@ -172,18 +537,45 @@ void URockInventoryManagerComponent::Server_MoveItem_Implementation(FRockMoveIte
 		UE_LOG(LogRockInventory, Warning, TEXT("Server_MoveItem - Not authority!"));
 		return;
 	}
-	// If we can't execute, don't execute and don't add to history
-	if (!ItemTransaction.CanExecute())
+	if (!ConsumeRateLimit(ERockRateLimitedRequest::MoveItem))
 	{
+		Client_TransactionResult(ItemTransaction.TransactionID, false);
+		return;
+	}
+	if (URockInventoryTransactionQueueSubsystem* Queue = GetTransactionQueue())
+	{
+		if (!Queue->Enqueue(this, FInstancedStruct::Make(ItemTransaction)))
+		{
+			Client_TransactionResult(ItemTransaction.TransactionID, false);
+		}
 		return;
 	}
-	const FRockMoveItemUndoTransaction& Undo = ItemTransaction.Execute();
 	FRockInventoryTransactionRecord TransactionRecord;
+	const ERockTransactionExecuteResult Result = ExecuteServerMoveItem(ItemTransaction, TransactionRecord);
+	// If we can't execute, don't execute and don't add to history
+	if (Result != ERockTransactionExecuteResult::Rejected)
+	{
+		AddToHistory(MoveTemp(TransactionRecord));
+	}
+	// Rejections are answered too, the client may have predicted the transaction
+	Client_TransactionResult(ItemTransaction.TransactionID, Result == ERockTransactionExecuteResult::Succeeded);
+}
 
-	TransactionRecord.Set<FRockMoveItemTransaction, FRockMoveItemUndoTransaction>(ItemTransaction, Undo);
-	TransactionHistoryData.Add(TransactionRecord);
-
-	Client_TransactionResult(ItemTransaction.TransactionID, Undo.bSuccess);
+ERockTransactionExecuteResult URockInventoryManagerComponent::ExecuteServerMoveItem(
+	const FRockMoveItemTransaction& ItemTransaction, FRockInventoryTransactionRecord& OutRecord)
+{
+	if (!ItemTransaction.CanExecute())
+	{
+		return ERockTransactionExecuteResult::Rejected;
+	}
+	const FRockMoveItemUndoTransaction& Undo = ItemTransaction.Execute();
+	OutRecord.Set<FRockMoveItemTransaction, FRockMoveItemUndoTransaction>(ItemTransaction, Undo);
+	if (!Undo.bSuccess)
+	{
+		return ERockTransactionExecuteResult::Failed;
+	}
+	JournalTransaction(ItemTransaction.SourceInventory, ItemTransaction.TargetInventory);
+	return ERockTransactionExecuteResult::Succeeded;
 }
 
 
@@ -211,24 +603,9 @@ void URockInventoryManagerComponent::DropItem(const FRockDropItemTransaction& It
 		{
 			// TODO: If undo/redo isn't predicted, do we even need to add it to local client history?
 
-			// Remove any redoable transactions
-			// We are about to add to the history, so we need to remove any redoable transactions ahead of 'this one'
-			if (TransactionHistoryData.Num() > 0 && CurrentTransactionIndex < TransactionHistoryData.Num() - 1)
-			{
-				TransactionHistoryData.RemoveAt(CurrentTransactionIndex + 1, TransactionHistoryData.Num() - CurrentTransactionIndex - 1);
-			}
-
 			FRockInventoryTransactionRecord TransactionRecord;
 			TransactionRecord.Set<FRockDropItemTransaction, FRockDropItemUndoTransaction>(ItemTransaction, Undo);
-			TransactionHistoryData.Add(TransactionRecord);
-
-			CurrentTransactionIndex = TransactionHistoryData.Num() - 1;
-			// Trim history if needed
-			if (TransactionHistoryData.Num() > MaxHistoryLength)
-			{
-				TransactionHistoryData.RemoveAt(0);
-				CurrentTransactionIndex--;
-			}
+			AddToHistory(MoveTemp(TransactionRecord));
 		}
 		else
 		{
@@ -248,47 +625,661 @@ void URockInventoryManagerComponent::Server_DropItem_Implementation(FRockDropIte
 		UE_LOG(LogRockInventory, Warning, TEXT("Server_DropItem - Not authority!"));
 		return;
 	}
-	// If we can't execute, don't execute and don't add to history
-	if (!ItemTransaction.CanExecute())
+	if (!ConsumeRateLimit(ERockRateLimitedRequest::DropItem))
 	{
+		Client_TransactionResult(ItemTransaction.TransactionID, false);
+		return;
+	}
+	if (URockInventoryTransactionQueueSubsystem* Queue = GetTransactionQueue())
+	{
+		if (!Queue->Enqueue(this, FInstancedStruct::Make(ItemTransaction)))
+		{
+			Client_TransactionResult(ItemTransaction.TransactionID, false);
+		}
 		return;
 	}
-	const FRockDropItemUndoTransaction& Undo = ItemTransaction.Execute();
 	FRockInventoryTransactionRecord TransactionRecord;
-
-	TransactionRecord.Set<FRockDropItemTransaction, FRockDropItemUndoTransaction>(ItemTransaction, Undo);
-	TransactionHistoryData.Add(TransactionRecord);
-
-	Client_TransactionResult(ItemTransaction.TransactionID, Undo.bSuccess);
+	const ERockTransactionExecuteResult Result = ExecuteServerDropItem(ItemTransaction, TransactionRecord);
+	// If we can't execute, don't execute and don't add to history
+	if (Result != ERockTransactionExecuteResult::Rejected)
+	{
+		AddToHistory(MoveTemp(TransactionRecord));
+	}
+	// Rejections are answered too, the client may have predicted the transaction
+	Client_TransactionResult(ItemTransaction.TransactionID, Result == ERockTransactionExecuteResult::Succeeded);
 }
 
-void URockInventoryManagerComponent::Server_RegisterSlotStatus_Implementation(
-	URockInventory* Inventory, AController* Instigator,
-	const FRockInventorySlotHandle& InSlotHandle, ERockSlotStatus InStatus)
+ERockTransactionExecuteResult URockInventoryManagerComponent::ExecuteServerDropItem(
+	const FRockDropItemTransaction& ItemTransaction, FRockInventoryTransactionRecord& OutRecord)
 {
-	ensureMsgf(Inventory, TEXT("Server_RegisterSlotStatus_Implementation: Inventory is null"));
-	Inventory->RegisterSlotStatus(Instigator, InSlotHandle, InStatus);
-}
-
-void URockInventoryManagerComponent::Server_ReleaseSlotStatus_Implementation(
-	URockInventory* Inventory, AController* Instigator, const FRockInventorySlotHandle& InSlotHandle)
+	if (!ItemTransaction.CanExecute())
+	{
+		return ERockTransactionExecuteResult::Rejected;
+	}
+	const FRockDropItemUndoTransaction& Undo = ItemTransaction.Execute();
+	OutRecord.Set<FRockDropItemTransaction, FRockDropItemUndoTransaction>(ItemTransaction, Undo);
+	if (!Undo.bSuccess)
+	{
+		return ERockTransactionExecuteResult::Failed;
+	}
+	JournalTransaction(ItemTransaction.SourceInventory);
+	return ERockTransactionExecuteResult::Succeeded;
+}
+
+void URockInventoryManagerComponent::TransferAllItems(const FRockTransferAllTransaction& ItemTransaction)
 {
-	Inventory->ReleaseSlotStatus(Instigator, InSlotHandle);
+	if (!ItemTransaction.CanExecute())
+	{
+		return;
+	}
+	// Nothing to predict or keep in the client history, a transfer can't be undone
+	Server_TransferAllItems(ItemTransaction);
 }
 
-void URockInventoryManagerComponent::ClearHistory()
+void URockInventoryManagerComponent::Server_TransferAllItems_Implementation(FRockTransferAllTransaction ItemTransaction)
 {
-	TransactionHistoryData.Empty();
-	CurrentTransactionIndex = -1;
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("Server_TransferAllItems - Not authority!"));
+		return;
+	}
+	if (!ConsumeRateLimit(ERockRateLimitedRequest::TransferAllItems))
+	{
+		Client_TransactionResult(ItemTransaction.TransactionID, false);
+		return;
+	}
+	// Emptying an inventory takes reach to both, like looting
+	if (!CanClientRequest(TEXT("Server_TransferAllItems"), ItemTransaction, ItemTransaction.SourceInventory, ItemTransaction.TargetInventory))
+	{
+		Client_TransactionResult(ItemTransaction.TransactionID, false);
+		return;
+	}
+	if (URockInventoryTransactionQueueSubsystem* Queue = GetTransactionQueue())
+	{
+		if (!Queue->Enqueue(this, FInstancedStruct::Make(ItemTransaction)))
+		{
+			Client_TransactionResult(ItemTransaction.TransactionID, false);
+		}
+		return;
+	}
+	FRockInventoryTransactionRecord TransactionRecord;
+	const ERockTransactionExecuteResult Result = ExecuteServerTransferAllItems(ItemTransaction, TransactionRecord);
+	// If we can't execute, don't execute and don't add to history
+	if (Result != ERockTransactionExecuteResult::Rejected)
+	{
+		AddToHistory(MoveTemp(TransactionRecord));
+	}
+	// Rejections are answered too, the client may have predicted the transaction
+	Client_TransactionResult(ItemTransaction.TransactionID, Result == ERockTransactionExecuteResult::Succeeded);
+}
+
+ERockTransactionExecuteResult URockInventoryManagerComponent::ExecuteServerTransferAllItems(
+	const FRockTransferAllTransaction& ItemTransaction, FRockInventoryTransactionRecord& OutRecord)
+{
+	if (!ItemTransaction.CanExecute())
+	{
+		return ERockTransactionExecuteResult::Rejected;
+	}
+	const FRockTransferAllUndoTransaction& Undo = ItemTransaction.Execute();
+	OutRecord.Set<FRockTransferAllTransaction, FRockTransferAllUndoTransaction>(ItemTransaction, Undo);
+	if (!Undo.bSuccess)
+	{
+		return ERockTransactionExecuteResult::Failed;
+	}
+	JournalTransaction(ItemTransaction.SourceInventory, ItemTransaction.TargetInventory);
+	return ERockTransactionExecuteResult::Succeeded;
+}
+
+void URockInventoryManagerComponent::SortInventory(const FRockSortInventoryTransaction& ItemTransaction)
+{
+	if (!ItemTransaction.CanExecute())
+	{
+		return;
+	}
+	// Not predicted, the whole layout changes and replicates back at once
+	Server_SortInventory(ItemTransaction);
+}
+
+void URockInventoryManagerComponent::Server_SortInventory_Implementation(FRockSortInventoryTransaction ItemTransaction)
+{
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("Server_SortInventory - Not authority!"));
+		return;
+	}
+	if (!ConsumeRateLimit(ERockRateLimitedRequest::SortInventory))
+	{
+		Client_TransactionResult(ItemTransaction.TransactionID, false);
+		return;
+	}
+	if (!CanClientRequest(TEXT("Server_SortInventory"), ItemTransaction, ItemTransaction.Inventory))
+	{
+		Client_TransactionResult(ItemTransaction.TransactionID, false);
+		return;
+	}
+	if (URockInventoryTransactionQueueSubsystem* Queue = GetTransactionQueue())
+	{
+		if (!Queue->Enqueue(this, FInstancedStruct::Make(ItemTransaction)))
+		{
+			Client_TransactionResult(ItemTransaction.TransactionID, false);
+		}
+		return;
+	}
+	FRockInventoryTransactionRecord TransactionRecord;
+	const ERockTransactionExecuteResult Result = ExecuteServerSortInventory(ItemTransaction, TransactionRecord);
+	// If we can't execute, don't execute and don't add to history
+	if (Result != ERockTransactionExecuteResult::Rejected)
+	{
+		AddToHistory(MoveTemp(TransactionRecord));
+	}
+	// Rejections are answered too, the client may have predicted the transaction
+	Client_TransactionResult(ItemTransaction.TransactionID, Result == ERockTransactionExecuteResult::Succeeded);
+}
+
+ERockTransactionExecuteResult URockInventoryManagerComponent::ExecuteServerSortInventory(
+	const FRockSortInventoryTransaction& ItemTransaction, FRockInventoryTransactionRecord& OutRecord)
+{
+	if (!ItemTransaction.CanExecute())
+	{
+		return ERockTransactionExecuteResult::Rejected;
+	}
+	const FRockSortInventoryUndoTransaction& Undo = ItemTransaction.Execute();
+	OutRecord.Set<FRockSortInventoryTransaction, FRockSortInventoryUndoTransaction>(ItemTransaction, Undo);
+	if (!Undo.bSuccess)
+	{
+		return ERockTransactionExecuteResult::Failed;
+	}
+	JournalTransaction(ItemTransaction.Inventory);
+	return ERockTransactionExecuteResult::Succeeded;
+}
+
+ERockTransactionExecuteResult URockInventoryManagerComponent::ExecuteServerTransaction(
+	FInstancedStruct& Transaction, FRockInventoryTransactionRecord& OutRecord)
+{
+	const UScriptStruct* TransactionType = Transaction.GetScriptStruct();
+	if (TransactionType == FRockMoveItemTransaction::StaticStruct())
+	{
+		return ExecuteServerMoveItem(Transaction.Get<FRockMoveItemTransaction>(), OutRecord);
+	}
+	if (TransactionType == FRockLootWorldItemTransaction::StaticStruct())
+	{
+		return ExecuteServerLootWorldItem(Transaction.GetMutable<FRockLootWorldItemTransaction>(), OutRecord);
+	}
+	if (TransactionType == FRockDropItemTransaction::StaticStruct())
+	{
+		return ExecuteServerDropItem(Transaction.Get<FRockDropItemTransaction>(), OutRecord);
+	}
+	if (TransactionType == FRockTransferAllTransaction::StaticStruct())
+	{
+		return ExecuteServerTransferAllItems(Transaction.Get<FRockTransferAllTransaction>(), OutRecord);
+	}
+	if (TransactionType == FRockSortInventoryTransaction::StaticStruct())
+	{
+		return ExecuteServerSortInventory(Transaction.Get<FRockSortInventoryTransaction>(), OutRecord);
+	}
+	UE_LOG(LogRockInventory, Warning, TEXT("ExecuteServerTransaction - Unsupported transaction type %s"),
+		TransactionType ? *TransactionType->GetName() : TEXT("None"));
+	return ERockTransactionExecuteResult::Rejected;
 }
 
-bool FRockInventoryTransactionRecord::ExecuteUndo()
+void URockInventoryManagerComponent::GetTouchedInventories(
+	const FInstancedStruct& Transaction, TArray<URockInventory*, TInlineAllocator<2>>& OutInventories)
 {
-	if (Undo.GetScriptStruct() == FRockMoveItemUndoTransaction::StaticStruct())
+	OutInventories.Reset();
+	auto Add = [&OutInventories](URockInventory* Inventory)
+	{
+		if (Inventory)
+		{
+			OutInventories.AddUnique(Inventory);
+		}
+	};
+	if (const FRockMoveItemTransaction* MoveTransaction = Transaction.GetPtr<FRockMoveItemTransaction>())
+	{
+		Add(MoveTransaction->SourceInventory);
+		Add(MoveTransaction->TargetInventory);
+	}
+	else if (const FRockLootWorldItemTransaction* LootTransaction = Transaction.GetPtr<FRockLootWorldItemTransaction>())
 	{
-		FRockMoveItemUndoTransaction UndoData = Undo.Get<FRockMoveItemUndoTransaction>();
-		return UndoData.Undo();
+		Add(LootTransaction->TargetInventory);
+	}
+	else if (const FRockDropItemTransaction* DropTransaction = Transaction.GetPtr<FRockDropItemTransaction>())
+	{
+		Add(DropTransaction->SourceInventory);
+	}
+	else if (const FRockTransferAllTransaction* TransferTransaction = Transaction.GetPtr<FRockTransferAllTransaction>())
+	{
+		Add(TransferTransaction->SourceInventory);
+		Add(TransferTransaction->TargetInventory);
+	}
+	else if (const FRockSortInventoryTransaction* SortTransaction = Transaction.GetPtr<FRockSortInventoryTransaction>())
+	{
+		Add(SortTransaction->Inventory);
+	}
+	else if (const FRockInventoryTransactionBatch* Batch = Transaction.GetPtr<FRockInventoryTransactionBatch>())
+	{
+		TArray<URockInventory*, TInlineAllocator<2>> EntryInventories;
+		for (const FInstancedStruct& Entry : Batch->Transactions)
+		{
+			GetTouchedInventories(Entry, EntryInventories);
+			for (URockInventory* Inventory : EntryInventories)
+			{
+				Add(Inventory);
+			}
+		}
+	}
+}
+
+void URockInventoryManagerComponent::ExecuteQueuedTransaction(FInstancedStruct& Transaction)
+{
+	if (const FRockInventoryTransactionBatch* Batch = Transaction.GetPtr<FRockInventoryTransactionBatch>())
+	{
+		// Answers with its own batch result
+		ExecuteServerTransactionBatch(*Batch);
+		return;
+	}
+	FRockInventoryTransactionRecord TransactionRecord;
+	const ERockTransactionExecuteResult Result = ExecuteServerTransaction(Transaction, TransactionRecord);
+	FinishQueuedTransaction(Transaction, Result, MoveTemp(TransactionRecord));
+}
+
+bool URockInventoryManagerComponent::CanExecuteOffGameThread(const FInstancedStruct& Transaction)
+{
+	const UScriptStruct* TransactionType = Transaction.GetScriptStruct();
+	// Loot and drop spawn or destroy world items
+	if (TransactionType != FRockMoveItemTransaction::StaticStruct()
+		&& TransactionType != FRockTransferAllTransaction::StaticStruct()
+		&& TransactionType != FRockSortInventoryTransaction::StaticStruct())
+	{
+		return false;
+	}
+	TArray<URockInventory*, TInlineAllocator<2>> Inventories;
+	GetTouchedInventories(Transaction, Inventories);
+	if (Inventories.IsEmpty())
+	{
+		// Rejected by CanExecute anyway, cheap enough to do on the game thread
+		return false;
+	}
+	for (const URockInventory* Inventory : Inventories)
+	{
+		if (!IsValid(Inventory) || Inventory->HasRuntimeInstances())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void URockInventoryManagerComponent::BeginParallelTransactions()
+{
+	check(IsInGameThread());
+	++JournalDeferDepth;
+}
+
+ERockTransactionExecuteResult URockInventoryManagerComponent::ExecuteParallelTransaction(
+	FInstancedStruct& Transaction, FRockInventoryTransactionRecord& OutRecord)
+{
+	checkf(JournalDeferDepth > 0, TEXT("ExecuteParallelTransaction - Called outside of Begin/EndParallelTransactions"));
+	return ExecuteServerTransaction(Transaction, OutRecord);
+}
+
+void URockInventoryManagerComponent::FinishQueuedTransaction(
+	const FInstancedStruct& Transaction, ERockTransactionExecuteResult Result, FRockInventoryTransactionRecord&& Record)
+{
+	if (Result != ERockTransactionExecuteResult::Rejected)
+	{
+		AddToHistory(MoveTemp(Record));
+	}
+	OnQueuedTransactionFinished.Broadcast(Transaction, Result);
+	if (const FRockItemTransactionBase* ItemTransaction = Transaction.GetPtr<FRockItemTransactionBase>())
+	{
+		Client_TransactionResult(ItemTransaction->TransactionID, Result == ERockTransactionExecuteResult::Succeeded);
+	}
+}
+
+void URockInventoryManagerComponent::EndParallelTransactions()
+{
+	check(IsInGameThread());
+	--JournalDeferDepth;
+	FlushDeferredJournal();
+}
+
+URockInventoryTransactionQueueSubsystem* URockInventoryManagerComponent::GetTransactionQueue() const
+{
+	URockInventoryTransactionQueueSubsystem* Queue = UWorld::GetSubsystem<URockInventoryTransactionQueueSubsystem>(GetWorld());
+	return Queue && Queue->IsEnabled() ? Queue : nullptr;
+}
+
+int32 URockInventoryManagerComponent::LootItemsInRadius(
+	AController* Instigator, URockInventory* TargetInventory, FVector Center, float Radius, int32 MaxItems)
+{
+	const URockWorldItemGridSubsystem* Grid = UWorld::GetSubsystem<URockWorldItemGridSubsystem>(GetWorld());
+	if (!Grid || !TargetInventory || MaxItems <= 0)
+	{
+		return 0;
+	}
+	const int32 Limit = FMath::Min(MaxItems, MaxTransactionsPerBatch);
+	auto MakeLootTransaction = [&](AActor* WorldItem)
+	{
+		FRockLootWorldItemTransaction LootTransaction;
+		LootTransaction.GenerateNewHandle();
+		LootTransaction.Instigator = Instigator;
+		LootTransaction.SourceWorldItemActor = WorldItem;
+		LootTransaction.TargetInventory = TargetInventory;
+		return LootTransaction;
+	};
+
+	// Nearest lootable actors, already sorted by the grid
+	TArray<AActor*> WorldItems;
+	Grid->QueryRadius(Center, Radius, WorldItems);
+	TArray<TPair<double, AActor*>, TInlineAllocator<16>> Lootable;
+	for (AActor* WorldItem : WorldItems)
+	{
+		if (Lootable.Num() >= Limit)
+		{
+			break;
+		}
+		if (MakeLootTransaction(WorldItem).CanExecute())
+		{
+			Lootable.Emplace(FVector::DistSquared(Center, WorldItem->GetActorLocation()), WorldItem);
+		}
+	}
+
+	// Clustered entries compete by distance, and only the ones that make the cut become actors
+	URockWorldItemClusterSubsystem* Clusters = UWorld::GetSubsystem<URockWorldItemClusterSubsystem>(GetWorld());
+	TArray<FRockWorldItemClusterHit> ClusterHits;
+	if (Clusters && GetOwnerRole() == ROLE_Authority)
+	{
+		Clusters->FindItemsInRadius(Center, Radius, Limit, ClusterHits);
+	}
+
+	FRockInventoryTransactionBatch Batch;
+	int32 ActorIndex = 0;
+	int32 HitIndex = 0;
+	while (Batch.Num() < Limit && (ActorIndex < Lootable.Num() || HitIndex < ClusterHits.Num()))
+	{
+		const bool bTakeHit = HitIndex < ClusterHits.Num()
+			&& (ActorIndex >= Lootable.Num() || ClusterHits[HitIndex].DistanceSquared < Lootable[ActorIndex].Key);
+		if (!bTakeHit)
+		{
+			Batch.Add(MakeLootTransaction(Lootable[ActorIndex++].Value));
+			continue;
+		}
+		const FRockWorldItemClusterHit& Hit = ClusterHits[HitIndex++];
+		AActor* WorldItem = Clusters->PromoteItem(Hit.Cluster, Hit.EntryId);
+		if (!WorldItem)
+		{
+			continue;
+		}
+		const FRockLootWorldItemTransaction LootTransaction = MakeLootTransaction(WorldItem);
+		if (LootTransaction.CanExecute())
+		{
+			Batch.Add(LootTransaction);
+		}
+		else
+		{
+			// Nothing will loot it, don't leave an actor behind
+			Clusters->DemoteWorldItem(WorldItem);
+		}
+	}
+	return Batch.IsEmpty() ? 0 : ExecuteTransactionBatch(MoveTemp(Batch));
+}
+
+int32 URockInventoryManagerComponent::ExecuteTransactionBatch(FRockInventoryTransactionBatch Batch)
+{
+	if (Batch.IsEmpty() || Batch.Num() > MaxTransactionsPerBatch)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("ExecuteTransactionBatch - Batch of %d transactions is empty or too large (max %d)"),
+			Batch.Num(), MaxTransactionsPerBatch);
+		return 0;
+	}
+	if (Batch.BatchID == 0)
+	{
+		// Skip 0 on wrap around, it means 'unassigned'
+		LastBatchID = FMath::Max(LastBatchID + 1, 1);
+		Batch.BatchID = LastBatchID;
+	}
+	Server_ExecuteTransactionBatch(Batch);
+	return Batch.BatchID;
+}
+
+void URockInventoryManagerComponent::Server_ExecuteTransactionBatch_Implementation(const FRockInventoryTransactionBatch& Batch)
+{
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("Server_ExecuteTransactionBatch - Not authority!"));
+		return;
+	}
+
+	FRockInventoryTransactionBatchResult Result;
+	Result.BatchID = Batch.BatchID;
+
+	if (Batch.Num() > MaxTransactionsPerBatch)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("Server_ExecuteTransactionBatch - Rejecting batch %d, %d transactions (max %d)"),
+			Batch.BatchID, Batch.Num(), MaxTransactionsPerBatch);
+		Client_TransactionBatchResult(Result);
+		return;
+	}
+	// A batch pays for every transaction in it, otherwise batching would be a way around the limits
+	if (!ConsumeRateLimit(ERockRateLimitedRequest::TransactionBatch, static_cast<float>(FMath::Max(Batch.Num(), 1))))
+	{
+		Client_TransactionBatchResult(Result);
+		return;
+	}
+	if (Batch.bAtomic)
+	{
+		// Rolling back relies on undo, which only moves support
+		for (int32 Index = 0; Index < Batch.Num(); ++Index)
+		{
+			if (Batch.Transactions[Index].GetScriptStruct() != FRockMoveItemTransaction::StaticStruct())
+			{
+				UE_LOG(LogRockInventory, Warning, TEXT("Server_ExecuteTransactionBatch - Atomic batch %d contains a non undoable transaction at %d"),
+					Batch.BatchID, Index);
+				Result.FailedIndices.Add(Index);
+				Client_TransactionBatchResult(Result);
+				return;
+			}
+		}
+	}
+	// Batched entries get the same checks as their single RPCs
+	for (int32 Index = 0; Index < Batch.Num(); ++Index)
+	{
+		if (const FRockTransferAllTransaction* TransferAll = Batch.Transactions[Index].GetPtr<FRockTransferAllTransaction>())
+		{
+			if (!CanClientRequest(TEXT("Server_ExecuteTransactionBatch"), *TransferAll, TransferAll->SourceInventory, TransferAll->TargetInventory))
+			{
+				Result.FailedIndices.Add(Index);
+				Client_TransactionBatchResult(Result);
+				return;
+			}
+		}
+		else if (const FRockSortInventoryTransaction* Sort = Batch.Transactions[Index].GetPtr<FRockSortInventoryTransaction>())
+		{
+			if (!CanClientRequest(TEXT("Server_ExecuteTransactionBatch"), *Sort, Sort->Inventory))
+			{
+				Result.FailedIndices.Add(Index);
+				Client_TransactionBatchResult(Result);
+				return;
+			}
+		}
+	}
+
+	// The whole batch waits for the transactions already queued on its inventories, and runs as one unit
+	if (URockInventoryTransactionQueueSubsystem* Queue = GetTransactionQueue())
+	{
+		if (!Queue->Enqueue(this, FInstancedStruct::Make(Batch)))
+		{
+			Client_TransactionBatchResult(Result);
+		}
+		return;
+	}
+	ExecuteServerTransactionBatch(Batch);
+}
+
+void URockInventoryManagerComponent::ExecuteServerTransactionBatch(const FRockInventoryTransactionBatch& Batch)
+{
+	FRockInventoryTransactionBatchResult Result;
+	Result.BatchID = Batch.BatchID;
+
+	// Executing mutates some transactions (looting), so work on a copy
+	TArray<FInstancedStruct> Transactions = Batch.Transactions;
+	TArray<FRockInventoryTransactionRecord> Executed;
+	Executed.Reserve(Transactions.Num());
+
+	++JournalDeferDepth;
+	for (int32 Index = 0; Index < Transactions.Num(); ++Index)
+	{
+		FRockInventoryTransactionRecord TransactionRecord;
+		const ERockTransactionExecuteResult EntryResult = ExecuteServerTransaction(Transactions[Index], TransactionRecord);
+		if (EntryResult == ERockTransactionExecuteResult::Succeeded)
+		{
+			Executed.Add(MoveTemp(TransactionRecord));
+			continue;
+		}
+
+		Result.FailedIndices.Add(Index);
+		if (Batch.bAtomic)
+		{
+			// Unwind in reverse so every undo sees exactly the state its move left behind
+			for (int32 UndoIndex = Executed.Num() - 1; UndoIndex >= 0; --UndoIndex)
+			{
+				if (!Executed[UndoIndex].ExecuteUndo())
+				{
+					UE_LOG(LogRockInventory, Error, TEXT("Server_ExecuteTransactionBatch - Failed to roll back entry %d of batch %d"),
+						UndoIndex, Batch.BatchID);
+				}
+			}
+			Executed.Reset();
+			Result.bRolledBack = true;
+			break;
+		}
+	}
+	--JournalDeferDepth;
+	FlushDeferredJournal();
+
+	for (FRockInventoryTransactionRecord& TransactionRecord : Executed)
+	{
+		AddToHistory(MoveTemp(TransactionRecord));
+	}
+
+	Result.bSuccess = Result.FailedIndices.IsEmpty();
+	Client_TransactionBatchResult(Result);
+}
+
+void URockInventoryManagerComponent::Client_TransactionBatchResult_Implementation(const FRockInventoryTransactionBatchResult& Result)
+{
+	// Batches aren't predicted, so a failure doesn't leave the client out of sync
+	OnTransactionBatchResult.Broadcast(Result);
+}
+
+void URockInventoryManagerComponent::Server_RegisterSlotStatus_Implementation(
+	URockInventory* Inventory, AController* Instigator,
+	const FRockInventorySlotHandle& InSlotHandle, ERockSlotStatus InStatus)
+{
+	if (!ConsumeRateLimit(ERockRateLimitedRequest::SlotStatus))
+	{
+		return;
+	}
+	if (!ensureMsgf(Inventory, TEXT("Server_RegisterSlotStatus_Implementation: Inventory is null")))
+	{
+		return;
+	}
+	Inventory->RegisterSlotStatus(Instigator, InSlotHandle, InStatus);
+}
+
+void URockInventoryManagerComponent::Server_ReleaseSlotStatus_Implementation(
+	URockInventory* Inventory, AController* Instigator, const FRockInventorySlotHandle& InSlotHandle)
+{
+	if (!ConsumeRateLimit(ERockRateLimitedRequest::SlotStatus) || !Inventory)
+	{
+		return;
+	}
+	Inventory->ReleaseSlotStatus(Instigator, InSlotHandle);
+}
+
+bool URockInventoryManagerComponent::ConsumeRateLimit(ERockRateLimitedRequest Request, float Cost)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (RateLimiter.TryConsume(Request, Now, Cost))
+	{
+		return true;
+	}
+	// A flooding client would flood the log as well
+	if (Now - LastRateLimitLogTime >= 1.0)
+	{
+		LastRateLimitLogTime = Now;
+		FRockRateLimitStats Stats;
+		RateLimiter.GetStats(Stats);
+		UE_LOG(LogRockInventory, Warning, TEXT("ConsumeRateLimit - %s is over its %s limit, %lld requests rejected so far"),
+			*GetNameSafe(GetOwner()), *UEnum::GetValueAsString(Request), Stats.TotalRejected);
 	}
 	return false;
-	// can't undo anything other than Move at this time. So don't even try.
+}
+
+FRockRateLimitStats URockInventoryManagerComponent::GetRateLimitStats() const
+{
+	FRockRateLimitStats Stats;
+	RateLimiter.GetStats(Stats);
+	return Stats;
+}
+
+void URockInventoryManagerComponent::JournalTransaction(URockInventory* InventoryA, URockInventory* InventoryB)
+{
+	if (!bJournalTransactions)
+	{
+		return;
+	}
+	if (JournalDeferDepth > 0)
+	{
+		DeferredJournalInventories.AddUnique(InventoryA);
+		if (InventoryB)
+		{
+			DeferredJournalInventories.AddUnique(InventoryB);
+		}
+		return;
+	}
+	URockInventoryPersistenceSubsystem* Persistence = UWorld::GetSubsystem<URockInventoryPersistenceSubsystem>(GetWorld());
+	if (!Persistence || !Persistence->IsJournalEnabled())
+	{
+		return;
+	}
+	// Each inventory gets its own record, holding everything it changed since its previous one
+	Persistence->JournalChanges(InventoryA);
+	if (InventoryB != InventoryA)
+	{
+		Persistence->JournalChanges(InventoryB);
+	}
+}
+
+void URockInventoryManagerComponent::FlushDeferredJournal()
+{
+	if (JournalDeferDepth > 0)
+	{
+		return;
+	}
+	// Rolled back entries were deferred too, so the records hold the state after the rollback
+	TArray<TWeakObjectPtr<URockInventory>, TInlineAllocator<4>> Inventories = MoveTemp(DeferredJournalInventories);
+	DeferredJournalInventories.Reset();
+	for (const TWeakObjectPtr<URockInventory>& Inventory : Inventories)
+	{
+		if (Inventory.IsValid())
+		{
+			JournalTransaction(Inventory.Get());
+		}
+	}
+}
+
+void URockInventoryManagerComponent::AddToHistory(FRockInventoryTransactionRecord&& TransactionRecord)
+{
+	// We are about to add to the history, so we need to remove any redoable transactions ahead of 'this one'
+	TransactionHistory.TruncateAfter(CurrentTransactionIndex);
+	// Full or over budget drops the oldest record
+	TransactionHistory.Add(MoveTemp(TransactionRecord));
+	CurrentTransactionIndex = TransactionHistory.Num() - 1;
+}
+
+void URockInventoryManagerComponent::ClearHistory()
+{
+	TransactionHistory.Reset();
+	CurrentTransactionIndex = -1;
 }
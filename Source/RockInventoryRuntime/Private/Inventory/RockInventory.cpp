@@ -3,7 +3,11 @@
 #include "Inventory/RockInventory.h"
 
 #include "RockInventoryLogging.h"
+#include "Inventory/RockInventoryDeferredEffects.h"
+#include "Inventory/RockInventoryResyncData.h"
 #include "Inventory/RockInventorySectionInfo.h"
+#include "Inventory/RockInventoryShadowState.h"
+#include "Inventory/RockInventorySnapshot.h"
 #include "Inventory/Events/RockSlotChangeType.h"
 #include "Inventory/Events/RockSlotDelta.h"
 #include "Iris/ReplicationSystem/ReplicationFragmentUtil.h"
@@ -76,6 +80,15 @@ void URockInventory::Init(const URockInventoryConfig* config)
 	ItemData.SetOwningInventory(this);
 	SlotData.SetOwningInventory(this);
 
+	if (!PersistentId.IsValid())
+	{
+		PersistentId = FGuid::NewGuid();
+	}
+	// Fresh contents, nothing to persist incrementally yet
+	ChangedItemIndices.Reset();
+	ChangedSlotIndices.Reset();
+	++ChangeSerial;
+
 	// Initialize the inventory data
 	int32 totalInventorySlots = 0;
 	SlotData.Empty();
@@ -119,6 +132,7 @@ void URockInventory::Init(const URockInventoryConfig* config)
 
 	SlotData.MarkArrayDirty();
 	ItemData.MarkArrayDirty();
+	InvalidateSnapshot();
 }
 
 const FRockInventorySectionInfo& URockInventory::GetSectionInfo(const FGameplayTag& SectionTag) const
@@ -146,6 +160,18 @@ int32 URockInventory::GetSectionIndex(const FGameplayTag& SectionTag) const
 	return INDEX_NONE;
 }
 
+int32 URockInventory::GetSectionIndexBySlotHandle(const FRockInventorySlotHandle& InSlotHandle) const
+{
+	for (int32 i = 0; i < SlotSections.Num(); ++i)
+	{
+		if (SlotSections[i].ContainsSlotHandle(InSlotHandle))
+		{
+			return i;
+		}
+	}
+	return INDEX_NONE;
+}
+
 
 const FRockInventorySectionInfo& URockInventory::GetSectionInfoBySlotHandle(const FRockInventorySlotHandle& InSlotHandle) const
 {
@@ -240,7 +266,8 @@ void URockInventory::SetItemByHandle(const FRockItemStackHandle& InSlotHandle, c
 	}
 	FRockItemStack& ChangedItem = ItemData[slotIndex];
 	ChangedItem.CopyDataFrom(InItemStack);
-	ItemData.MarkItemDirty(ChangedItem);
+	MarkItemEntryDirty(slotIndex);
+	MarkItemIndexChanged(slotIndex);
 	BroadcastItemChanged(InSlotHandle, ERockItemChangeType::Removed);
 }
 
@@ -292,7 +319,8 @@ void URockInventory::SetSlotByHandle(const FRockInventorySlotHandle& InSlotHandl
 		ChangedSlot.LastKnownItemHandle = InSlotEntry.ItemHandle;
 		ChangedSlot.Orientation = InSlotEntry.Orientation;
 		ChangedSlot.bIsLocked = InSlotEntry.bIsLocked;
-		SlotData.MarkItemDirty(ChangedSlot);
+		MarkSlotEntryDirty(slotIndex);
+		MarkSlotIndexChanged(slotIndex);
 
 		FRockSlotDelta slotDelta(this, InSlotHandle, ChangeType, PreviousItemHandle);
 		BroadcastSlotChanged(slotDelta);
@@ -411,11 +439,23 @@ void URockInventory::UnregisterReplicationWithOwner()
 
 void URockInventory::BroadcastSlotChanged(const FRockSlotDelta& SlotDelta)
 {
+	if (DeferredEffects)
+	{
+		DeferredEffects->Add(this, FRockInventoryDeferredEffects::EEffectType::SlotChanged, DeferredEffects->SlotDeltas.Add(SlotDelta));
+		return;
+	}
 	OnSlotChanged.Broadcast(SlotDelta);
 }
 
 void URockInventory::BroadcastItemChanged(const FRockItemStackHandle& ItemStackHandle, ERockItemChangeType ChangeType)
 {
+	if (DeferredEffects)
+	{
+		DeferredEffects->Add(this, FRockInventoryDeferredEffects::EEffectType::ItemChanged);
+		DeferredEffects->Effects.Last().ItemHandle = ItemStackHandle;
+		DeferredEffects->Effects.Last().ItemChangeType = ChangeType;
+		return;
+	}
 	OnItemChanged.Broadcast(FRockItemDelta(this, ItemStackHandle));
 }
 
@@ -590,6 +630,74 @@ FRockPendingSlotOperation URockInventory::GetPendingSlotState(const FRockInvento
 	return FRockPendingSlotOperation();
 }
 
+void URockInventory::MarkItemIndexChanged(int32 ItemIndex)
+{
+	if (ChangedItemIndices.Num() <= ItemIndex)
+	{
+		ChangedItemIndices.SetNum(FMath::Max(ItemIndex + 1, ItemData.Num()), false);
+	}
+	ChangedItemIndices[ItemIndex] = true;
+	++ChangeSerial;
+	MarkSnapshotItemDirty(ItemIndex);
+}
+
+void URockInventory::MarkSlotIndexChanged(int32 SlotIndex)
+{
+	if (ChangedSlotIndices.Num() <= SlotIndex)
+	{
+		ChangedSlotIndices.SetNum(SlotData.Num(), false);
+	}
+	ChangedSlotIndices[SlotIndex] = true;
+	++ChangeSerial;
+	MarkSnapshotSlotDirty(SlotIndex);
+}
+
+void URockInventory::MarkItemEntryDirty(int32 ItemIndex)
+{
+	if (DeferredEffects)
+	{
+		DeferredEffects->Add(this, FRockInventoryDeferredEffects::EEffectType::ItemDirty, ItemIndex);
+		return;
+	}
+	ItemData.MarkItemDirty(ItemData[ItemIndex]);
+}
+
+void URockInventory::MarkItemArrayDirty()
+{
+	if (DeferredEffects)
+	{
+		DeferredEffects->Add(this, FRockInventoryDeferredEffects::EEffectType::ItemArrayDirty);
+		return;
+	}
+	ItemData.MarkArrayDirty();
+}
+
+void URockInventory::MarkSlotEntryDirty(int32 SlotIndex)
+{
+	if (DeferredEffects)
+	{
+		DeferredEffects->Add(this, FRockInventoryDeferredEffects::EEffectType::SlotDirty, SlotIndex);
+		return;
+	}
+	SlotData.MarkItemDirty(SlotData[SlotIndex]);
+}
+
+void URockInventory::ConsumeChangedIndices(TArray<int32>& OutItemIndices, TArray<int32>& OutSlotIndices)
+{
+	OutItemIndices.Reset();
+	OutSlotIndices.Reset();
+	for (TConstSetBitIterator<> It(ChangedItemIndices); It; ++It)
+	{
+		OutItemIndices.Add(It.GetIndex());
+	}
+	for (TConstSetBitIterator<> It(ChangedSlotIndices); It; ++It)
+	{
+		OutSlotIndices.Add(It.GetIndex());
+	}
+	ChangedItemIndices.Reset();
+	ChangedSlotIndices.Reset();
+}
+
 FString URockInventory::GetDebugString() const
 {
 	// Is there a better 'name' for this inventory?
@@ -599,10 +707,21 @@ FString URockInventory::GetDebugString() const
 
 uint32 URockInventory::AcquireAvailableItemIndex()
 {
+	if (IsPredicting())
+	{
+		// Clients don't have FreeIndices, and growing the array locally would fight the FastArray replication.
+		// Predictions check FindFreeItemIndex up front
+		const int32 FreeIndex = FindFreeItemIndex();
+		checkf(FreeIndex != INDEX_NONE, TEXT("AcquireAvailableItemData - Predicted an add without a free item index"));
+		return FreeIndex;
+	}
 	if (FreeIndices.Num() > 0)
 	{
+		// Always reuse the lowest index, so a client can predict which one we pick (FindFreeItemIndex)
 		// The item should already have its handle and generation set
-		return FreeIndices.Pop(EAllowShrinking::No);
+		uint32 Index = 0;
+		FreeIndices.HeapPop(Index, EAllowShrinking::No);
+		return Index;
 	}
 	else if (ItemData.Num() <= SlotData.Num())
 	{
@@ -621,6 +740,290 @@ uint32 URockInventory::AcquireAvailableItemIndex()
 	return INDEX_NONE;
 }
 
+void URockInventory::MarkSnapshotItemDirty(int32 ItemIndex)
+{
+	// Pages past the end of the cached snapshot are always copied
+	const int32 Page = ItemIndex / FRockInventorySnapshot::ItemsPerPage;
+	if (CachedSnapshot && SnapshotDirtyItemPages.IsValidIndex(Page))
+	{
+		SnapshotDirtyItemPages[Page] = true;
+	}
+}
+
+void URockInventory::MarkSnapshotSlotDirty(int32 SlotIndex)
+{
+	if (!CachedSnapshot)
+	{
+		return;
+	}
+	for (int32 SectionIndex = 0; SectionIndex < SlotSections.Num() && SectionIndex < SnapshotDirtySections.Num(); ++SectionIndex)
+	{
+		const FRockInventorySectionInfo& Section = SlotSections[SectionIndex];
+		if (SlotIndex >= Section.GetFirstSlotIndex() && SlotIndex < Section.GetFirstSlotIndex() + Section.GetNumSlots())
+		{
+			SnapshotDirtySections[SectionIndex] = true;
+			return;
+		}
+	}
+}
+
+void URockInventory::InvalidateSnapshot()
+{
+	CachedSnapshot.Reset();
+	SnapshotDirtySections.Empty();
+	SnapshotDirtyItemPages.Empty();
+}
+
+TSharedRef<const FRockInventorySnapshot, ESPMode::ThreadSafe> URockInventory::GetSnapshot() const
+{
+	check(IsInGameThread());
+	constexpr int32 ItemsPerPage = FRockInventorySnapshot::ItemsPerPage;
+
+	const FRockInventorySnapshot* Previous = CachedSnapshot.Get();
+	const bool bSameLayout = Previous && Previous->Sections.Num() == SlotSections.Num() && Previous->NumSlots == SlotData.Num();
+	if (bSameLayout && Previous->NumItems == ItemData.Num()
+		&& !SnapshotDirtySections.Contains(true) && !SnapshotDirtyItemPages.Contains(true))
+	{
+		return CachedSnapshot.ToSharedRef();
+	}
+
+	TSharedRef<FRockInventorySnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FRockInventorySnapshot, ESPMode::ThreadSafe>();
+	Snapshot->Version = Previous ? Previous->Version + 1 : 1;
+	Snapshot->NumSlots = SlotData.Num();
+	Snapshot->NumItems = ItemData.Num();
+
+	// Unchanged sections and pages are shared with the previous snapshot, the rest is copied
+	Snapshot->Sections.Reserve(SlotSections.Num());
+	for (int32 SectionIndex = 0; SectionIndex < SlotSections.Num(); ++SectionIndex)
+	{
+		if (bSameLayout && !SnapshotDirtySections[SectionIndex])
+		{
+			Snapshot->Sections.Add(Previous->Sections[SectionIndex]);
+			continue;
+		}
+		const FRockInventorySectionInfo& SectionInfo = SlotSections[SectionIndex];
+		TSharedRef<FRockInventorySnapshot::FSection, ESPMode::ThreadSafe> Section = MakeShared<FRockInventorySnapshot::FSection, ESPMode::ThreadSafe>();
+		Section->Info = SectionInfo;
+		Section->Slots.Append(MakeArrayView(SlotData.AllSlots).Slice(SectionInfo.GetFirstSlotIndex(), SectionInfo.GetNumSlots()));
+		Snapshot->Sections.Add(Section);
+	}
+
+	const int32 NumPages = FMath::DivideAndRoundUp(ItemData.Num(), ItemsPerPage);
+	Snapshot->ItemPages.Reserve(NumPages);
+	for (int32 Page = 0; Page < NumPages; ++Page)
+	{
+		const int32 FirstItem = Page * ItemsPerPage;
+		const int32 NumPageItems = FMath::Min(ItemsPerPage, ItemData.Num() - FirstItem);
+		const bool bUnchanged = Previous && SnapshotDirtyItemPages.IsValidIndex(Page) && !SnapshotDirtyItemPages[Page]
+			&& Previous->ItemPages[Page]->Items.Num() == NumPageItems;
+		if (bUnchanged)
+		{
+			Snapshot->ItemPages.Add(Previous->ItemPages[Page]);
+			continue;
+		}
+		TSharedRef<FRockInventorySnapshot::FItemPage, ESPMode::ThreadSafe> ItemPage = MakeShared<FRockInventorySnapshot::FItemPage, ESPMode::ThreadSafe>();
+		ItemPage->Items.Append(MakeArrayView(ItemData.AllSlots).Slice(FirstItem, NumPageItems));
+		Snapshot->ItemPages.Add(ItemPage);
+	}
+
+	CachedSnapshot = Snapshot;
+	SnapshotDirtySections.Init(false, SlotSections.Num());
+	SnapshotDirtyItemPages.Init(false, NumPages);
+	return Snapshot;
+}
+
+bool URockInventory::HasRuntimeInstances() const
+{
+	for (const FRockItemStack& Item : ItemData)
+	{
+		if (Item.RuntimeInstance || (Item.Definition && !Item.Definition->RuntimeInstanceClass.IsNull()))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+int32 URockInventory::FindFreeItemIndex() const
+{
+	if (!IsPredicting() && FreeIndices.Num() > 0)
+	{
+		return static_cast<int32>(FreeIndices.HeapTop());
+	}
+	// Every reset entry is free. On the server that's exactly the FreeIndices set, on a client it's the only thing we know
+	for (int32 Index = 0; Index < ItemData.Num(); ++Index)
+	{
+		if (!ItemData[Index].IsValid())
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+void URockInventory::CaptureShadowState(FRockInventoryShadowState& OutState) const
+{
+	OutState.Items = ItemData.AllSlots;
+	OutState.Slots = SlotData.AllSlots;
+	OutState.FreeIndices = FreeIndices;
+}
+
+void URockInventory::RebaseShadowState(
+	FRockInventoryShadowState& InOutState, TConstArrayView<int32> ItemIndices, TConstArrayView<int32> SlotIndices) const
+{
+	if (InOutState.Items.Num() < ItemData.Num())
+	{
+		InOutState.Items.SetNum(ItemData.Num());
+	}
+	if (InOutState.Slots.Num() < SlotData.Num())
+	{
+		InOutState.Slots.SetNum(SlotData.Num());
+	}
+	for (const int32 Index : ItemIndices)
+	{
+		if (ItemData.ContainsIndex(Index))
+		{
+			InOutState.Items[Index] = ItemData[Index];
+		}
+	}
+	for (const int32 Index : SlotIndices)
+	{
+		if (SlotData.ContainsIndex(Index))
+		{
+			InOutState.Slots[Index] = SlotData[Index];
+		}
+	}
+}
+
+void URockInventory::RestoreShadowState(const FRockInventoryShadowState& InState)
+{
+	FreeIndices = InState.FreeIndices;
+
+	// Predictions never grow the arrays, replication might have. Anything past the shadow is authoritative already
+	const int32 NumItems = FMath::Min(ItemData.Num(), InState.Items.Num());
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		OverwriteItemAtIndex(Index, InState.Items[Index]);
+	}
+
+	const int32 NumSlots = FMath::Min(SlotData.Num(), InState.Slots.Num());
+	for (int32 Index = 0; Index < NumSlots; ++Index)
+	{
+		// Only broadcasts what actually differs
+		SetSlotByHandle(SlotData[Index].SlotHandle, InState.Slots[Index]);
+	}
+}
+
+void URockInventory::BuildResyncData(uint32 SectionMask, FRockInventoryResyncData& OutData) const
+{
+	OutData.Inventory = const_cast<URockInventory*>(this);
+	OutData.SectionMask = SectionMask;
+	OutData.Slots.Reset();
+	OutData.ItemIndices.Reset();
+	OutData.Items.Reset();
+
+	TBitArray<> AddedItems(false, ItemData.Num());
+	auto AddItem = [this, &OutData, &AddedItems](int32 ItemIndex)
+	{
+		if (ItemData.ContainsIndex(ItemIndex) && !AddedItems[ItemIndex])
+		{
+			AddedItems[ItemIndex] = true;
+			OutData.ItemIndices.Add(ItemIndex);
+			OutData.Items.Add(ItemData[ItemIndex]);
+		}
+	};
+
+	for (int32 SectionIndex = 0; SectionIndex < SlotSections.Num(); ++SectionIndex)
+	{
+		if (SectionIndex < 32 && (SectionMask & (1u << SectionIndex)) == 0)
+		{
+			continue;
+		}
+		const FRockInventorySectionInfo& Section = SlotSections[SectionIndex];
+		const int32 FirstIndex = Section.GetFirstSlotIndex();
+		for (int32 SlotIndex = FirstIndex; SlotIndex < FirstIndex + Section.GetNumSlots(); ++SlotIndex)
+		{
+			const FRockInventorySlotEntry& Slot = SlotData[SlotIndex];
+			OutData.Slots.Add(Slot);
+			if (Slot.ItemHandle.IsValid())
+			{
+				AddItem(Slot.ItemHandle.GetIndex());
+			}
+		}
+	}
+	// A client may hold a stale item in an entry we consider free, e.g. a split it predicted that got rejected
+	for (const uint32 FreeIndex : FreeIndices)
+	{
+		AddItem(FreeIndex);
+	}
+}
+
+void URockInventory::ApplyResyncData(const FRockInventoryResyncData& InData)
+{
+	TArray<int32, TInlineAllocator<16>> ItemIndices;
+	for (int32 Entry = 0; Entry < InData.Items.Num() && Entry < InData.ItemIndices.Num(); ++Entry)
+	{
+		// Entries past our array haven't replicated yet, replication will bring them
+		const int32 ItemIndex = InData.ItemIndices[Entry];
+		if (ItemData.ContainsIndex(ItemIndex))
+		{
+			OverwriteItemAtIndex(ItemIndex, InData.Items[Entry]);
+			ItemIndices.Add(ItemIndex);
+		}
+	}
+
+	TArray<int32, TInlineAllocator<32>> SlotIndices;
+	for (const FRockInventorySlotEntry& Slot : InData.Slots)
+	{
+		const int32 SlotIndex = Slot.SlotHandle.GetAbsoluteIndex();
+		if (SlotData.ContainsIndex(SlotIndex))
+		{
+			SetSlotByHandle(Slot.SlotHandle, Slot);
+			SlotIndices.Add(SlotIndex);
+		}
+	}
+
+	// Same as replicated data as far as anyone reconciling predictions is concerned
+	NotifyDataReplicated(ItemIndices, SlotIndices);
+}
+
+void URockInventory::OverwriteItemAtIndex(int32 ItemIndex, const FRockItemStack& InItemStack)
+{
+	FRockItemStack& LiveItem = ItemData[ItemIndex];
+	if (LiveItem == InItemStack)
+	{
+		return;
+	}
+	const FRockItemStackHandle PreviousHandle = LiveItem.ItemHandle;
+	const bool bWasValid = LiveItem.IsValid();
+	LiveItem.CopyDataFrom(InItemStack);
+	LiveItem.bInitialized = InItemStack.bInitialized;
+	MarkItemIndexChanged(ItemIndex);
+
+	if (bWasValid && (!LiveItem.IsValid() || PreviousHandle != LiveItem.ItemHandle))
+	{
+		BroadcastItemChanged(PreviousHandle, ERockItemChangeType::Removed);
+	}
+	if (LiveItem.IsValid())
+	{
+		BroadcastItemChanged(LiveItem.ItemHandle,
+			bWasValid && PreviousHandle == LiveItem.ItemHandle ? ERockItemChangeType::Changed : ERockItemChangeType::Added);
+	}
+}
+
+void URockInventory::NotifyDataReplicated(TConstArrayView<int32> ItemIndices, TConstArrayView<int32> SlotIndices)
+{
+	for (const int32 ItemIndex : ItemIndices)
+	{
+		MarkSnapshotItemDirty(ItemIndex);
+	}
+	for (const int32 SlotIndex : SlotIndices)
+	{
+		MarkSnapshotSlotDirty(SlotIndex);
+	}
+	OnDataReplicated.Broadcast(this, ItemIndices, SlotIndices);
+}
+
 int32 URockInventory::GetItemStackCount()
 {
 	int32 Count = 0;
@@ -679,8 +1082,8 @@ FRockItemStackHandle URockInventory::AddItemToInventory(const FRockItemStack& In
 
 	// Let's make sure we are owned by an actor with authority
 	AActor* OwningActor = GetOwningActor();
-	checkf(OwningActor && OwningActor->HasAuthority(),
-	       TEXT("AddItemToInventory - Inventory must be owned by an actor with authority"));
+	checkf(OwningActor && (OwningActor->HasAuthority() || IsPredicting()),
+	       TEXT("AddItemToInventory - Inventory must be owned by an actor with authority, or be predicted"));
 
 	const int32 PreviousItemDataNum = ItemData.Num();
 	const uint32 Index = AcquireAvailableItemIndex();
@@ -741,11 +1144,12 @@ FRockItemStackHandle URockInventory::AddItemToInventory(const FRockItemStack& In
 	}
 
 	// Set up the item
-	ItemData.MarkItemDirty(ItemData[Index]);
+	MarkItemEntryDirty(Index);
+	MarkItemIndexChanged(Index);
 	if (ItemData.Num() != PreviousItemDataNum)
 	{
 		// Our array changed size. Mark dirty.
-		ItemData.MarkArrayDirty();
+		MarkItemArrayDirty();
 	}
 	BroadcastItemChanged(ItemData[Index].ItemHandle, ERockItemChangeType::Added);
 	// Return handle with current index and generation
@@ -774,7 +1178,7 @@ void URockInventory::RemoveItemFromInventory(const FRockItemStackHandle& InItemS
 		ItemData[InIndex].RuntimeInstance->UnregisterReplicationWithOwner();
 	}
 	const FRockItemStackHandle OldHandle = ItemData[InIndex].ItemHandle;
-	FreeIndices.Add(InIndex);
+	FreeIndices.HeapPush(InIndex);
 	// Update the ItemHandle with new Generation
 	ItemData[InIndex].Generation++;
 	ItemData[InIndex].ItemHandle = FRockItemStackHandle::Create(InIndex, ItemData[InIndex].Generation);
@@ -782,7 +1186,8 @@ void URockInventory::RemoveItemFromInventory(const FRockItemStackHandle& InItemS
 
 	// It's common that Remove from FastArray typically would call MarkArrayDirty.
 	// But we are not removing the item from the array, just resetting it to be reused later. 
-	ItemData.MarkItemDirty(ItemData[InIndex]);
+	MarkItemEntryDirty(InIndex);
+	MarkItemIndexChanged(InIndex);
 
 	// We need to broadcast the old handle so that the client can remove it from their inventory.
 	BroadcastItemChanged(OldHandle, ERockItemChangeType::Removed);
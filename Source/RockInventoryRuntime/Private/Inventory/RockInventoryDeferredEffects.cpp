@@ -0,0 +1,139 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Inventory/RockInventoryDeferredEffects.h"
+
+#include "Inventory/RockInventory.h"
+
+void FRockInventoryDeferredEffects::Apply()
+{
+	check(IsInGameThread());
+	for (const FEffect& Effect : Effects)
+	{
+		URockInventory* Inventory = Effect.Inventory;
+		checkf(!Inventory->DeferredEffects, TEXT("FRockInventoryDeferredEffects::Apply - Inventory is still deferring"));
+		switch (Effect.Type)
+		{
+		case EEffectType::ItemDirty:
+			Inventory->MarkItemEntryDirty(Effect.Index);
+			break;
+		case EEffectType::ItemArrayDirty:
+			Inventory->MarkItemArrayDirty();
+			break;
+		case EEffectType::SlotDirty:
+			Inventory->MarkSlotEntryDirty(Effect.Index);
+			break;
+		case EEffectType::ItemChanged:
+			Inventory->BroadcastItemChanged(Effect.ItemHandle, Effect.ItemChangeType);
+			break;
+		case EEffectType::SlotChanged:
+			Inventory->BroadcastSlotChanged(SlotDeltas[Effect.Index]);
+			break;
+		}
+	}
+	Reset();
+}
+
+void FRockInventoryDeferredEffects::Coalesce()
+{
+	TSet<URockInventory*, DefaultKeyFuncs<URockInventory*>, TInlineSetAllocator<2>> ItemArrayDirtyInventories;
+	for (const FEffect& Effect : Effects)
+	{
+		if (Effect.Type == EEffectType::ItemArrayDirty)
+		{
+			ItemArrayDirtyInventories.Add(Effect.Inventory);
+		}
+	}
+
+	TSet<URockInventory*, DefaultKeyFuncs<URockInventory*>, TInlineSetAllocator<2>> DirtiedItemArrays;
+	using FEntryKey = TPair<URockInventory*, int32>;
+	TSet<FEntryKey> DirtiedItems;
+	TSet<FEntryKey> DirtiedSlots;
+	TMap<TPair<URockInventory*, FRockItemStackHandle>, int32> BroadcastItems;
+	TMap<FEntryKey, int32> BroadcastSlots;
+
+	TArray<FEffect> Coalesced;
+	Coalesced.Reserve(Effects.Num());
+	for (const FEffect& Effect : Effects)
+	{
+		bool bKeep = true;
+		switch (Effect.Type)
+		{
+		case EEffectType::ItemDirty:
+			bKeep = !ItemArrayDirtyInventories.Contains(Effect.Inventory) && !DirtiedItems.Contains(FEntryKey(Effect.Inventory, Effect.Index));
+			DirtiedItems.Add(FEntryKey(Effect.Inventory, Effect.Index));
+			break;
+		case EEffectType::ItemArrayDirty:
+			bKeep = !DirtiedItemArrays.Contains(Effect.Inventory);
+			DirtiedItemArrays.Add(Effect.Inventory);
+			break;
+		case EEffectType::SlotDirty:
+			bKeep = !DirtiedSlots.Contains(FEntryKey(Effect.Inventory, Effect.Index));
+			DirtiedSlots.Add(FEntryKey(Effect.Inventory, Effect.Index));
+			break;
+		case EEffectType::ItemChanged:
+			if (const int32* Existing = BroadcastItems.Find(TPair<URockInventory*, FRockItemStackHandle>(Effect.Inventory, Effect.ItemHandle)))
+			{
+				Coalesced[*Existing].ItemChangeType = Effect.ItemChangeType;
+				bKeep = false;
+			}
+			else
+			{
+				BroadcastItems.Add(TPair<URockInventory*, FRockItemStackHandle>(Effect.Inventory, Effect.ItemHandle), Coalesced.Num());
+			}
+			break;
+		case EEffectType::SlotChanged:
+			{
+				const FRockSlotDelta& SlotDelta = SlotDeltas[Effect.Index];
+				const FEntryKey SlotKey(Effect.Inventory, SlotDelta.SlotHandle.GetAbsoluteIndex());
+				if (const int32* Existing = BroadcastSlots.Find(SlotKey))
+				{
+					SlotDeltas[Coalesced[*Existing].Index].ChangeType = SlotDelta.ChangeType;
+					bKeep = false;
+				}
+				else
+				{
+					BroadcastSlots.Add(SlotKey, Coalesced.Num());
+				}
+			}
+			break;
+		}
+		if (bKeep)
+		{
+			Coalesced.Add(Effect);
+		}
+	}
+	Effects = MoveTemp(Coalesced);
+}
+
+void FRockInventoryDeferredEffects::Reset()
+{
+	Effects.Reset();
+	SlotDeltas.Reset();
+}
+
+void FRockInventoryDeferredEffects::Add(URockInventory* Inventory, EEffectType Type, int32 Index)
+{
+	FEffect& Effect = Effects.AddDefaulted_GetRef();
+	Effect.Inventory = Inventory;
+	Effect.Type = Type;
+	Effect.Index = Index;
+}
+
+FRockInventoryDeferredEffectsScope::FRockInventoryDeferredEffectsScope(
+	FRockInventoryDeferredEffects& InEffects, TConstArrayView<URockInventory*> InInventories)
+	: Inventories(InInventories)
+{
+	for (URockInventory* Inventory : Inventories)
+	{
+		checkf(!Inventory->DeferredEffects, TEXT("FRockInventoryDeferredEffectsScope - %s is already deferring"), *Inventory->GetName());
+		Inventory->DeferredEffects = &InEffects;
+	}
+}
+
+FRockInventoryDeferredEffectsScope::~FRockInventoryDeferredEffectsScope()
+{
+	for (URockInventory* Inventory : Inventories)
+	{
+		Inventory->DeferredEffects = nullptr;
+	}
+}
@@ -0,0 +1,30 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Inventory/RockInventoryShadowState.h"
+
+#include "Inventory/RockInventory.h"
+
+FRockInventoryPredictionScope::FRockInventoryPredictionScope(URockInventory* InInventoryA, URockInventory* InInventoryB)
+	: InventoryA(InInventoryA), InventoryB(InInventoryB != InInventoryA ? InInventoryB : nullptr)
+{
+	if (InventoryA)
+	{
+		++InventoryA->PredictionScopeCount;
+	}
+	if (InventoryB)
+	{
+		++InventoryB->PredictionScopeCount;
+	}
+}
+
+FRockInventoryPredictionScope::~FRockInventoryPredictionScope()
+{
+	if (InventoryA)
+	{
+		--InventoryA->PredictionScopeCount;
+	}
+	if (InventoryB)
+	{
+		--InventoryB->PredictionScopeCount;
+	}
+}
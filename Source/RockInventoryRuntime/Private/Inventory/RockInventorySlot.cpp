@@ -92,6 +92,7 @@ void FRockInventorySlotContainer::PostReplicatedAdd(const TArrayView<int32> Adde
 			}
 		}
 	}
+	OwnerInventory->NotifyDataReplicated({}, AddedIndices);
 }
 
 void FRockInventorySlotContainer::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
@@ -157,4 +158,5 @@ void FRockInventorySlotContainer::PostReplicatedChange(const TArrayView<int32> C
 			OwnerInventory->BroadcastSlotChanged(SlotDelta);
 		}
 	}
+	OwnerInventory->NotifyDataReplicated({}, ChangedIndices);
 }
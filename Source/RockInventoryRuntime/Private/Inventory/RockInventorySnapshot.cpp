@@ -0,0 +1,56 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Inventory/RockInventorySnapshot.h"
+
+const FRockInventorySlotEntry* FRockInventorySnapshot::GetSlot(const FRockInventorySlotHandle& SlotHandle) const
+{
+	const int32 AbsoluteIndex = SlotHandle.GetAbsoluteIndex();
+	for (const TSharedPtr<const FSection, ESPMode::ThreadSafe>& Section : Sections)
+	{
+		const int32 LocalIndex = AbsoluteIndex - Section->Info.GetFirstSlotIndex();
+		if (Section->Slots.IsValidIndex(LocalIndex))
+		{
+			return &Section->Slots[LocalIndex];
+		}
+	}
+	return nullptr;
+}
+
+const FRockItemStack* FRockInventorySnapshot::GetItem(const FRockItemStackHandle& ItemHandle) const
+{
+	if (!ItemHandle.IsValid())
+	{
+		return nullptr;
+	}
+	const FRockItemStack* Item = GetItemAtIndex(ItemHandle.GetIndex());
+	return Item && Item->ItemHandle == ItemHandle && Item->IsValid() ? Item : nullptr;
+}
+
+const FRockItemStack* FRockInventorySnapshot::GetItemBySlot(const FRockInventorySlotHandle& SlotHandle) const
+{
+	const FRockInventorySlotEntry* Slot = GetSlot(SlotHandle);
+	return Slot ? GetItem(Slot->ItemHandle) : nullptr;
+}
+
+void FRockInventorySnapshot::ForEachItem(const TFunctionRef<void(const FRockItemStack&)>& Visitor) const
+{
+	for (const TSharedPtr<const FItemPage, ESPMode::ThreadSafe>& Page : ItemPages)
+	{
+		for (const FRockItemStack& Item : Page->Items)
+		{
+			if (Item.IsValid())
+			{
+				Visitor(Item);
+			}
+		}
+	}
+}
+
+const FRockItemStack* FRockInventorySnapshot::GetItemAtIndex(int32 ItemIndex) const
+{
+	if (ItemIndex < 0 || ItemIndex >= NumItems)
+	{
+		return nullptr;
+	}
+	return &ItemPages[ItemIndex / ItemsPerPage]->Items[ItemIndex % ItemsPerPage];
+}
@@ -0,0 +1,13 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Inventory/RockInventorySortParams.h"
+
+FRockInventorySortParams::FRockInventorySortParams()
+{
+	SortKeys = {
+		ERockInventorySortKey::ItemType,
+		ERockInventorySortKey::Rarity,
+		ERockInventorySortKey::Size,
+		ERockInventorySortKey::Value,
+	};
+}
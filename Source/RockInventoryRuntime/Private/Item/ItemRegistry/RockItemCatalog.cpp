@@ -0,0 +1,273 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Item/ItemRegistry/RockItemCatalog.h"
+
+#include "RockInventoryLogging.h"
+#include "Item/RockItemDefinition.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace RockItemCatalog
+{
+	// Tags, ids and paths repeat a lot across a catalog, so everything string-like goes through one table.
+	struct FNameTable
+	{
+		TArray<FString> Strings;
+		TMap<FString, uint32> Lookup;
+
+		uint32 Add(const FString& String)
+		{
+			if (const uint32* Existing = Lookup.Find(String))
+			{
+				return *Existing;
+			}
+			const uint32 Index = Strings.Add(String);
+			Lookup.Add(String, Index);
+			return Index;
+		}
+	};
+
+	void WriteTags(FArchive& Ar, FNameTable& Names, const FGameplayTagContainer& Tags)
+	{
+		uint32 Count = Tags.Num();
+		Ar.SerializeIntPacked(Count);
+		for (const FGameplayTag& Tag : Tags)
+		{
+			uint32 NameIndex = Names.Add(Tag.ToString());
+			Ar.SerializeIntPacked(NameIndex);
+		}
+	}
+
+	bool ReadTags(FArchive& Ar, const TArray<FString>& Names, FGameplayTagContainer& OutTags)
+	{
+		uint32 Count = 0;
+		Ar.SerializeIntPacked(Count);
+		for (uint32 i = 0; i < Count && !Ar.IsError(); ++i)
+		{
+			uint32 NameIndex = 0;
+			Ar.SerializeIntPacked(NameIndex);
+			if (!Names.IsValidIndex(NameIndex))
+			{
+				return false;
+			}
+			// Tags that were removed from the project since the catalog was built are silently dropped
+			const FGameplayTag Tag = FGameplayTag::RequestGameplayTag(FName(*Names[NameIndex]), false);
+			if (Tag.IsValid())
+			{
+				OutTags.AddTag(Tag);
+			}
+		}
+		return !Ar.IsError();
+	}
+}
+
+FRockItemCatalogEntry FRockItemCatalogEntry::FromDefinition(const URockItemDefinition* Definition, int32 DenseId)
+{
+	check(Definition);
+	FRockItemCatalogEntry Entry;
+	Entry.ItemId = Definition->ItemId;
+	Entry.AssetPath = FSoftObjectPath(Definition);
+	Entry.DenseId = DenseId;
+	Entry.ItemType = Definition->ItemType;
+	Entry.ItemTags = Definition->ItemTags;
+	Entry.ItemRarity = Definition->ItemRarity;
+	Entry.GridSize = Definition->GridSize;
+	Entry.MaxStackCount = Definition->MaxStackCount;
+	Entry.Weight = Definition->Weight;
+	return Entry;
+}
+
+bool FRockItemCatalogEntry::MatchesDefinition(const URockItemDefinition* Definition, FString& OutMismatch) const
+{
+	if (!Definition)
+	{
+		OutMismatch = TEXT("definition missing");
+		return false;
+	}
+	if (Definition->ItemId != ItemId)
+	{
+		OutMismatch = FString::Printf(TEXT("ItemId %s != %s"), *ItemId.ToString(), *Definition->ItemId.ToString());
+	}
+	else if (FSoftObjectPath(Definition) != AssetPath)
+	{
+		OutMismatch = FString::Printf(TEXT("AssetPath %s != %s"), *AssetPath.ToString(), *FSoftObjectPath(Definition).ToString());
+	}
+	else if (Definition->GridSize != GridSize)
+	{
+		OutMismatch = FString::Printf(TEXT("GridSize %s != %s"), *GridSize.ToString(), *Definition->GridSize.ToString());
+	}
+	else if (Definition->MaxStackCount != MaxStackCount)
+	{
+		OutMismatch = FString::Printf(TEXT("MaxStackCount %d != %d"), MaxStackCount, Definition->MaxStackCount);
+	}
+	else if (Definition->Weight != Weight)
+	{
+		OutMismatch = FString::Printf(TEXT("Weight %lld != %lld"), Weight, Definition->Weight);
+	}
+	else if (!(Definition->ItemType == ItemType) || !(Definition->ItemTags == ItemTags) || Definition->ItemRarity != ItemRarity)
+	{
+		OutMismatch = TEXT("tags differ");
+	}
+	else
+	{
+		return true;
+	}
+	return false;
+}
+
+void FRockItemCatalog::Reset()
+{
+	Entries.Reset();
+	ItemIdToIndex.Reset();
+	SourceHash = 0;
+}
+
+void FRockItemCatalog::AddEntry(FRockItemCatalogEntry&& Entry)
+{
+	Entry.DenseId = Entries.Num();
+	ItemIdToIndex.Add(Entry.ItemId, Entry.DenseId);
+	Entries.Add(MoveTemp(Entry));
+}
+
+const FRockItemCatalogEntry* FRockItemCatalog::Find(FName ItemId) const
+{
+	const int32* Index = ItemIdToIndex.Find(ItemId);
+	return Index ? &Entries[*Index] : nullptr;
+}
+
+bool FRockItemCatalog::SaveToFile(const FString& Filename) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	// Serialize is symmetric, but saving doesn't mutate anything
+	if (!const_cast<FRockItemCatalog*>(this)->Serialize(Writer))
+	{
+		return false;
+	}
+	return FFileHelper::SaveArrayToFile(Bytes, *Filename);
+}
+
+bool FRockItemCatalog::LoadFromFile(const FString& Filename)
+{
+	Reset();
+	// One bulk read, everything after that is parsing from memory.
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Filename, FILEREAD_Silent))
+	{
+		return false;
+	}
+	FMemoryReader Reader(Bytes);
+	if (!Serialize(Reader))
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("Item catalog '%s' is corrupt or out of date. Ignoring it."), *Filename);
+		Reset();
+		return false;
+	}
+	return true;
+}
+
+bool FRockItemCatalog::Serialize(FArchive& Ar)
+{
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = Version;
+	Ar << FileMagic;
+	Ar << FileVersion;
+	if (FileMagic != Magic || FileVersion != Version)
+	{
+		return false;
+	}
+
+	if (Ar.IsSaving())
+	{
+		// Build the body first so the name table can be written ahead of it
+		RockItemCatalog::FNameTable Names;
+		TArray<uint8> Body;
+		FMemoryWriter BodyWriter(Body);
+		for (const FRockItemCatalogEntry& Entry : Entries)
+		{
+			uint32 IdIndex = Names.Add(Entry.ItemId.ToString());
+			uint32 PathIndex = Names.Add(Entry.AssetPath.ToString());
+			uint32 RarityIndex = Names.Add(Entry.ItemRarity.ToString());
+			BodyWriter.SerializeIntPacked(IdIndex);
+			BodyWriter.SerializeIntPacked(PathIndex);
+			BodyWriter.SerializeIntPacked(RarityIndex);
+			RockItemCatalog::WriteTags(BodyWriter, Names, Entry.ItemType);
+			RockItemCatalog::WriteTags(BodyWriter, Names, Entry.ItemTags);
+			FIntPoint GridSize = Entry.GridSize;
+			int32 MaxStackCount = Entry.MaxStackCount;
+			int64 Weight = Entry.Weight;
+			BodyWriter << GridSize.X << GridSize.Y << MaxStackCount << Weight;
+		}
+
+		int32 NumEntries = Entries.Num();
+		Ar << NumEntries;
+		Ar << SourceHash;
+		Ar << Names.Strings;
+		Ar.Serialize(Body.GetData(), Body.Num());
+		return !Ar.IsError();
+	}
+
+	Reset();
+	int32 NumEntries = 0;
+	Ar << NumEntries;
+	Ar << SourceHash;
+	TArray<FString> Names;
+	Ar << Names;
+	if (Ar.IsError() || NumEntries < 0)
+	{
+		return false;
+	}
+
+	Entries.Reserve(NumEntries);
+	ItemIdToIndex.Reserve(NumEntries);
+	for (int32 i = 0; i < NumEntries; ++i)
+	{
+		uint32 IdIndex = 0;
+		uint32 PathIndex = 0;
+		uint32 RarityIndex = 0;
+		Ar.SerializeIntPacked(IdIndex);
+		Ar.SerializeIntPacked(PathIndex);
+		Ar.SerializeIntPacked(RarityIndex);
+		if (!Names.IsValidIndex(IdIndex) || !Names.IsValidIndex(PathIndex) || !Names.IsValidIndex(RarityIndex))
+		{
+			return false;
+		}
+
+		FRockItemCatalogEntry Entry;
+		Entry.ItemId = FName(*Names[IdIndex]);
+		Entry.AssetPath = FSoftObjectPath(Names[PathIndex]);
+		Entry.ItemRarity = FGameplayTag::RequestGameplayTag(FName(*Names[RarityIndex]), false);
+		if (!RockItemCatalog::ReadTags(Ar, Names, Entry.ItemType) || !RockItemCatalog::ReadTags(Ar, Names, Entry.ItemTags))
+		{
+			return false;
+		}
+		Ar << Entry.GridSize.X << Entry.GridSize.Y << Entry.MaxStackCount << Entry.Weight;
+		if (Ar.IsError())
+		{
+			return false;
+		}
+		AddEntry(MoveTemp(Entry));
+	}
+	return true;
+}
+
+FString FRockItemCatalog::GetCatalogFilename()
+{
+	return FPaths::ProjectContentDir() / GetDefault<URockInventoryDeveloperSettings>()->ItemCatalogPath;
+}
+
+uint32 FRockItemCatalog::HashSourceAssets(TArray<FSoftObjectPath> AssetPaths)
+{
+	// Asset registry enumeration order isn't stable
+	AssetPaths.Sort([](const FSoftObjectPath& A, const FSoftObjectPath& B) { return A.ToString() < B.ToString(); });
+	const int32 NumPaths = AssetPaths.Num();
+	uint32 Hash = FCrc::MemCrc32(&NumPaths, sizeof(NumPaths));
+	for (const FSoftObjectPath& AssetPath : AssetPaths)
+	{
+		Hash = FCrc::StrCrc32(*AssetPath.ToString(), Hash);
+	}
+	return Hash;
+}
@@ -0,0 +1,211 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Item/ItemRegistry/RockItemDefinitionTable.h"
+
+#include "Item/RockItemDefinition.h"
+#include "Item/ItemRegistry/RockItemCatalog.h"
+
+int32 FRockItemDefinitionTable::Add(URockItemDefinition* Definition)
+{
+	if (!Definition || Definition->ItemId.IsNone() || ItemIdToIndex.Contains(Definition->ItemId))
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 DenseIndex = Definitions.Add(Definition);
+	ItemIdToIndex.Add(Definition->ItemId, DenseIndex);
+
+	// Indices are appended in dense order, so every posting list stays sorted without a sort pass.
+	AddToIndex(TagIndex, Definition->GetAllTags().GetGameplayTagParents(), DenseIndex);
+	AddToIndex(TypeIndex, Definition->ItemType.GetGameplayTagParents(), DenseIndex);
+	if (Definition->ItemRarity.IsValid())
+	{
+		AddToIndex(RarityIndex, Definition->ItemRarity.GetGameplayTagParents(), DenseIndex);
+	}
+	return DenseIndex;
+}
+
+void FRockItemDefinitionTable::InitializeFromCatalog(const FRockItemCatalog& Catalog)
+{
+	Reset();
+	Definitions.SetNum(Catalog.Num());
+	ItemIdToIndex.Reserve(Catalog.Num());
+	for (const FRockItemCatalogEntry& Entry : Catalog.GetEntries())
+	{
+		ItemIdToIndex.Add(Entry.ItemId, Entry.DenseId);
+
+		FGameplayTagContainer AllTags = Entry.ItemType;
+		AllTags.AppendTags(Entry.ItemTags);
+		AddToIndex(TagIndex, AllTags.GetGameplayTagParents(), Entry.DenseId);
+		AddToIndex(TypeIndex, Entry.ItemType.GetGameplayTagParents(), Entry.DenseId);
+		if (Entry.ItemRarity.IsValid())
+		{
+			AddToIndex(RarityIndex, Entry.ItemRarity.GetGameplayTagParents(), Entry.DenseId);
+		}
+	}
+	Compact();
+}
+
+void FRockItemDefinitionTable::SetDefinition(int32 DenseIndex, URockItemDefinition* Definition)
+{
+	if (ensureMsgf(Definitions.IsValidIndex(DenseIndex), TEXT("SetDefinition: dense index %d out of range"), DenseIndex))
+	{
+		Definitions[DenseIndex] = Definition;
+	}
+}
+
+void FRockItemDefinitionTable::Reset()
+{
+	Definitions.Reset();
+	ItemIdToIndex.Reset();
+	TagIndex.Reset();
+	TypeIndex.Reset();
+	RarityIndex.Reset();
+}
+
+void FRockItemDefinitionTable::Compact()
+{
+	Definitions.Shrink();
+	ItemIdToIndex.Compact();
+	for (TMap<FGameplayTag, TArray<int32>>* Index : {&TagIndex, &TypeIndex, &RarityIndex})
+	{
+		Index->Compact();
+		for (TPair<FGameplayTag, TArray<int32>>& Pair : *Index)
+		{
+			Pair.Value.Shrink();
+		}
+	}
+}
+
+int32 FRockItemDefinitionTable::FindIndex(FName ItemId) const
+{
+	const int32* DenseIndex = ItemIdToIndex.Find(ItemId);
+	return DenseIndex ? *DenseIndex : INDEX_NONE;
+}
+
+URockItemDefinition* FRockItemDefinitionTable::FindDefinition(FName ItemId) const
+{
+	return GetDefinition(FindIndex(ItemId));
+}
+
+URockItemDefinition* FRockItemDefinitionTable::GetDefinition(int32 DenseIndex) const
+{
+	return Definitions.IsValidIndex(DenseIndex) ? Definitions[DenseIndex].Get() : nullptr;
+}
+
+TConstArrayView<int32> FRockItemDefinitionTable::GetIndicesWithTag(FGameplayTag Tag) const
+{
+	return FindInIndex(TagIndex, Tag);
+}
+
+TConstArrayView<int32> FRockItemDefinitionTable::GetIndicesOfType(FGameplayTag TypeTag) const
+{
+	return FindInIndex(TypeIndex, TypeTag);
+}
+
+TConstArrayView<int32> FRockItemDefinitionTable::GetIndicesOfRarity(FGameplayTag RarityTag) const
+{
+	return FindInIndex(RarityIndex, RarityTag);
+}
+
+void FRockItemDefinitionTable::GetIndicesWithAllTags(const FGameplayTagContainer& Tags, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+	if (Tags.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<TConstArrayView<int32>, TInlineAllocator<8>> Lists;
+	for (const FGameplayTag& Tag : Tags)
+	{
+		const TConstArrayView<int32> List = GetIndicesWithTag(Tag);
+		if (List.IsEmpty())
+		{
+			// Any missing tag means nothing can match
+			return;
+		}
+		Lists.Add(List);
+	}
+	Lists.Sort([](const TConstArrayView<int32>& A, const TConstArrayView<int32>& B) { return A.Num() < B.Num(); });
+
+	// Seed with the shortest list, then narrow with a merge walk against each longer one.
+	OutIndices.Append(Lists[0].GetData(), Lists[0].Num());
+	for (int32 ListIndex = 1; ListIndex < Lists.Num() && OutIndices.Num() > 0; ++ListIndex)
+	{
+		const TConstArrayView<int32>& Other = Lists[ListIndex];
+		int32 Write = 0;
+		int32 OtherCursor = 0;
+		for (int32 Read = 0; Read < OutIndices.Num(); ++Read)
+		{
+			const int32 Candidate = OutIndices[Read];
+			while (OtherCursor < Other.Num() && Other[OtherCursor] < Candidate)
+			{
+				++OtherCursor;
+			}
+			if (OtherCursor == Other.Num())
+			{
+				break;
+			}
+			if (Other[OtherCursor] == Candidate)
+			{
+				OutIndices[Write++] = Candidate;
+			}
+		}
+		OutIndices.SetNum(Write, EAllowShrinking::No);
+	}
+}
+
+void FRockItemDefinitionTable::GetIndicesWithAnyTags(const FGameplayTagContainer& Tags, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+	for (const FGameplayTag& Tag : Tags)
+	{
+		const TConstArrayView<int32> List = GetIndicesWithTag(Tag);
+		OutIndices.Append(List.GetData(), List.Num());
+	}
+	if (Tags.Num() > 1)
+	{
+		OutIndices.Sort();
+		// Remove adjacent duplicates
+		int32 Write = 0;
+		for (int32 Read = 0; Read < OutIndices.Num(); ++Read)
+		{
+			if (Write == 0 || OutIndices[Write - 1] != OutIndices[Read])
+			{
+				OutIndices[Write++] = OutIndices[Read];
+			}
+		}
+		OutIndices.SetNum(Write, EAllowShrinking::No);
+	}
+}
+
+void FRockItemDefinitionTable::ResolveIndices(TConstArrayView<int32> Indices, TArray<URockItemDefinition*>& OutDefinitions) const
+{
+	OutDefinitions.Reset(Indices.Num());
+	for (const int32 DenseIndex : Indices)
+	{
+		// Catalog backed slots can still be unloaded
+		if (URockItemDefinition* Definition = Definitions[DenseIndex])
+		{
+			OutDefinitions.Add(Definition);
+		}
+	}
+}
+
+void FRockItemDefinitionTable::AddToIndex(TMap<FGameplayTag, TArray<int32>>& Index, const FGameplayTagContainer& Tags, int32 DenseIndex)
+{
+	for (const FGameplayTag& Tag : Tags)
+	{
+		Index.FindOrAdd(Tag).Add(DenseIndex);
+	}
+}
+
+TConstArrayView<int32> FRockItemDefinitionTable::FindInIndex(const TMap<FGameplayTag, TArray<int32>>& Index, FGameplayTag Tag)
+{
+	if (const TArray<int32>* List = Index.Find(Tag))
+	{
+		return *List;
+	}
+	return {};
+}
@@ -5,13 +5,28 @@
 #include "Engine/StreamableManager.h"
 #include "Item/RockItemDefinition.h"
 #include "Item/ItemRegistry/RockItemDefinitionRegistry.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
 #include "ProfilingDebugging/ScopedTimers.h"
+#include <atomic>
 
 // Define a log category for easier debugging
 DEFINE_LOG_CATEGORY_STATIC(LogRockItemRegistry, Log, All);
 
+namespace RockItemRegistry
+{
+	std::atomic<const FRockItemRegistrySnapshot*> CurrentSnapshot{nullptr};
+	std::atomic<uint32> NextSnapshotVersion{1};
+	// Avoids walking the world contexts on every GetInstance call. Game thread only.
+	TWeakObjectPtr<URockItemRegistrySubsystem> ActiveInstance;
+}
+
 URockItemRegistrySubsystem* URockItemRegistrySubsystem::GetInstance()
 {
+	check(IsInGameThread());
+	if (URockItemRegistrySubsystem* Cached = RockItemRegistry::ActiveInstance.Get())
+	{
+		return Cached;
+	}
 	checkf(GEngine && GEngine->GetWorldContexts().Num() > 0, TEXT("Expected at least one world context"));
 	for (const FWorldContext& Context : GEngine->GetWorldContexts())
 	{
@@ -22,6 +37,7 @@ URockItemRegistrySubsystem* URockItemRegistrySubsystem::GetInstance()
 			{
 				if (URockItemRegistrySubsystem* Subsystem = GI->GetSubsystem<URockItemRegistrySubsystem>())
 				{
+					RockItemRegistry::ActiveInstance = Subsystem;
 					return Subsystem;
 				}
 			}
@@ -31,6 +47,11 @@ URockItemRegistrySubsystem* URockItemRegistrySubsystem::GetInstance()
 	return nullptr;
 }
 
+const FRockItemRegistrySnapshot* URockItemRegistrySubsystem::GetSnapshot()
+{
+	return RockItemRegistry::CurrentSnapshot.load(std::memory_order_acquire);
+}
+
 void URockItemRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
@@ -40,16 +61,39 @@ void URockItemRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection
 	}
 	
 	UE_LOG(LogRockItemRegistry, Log, TEXT("Initializing RockItemRegistry..."));
-	BuildRegistry();
+	if (!BuildRegistryFromCatalog())
+	{
+		BuildRegistry();
+	}
 	bIsInitialized = true;
-	UE_LOG(LogRockItemRegistry, Log, TEXT("RockItemRegistry Initialized. Found %d item definitions."), ItemDefinitionMap.Num());
+	RockItemRegistry::ActiveInstance = this;
+	PublishSnapshot();
+	UE_LOG(LogRockItemRegistry, Log, TEXT("RockItemRegistry Initialized. Found %d item definitions."), DefinitionTable.Num());
 }
 
 void URockItemRegistrySubsystem::Deinitialize()
 {
 	UE_LOG(LogRockItemRegistry, Log, TEXT("Deinitializing RockItemRegistry..."));
-	ItemDefinitionMap.Empty();
+	if (CatalogLoadHandle.IsValid())
+	{
+		CatalogLoadHandle->CancelHandle();
+		CatalogLoadHandle.Reset();
+	}
+	Catalog.Reset();
+	DefinitionTable.Reset();
 	bIsInitialized = false;
+
+	// Unpublish before freeing, but leave another game instance's snapshot alone (PIE with multiple clients)
+	for (const TUniquePtr<const FRockItemRegistrySnapshot>& Snapshot : PublishedSnapshots)
+	{
+		const FRockItemRegistrySnapshot* Expected = Snapshot.Get();
+		RockItemRegistry::CurrentSnapshot.compare_exchange_strong(Expected, nullptr, std::memory_order_acq_rel);
+	}
+	PublishedSnapshots.Empty();
+	if (RockItemRegistry::ActiveInstance.Get() == this)
+	{
+		RockItemRegistry::ActiveInstance.Reset();
+	}
 	Super::Deinitialize();
 }
 
@@ -86,10 +130,9 @@ void URockItemRegistrySubsystem::BuildRegistry()
 				{
 					if (!ItemDef->ItemId.IsNone())
 					{
-						if (ItemDefinitionMap.Contains(ItemDef->ItemId))
+						if (URockItemDefinition* ExistingDef = DefinitionTable.FindDefinition(ItemDef->ItemId))
 						{
 							// Duplicate ItemId found! This is usually an error in data setup.
-							URockItemDefinition* ExistingDef = ItemDefinitionMap[ItemDef->ItemId];
 							UE_LOG(LogRockItemRegistry, Error,
 								TEXT("Duplicate ItemId '%s' found! Asset '%s' conflicts with existing asset '%s'. Ignoring the new one."),
 								*ItemDef->ItemId.ToString(),
@@ -98,8 +141,8 @@ void URockItemRegistrySubsystem::BuildRegistry()
 						}
 						else
 						{
-							// Add the valid definition to the map
-							ItemDefinitionMap.Add(ItemDef->ItemId, ItemDef);
+							// Add the valid definition to the dense table
+							DefinitionTable.Add(ItemDef);
 							UE_LOG(LogRockItemRegistry, Display, TEXT("Added Item Definition: ID '%s', Asset '%s'"), *ItemDef->ItemId.ToString(),
 								*GetPathNameSafe(ItemDef));
 						}
@@ -123,11 +166,153 @@ void URockItemRegistrySubsystem::BuildRegistry()
 				UE_LOG(LogRockItemRegistry, Warning, TEXT("Failed to initiate load for PrimaryAssetId '%s'."), *AssetId.ToString());
 			}
 		}
+		DefinitionTable.Compact();
 	}
 
 	UE_LOG(LogRockItemRegistry, Warning, TEXT("BuildRegistry() took %.3f seconds to load %d assets."), TimeBuildingRegistry, NumAssetsLoaded);
 }
 
+bool URockItemRegistrySubsystem::BuildRegistryFromCatalog()
+{
+	if (!GetDefault<URockInventoryDeveloperSettings>()->bUseItemCatalog)
+	{
+		return false;
+	}
+
+	double TimeLoadingCatalog = 0.0;
+	{
+		FScopedDurationTimer Timer(TimeLoadingCatalog);
+		const FString Filename = FRockItemCatalog::GetCatalogFilename();
+		if (!Catalog.LoadFromFile(Filename))
+		{
+			UE_LOG(LogRockItemRegistry, Display, TEXT("No usable item catalog at '%s'. Falling back to asset manager scan."), *Filename);
+			return false;
+		}
+		DefinitionTable.InitializeFromCatalog(Catalog);
+	}
+	UE_LOG(LogRockItemRegistry, Display, TEXT("Item catalog ready in %.3f seconds with %d entries."), TimeLoadingCatalog, Catalog.Num());
+
+	// Cheap staleness check, nothing gets loaded for this. A catalog that disagrees with the asset manager would hand out
+	// dense IDs for definitions that moved or leave new ones unreachable, so scan instead. The commandlet hashes every asset
+	// it was given, including the ones it skipped, so this compares the same set. ItemIds changed inside an asset are caught
+	// once the definitions stream in (see OnCatalogDefinitionsLoaded).
+	TArray<FPrimaryAssetId> PrimaryAssetIds;
+	UAssetManager::Get().GetPrimaryAssetIdList(ItemDefinitionAssetType, PrimaryAssetIds);
+	TArray<FSoftObjectPath> SourceAssetPaths;
+	SourceAssetPaths.Reserve(PrimaryAssetIds.Num());
+	for (const FPrimaryAssetId& AssetId : PrimaryAssetIds)
+	{
+		SourceAssetPaths.Add(UAssetManager::Get().GetPrimaryAssetPath(AssetId));
+	}
+	if (FRockItemCatalog::HashSourceAssets(MoveTemp(SourceAssetPaths)) != Catalog.SourceHash)
+	{
+		UE_LOG(LogRockItemRegistry, Warning, TEXT("Item catalog was built from other item definitions than the %d the asset manager knows. Falling back to asset manager scan, re-run the RockItemCatalog commandlet."),
+			PrimaryAssetIds.Num());
+		Catalog.Reset();
+		DefinitionTable.Reset();
+		return false;
+	}
+
+	// IDs, tags and metadata are usable now. The definitions themselves stream in, one batched request for the whole catalog.
+	TArray<FSoftObjectPath> AssetPaths;
+	AssetPaths.Reserve(Catalog.Num());
+	for (const FRockItemCatalogEntry& Entry : Catalog.GetEntries())
+	{
+		AssetPaths.Add(Entry.AssetPath);
+	}
+	CatalogLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		AssetPaths, FStreamableDelegate::CreateUObject(this, &URockItemRegistrySubsystem::OnCatalogDefinitionsLoaded));
+	return true;
+}
+
+void URockItemRegistrySubsystem::OnCatalogDefinitionsLoaded()
+{
+	int32 NumMismatched = 0;
+	for (const FRockItemCatalogEntry& Entry : Catalog.GetEntries())
+	{
+		URockItemDefinition* ItemDef = Cast<URockItemDefinition>(Entry.AssetPath.ResolveObject());
+		if (!ItemDef)
+		{
+			UE_LOG(LogRockItemRegistry, Warning, TEXT("Catalog entry '%s' points to missing asset '%s'."), *Entry.ItemId.ToString(), *Entry.AssetPath.ToString());
+			continue;
+		}
+		DefinitionTable.SetDefinition(Entry.DenseId, ItemDef);
+
+#if !UE_BUILD_SHIPPING
+		FString Mismatch;
+		if (!Entry.MatchesDefinition(ItemDef, Mismatch))
+		{
+			++NumMismatched;
+			UE_LOG(LogRockItemRegistry, Warning, TEXT("Catalog entry '%s' is stale: %s"), *Entry.ItemId.ToString(), *Mismatch);
+		}
+#endif
+	}
+	UE_LOG(LogRockItemRegistry, Log, TEXT("Streamed %d catalog definitions (%d stale)."), Catalog.Num(), NumMismatched);
+	CatalogLoadHandle.Reset();
+
+	// Workers only see definitions through snapshots, so republish now that every slot is filled
+	PublishSnapshot();
+}
+
+void URockItemRegistrySubsystem::PublishSnapshot()
+{
+	check(IsInGameThread());
+
+	TArray<FRockItemCatalogEntry> Metadata;
+	if (IsUsingCatalog())
+	{
+		Metadata = Catalog.GetEntries();
+	}
+	else
+	{
+		Metadata.Reserve(DefinitionTable.Num());
+		for (int32 DenseIndex = 0; DenseIndex < DefinitionTable.Num(); ++DenseIndex)
+		{
+			Metadata.Add(FRockItemCatalogEntry::FromDefinition(DefinitionTable.GetDefinition(DenseIndex), DenseIndex));
+		}
+	}
+
+	const uint32 Version = RockItemRegistry::NextSnapshotVersion.fetch_add(1, std::memory_order_relaxed);
+	const FRockItemRegistrySnapshot* Snapshot = PublishedSnapshots.Add_GetRef(
+		MakeUnique<FRockItemRegistrySnapshot>(DefinitionTable, MoveTemp(Metadata), Version)).Get();
+	// Release pairs with the acquire in GetSnapshot, readers never see a partially built snapshot
+	RockItemRegistry::CurrentSnapshot.store(Snapshot, std::memory_order_release);
+	UE_LOG(LogRockItemRegistry, Log, TEXT("Published registry snapshot v%u with %d definitions."), Version, Snapshot->Num());
+}
+
+URockItemDefinition* URockItemRegistrySubsystem::ResolveDefinition(int32 DenseIndex) const
+{
+	URockItemDefinition* ItemDef = DefinitionTable.GetDefinition(DenseIndex);
+	if (!ItemDef && Catalog.GetEntries().IsValidIndex(DenseIndex))
+	{
+		// Asked for before the bulk stream finished. Load just this one, the streamable request will pick it up as already loaded.
+		ItemDef = Cast<URockItemDefinition>(Catalog.GetEntries()[DenseIndex].AssetPath.TryLoad());
+		if (ItemDef)
+		{
+			// The table is a cache of what's already loaded, filling it in doesn't change the registry's observable state
+			const_cast<FRockItemDefinitionTable&>(DefinitionTable).SetDefinition(DenseIndex, ItemDef);
+		}
+	}
+	return ItemDef;
+}
+
+void URockItemRegistrySubsystem::ResolveDefinitions(TConstArrayView<int32> Indices, TArray<URockItemDefinition*>& OutDefinitions) const
+{
+	OutDefinitions.Reset(Indices.Num());
+	for (const int32 DenseIndex : Indices)
+	{
+		if (URockItemDefinition* ItemDef = ResolveDefinition(DenseIndex))
+		{
+			OutDefinitions.Add(ItemDef);
+		}
+	}
+}
+
+const FRockItemCatalogEntry* URockItemRegistrySubsystem::FindCatalogEntry(FName ItemID) const
+{
+	return Catalog.Find(ItemID);
+}
+
 URockItemDefinition* URockItemRegistrySubsystem::FindDefinition(FName ItemID) const
 {
 	if (!bIsInitialized)
@@ -140,10 +325,9 @@ URockItemDefinition* URockItemRegistrySubsystem::FindDefinition(FName ItemID) co
 		UE_LOG(LogRockItemRegistry, Warning, TEXT("Attempted to FindDefinition with None ItemID."));
 		return nullptr;
 	}
-	const TObjectPtr<URockItemDefinition>* FoundDefPtr = ItemDefinitionMap.Find(ItemID);
-	if (FoundDefPtr)
+	if (URockItemDefinition* FoundDef = ResolveDefinition(DefinitionTable.FindIndex(ItemID)))
 	{
-		return *FoundDefPtr; // Dereference the TObjectPtr pointer to get the URockItemDefinition*
+		return FoundDef;
 	}
 
 	UE_LOG(LogRockItemRegistry, Warning, TEXT("Could not find Item Definition with ID '%s'."), *ItemID.ToString());
@@ -158,5 +342,62 @@ void URockItemRegistrySubsystem::GetAllDefinitions(TArray<URockItemDefinition*>&
 		OutDefinitions.Empty();
 		return;
 	}
-	// ItemDefinitionMap.GenerateValueArray(OutDefinitions); // Efficiently get all values from the map
+	OutDefinitions.Reset(DefinitionTable.Num());
+	for (int32 DenseIndex = 0; DenseIndex < DefinitionTable.Num(); ++DenseIndex)
+	{
+		if (URockItemDefinition* ItemDef = ResolveDefinition(DenseIndex))
+		{
+			OutDefinitions.Add(ItemDef);
+		}
+	}
+}
+
+void URockItemRegistrySubsystem::GetDefinitionsWithTag(FGameplayTag Tag, TArray<URockItemDefinition*>& OutDefinitions) const
+{
+	if (!bIsInitialized)
+	{
+		UE_LOG(LogRockItemRegistry, Warning, TEXT("Attempted to GetDefinitionsWithTag before registry was initialized."));
+		OutDefinitions.Empty();
+		return;
+	}
+
+	ResolveDefinitions(DefinitionTable.GetIndicesWithTag(Tag), OutDefinitions);
+}
+
+void URockItemRegistrySubsystem::GetDefinitionsWithAllTags(const FGameplayTagContainer& Tags, TArray<URockItemDefinition*>& OutDefinitions) const
+{
+	if (!bIsInitialized)
+	{
+		UE_LOG(LogRockItemRegistry, Warning, TEXT("Attempted to GetDefinitionsWithAllTags before registry was initialized."));
+		OutDefinitions.Empty();
+		return;
+	}
+
+	TArray<int32> Indices;
+	DefinitionTable.GetIndicesWithAllTags(Tags, Indices);
+	ResolveDefinitions(Indices, OutDefinitions);
+}
+
+void URockItemRegistrySubsystem::GetDefinitionsOfType(FGameplayTag TypeTag, TArray<URockItemDefinition*>& OutDefinitions) const
+{
+	if (!bIsInitialized)
+	{
+		UE_LOG(LogRockItemRegistry, Warning, TEXT("Attempted to GetDefinitionsOfType before registry was initialized."));
+		OutDefinitions.Empty();
+		return;
+	}
+
+	ResolveDefinitions(DefinitionTable.GetIndicesOfType(TypeTag), OutDefinitions);
+}
+
+void URockItemRegistrySubsystem::GetDefinitionsOfRarity(FGameplayTag RarityTag, TArray<URockItemDefinition*>& OutDefinitions) const
+{
+	if (!bIsInitialized)
+	{
+		UE_LOG(LogRockItemRegistry, Warning, TEXT("Attempted to GetDefinitionsOfRarity before registry was initialized."));
+		OutDefinitions.Empty();
+		return;
+	}
+
+	ResolveDefinitions(DefinitionTable.GetIndicesOfRarity(RarityTag), OutDefinitions);
 }
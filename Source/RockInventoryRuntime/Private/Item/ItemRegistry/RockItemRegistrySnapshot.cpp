@@ -0,0 +1,21 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Item/ItemRegistry/RockItemRegistrySnapshot.h"
+
+FRockItemRegistrySnapshot::FRockItemRegistrySnapshot(const FRockItemDefinitionTable& InTable, TArray<FRockItemCatalogEntry>&& InMetadata, uint32 InVersion)
+	: Table(InTable)
+	, Metadata(MoveTemp(InMetadata))
+	, Version(InVersion)
+{
+	check(Metadata.Num() == Table.Num());
+}
+
+const FRockItemCatalogEntry* FRockItemRegistrySnapshot::FindMetadata(FName ItemId) const
+{
+	return GetMetadata(Table.FindIndex(ItemId));
+}
+
+const FRockItemCatalogEntry* FRockItemRegistrySnapshot::GetMetadata(int32 DenseIndex) const
+{
+	return Metadata.IsValidIndex(DenseIndex) ? &Metadata[DenseIndex] : nullptr;
+}
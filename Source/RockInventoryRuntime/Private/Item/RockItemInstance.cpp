@@ -7,6 +7,7 @@
 #include "Item/RockItemDefinition.h"
 #include "Library/RockInventoryLibrary.h"
 #include "Net/UnrealNetwork.h"
+#include "Persistence/RockInventorySaveData.h"
 
 
 void URockItemInstance::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -191,6 +192,87 @@ FRockItemStack URockItemInstance::GetItemStack() const
 	return GetOwningInventory()->GetItemByHandle(ItemHandle);
 }
 
+namespace RockItemInstance
+{
+	// FGameplayTagStackContainer only exposes per-tag lookups, so the stacks are read through reflection
+	void GatherStatStacks(const FGameplayTagStackContainer& Container, TArray<FGameplayTagStack>& OutStacks)
+	{
+		for (TFieldIterator<FArrayProperty> It(FGameplayTagStackContainer::StaticStruct()); It; ++It)
+		{
+			const FStructProperty* Inner = CastField<FStructProperty>(It->Inner);
+			if (Inner && Inner->Struct == FGameplayTagStack::StaticStruct())
+			{
+				FScriptArrayHelper Helper(*It, It->ContainerPtrToValuePtr<void>(&Container));
+				for (int32 i = 0; i < Helper.Num(); ++i)
+				{
+					OutStacks.Add(*reinterpret_cast<const FGameplayTagStack*>(Helper.GetRawPtr(i)));
+				}
+				return;
+			}
+		}
+	}
+}
+
+void URockItemInstance::SerializeSaveData(FArchive& Ar)
+{
+	// Tags go through names and AddTag/SetStack so the containers rebuild their parent tags and lookup maps
+	TArray<FString> TagNames;
+	if (Ar.IsSaving())
+	{
+		for (const FGameplayTag& Tag : Tags)
+		{
+			TagNames.Add(Tag.ToString());
+		}
+	}
+	Ar << TagNames;
+	if (Ar.IsLoading())
+	{
+		Tags.Reset();
+		for (const FString& TagName : TagNames)
+		{
+			Tags.AddTag(FGameplayTag::RequestGameplayTag(FName(*TagName), false));
+		}
+	}
+
+	TArray<FGameplayTagStack> Stacks;
+	if (Ar.IsSaving())
+	{
+		RockItemInstance::GatherStatStacks(StatTags, Stacks);
+	}
+	int32 NumStacks = Stacks.Num();
+	Ar << NumStacks;
+	for (int32 i = 0; i < NumStacks && !Ar.IsError(); ++i)
+	{
+		FString TagName = Ar.IsSaving() ? Stacks[i].GetTag().ToString() : FString();
+		int32 Count = Ar.IsSaving() ? Stacks[i].GetStackCount() : 0;
+		Ar << TagName << Count;
+		if (Ar.IsLoading())
+		{
+			const FGameplayTag Tag = FGameplayTag::RequestGameplayTag(FName(*TagName), false);
+			if (Tag.IsValid())
+			{
+				StatTags.SetStack(Tag, Count, true);
+			}
+		}
+	}
+
+	// Nested inventories are stored inline. On load SetDefinition has already created (and Init'd) it from the config.
+	TArray<uint8> NestedBytes;
+	if (Ar.IsSaving() && NestedInventory)
+	{
+		FRockInventorySaveData::SaveInventory(NestedInventory, NestedBytes);
+	}
+	Ar << NestedBytes;
+	if (Ar.IsLoading() && NestedBytes.Num() > 0)
+	{
+		if (!NestedInventory)
+		{
+			NestedInventory = NewObject<URockInventory>(this);
+		}
+		FRockInventorySaveData::LoadInventory(NestedInventory, NestedBytes);
+	}
+}
+
 
 #if UE_WITH_IRIS
 void URockItemInstance::RegisterReplicationFragments(
@@ -151,6 +151,17 @@ bool FRockItemStack::operator!=(const FRockItemStack& Other) const
 	return !(*this == Other);
 }
 
+uint32 FRockItemStack::GetFingerprint() const
+{
+	uint32 Hash = GetTypeHash(ItemHandle);
+	Hash = HashCombineFast(Hash, PointerHash(Definition.Get()));
+	Hash = HashCombineFast(Hash, PointerHash(RuntimeInstance.Get()));
+	Hash = HashCombineFast(Hash, GetTypeHash(StackCount));
+	Hash = HashCombineFast(Hash, GetTypeHash(CustomValue1));
+	Hash = HashCombineFast(Hash, GetTypeHash(CustomValue2));
+	return HashCombineFast(Hash, GetTypeHash(Generation));
+}
+
 bool FRockItemStack::IsEmpty() const
 {
 	return StackCount <= 0;
@@ -256,4 +267,5 @@ void FRockInventoryItemContainer::PostReplicatedChange(const TArrayView<int32> C
 		// Sync the tracker for the next update
 		PreviousItemHandles[Index] = CurrentItem.ItemHandle;
 	}
+	OwnerInventory->NotifyDataReplicated(ChangedIndices, {});
 }
@@ -3,13 +3,16 @@
 #include "Library/RockInventoryLibrary.h"
 
 #include "RockInventoryLogging.h"
+#include "Algo/StableSort.h"
 #include "Components/RockInventoryComponent.h"
 #include "Inventory/RockInventory.h"
+#include "Inventory/RockInventoryDeferredEffects.h"
 #include "Inventory/RockInventoryInterface.h"
 #include "Inventory/RockInventorySectionInfo.h"
 #include "Item/RockItemDefinition.h"
 #include "Item/RockItemInstance.h"
 #include "Library/RockItemStackLibrary.h"
+#include "Misc/RockInventoryTags.h"
 
 
 bool URockInventoryLibrary::LootItemToInventory(
@@ -369,6 +372,529 @@ bool URockInventoryLibrary::MoveItem(
 	return true;
 }
 
+bool URockInventoryLibrary::TransferAllItems(
+	URockInventory* SourceInventory, URockInventory* TargetInventory, AController* Instigator,
+	int32& OutMovedCount, TArray<FRockInventorySlotHandle>& OutLeftoverSlots)
+{
+	OutMovedCount = 0;
+	OutLeftoverSlots.Reset();
+	if (!SourceInventory || !TargetInventory || SourceInventory == TargetInventory)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("TransferAllItems: Invalid Source or Target Inventory"));
+		return false;
+	}
+
+	struct FTransferEntry
+	{
+		FRockInventorySlotHandle SourceSlotHandle;
+		// Copy of the source item, StackCount is what's left to move
+		FRockItemStack Item;
+		int32 OriginalCount = 0;
+	};
+
+	TArray<FTransferEntry> Entries;
+	for (const FRockInventorySlotEntry& Slot : SourceInventory->SlotData)
+	{
+		const FRockItemStack* SourceItem = SourceInventory->GetItemByHandlePtr(Slot.ItemHandle);
+		if (!SourceItem || !SourceItem->IsValid())
+		{
+			continue;
+		}
+		if (SourceInventory->GetPendingSlotState(Slot.SlotHandle).IsClaimedByOther(Instigator))
+		{
+			OutLeftoverSlots.Add(Slot.SlotHandle);
+			continue;
+		}
+		Entries.Add({Slot.SlotHandle, *SourceItem, SourceItem->GetStackCount()});
+	}
+	if (Entries.IsEmpty())
+	{
+		return false;
+	}
+
+	// Every touched entry is dirtied and broadcast once when the transfer is done, instead of once per merge and placement.
+	// Inside a transaction that already defers (off the game thread) the effects simply join that batch.
+	FRockInventoryDeferredEffects BatchedEffects;
+	TOptional<FRockInventoryDeferredEffectsScope> BatchScope;
+	if (!SourceInventory->IsDeferringEffects() && !TargetInventory->IsDeferringEffects())
+	{
+		BatchScope.Emplace(BatchedEffects, TArray<URockInventory*, TInlineAllocator<2>>{SourceInventory, TargetInventory});
+	}
+
+	// Partial stacks of the target by item id, so merging doesn't rescan the whole target for every item.
+	// Stacks placed below are added as well, which consolidates the source's own partial stacks.
+	TMap<FName, TArray<FRockInventorySlotHandle, TInlineAllocator<4>>> PartialStacks;
+	for (const FRockInventorySlotEntry& Slot : TargetInventory->SlotData)
+	{
+		const FRockItemStack* TargetItem = TargetInventory->GetItemByHandlePtr(Slot.ItemHandle);
+		if (TargetItem && TargetItem->IsValid() && TargetItem->GetStackCount() < TargetItem->GetMaxStackCount()
+			&& !TargetInventory->GetPendingSlotState(Slot.SlotHandle).IsClaimedByOther(Instigator))
+		{
+			PartialStacks.FindOrAdd(TargetItem->GetItemId()).Add(Slot.SlotHandle);
+		}
+	}
+
+	auto MergeIntoPartialStacks = [&](FTransferEntry& Entry)
+	{
+		TArray<FRockInventorySlotHandle, TInlineAllocator<4>>* Candidates = PartialStacks.Find(Entry.Item.GetItemId());
+		if (!Candidates)
+		{
+			return;
+		}
+		for (int32 Index = 0; Index < Candidates->Num() && Entry.Item.GetStackCount() > 0;)
+		{
+			const FRockInventorySlotHandle CandidateHandle = (*Candidates)[Index];
+			if (!CanMergeItemAtGridPosition(TargetInventory, CandidateHandle, Entry.Item, ERockItemStackMergeCondition::Partial))
+			{
+				// Same item but not stackable with this one (custom values), or already full
+				++Index;
+				continue;
+			}
+			Entry.Item.StackCount = MergeItemAtGridPosition(TargetInventory, CandidateHandle, Entry.Item);
+			const FRockItemStack& MergedItem = TargetInventory->GetItemBySlotHandle(CandidateHandle);
+			if (MergedItem.GetStackCount() >= MergedItem.GetMaxStackCount())
+			{
+				Candidates->RemoveAt(Index, EAllowShrinking::No);
+				continue;
+			}
+			++Index;
+		}
+	};
+
+	// Merge everything first, so a stack only takes up new space for what couldn't be merged
+	for (FTransferEntry& Entry : Entries)
+	{
+		MergeIntoPartialStacks(Entry);
+	}
+
+	// One occupancy grid for the whole transfer, updated as items are placed
+	TArray<bool> OccupancyGrid;
+	PrecomputeOccupancyGrids(TargetInventory, OccupancyGrid);
+	// Item sizes known not to fit per section, so a full target isn't rescanned for every remaining item
+	TArray<TArray<FIntPoint, TInlineAllocator<4>>> NoFitSizes;
+	NoFitSizes.SetNum(TargetInventory->SlotSections.Num());
+
+	for (FTransferEntry& Entry : Entries)
+	{
+		if (Entry.Item.GetStackCount() > 0)
+		{
+			// A stack placed earlier in this transfer might have room now
+			MergeIntoPartialStacks(Entry);
+		}
+		if (Entry.Item.GetStackCount() <= 0)
+		{
+			// Fully merged
+			SourceInventory->RemoveItemFromInventory(Entry.Item.ItemHandle);
+			FRockInventorySlotEntry SourceSlot = SourceInventory->GetSlotByHandle(Entry.SourceSlotHandle);
+			SourceSlot.ItemHandle = FRockItemStackHandle::Invalid();
+			SourceSlot.Orientation = ERockItemOrientation::Horizontal;
+			SourceInventory->SetSlotByHandle(Entry.SourceSlotHandle, SourceSlot);
+			OutMovedCount += Entry.OriginalCount;
+			continue;
+		}
+
+		const FIntPoint ItemSize = URockItemStackLibrary::GetItemSize(Entry.Item);
+		FRockInventorySlotHandle TargetSlotHandle;
+		for (int32 SectionIndex = 0; SectionIndex < TargetInventory->SlotSections.Num() && !TargetSlotHandle.IsValid(); ++SectionIndex)
+		{
+			const FRockInventorySectionInfo& SectionInfo = TargetInventory->SlotSections[SectionIndex];
+			if (NoFitSizes[SectionIndex].Contains(ItemSize) || !CanItemBePlacedInSection(Entry.Item, SectionInfo))
+			{
+				continue;
+			}
+			for (int32 LocalIndex = 0; LocalIndex < SectionInfo.GetNumSlots(); ++LocalIndex)
+			{
+				const int32 AbsoluteIndex = SectionInfo.GetFirstSlotIndex() + LocalIndex;
+				if (OccupancyGrid[AbsoluteIndex])
+				{
+					continue;
+				}
+				const FRockInventorySlotHandle SlotHandle(AbsoluteIndex);
+				if (TargetInventory->GetPendingSlotState(SlotHandle).IsClaimedByOther(Instigator))
+				{
+					continue;
+				}
+				const int32 Column = LocalIndex % SectionInfo.GetColumns();
+				const int32 Row = LocalIndex / SectionInfo.GetColumns();
+				if (CanItemFitInGridPosition(OccupancyGrid, SectionInfo, Column, Row, FVector2D(ItemSize)))
+				{
+					TargetSlotHandle = SlotHandle;
+					if (SectionInfo.GetSlotSizePolicy() == ERockItemSizePolicy::IgnoreSize)
+					{
+						OccupancyGrid[AbsoluteIndex] = true;
+						break;
+					}
+					for (int32 Y = 0; Y < ItemSize.Y; ++Y)
+					{
+						for (int32 X = 0; X < ItemSize.X; ++X)
+						{
+							OccupancyGrid[SectionInfo.GetFirstSlotIndex() + (Row + Y) * SectionInfo.GetColumns() + Column + X] = true;
+						}
+					}
+					break;
+				}
+			}
+			if (!TargetSlotHandle.IsValid())
+			{
+				NoFitSizes[SectionIndex].Add(ItemSize);
+			}
+		}
+
+		if (!TargetSlotHandle.IsValid())
+		{
+			if (Entry.Item.GetStackCount() != Entry.OriginalCount)
+			{
+				// Partially merged, keep the rest in the source
+				SourceInventory->SetItemByHandle(Entry.Item.ItemHandle, Entry.Item);
+				OutMovedCount += Entry.OriginalCount - Entry.Item.GetStackCount();
+			}
+			OutLeftoverSlots.Add(Entry.SourceSlotHandle);
+			continue;
+		}
+
+		// Release from the source before adding, so a runtime instance ends up registered with the target only
+		SourceInventory->RemoveItemFromInventory(Entry.Item.ItemHandle);
+		FRockInventorySlotEntry SourceSlot = SourceInventory->GetSlotByHandle(Entry.SourceSlotHandle);
+		SourceSlot.ItemHandle = FRockItemStackHandle::Invalid();
+		SourceSlot.Orientation = ERockItemOrientation::Horizontal;
+		SourceInventory->SetSlotByHandle(Entry.SourceSlotHandle, SourceSlot);
+
+		FRockInventorySlotEntry TargetSlot = TargetInventory->GetSlotByHandle(TargetSlotHandle);
+		TargetSlot.ItemHandle = TargetInventory->AddItemToInventory(Entry.Item);
+		TargetSlot.Orientation = ERockItemOrientation::Horizontal;
+		TargetInventory->SetSlotByHandle(TargetSlotHandle, TargetSlot);
+		OutMovedCount += Entry.OriginalCount;
+
+		if (Entry.Item.GetStackCount() < Entry.Item.GetMaxStackCount())
+		{
+			PartialStacks.FindOrAdd(Entry.Item.GetItemId()).Add(TargetSlotHandle);
+		}
+	}
+
+	if (BatchScope.IsSet())
+	{
+		BatchScope.Reset();
+		BatchedEffects.Coalesce();
+		BatchedEffects.Apply();
+	}
+	return OutMovedCount > 0;
+}
+
+bool URockInventoryLibrary::SortInventory(URockInventory* Inventory, const FRockInventorySortParams& Params, AController* Instigator)
+{
+	if (!Inventory)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("SortInventory: Invalid Inventory"));
+		return false;
+	}
+
+	TArray<int32, TInlineAllocator<4>> SortedSections;
+	for (int32 SectionIndex = 0; SectionIndex < Inventory->SlotSections.Num(); ++SectionIndex)
+	{
+		const FRockInventorySectionInfo& SectionInfo = Inventory->SlotSections[SectionIndex];
+		const bool bSelected = Params.SectionTag.IsValid()
+			? SectionInfo.GetSectionTag() == Params.SectionTag
+			: SectionInfo.GetSlotSizePolicy() == ERockItemSizePolicy::RespectSize;
+		if (bSelected)
+		{
+			SortedSections.Add(SectionIndex);
+		}
+	}
+	if (SortedSections.IsEmpty())
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("SortInventory: No sections to sort"));
+		return false;
+	}
+
+	const TArray<FGameplayTag> DefaultRarityOrder = {
+		RockInventoryTags::Item_Rarity_Common,
+		RockInventoryTags::Item_Rarity_Uncommon,
+		RockInventoryTags::Item_Rarity_Rare,
+		RockInventoryTags::Item_Rarity_Epic,
+		RockInventoryTags::Item_Rarity_Legendary,
+	};
+	const TArray<FGameplayTag>& RarityOrder = Params.RarityOrder.IsEmpty() ? DefaultRarityOrder : Params.RarityOrder;
+
+	struct FSortEntry
+	{
+		// Copy of the item, StackCount is the count after consolidation
+		FRockItemStack Item;
+		int32 OriginalCount = 0;
+		int32 OriginalSlotIndex = INDEX_NONE;
+		FIntPoint Size = FIntPoint(1, 1);
+		int32 RarityRank = INDEX_NONE;
+		FRockInventorySlotHandle NewSlotHandle;
+	};
+
+	TArray<FSortEntry> Entries;
+	for (const int32 SectionIndex : SortedSections)
+	{
+		const FRockInventorySectionInfo& SectionInfo = Inventory->SlotSections[SectionIndex];
+		for (int32 LocalIndex = 0; LocalIndex < SectionInfo.GetNumSlots(); ++LocalIndex)
+		{
+			const FRockInventorySlotEntry& Slot = Inventory->SlotData[SectionInfo.GetFirstSlotIndex() + LocalIndex];
+			if (Inventory->GetPendingSlotState(Slot.SlotHandle).IsClaimedByOther(Instigator))
+			{
+				// Rearranging underneath someone else's pending operation would break it
+				UE_LOG(LogRockInventory, Warning, TEXT("SortInventory: Slot %s is claimed by another controller"), *Slot.SlotHandle.ToString());
+				return false;
+			}
+			const FRockItemStack* Item = Inventory->GetItemByHandlePtr(Slot.ItemHandle);
+			if (!Item || !Item->IsValid())
+			{
+				continue;
+			}
+			FSortEntry& Entry = Entries.AddDefaulted_GetRef();
+			Entry.Item = *Item;
+			Entry.OriginalCount = Item->GetStackCount();
+			Entry.OriginalSlotIndex = Slot.SlotHandle.GetAbsoluteIndex();
+			Entry.Size = URockItemStackLibrary::GetItemSize(*Item);
+			Entry.RarityRank = RarityOrder.IndexOfByKey(Item->GetDefinition()->ItemRarity);
+		}
+	}
+
+	if (Params.bConsolidateStacks)
+	{
+		// Stackable entries grouped in slot order. The first stacks of a group are filled up and the rest emptied
+		TMap<FName, TArray<TArray<int32, TInlineAllocator<4>>, TInlineAllocator<1>>> Groups;
+		for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+		{
+			const FRockItemStack& Item = Entries[EntryIndex].Item;
+			if (Item.GetMaxStackCount() <= 1 || Item.GetRuntimeInstance())
+			{
+				continue;
+			}
+			auto& ItemGroups = Groups.FindOrAdd(Item.GetItemId());
+			auto* Group = ItemGroups.FindByPredicate([&](const TArray<int32, TInlineAllocator<4>>& Candidate)
+			{
+				return Entries[Candidate[0]].Item.CanStackWith(Item);
+			});
+			if (Group)
+			{
+				Group->Add(EntryIndex);
+			}
+			else
+			{
+				ItemGroups.AddDefaulted_GetRef().Add(EntryIndex);
+			}
+		}
+		for (const auto& Pair : Groups)
+		{
+			for (const TArray<int32, TInlineAllocator<4>>& Group : Pair.Value)
+			{
+				int32 Remaining = 0;
+				for (const int32 EntryIndex : Group)
+				{
+					Remaining += Entries[EntryIndex].Item.GetStackCount();
+				}
+				const int32 MaxStackCount = Entries[Group[0]].Item.GetMaxStackCount();
+				for (const int32 EntryIndex : Group)
+				{
+					Entries[EntryIndex].Item.StackCount = FMath::Min(Remaining, MaxStackCount);
+					Remaining -= Entries[EntryIndex].Item.StackCount;
+				}
+			}
+		}
+	}
+
+	// Negative when A goes first
+	auto CompareByKey = [](ERockInventorySortKey Key, const FSortEntry& A, const FSortEntry& B) -> int32
+	{
+		switch (Key)
+		{
+		case ERockInventorySortKey::ItemType:
+			{
+				const FGameplayTag TypeA = A.Item.GetDefinition()->ItemType.First();
+				const FGameplayTag TypeB = B.Item.GetDefinition()->ItemType.First();
+				if (!TypeA.IsValid() || !TypeB.IsValid())
+				{
+					// Untyped items last
+					return TypeB.IsValid() - TypeA.IsValid();
+				}
+				return TypeA.GetTagName().Compare(TypeB.GetTagName());
+			}
+		case ERockInventorySortKey::Rarity:
+			return B.RarityRank - A.RarityRank;
+		case ERockInventorySortKey::Size:
+			if (A.Size.X * A.Size.Y != B.Size.X * B.Size.Y)
+			{
+				return B.Size.X * B.Size.Y - A.Size.X * A.Size.Y;
+			}
+			return B.Size.Y - A.Size.Y;
+		case ERockInventorySortKey::Value:
+			{
+				const int32 ValueA = A.Item.GetDefinition()->ItemValue;
+				const int32 ValueB = B.Item.GetDefinition()->ItemValue;
+				return ValueA == ValueB ? 0 : (ValueA > ValueB ? -1 : 1);
+			}
+		case ERockInventorySortKey::ItemId:
+			return A.Item.GetItemId().Compare(B.Item.GetItemId());
+		default:
+			return 0;
+		}
+	};
+
+	TArray<int32> Order;
+	Order.Reserve(Entries.Num());
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		if (Entries[EntryIndex].Item.GetStackCount() > 0)
+		{
+			Order.Add(EntryIndex);
+		}
+	}
+	Order.Sort([&](int32 IndexA, int32 IndexB)
+	{
+		const FSortEntry& A = Entries[IndexA];
+		const FSortEntry& B = Entries[IndexB];
+		for (const ERockInventorySortKey Key : Params.SortKeys)
+		{
+			if (const int32 Result = CompareByKey(Key, A, B))
+			{
+				return Result < 0;
+			}
+		}
+		// Deterministic tie breaks, the original slot is unique
+		if (const int32 Result = A.Item.GetItemId().Compare(B.Item.GetItemId()))
+		{
+			return Result < 0;
+		}
+		if (A.Item.GetStackCount() != B.Item.GetStackCount())
+		{
+			return A.Item.GetStackCount() > B.Item.GetStackCount();
+		}
+		if (A.Item.CustomValue1 != B.Item.CustomValue1)
+		{
+			return A.Item.CustomValue1 < B.Item.CustomValue1;
+		}
+		if (A.Item.CustomValue2 != B.Item.CustomValue2)
+		{
+			return A.Item.CustomValue2 < B.Item.CustomValue2;
+		}
+		return A.OriginalSlotIndex < B.OriginalSlotIndex;
+	});
+
+	// Sorted sections start out empty, anything else keeps its cells
+	TArray<bool> InitialGrid;
+	PrecomputeOccupancyGrids(Inventory, InitialGrid);
+	for (const int32 SectionIndex : SortedSections)
+	{
+		const FRockInventorySectionInfo& SectionInfo = Inventory->SlotSections[SectionIndex];
+		for (int32 LocalIndex = 0; LocalIndex < SectionInfo.GetNumSlots(); ++LocalIndex)
+		{
+			InitialGrid[SectionInfo.GetFirstSlotIndex() + LocalIndex] = false;
+		}
+	}
+
+	// First fit, row by row. Returns false as soon as an item doesn't fit
+	auto TryPack = [&](TConstArrayView<int32> PackOrder) -> bool
+	{
+		TArray<bool> OccupancyGrid = InitialGrid;
+		// Everything before a section's cursor is occupied, so scans start there
+		TArray<int32, TInlineAllocator<4>> FirstFreeIndex;
+		FirstFreeIndex.SetNumZeroed(SortedSections.Num());
+
+		for (const int32 EntryIndex : PackOrder)
+		{
+			FSortEntry& Entry = Entries[EntryIndex];
+			Entry.NewSlotHandle = FRockInventorySlotHandle();
+			for (int32 SortedIndex = 0; SortedIndex < SortedSections.Num() && !Entry.NewSlotHandle.IsValid(); ++SortedIndex)
+			{
+				const FRockInventorySectionInfo& SectionInfo = Inventory->SlotSections[SortedSections[SortedIndex]];
+				if (!CanItemBePlacedInSection(Entry.Item, SectionInfo))
+				{
+					continue;
+				}
+				const int32 FirstSlotIndex = SectionInfo.GetFirstSlotIndex();
+				int32& Cursor = FirstFreeIndex[SortedIndex];
+				while (Cursor < SectionInfo.GetNumSlots() && OccupancyGrid[FirstSlotIndex + Cursor])
+				{
+					++Cursor;
+				}
+				for (int32 LocalIndex = Cursor; LocalIndex < SectionInfo.GetNumSlots(); ++LocalIndex)
+				{
+					if (OccupancyGrid[FirstSlotIndex + LocalIndex])
+					{
+						continue;
+					}
+					const int32 Column = LocalIndex % SectionInfo.GetColumns();
+					const int32 Row = LocalIndex / SectionInfo.GetColumns();
+					if (!CanItemFitInGridPosition(OccupancyGrid, SectionInfo, Column, Row, FVector2D(Entry.Size)))
+					{
+						continue;
+					}
+					const bool bIgnoreSize = SectionInfo.GetSlotSizePolicy() == ERockItemSizePolicy::IgnoreSize;
+					for (int32 Y = 0; Y < (bIgnoreSize ? 1 : Entry.Size.Y); ++Y)
+					{
+						for (int32 X = 0; X < (bIgnoreSize ? 1 : Entry.Size.X); ++X)
+						{
+							OccupancyGrid[FirstSlotIndex + (Row + Y) * SectionInfo.GetColumns() + Column + X] = true;
+						}
+					}
+					Entry.NewSlotHandle = FRockInventorySlotHandle(FirstSlotIndex + LocalIndex);
+					break;
+				}
+			}
+			if (!Entry.NewSlotHandle.IsValid())
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	if (!TryPack(Order))
+	{
+		// The requested order fragments too much, fall back to largest first (keeping the order within a size)
+		TArray<int32> BySize = Order;
+		Algo::StableSort(BySize, [&](int32 IndexA, int32 IndexB)
+		{
+			return Entries[IndexA].Size.X * Entries[IndexA].Size.Y > Entries[IndexB].Size.X * Entries[IndexB].Size.Y;
+		});
+		if (!TryPack(BySize))
+		{
+			UE_LOG(LogRockInventory, Warning, TEXT("SortInventory: Items don't fit a sorted layout, leaving the inventory as is"));
+			return false;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	/// Apply. Everything below was validated above
+	TArray<FRockItemStackHandle> NewSlotItems;
+	NewSlotItems.Init(FRockItemStackHandle::Invalid(), Inventory->SlotData.Num());
+	for (const FSortEntry& Entry : Entries)
+	{
+		if (Entry.Item.GetStackCount() <= 0)
+		{
+			// Consolidated into another stack
+			Inventory->RemoveItemFromInventory(Entry.Item.ItemHandle);
+			continue;
+		}
+		if (Entry.Item.GetStackCount() != Entry.OriginalCount)
+		{
+			Inventory->SetItemByHandle(Entry.Item.ItemHandle, Entry.Item);
+		}
+		NewSlotItems[Entry.NewSlotHandle.GetAbsoluteIndex()] = Entry.Item.ItemHandle;
+	}
+	for (const int32 SectionIndex : SortedSections)
+	{
+		const FRockInventorySectionInfo& SectionInfo = Inventory->SlotSections[SectionIndex];
+		for (int32 LocalIndex = 0; LocalIndex < SectionInfo.GetNumSlots(); ++LocalIndex)
+		{
+			const int32 AbsoluteIndex = SectionInfo.GetFirstSlotIndex() + LocalIndex;
+			FRockInventorySlotEntry Slot = Inventory->SlotData[AbsoluteIndex];
+			if (Slot.ItemHandle == NewSlotItems[AbsoluteIndex] && Slot.Orientation == ERockItemOrientation::Horizontal)
+			{
+				continue;
+			}
+			Slot.ItemHandle = NewSlotItems[AbsoluteIndex];
+			Slot.Orientation = ERockItemOrientation::Horizontal;
+			Inventory->SetSlotByHandle(Slot.SlotHandle, Slot);
+		}
+	}
+	return true;
+}
+
 bool URockInventoryLibrary::CanMergeItemAtGridPosition(
 	const URockInventory* Inventory, FRockInventorySlotHandle SlotHandle, const FRockItemStack& ItemStack,
 	ERockItemStackMergeCondition MergeCondition)
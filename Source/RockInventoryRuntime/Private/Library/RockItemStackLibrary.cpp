@@ -9,6 +9,20 @@
 
 URockItemDefinition* URockItemStackLibrary::GetItemDefinitionById(const FName& ItemId)
 {
+	// The snapshot is a lock-free read and doesn't need a world context
+	if (const FRockItemRegistrySnapshot* Snapshot = URockItemRegistrySubsystem::GetSnapshot())
+	{
+		if (URockItemDefinition* ItemDef = Snapshot->FindDefinition(ItemId))
+		{
+			return ItemDef;
+		}
+	}
+	// Workers only get what the snapshot has, loading on demand is game thread only
+	if (!IsInGameThread())
+	{
+		return nullptr;
+	}
+	// Still streaming from the catalog (or not built yet), let the registry load it on demand
 	if (const URockItemRegistrySubsystem* ItemRegistry = URockItemRegistrySubsystem::GetInstance())
 	{
 		return ItemRegistry->FindDefinition(ItemId);
@@ -0,0 +1,210 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Library/RockLootScoring.h"
+
+#include "Async/ParallelFor.h"
+#include "GameFramework/Actor.h"
+#include "Inventory/RockInventory.h"
+#include "Inventory/RockInventorySnapshot.h"
+#include "Item/RockItemDefinition.h"
+#include "World/RockLootableInterface.h"
+
+FRockLootSource FRockLootSource::FromInventory(URockInventory* Inventory, const FVector& Location)
+{
+	check(IsInGameThread());
+	FRockLootSource Source;
+	Source.Location = Location;
+	if (Inventory)
+	{
+		Source.Inventory = Inventory;
+		Source.Snapshot = Inventory->GetSnapshot();
+	}
+	return Source;
+}
+
+FRockLootSource FRockLootSource::FromWorldItem(AActor* WorldItem)
+{
+	check(IsInGameThread());
+	FRockLootSource Source;
+	if (const IRockLootableInterface* Lootable = Cast<IRockLootableInterface>(WorldItem))
+	{
+		Source.WorldItem = WorldItem;
+		Source.WorldItemStack = Lootable->GetItemStack(nullptr);
+		Source.Location = WorldItem->GetActorLocation();
+	}
+	return Source;
+}
+
+namespace RockLootScoring
+{
+	namespace Internal
+	{
+		struct FScoredCandidate
+		{
+			FRockLootCandidate Candidate;
+			/** Visit order, breaks ties so results don't depend on the heap layout */
+			int32 Order = 0;
+		};
+
+		/** True if A ranks below B */
+		bool IsWorse(const FScoredCandidate& A, const FScoredCandidate& B)
+		{
+			return A.Candidate.Score < B.Candidate.Score || (A.Candidate.Score == B.Candidate.Score && A.Order > B.Order);
+		}
+
+		/** Keeps the best MaxResults candidates in a min heap, the worst kept on top */
+		struct FTopK
+		{
+			explicit FTopK(int32 InMaxResults) : MaxResults(InMaxResults)
+			{
+				Heap.Reserve(MaxResults);
+			}
+
+			void Add(const FRockLootCandidate& Candidate)
+			{
+				const FScoredCandidate Scored{Candidate, NextOrder++};
+				if (Heap.Num() < MaxResults)
+				{
+					Heap.HeapPush(Scored, IsWorse);
+					return;
+				}
+				if (!IsWorse(Heap.HeapTop(), Scored))
+				{
+					return;
+				}
+				Heap.HeapPopDiscard(IsWorse, EAllowShrinking::No);
+				Heap.HeapPush(Scored, IsWorse);
+			}
+
+			void Finish(TArray<FRockLootCandidate>& OutCandidates)
+			{
+				Heap.Sort([](const FScoredCandidate& A, const FScoredCandidate& B) { return IsWorse(B, A); });
+				OutCandidates.Reset(Heap.Num());
+				for (const FScoredCandidate& Scored : Heap)
+				{
+					OutCandidates.Add(Scored.Candidate);
+				}
+			}
+
+			TArray<FScoredCandidate> Heap;
+			int32 MaxResults = 0;
+			int32 NextOrder = 0;
+		};
+
+		void ScoreRequest(TConstArrayView<FRockLootSource> Sources, const FRockLootScoringRequest& Request, TArray<FRockLootCandidate>& OutCandidates)
+		{
+			OutCandidates.Reset();
+			if (!Request.ScoreFunction || Request.MaxResults <= 0)
+			{
+				return;
+			}
+			const FRockInventoryQuery& Filter = Request.Filter;
+			const double MaxDistanceSquared = FMath::Square(static_cast<double>(Request.MaxDistance));
+			FTopK Best(Request.MaxResults);
+
+			for (int32 SourceIndex = 0; SourceIndex < Sources.Num(); ++SourceIndex)
+			{
+				const FRockLootSource& Source = Sources[SourceIndex];
+				if (Request.MaxDistance > 0.0f && FVector::DistSquared(Request.Location, Source.Location) > MaxDistanceSquared)
+				{
+					continue;
+				}
+
+				auto Consider = [&](const FRockItemStack& Item, const FRockInventorySlotHandle& SlotHandle)
+				{
+					if (Filter.ItemPredicate && !Filter.ItemPredicate(&Item))
+					{
+						return;
+					}
+					const float Score = Request.ScoreFunction(Item, Source);
+					if (Score <= 0.0f)
+					{
+						return;
+					}
+					FRockLootCandidate Candidate;
+					Candidate.SourceIndex = SourceIndex;
+					Candidate.SlotHandle = SlotHandle;
+					Candidate.ItemHandle = Item.ItemHandle;
+					Candidate.Score = Score;
+					Best.Add(Candidate);
+				};
+
+				if (Source.Snapshot)
+				{
+					const FRockInventorySnapshot& Snapshot = *Source.Snapshot;
+					for (int32 SectionIndex = 0; SectionIndex < Snapshot.GetNumSections(); ++SectionIndex)
+					{
+						if (Filter.SectionPredicate && !Filter.SectionPredicate(&Snapshot.GetSectionInfo(SectionIndex)))
+						{
+							continue;
+						}
+						for (const FRockInventorySlotEntry& Slot : Snapshot.GetSectionSlots(SectionIndex))
+						{
+							if (Filter.SlotPredicate && !Filter.SlotPredicate(&Slot))
+							{
+								continue;
+							}
+							if (const FRockItemStack* Item = Snapshot.GetItem(Slot.ItemHandle))
+							{
+								Consider(*Item, Slot.SlotHandle);
+							}
+						}
+					}
+				}
+				else if (Source.WorldItemStack.IsValid())
+				{
+					Consider(Source.WorldItemStack, FRockInventorySlotHandle());
+				}
+			}
+			Best.Finish(OutCandidates);
+		}
+	}
+
+	void ScoreLoot(TConstArrayView<FRockLootSource> Sources, TConstArrayView<FRockLootScoringRequest> Requests, TArray<TArray<FRockLootCandidate>>& OutResults)
+	{
+		OutResults.Reset();
+		OutResults.SetNum(Requests.Num());
+		// One task per requester. Each reads every source, which are immutable from here on
+		ParallelFor(Requests.Num(), [Sources, Requests, &OutResults](int32 RequestIndex)
+		{
+			Internal::ScoreRequest(Sources, Requests[RequestIndex], OutResults[RequestIndex]);
+		});
+	}
+
+	FRockLootScoreFunction ValuePerWeight()
+	{
+		return [](const FRockItemStack& Item, const FRockLootSource&)
+		{
+			const URockItemDefinition* Definition = Item.GetDefinition();
+			if (!Definition || Definition->ItemValue <= 0)
+			{
+				return 0.0f;
+			}
+			// Weight is in milligrams. Weightless items count as 1 mg rather than infinitely valuable
+			const double WeightKg = FMath::Max<int64>(Definition->Weight, 1) / 1000000.0;
+			return static_cast<float>(Definition->ItemValue / WeightKg);
+		};
+	}
+
+	FRockLootScoreFunction TagNeed(TMap<FGameplayTag, float> TagWeights, bool bPerUnit)
+	{
+		return [TagWeights = MoveTemp(TagWeights), bPerUnit](const FRockItemStack& Item, const FRockLootSource&)
+		{
+			const URockItemDefinition* Definition = Item.GetDefinition();
+			if (!Definition)
+			{
+				return 0.0f;
+			}
+			const FGameplayTagContainer& ItemTags = Definition->GetAllTags();
+			float Score = 0.0f;
+			for (const TPair<FGameplayTag, float>& TagWeight : TagWeights)
+			{
+				if (ItemTags.HasTag(TagWeight.Key))
+				{
+					Score += TagWeight.Value;
+				}
+			}
+			return bPerUnit ? Score * Item.GetStackCount() : Score;
+		};
+	}
+}
@@ -8,6 +8,13 @@
 
 URockInventoryDeveloperSettings::URockInventoryDeveloperSettings(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
+	// A drag registers and releases a slot around every move
+	TransactionRateLimitOverrides.Add(ERockRateLimitedRequest::SlotStatus, FRockTokenBucketConfig(60.0f, 120.0f));
+	// Batches pay per transaction, so allow at least one full batch
+	TransactionRateLimitOverrides.Add(ERockRateLimitedRequest::TransactionBatch, FRockTokenBucketConfig(64.0f, 128.0f));
+	TransactionRateLimitOverrides.Add(ERockRateLimitedRequest::TransferAllItems, FRockTokenBucketConfig(2.0f, 5.0f));
+	TransactionRateLimitOverrides.Add(ERockRateLimitedRequest::SortInventory, FRockTokenBucketConfig(1.0f, 3.0f));
+	TransactionRateLimitOverrides.Add(ERockRateLimitedRequest::Resync, FRockTokenBucketConfig(2.0f, 8.0f));
 }
 
 void URockInventoryDeveloperSettings::PostInitProperties()
@@ -0,0 +1,433 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Persistence/RockInventoryJournal.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "RockInventoryLogging.h"
+#include "Inventory/RockInventory.h"
+#include "Item/RockItemInstance.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace RockInventoryJournal
+{
+	enum ESlotFlags : uint8
+	{
+		Slot_Locked = 1 << 0,
+	};
+
+	// [payload size][crc]
+	constexpr int32 FrameHeaderSize = sizeof(uint32) * 2;
+	// Anything larger is treated as a corrupt size field rather than trusted for an allocation
+	constexpr uint32 MaxPayloadSize = 64 * 1024 * 1024;
+
+	void SerializeIndex(FArchive& Ar, int32& Index)
+	{
+		uint32 Packed = static_cast<uint32>(FMath::Max(Index, 0));
+		Ar.SerializeIntPacked(Packed);
+		Index = static_cast<int32>(Packed);
+	}
+}
+
+FRockInventoryJournalRecord FRockInventoryJournalRecord::Capture(URockInventory* Inventory)
+{
+	check(IsInGameThread());
+	FRockInventoryJournalRecord Record;
+	if (!Inventory)
+	{
+		return Record;
+	}
+
+	Record.InventoryId = Inventory->PersistentId;
+	TArray<int32> SlotIndices;
+	Inventory->ConsumeChangedIndices(Record.ItemIndices, SlotIndices);
+
+	Record.Items.Reserve(Record.ItemIndices.Num());
+	for (const int32 ItemIndex : Record.ItemIndices)
+	{
+		Record.Items.Add(FRockInventorySaveData::CaptureItem(Inventory->ItemData[ItemIndex]));
+	}
+	Record.Slots.Reserve(SlotIndices.Num());
+	for (const int32 SlotIndex : SlotIndices)
+	{
+		Record.Slots.Add(Inventory->SlotData[SlotIndex]);
+	}
+	return Record;
+}
+
+void FRockInventoryJournalRecord::Serialize(FArchive& Ar)
+{
+	using namespace RockInventoryJournal;
+
+	Ar << InventoryId;
+	Ar << Sequence;
+
+	FRockSaveNameTable NameTable;
+	if (Ar.IsSaving())
+	{
+		for (const FRockItemStackSaveData& Item : Items)
+		{
+			if (Item.bValid)
+			{
+				NameTable.Add(Item.ItemId);
+			}
+		}
+	}
+	NameTable.Serialize(Ar);
+
+	int32 NumItems = Items.Num();
+	SerializeIndex(Ar, NumItems);
+	if (Ar.IsLoading())
+	{
+		ItemIndices.SetNum(NumItems);
+		Items.SetNum(NumItems);
+	}
+	for (int32 i = 0; i < NumItems && !Ar.IsError(); ++i)
+	{
+		SerializeIndex(Ar, ItemIndices[i]);
+		FRockInventorySaveData::SerializeItem(Ar, Items[i], NameTable);
+	}
+
+	// Unlike the snapshot, the item a slot points at isn't necessarily part of the same record, so the generation is stored
+	int32 NumSlots = Slots.Num();
+	SerializeIndex(Ar, NumSlots);
+	if (Ar.IsLoading())
+	{
+		Slots.SetNum(NumSlots);
+	}
+	for (int32 i = 0; i < NumSlots && !Ar.IsError(); ++i)
+	{
+		FRockInventorySlotEntry& Slot = Slots[i];
+		int32 SlotIndex = Slot.SlotHandle.GetAbsoluteIndex();
+		uint32 ItemIndexPlusOne = Slot.ItemHandle.IsValid() ? Slot.ItemHandle.GetIndex() + 1 : 0;
+		uint32 Generation = Slot.ItemHandle.IsValid() ? Slot.ItemHandle.GetGeneration() : 0;
+		uint8 Orientation = static_cast<uint8>(Slot.Orientation);
+		uint8 Flags = Slot.bIsLocked ? Slot_Locked : 0;
+		SerializeIndex(Ar, SlotIndex);
+		Ar.SerializeIntPacked(ItemIndexPlusOne);
+		Ar.SerializeIntPacked(Generation);
+		Ar << Orientation << Flags;
+		if (Ar.IsLoading())
+		{
+			Slot.SlotHandle = FRockInventorySlotHandle(SlotIndex);
+			Slot.ItemHandle = ItemIndexPlusOne == 0 ? FRockItemStackHandle::Invalid() : FRockItemStackHandle::Create(ItemIndexPlusOne - 1, Generation);
+			Slot.Orientation = static_cast<ERockItemOrientation>(Orientation);
+			Slot.bIsLocked = (Flags & Slot_Locked) != 0;
+		}
+	}
+}
+
+bool FRockInventoryJournalRecord::Apply(URockInventory* Inventory) const
+{
+	check(IsInGameThread());
+	if (!Inventory || Inventory->PersistentId != InventoryId)
+	{
+		return false;
+	}
+
+	// Validate up front so a bad record can't leave the inventory half applied
+	for (const int32 ItemIndex : ItemIndices)
+	{
+		// AcquireAvailableItemIndex never grows ItemData past Slots + 1
+		if (ItemIndex < 0 || ItemIndex > Inventory->SlotData.Num())
+		{
+			UE_LOG(LogRockInventory, Warning, TEXT("Journal record %llu: item index %d out of range for %s"), Sequence, ItemIndex, *Inventory->GetDebugString());
+			return false;
+		}
+	}
+	for (const FRockInventorySlotEntry& Slot : Slots)
+	{
+		if (!Inventory->SlotData.ContainsIndex(Slot.SlotHandle.GetAbsoluteIndex()))
+		{
+			UE_LOG(LogRockInventory, Warning, TEXT("Journal record %llu: slot %d out of range for %s"), Sequence, Slot.SlotHandle.GetAbsoluteIndex(), *Inventory->GetDebugString());
+			return false;
+		}
+	}
+
+	const int32 PreviousItemDataNum = Inventory->ItemData.Num();
+	TArray<FRockItemStackHandle, TInlineAllocator<8>> DroppedItems;
+	for (int32 i = 0; i < ItemIndices.Num(); ++i)
+	{
+		const int32 ItemIndex = ItemIndices[i];
+		while (Inventory->ItemData.Num() <= ItemIndex)
+		{
+			const int32 NewIndex = Inventory->ItemData.AddDefaulted();
+			Inventory->ItemData[NewIndex].ItemHandle = FRockItemStackHandle::Create(NewIndex, 0);
+		}
+		if (URockItemInstance* OldInstance = Inventory->ItemData[ItemIndex].RuntimeInstance)
+		{
+			OldInstance->UnregisterReplicationWithOwner();
+		}
+		if (!FRockInventorySaveData::RestoreItem(Inventory, ItemIndex, Items[i]))
+		{
+			DroppedItems.Add(FRockItemStackHandle::Create(ItemIndex, Items[i].Generation));
+		}
+		Inventory->ItemData.MarkItemDirty(Inventory->ItemData[ItemIndex]);
+		Inventory->MarkSnapshotItemDirty(ItemIndex);
+	}
+
+	// Rebuilt rather than patched, records can free and reuse indices in any order
+	Inventory->FreeIndices.Reset();
+	for (int32 ItemIndex = Inventory->ItemData.Num() - 1; ItemIndex >= 0; --ItemIndex)
+	{
+		if (!Inventory->ItemData[ItemIndex].IsValid())
+		{
+			Inventory->FreeIndices.Add(ItemIndex);
+		}
+	}
+	Inventory->FreeIndices.Heapify();
+	if (Inventory->ItemData.Num() != PreviousItemDataNum)
+	{
+		Inventory->ItemData.MarkArrayDirty();
+	}
+	// Registers the inventory and every (new) runtime instance
+	Inventory->RegisterReplicationWithOwner();
+
+	for (int32 i = 0; i < ItemIndices.Num(); ++i)
+	{
+		Inventory->BroadcastItemChanged(Inventory->ItemData[ItemIndices[i]].ItemHandle, ERockItemChangeType::Changed);
+	}
+	for (const FRockInventorySlotEntry& Slot : Slots)
+	{
+		FRockInventorySlotEntry NewSlot = Slot;
+		if (DroppedItems.Contains(NewSlot.ItemHandle))
+		{
+			NewSlot.ItemHandle = FRockItemStackHandle::Invalid();
+		}
+		// Marks dirty and broadcasts the right slot delta
+		Inventory->SetSlotByHandle(NewSlot.SlotHandle, NewSlot);
+	}
+
+	// The state now matches what the journal already holds
+	Inventory->ChangedItemIndices.Reset();
+	Inventory->ChangedSlotIndices.Reset();
+	return true;
+}
+
+FRockInventoryJournal::~FRockInventoryJournal()
+{
+	Close();
+}
+
+bool FRockInventoryJournal::Open(const FString& InFilename, bool bInFlushEveryRecord, TArray<FRockInventoryJournalRecord>* OutExistingRecords)
+{
+	Close();
+	Filename = InFilename;
+	bFlushEveryRecord = bInFlushEveryRecord;
+	NumRecords = 0;
+	Size = 0;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Filename));
+
+	TArray<FRockInventoryJournalRecord> ExistingRecords;
+	int64 ValidSize = 0;
+	const bool bFileExists = PlatformFile.FileExists(*Filename);
+	const bool bHasValidHeader = bFileExists && ReadRecords(Filename, ExistingRecords, ValidSize);
+	if (bFileExists && !bHasValidHeader && PlatformFile.FileSize(*Filename) > 0)
+	{
+		// Damaged, foreign or written by a newer build. Its records may still be recoverable elsewhere, so it is never overwritten
+		const FString RejectedFilename = FString::Printf(TEXT("%s.rejected-%s"), *Filename, *FDateTime::UtcNow().ToString());
+		if (!PlatformFile.MoveFile(*RejectedFilename, *Filename))
+		{
+			UE_LOG(LogRockInventory, Error, TEXT("Inventory journal %s has an unreadable header and could not be moved aside, refusing to open it"), *Filename);
+			return false;
+		}
+		UE_LOG(LogRockInventory, Warning, TEXT("Inventory journal %s has an unreadable header, moved it to %s and starting a new one"), *Filename, *RejectedFilename);
+	}
+	if (bHasValidHeader)
+	{
+		const int64 FileSize = PlatformFile.FileSize(*Filename);
+		if (ValidSize < FileSize)
+		{
+			UE_LOG(LogRockInventory, Warning, TEXT("Inventory journal %s: discarding %lld bytes of torn/corrupt tail after %d records"),
+				*Filename, FileSize - ValidSize, ExistingRecords.Num());
+		}
+		FileHandle.Reset(PlatformFile.OpenWrite(*Filename, true, false));
+		if (FileHandle && ValidSize < FileSize && !FileHandle->Truncate(ValidSize))
+		{
+			FileHandle.Reset();
+		}
+		if (FileHandle)
+		{
+			FileHandle->SeekFromEnd(0);
+		}
+		Size = ValidSize;
+		NumRecords = ExistingRecords.Num();
+		if (ExistingRecords.Num() > 0)
+		{
+			NextSequence = FMath::Max(NextSequence, ExistingRecords.Last().Sequence + 1);
+		}
+	}
+	else
+	{
+		FileHandle.Reset(PlatformFile.OpenWrite(*Filename, false, false));
+		if (FileHandle && !WriteHeader())
+		{
+			FileHandle.Reset();
+		}
+	}
+
+	if (!FileHandle)
+	{
+		UE_LOG(LogRockInventory, Error, TEXT("Inventory journal: failed to open %s for writing"), *Filename);
+		return false;
+	}
+	if (OutExistingRecords)
+	{
+		*OutExistingRecords = MoveTemp(ExistingRecords);
+	}
+	return true;
+}
+
+void FRockInventoryJournal::Close()
+{
+	if (FileHandle)
+	{
+		FileHandle->Flush(true);
+		FileHandle.Reset();
+	}
+}
+
+bool FRockInventoryJournal::WriteHeader()
+{
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = Version;
+	TArray<uint8> Header;
+	FMemoryWriter Writer(Header);
+	Writer << FileMagic << FileVersion;
+	if (!FileHandle->Write(Header.GetData(), Header.Num()))
+	{
+		return false;
+	}
+	FileHandle->Flush(true);
+	Size = Header.Num();
+	return true;
+}
+
+bool FRockInventoryJournal::Append(FRockInventoryJournalRecord& Record)
+{
+	using namespace RockInventoryJournal;
+
+	if (!FileHandle)
+	{
+		return false;
+	}
+	const double StartTime = FPlatformTime::Seconds();
+	Record.Sequence = NextSequence++;
+
+	// Frame header is patched in once the payload size is known
+	FrameBuffer.Reset();
+	FMemoryWriter Writer(FrameBuffer);
+	uint32 PayloadSize = 0;
+	uint32 PayloadCrc = 0;
+	Writer << PayloadSize << PayloadCrc;
+	Record.Serialize(Writer);
+	PayloadSize = FrameBuffer.Num() - FrameHeaderSize;
+	PayloadCrc = FCrc::MemCrc32(FrameBuffer.GetData() + FrameHeaderSize, PayloadSize);
+	Writer.Seek(0);
+	Writer << PayloadSize << PayloadCrc;
+
+	if (!FileHandle->Write(FrameBuffer.GetData(), FrameBuffer.Num()))
+	{
+		UE_LOG(LogRockInventory, Error, TEXT("Inventory journal: write failed for %s"), *Filename);
+		return false;
+	}
+	if (bFlushEveryRecord)
+	{
+		FileHandle->Flush(true);
+	}
+
+	Size += FrameBuffer.Num();
+	++NumRecords;
+	++Stats.RecordsAppended;
+	Stats.BytesAppended += FrameBuffer.Num();
+	Stats.AppendSeconds += FPlatformTime::Seconds() - StartTime;
+	return true;
+}
+
+bool FRockInventoryJournal::AppendChanges(URockInventory* Inventory)
+{
+	if (!Inventory || !Inventory->HasChangedIndices())
+	{
+		return true;
+	}
+	FRockInventoryJournalRecord Record = FRockInventoryJournalRecord::Capture(Inventory);
+	return Append(Record);
+}
+
+void FRockInventoryJournal::Flush()
+{
+	if (FileHandle)
+	{
+		FileHandle->Flush(true);
+	}
+}
+
+bool FRockInventoryJournal::Reset()
+{
+	if (!FileHandle || !FileHandle->Truncate(HeaderSize) || !FileHandle->Seek(HeaderSize))
+	{
+		UE_LOG(LogRockInventory, Error, TEXT("Inventory journal: failed to reset %s"), *Filename);
+		return false;
+	}
+	FileHandle->Flush(true);
+	Size = HeaderSize;
+	NumRecords = 0;
+	return true;
+}
+
+bool FRockInventoryJournal::ReadRecords(const FString& InFilename, TArray<FRockInventoryJournalRecord>& OutRecords, int64& OutValidSize)
+{
+	using namespace RockInventoryJournal;
+
+	OutRecords.Reset();
+	OutValidSize = 0;
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *InFilename, FILEREAD_Silent))
+	{
+		return false;
+	}
+	FMemoryReader Reader(Bytes);
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	Reader << FileMagic << FileVersion;
+	if (Reader.IsError() || FileMagic != Magic || FileVersion == 0 || FileVersion > Version)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("Inventory journal %s has unknown magic/version (%u)"), *InFilename, FileVersion);
+		return false;
+	}
+	OutValidSize = Reader.Tell();
+
+	while (Bytes.Num() - OutValidSize >= FrameHeaderSize)
+	{
+		Reader.Seek(OutValidSize);
+		uint32 PayloadSize = 0;
+		uint32 PayloadCrc = 0;
+		Reader << PayloadSize << PayloadCrc;
+		const int64 PayloadOffset = OutValidSize + FrameHeaderSize;
+		if (PayloadSize > MaxPayloadSize || PayloadOffset + PayloadSize > Bytes.Num())
+		{
+			// Torn write, the process died mid-record
+			break;
+		}
+		if (FCrc::MemCrc32(Bytes.GetData() + PayloadOffset, PayloadSize) != PayloadCrc)
+		{
+			break;
+		}
+
+		FMemoryReaderView PayloadReader(TConstArrayView<uint8>(Bytes.GetData() + PayloadOffset, PayloadSize));
+		FRockInventoryJournalRecord Record;
+		Record.Serialize(PayloadReader);
+		if (PayloadReader.IsError())
+		{
+			break;
+		}
+		OutRecords.Add(MoveTemp(Record));
+		OutValidSize = PayloadOffset + PayloadSize;
+	}
+	return true;
+}
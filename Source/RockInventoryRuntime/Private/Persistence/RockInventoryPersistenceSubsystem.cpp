@@ -0,0 +1,435 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Persistence/RockInventoryPersistenceSubsystem.h"
+
+#include "RockInventoryLogging.h"
+#include "Engine/World.h"
+#include "Inventory/RockInventory.h"
+#include "Item/RockItemInstance.h"
+#include "Misc/Paths.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "TimerManager.h"
+
+void URockInventoryPersistenceSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const URockInventoryDeveloperSettings* Settings = GetDefault<URockInventoryDeveloperSettings>();
+	if ((!Settings->bEnableInventoryJournal && !Settings->bEnableInventoryAutosave) || InWorld.GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	PersistenceDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), Settings->InventoryPersistenceDirectory);
+	BatchSize = Settings->InventoryAutosaveBatchSize;
+	bCompressSnapshots = Settings->bCompressInventorySnapshots;
+	WriteBehind = MakeUnique<FRockInventoryWriteBehindQueue>(
+		MakeShared<FRockInventoryFileStorageBackend, ESPMode::ThreadSafe>(FPaths::Combine(PersistenceDirectory, TEXT("Snapshots"))));
+
+	if (Settings->bEnableInventoryAutosave && Settings->InventoryAutosaveInterval > 0.0f)
+	{
+		InWorld.GetTimerManager().SetTimer(AutosaveTimerHandle, FTimerDelegate::CreateUObject(this, &ThisClass::Autosave),
+			Settings->InventoryAutosaveInterval, true);
+	}
+
+	if (!Settings->bEnableInventoryJournal)
+	{
+		return;
+	}
+	CompactionSizeBytes = static_cast<int64>(Settings->JournalCompactionSizeKB) * 1024;
+
+	TArray<FRockInventoryJournalRecord> ExistingRecords;
+	const FString JournalFilename = FPaths::Combine(PersistenceDirectory, TEXT("Inventory.journal"));
+	if (!Journal.Open(JournalFilename, Settings->bFlushJournalEveryRecord, &ExistingRecords))
+	{
+		return;
+	}
+
+	// Sequence order is preserved per inventory, which is all replay needs
+	for (FRockInventoryJournalRecord& Record : ExistingRecords)
+	{
+		PendingRecords.FindOrAdd(Record.InventoryId).Add(MoveTemp(Record));
+	}
+	if (ExistingRecords.Num() > 0)
+	{
+		UE_LOG(LogRockInventory, Log, TEXT("Inventory journal: %d records for %d inventories pending recovery"), ExistingRecords.Num(), PendingRecords.Num());
+	}
+
+	if (Settings->JournalCompactionInterval > 0.0f)
+	{
+		InWorld.GetTimerManager().SetTimer(CompactionTimerHandle, FTimerDelegate::CreateWeakLambda(this, [this]() { Compact(); }),
+			Settings->JournalCompactionInterval, true);
+	}
+}
+
+void URockInventoryPersistenceSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(AutosaveTimerHandle);
+		World->GetTimerManager().ClearTimer(CompactionTimerHandle);
+	}
+	if (Journal.IsOpen())
+	{
+		// A clean shutdown leaves nothing to replay but the records no snapshot covers
+		Compact();
+		Journal.Close();
+	}
+	else if (WriteBehind)
+	{
+		Autosave();
+	}
+	if (WriteBehind)
+	{
+		WriteBehind->WaitForCompletion();
+		WriteBehind.Reset();
+	}
+	PendingRecords.Reset();
+	TrackedInventories.Reset();
+	bLostTrackedInventory = false;
+	Super::Deinitialize();
+}
+
+bool URockInventoryPersistenceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URockInventoryPersistenceSubsystem::TrackInventory(URockInventory* Inventory)
+{
+	if (!Inventory || !WriteBehind)
+	{
+		return;
+	}
+	URockInventory* RootInventory = GetRootInventory(Inventory);
+	FTrackedInventory& Tracked = TrackedInventories.FindOrAdd(RootInventory->GetPersistentId());
+	Tracked.Inventory = RootInventory;
+}
+
+bool URockInventoryPersistenceSubsystem::JournalChanges(URockInventory* Inventory)
+{
+	check(IsInGameThread());
+	if (!Journal.IsOpen() || !Inventory)
+	{
+		return false;
+	}
+	if (!Journal.AppendChanges(Inventory))
+	{
+		return false;
+	}
+
+	// Journaled changes have to end up in a snapshot before compaction can drop them
+	TrackInventory(Inventory);
+
+	if (Journal.GetSize() > CompactionSizeBytes)
+	{
+		Compact();
+	}
+	return true;
+}
+
+bool URockInventoryPersistenceSubsystem::RecoverInventory(URockInventory* Inventory)
+{
+	check(IsInGameThread());
+	if (!Inventory || !Inventory->GetPersistentId().IsValid() || !WriteBehind)
+	{
+		return false;
+	}
+
+	// A queued or in flight snapshot of this inventory would be newer than what's on disk
+	WriteBehind->Submit(BatchSize, bCompressSnapshots);
+	WriteBehind->WaitForCompletion();
+
+	bool bRecovered = false;
+	TArray<uint8> Blob;
+	if (WriteBehind->GetBackend().Read(Inventory->GetPersistentId(), Blob))
+	{
+		TArray<uint8> SaveBytes;
+		if (FRockInventoryWriteBehindQueue::DecodeBlob(Blob, SaveBytes) && FRockInventorySaveData::LoadInventory(Inventory, SaveBytes))
+		{
+			bRecovered = true;
+		}
+		else
+		{
+			UE_LOG(LogRockInventory, Warning, TEXT("RecoverInventory - Snapshot for %s is unreadable, replaying the journal on the current contents"),
+				*Inventory->GetDebugString());
+		}
+	}
+	bRecovered |= ApplyPendingRecords(Inventory);
+
+	FTrackedInventory& Tracked = TrackedInventories.FindOrAdd(Inventory->GetPersistentId());
+	Tracked.Inventory = Inventory;
+	// The replayed records only live in the journal until the next snapshot
+	Tracked.bSaved = Tracked.bSaved && !bRecovered;
+	return bRecovered;
+}
+
+bool URockInventoryPersistenceSubsystem::ApplyPendingRecords(URockInventory* Inventory)
+{
+	bool bApplied = false;
+	if (TArray<FRockInventoryJournalRecord>* Records = PendingRecords.Find(Inventory->GetPersistentId()))
+	{
+		for (const FRockInventoryJournalRecord& Record : *Records)
+		{
+			bApplied |= Record.Apply(Inventory);
+		}
+		PendingRecords.Remove(Inventory->GetPersistentId());
+	}
+
+	// Nested inventories only exist once their parent's records have recreated them
+	TArray<URockInventory*, TInlineAllocator<4>> NestedInventories;
+	Inventory->ForEachItemStack([&NestedInventories](const FRockItemStack& ItemStack)
+	{
+		const URockItemInstance* Instance = ItemStack.GetRuntimeInstance();
+		if (Instance && Instance->NestedInventory)
+		{
+			NestedInventories.Add(Instance->NestedInventory);
+		}
+		return true;
+	});
+	for (URockInventory* NestedInventory : NestedInventories)
+	{
+		bApplied |= ApplyPendingRecords(NestedInventory);
+	}
+	return bApplied;
+}
+
+void URockInventoryPersistenceSubsystem::ReleaseInventory(URockInventory* Inventory)
+{
+	if (!Inventory || !WriteBehind)
+	{
+		return;
+	}
+	FTrackedInventory Tracked;
+	if (!TrackedInventories.RemoveAndCopyValue(Inventory->GetPersistentId(), Tracked))
+	{
+		return;
+	}
+	if (!Tracked.bSaved || Tracked.SavedFingerprint != GetChangeFingerprint(Inventory))
+	{
+		// The capture is all that's needed from the inventory, the write can finish after it is gone
+		CaptureInventory(Inventory, Tracked);
+		WriteBehind->Submit(BatchSize, bCompressSnapshots);
+	}
+}
+
+void URockInventoryPersistenceSubsystem::SaveInventoryNow(URockInventory* Inventory)
+{
+	check(IsInGameThread());
+	if (!Inventory || !WriteBehind)
+	{
+		return;
+	}
+	TrackInventory(Inventory);
+	if (Journal.IsOpen())
+	{
+		Compact();
+		return;
+	}
+	URockInventory* RootInventory = GetRootInventory(Inventory);
+	CaptureInventory(RootInventory, TrackedInventories.FindChecked(RootInventory->GetPersistentId()));
+	// Lands after anything submitted earlier for the same inventory
+	WriteBehind->Submit(BatchSize, bCompressSnapshots);
+}
+
+void URockInventoryPersistenceSubsystem::Autosave()
+{
+	if (!WriteBehind)
+	{
+		return;
+	}
+	const double StartCaptureSeconds = CaptureSeconds;
+	const int32 NumCaptured = CaptureDirtyInventories();
+	WriteBehind->Submit(BatchSize, bCompressSnapshots);
+
+	if (NumCaptured > 0)
+	{
+		const FRockInventoryWriteBehindStats Stats = WriteBehind->GetStats();
+		UE_LOG(LogRockInventory, Verbose, TEXT("Inventory autosave: captured %d inventories in %.2f ms on the game thread. Background throughput %.1f KB/s, %lld failed writes"),
+			NumCaptured, (CaptureSeconds - StartCaptureSeconds) * 1000.0, Stats.GetBytesPerSecond() / 1024.0, Stats.FailedWrites);
+	}
+}
+
+int32 URockInventoryPersistenceSubsystem::CaptureDirtyInventories()
+{
+	check(IsInGameThread());
+	int32 NumCaptured = 0;
+	for (auto It = TrackedInventories.CreateIterator(); It; ++It)
+	{
+		URockInventory* Inventory = It.Value().Inventory.Get();
+		if (!Inventory)
+		{
+			if (Journal.IsOpen())
+			{
+				UE_LOG(LogRockInventory, Warning, TEXT("Inventory persistence: %s was destroyed without ReleaseInventory, its latest changes only live in the journal"),
+					*It.Key().ToString());
+				bLostTrackedInventory = true;
+			}
+			else
+			{
+				UE_LOG(LogRockInventory, Warning, TEXT("Inventory persistence: %s was destroyed without ReleaseInventory, its latest changes are lost"),
+					*It.Key().ToString());
+			}
+			It.RemoveCurrent();
+			continue;
+		}
+		if (!It.Value().bSaved || It.Value().SavedFingerprint != GetChangeFingerprint(Inventory))
+		{
+			CaptureInventory(Inventory, It.Value());
+			++NumCaptured;
+		}
+	}
+	return NumCaptured;
+}
+
+void URockInventoryPersistenceSubsystem::CaptureInventory(URockInventory* Inventory, FTrackedInventory& Tracked)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	WriteBehind->Enqueue(FRockInventorySaveData::Capture(Inventory));
+	Tracked.SavedFingerprint = GetChangeFingerprint(Inventory);
+	Tracked.bSaved = true;
+	CaptureSeconds += FPlatformTime::Seconds() - StartTime;
+}
+
+bool URockInventoryPersistenceSubsystem::Compact()
+{
+	check(IsInGameThread());
+	if (!Journal.IsOpen() || !WriteBehind)
+	{
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 NumCompactedRecords = Journal.GetNumRecords();
+	const int64 PreviousFailedWrites = WriteBehind->GetStats().FailedWrites;
+
+	// Covers the records of every inventory still tracked. Lost inventories are carried over below, like pending ones
+	const int32 NumSnapshots = CaptureDirtyInventories();
+	WriteBehind->Submit(BatchSize, bCompressSnapshots);
+	WriteBehind->WaitForCompletion();
+	if (WriteBehind->GetStats().FailedWrites != PreviousFailedWrites)
+	{
+		// Leave the journal alone, it is still the only copy of these changes. Force them to be captured again next time.
+		UE_LOG(LogRockInventory, Error, TEXT("Inventory journal: compaction aborted, snapshots failed to write"));
+		for (TPair<FGuid, FTrackedInventory>& Pair : TrackedInventories)
+		{
+			Pair.Value.bSaved = false;
+		}
+		return false;
+	}
+	if (bLostTrackedInventory && !CarryOverUntrackedRecords())
+	{
+		return false;
+	}
+
+	if (!Journal.Reset())
+	{
+		return false;
+	}
+	bLostTrackedInventory = false;
+	// Inventories that haven't been recovered yet still need their records
+	for (TPair<FGuid, TArray<FRockInventoryJournalRecord>>& Pair : PendingRecords)
+	{
+		for (FRockInventoryJournalRecord& Record : Pair.Value)
+		{
+			Journal.Append(Record);
+		}
+	}
+
+	const FRockInventoryJournalStats& Stats = Journal.GetStats();
+	UE_LOG(LogRockInventory, Log, TEXT("Inventory journal compacted: %d records into %d snapshots in %.2f ms. Append throughput %.0f records/s, %.1f KB/s"),
+		NumCompactedRecords, NumSnapshots, (FPlatformTime::Seconds() - StartTime) * 1000.0, Stats.GetRecordsPerSecond(), Stats.GetBytesPerSecond() / 1024.0);
+	return true;
+}
+
+bool URockInventoryPersistenceSubsystem::CarryOverUntrackedRecords()
+{
+	TSet<FGuid> TrackedIds;
+	for (const TPair<FGuid, FTrackedInventory>& Pair : TrackedInventories)
+	{
+		if (const URockInventory* Inventory = Pair.Value.Inventory.Get())
+		{
+			GatherPersistentIds(Inventory, TrackedIds);
+		}
+	}
+
+	Journal.Flush();
+	TArray<FRockInventoryJournalRecord> Records;
+	int64 ValidSize = 0;
+	if (!FRockInventoryJournal::ReadRecords(Journal.GetFilename(), Records, ValidSize))
+	{
+		UE_LOG(LogRockInventory, Error, TEXT("Inventory journal: compaction aborted, could not read back %s"), *Journal.GetFilename());
+		return false;
+	}
+
+	// Pending records are already in the journal, only add the ones of inventories that were lost since
+	TMap<FGuid, TArray<FRockInventoryJournalRecord>> LostRecords;
+	for (FRockInventoryJournalRecord& Record : Records)
+	{
+		if (!TrackedIds.Contains(Record.InventoryId) && !PendingRecords.Contains(Record.InventoryId))
+		{
+			LostRecords.FindOrAdd(Record.InventoryId).Add(MoveTemp(Record));
+		}
+	}
+	UE_LOG(LogRockInventory, Log, TEXT("Inventory journal: carrying over the records of %d inventories destroyed without a snapshot"), LostRecords.Num());
+	PendingRecords.Append(MoveTemp(LostRecords));
+	return true;
+}
+
+void URockInventoryPersistenceSubsystem::SetStorageBackend(TSharedRef<IRockInventoryStorageBackend, ESPMode::ThreadSafe> InBackend)
+{
+	if (WriteBehind)
+	{
+		WriteBehind->SetBackend(MoveTemp(InBackend));
+	}
+}
+
+FRockInventoryWriteBehindStats URockInventoryPersistenceSubsystem::GetWriteBehindStats() const
+{
+	return WriteBehind ? WriteBehind->GetStats() : FRockInventoryWriteBehindStats();
+}
+
+URockInventory* URockInventoryPersistenceSubsystem::GetRootInventory(URockInventory* Inventory)
+{
+	URockInventory* RootInventory = Inventory;
+	while (RootInventory)
+	{
+		const URockItemInstance* Instance = RootInventory->GetTypedOuter<URockItemInstance>();
+		if (!Instance || !Instance->OwningInventory)
+		{
+			break;
+		}
+		RootInventory = Instance->OwningInventory;
+	}
+	return RootInventory;
+}
+
+void URockInventoryPersistenceSubsystem::GatherPersistentIds(const URockInventory* Inventory, TSet<FGuid>& OutIds)
+{
+	OutIds.Add(Inventory->GetPersistentId());
+	Inventory->ForEachItemStack([&OutIds](const FRockItemStack& ItemStack)
+	{
+		const URockItemInstance* Instance = ItemStack.GetRuntimeInstance();
+		if (Instance && Instance->NestedInventory)
+		{
+			GatherPersistentIds(Instance->NestedInventory, OutIds);
+		}
+		return true;
+	});
+}
+
+uint32 URockInventoryPersistenceSubsystem::GetChangeFingerprint(const URockInventory* Inventory)
+{
+	uint32 Fingerprint = Inventory->GetChangeSerial();
+	Inventory->ForEachItemStack([&Fingerprint](const FRockItemStack& ItemStack)
+	{
+		const URockItemInstance* Instance = ItemStack.GetRuntimeInstance();
+		if (Instance && Instance->NestedInventory)
+		{
+			Fingerprint = HashCombineFast(Fingerprint, GetTypeHash(Instance->NestedInventory->GetPersistentId()));
+			Fingerprint = HashCombineFast(Fingerprint, GetChangeFingerprint(Instance->NestedInventory));
+		}
+		return true;
+	});
+	return Fingerprint;
+}
@@ -0,0 +1,473 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Persistence/RockInventorySaveData.h"
+
+#include "RockInventoryLogging.h"
+#include "Inventory/RockInventory.h"
+#include "Item/RockItemDefinition.h"
+#include "Item/RockItemInstance.h"
+#include "Library/RockItemStackLibrary.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+namespace RockInventorySave
+{
+	enum EItemFlags : uint8
+	{
+		Item_Valid = 1 << 0,
+		Item_Initialized = 1 << 1,
+		Item_HasCustomValues = 1 << 2,
+		Item_HasInstance = 1 << 3,
+	};
+
+	enum ESlotFlags : uint8
+	{
+		Slot_Locked = 1 << 0,
+	};
+
+	// Custom values are usually small and can be negative, zigzag keeps them at 1-2 bytes packed
+	void SerializeZigZag(FArchive& Ar, int32& Value)
+	{
+		uint32 Encoded = static_cast<uint32>((Value << 1) ^ (Value >> 31));
+		Ar.SerializeIntPacked(Encoded);
+		if (Ar.IsLoading())
+		{
+			Value = static_cast<int32>((Encoded >> 1) ^ (~(Encoded & 1) + 1));
+		}
+	}
+
+	void SerializeCount(FArchive& Ar, int32& Count)
+	{
+		uint32 Packed = static_cast<uint32>(FMath::Max(Count, 0));
+		Ar.SerializeIntPacked(Packed);
+		Count = static_cast<int32>(Packed);
+	}
+
+	// No inventory comes near this, anything above it is corrupt data
+	constexpr uint32 MaxElementCount = 1 << 20;
+
+	/**
+	 * Serializes the length of an array that is about to be SetNum'd. When loading, the count is bounded by MaxElementCount
+	 * and by what the rest of the archive could hold at MinElementSize bytes per element, so corrupt data can't allocate.
+	 */
+	void SerializeElementCount(FArchive& Ar, int32& Count, int64 MinElementSize)
+	{
+		uint32 Packed = static_cast<uint32>(FMath::Max(Count, 0));
+		Ar.SerializeIntPacked(Packed);
+		if (!Ar.IsLoading())
+		{
+			return;
+		}
+		const int64 TotalSize = Ar.TotalSize();
+		const int64 RemainingBytes = TotalSize >= 0 ? TotalSize - Ar.Tell() : MAX_int64;
+		if (Ar.IsError() || Packed > MaxElementCount || static_cast<int64>(Packed) * MinElementSize > RemainingBytes)
+		{
+			UE_LOG(LogRockInventory, Warning, TEXT("Inventory save data: %u elements can't fit the remaining %lld bytes"), Packed, RemainingBytes);
+			Ar.SetError();
+			Packed = 0;
+		}
+		Count = static_cast<int32>(Packed);
+	}
+}
+
+int32 FRockSaveNameTable::Add(FName Name)
+{
+	if (const int32* Existing = Lookup.Find(Name))
+	{
+		return *Existing;
+	}
+	const int32 Index = Names.Add(Name);
+	Lookup.Add(Name, Index);
+	return Index;
+}
+
+void FRockSaveNameTable::Serialize(FArchive& Ar)
+{
+	int32 NumNames = Names.Num();
+	// A name is at least its FString length
+	RockInventorySave::SerializeElementCount(Ar, NumNames, sizeof(int32));
+	if (Ar.IsLoading())
+	{
+		Names.SetNum(NumNames);
+		Lookup.Reset();
+	}
+	for (int32 i = 0; i < NumNames && !Ar.IsError(); ++i)
+	{
+		FString NameString = Ar.IsSaving() ? Names[i].ToString() : FString();
+		Ar << NameString;
+		if (Ar.IsLoading())
+		{
+			Names[i] = FName(*NameString);
+			Lookup.Add(Names[i], i);
+		}
+	}
+}
+
+FRockItemStackSaveData FRockInventorySaveData::CaptureItem(const FRockItemStack& ItemStack)
+{
+	FRockItemStackSaveData Item;
+	Item.Generation = ItemStack.Generation;
+	Item.bInitialized = ItemStack.bInitialized;
+	Item.bValid = ItemStack.IsValid();
+	if (!Item.bValid)
+	{
+		return Item;
+	}
+
+	Item.ItemId = ItemStack.GetItemId();
+	Item.StackCount = ItemStack.StackCount;
+	Item.CustomValue1 = ItemStack.CustomValue1;
+	Item.CustomValue2 = ItemStack.CustomValue2;
+	if (URockItemInstance* Instance = ItemStack.RuntimeInstance)
+	{
+		Item.InstanceClass = FSoftClassPath(Instance->GetClass());
+		FMemoryWriter Writer(Item.InstanceState);
+		FObjectAndNameAsStringProxyArchive Proxy(Writer, false);
+		Instance->SerializeSaveData(Proxy);
+	}
+	return Item;
+}
+
+void FRockInventorySaveData::SerializeItem(FArchive& Ar, FRockItemStackSaveData& Item, FRockSaveNameTable& NameTable)
+{
+	using namespace RockInventorySave;
+
+	uint8 Flags = 0;
+	if (Ar.IsSaving())
+	{
+		Flags |= Item.bValid ? Item_Valid : 0;
+		Flags |= Item.bInitialized ? Item_Initialized : 0;
+		Flags |= (Item.CustomValue1 != 0 || Item.CustomValue2 != 0) ? Item_HasCustomValues : 0;
+		Flags |= !Item.InstanceClass.IsNull() ? Item_HasInstance : 0;
+	}
+	Ar << Flags;
+	Ar << Item.Generation;
+	Item.bValid = (Flags & Item_Valid) != 0;
+	Item.bInitialized = (Flags & Item_Initialized) != 0;
+	if (!Item.bValid)
+	{
+		return;
+	}
+
+	int32 NameIndex = Ar.IsSaving() ? NameTable.Add(Item.ItemId) : 0;
+	SerializeCount(Ar, NameIndex);
+	if (Ar.IsLoading())
+	{
+		if (!NameTable.Names.IsValidIndex(NameIndex))
+		{
+			Ar.SetError();
+			return;
+		}
+		Item.ItemId = NameTable.Names[NameIndex];
+	}
+	SerializeCount(Ar, Item.StackCount);
+	if (Flags & Item_HasCustomValues)
+	{
+		SerializeZigZag(Ar, Item.CustomValue1);
+		SerializeZigZag(Ar, Item.CustomValue2);
+	}
+	if (Flags & Item_HasInstance)
+	{
+		FString InstanceClassPath = Item.InstanceClass.ToString();
+		Ar << InstanceClassPath;
+		Ar << Item.InstanceState;
+		if (Ar.IsLoading())
+		{
+			Item.InstanceClass = FSoftClassPath(InstanceClassPath);
+		}
+	}
+}
+
+bool FRockInventorySaveData::RestoreItem(URockInventory* Inventory, int32 Index, const FRockItemStackSaveData& Item)
+{
+	FRockItemStack& Stack = Inventory->ItemData[Index];
+	Stack.Reset();
+	Stack.Generation = Item.Generation;
+	Stack.ItemHandle = FRockItemStackHandle::Create(Index, Item.Generation);
+	if (!Item.bValid)
+	{
+		return true;
+	}
+
+	URockItemDefinition* Definition = URockItemStackLibrary::GetItemDefinitionById(Item.ItemId);
+	if (!Definition)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("RestoreItem - Unknown ItemId '%s', dropping the stack"), *Item.ItemId.ToString());
+		return false;
+	}
+	Stack.Definition = Definition;
+	Stack.StackCount = Item.StackCount;
+	Stack.CustomValue1 = Item.CustomValue1;
+	Stack.CustomValue2 = Item.CustomValue2;
+	Stack.bInitialized = Item.bInitialized;
+
+	if (!Item.InstanceClass.IsNull())
+	{
+		UClass* InstanceClass = Item.InstanceClass.TryLoadClass<URockItemInstance>();
+		if (!InstanceClass)
+		{
+			UE_LOG(LogRockInventory, Warning, TEXT("RestoreItem - Missing runtime instance class '%s' for '%s'"),
+				*Item.InstanceClass.ToString(), *Item.ItemId.ToString());
+			return true;
+		}
+		URockItemInstance* Instance = NewObject<URockItemInstance>(Inventory, InstanceClass);
+		Instance->ItemHandle = Stack.ItemHandle;
+		// Replication is registered in bulk by the caller
+		Instance->OwningInventory = Inventory;
+		Instance->SetDefinition(Definition);
+
+		FMemoryReader Reader(Item.InstanceState);
+		FObjectAndNameAsStringProxyArchive Proxy(Reader, true);
+		Instance->SerializeSaveData(Proxy);
+		Stack.RuntimeInstance = Instance;
+	}
+	return true;
+}
+
+FRockInventorySaveData FRockInventorySaveData::Capture(const URockInventory* Inventory)
+{
+	check(IsInGameThread());
+	FRockInventorySaveData SaveData;
+	if (!Inventory)
+	{
+		return SaveData;
+	}
+
+	SaveData.InventoryId = Inventory->PersistentId;
+	SaveData.Sections = Inventory->SlotSections;
+	SaveData.Slots = Inventory->SlotData.AllSlots;
+	SaveData.Items.Reserve(Inventory->ItemData.Num());
+	for (const FRockItemStack& ItemStack : Inventory->ItemData)
+	{
+		SaveData.Items.Add(CaptureItem(ItemStack));
+	}
+	return SaveData;
+}
+
+bool FRockInventorySaveData::Serialize(FArchive& Ar)
+{
+	using namespace RockInventorySave;
+
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = static_cast<uint32>(ERockInventorySaveVersion::LatestVersion);
+	Ar << FileMagic;
+	Ar << FileVersion;
+	if (FileMagic != Magic || FileVersion == 0 || FileVersion > static_cast<uint32>(ERockInventorySaveVersion::LatestVersion))
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("Inventory save data has unknown magic/version (%u)"), FileVersion);
+		return false;
+	}
+
+	if (FileVersion >= static_cast<uint32>(ERockInventorySaveVersion::PersistentId))
+	{
+		Ar << InventoryId;
+	}
+
+	// Sections are few and carry filters/queries, tagged serialization keeps them robust to struct changes
+	int32 NumSections = Sections.Num();
+	SerializeElementCount(Ar, NumSections, 1);
+	if (Ar.IsLoading())
+	{
+		Sections.SetNum(NumSections);
+	}
+	for (FRockInventorySectionInfo& Section : Sections)
+	{
+		FRockInventorySectionInfo::StaticStruct()->SerializeItem(Ar, &Section, nullptr);
+	}
+
+	// Slot handles are implicit (slot index) and an item handle's generation always matches its item, so only the index is stored
+	int32 NumSlots = Slots.Num();
+	// Packed item index, orientation and flags
+	SerializeElementCount(Ar, NumSlots, 3);
+	if (Ar.IsLoading())
+	{
+		Slots.SetNum(NumSlots);
+	}
+	for (int32 SlotIndex = 0; SlotIndex < NumSlots && !Ar.IsError(); ++SlotIndex)
+	{
+		FRockInventorySlotEntry& Slot = Slots[SlotIndex];
+		uint32 ItemIndexPlusOne = Slot.ItemHandle.IsValid() ? Slot.ItemHandle.GetIndex() + 1 : 0;
+		uint8 Orientation = static_cast<uint8>(Slot.Orientation);
+		uint8 Flags = Slot.bIsLocked ? Slot_Locked : 0;
+		Ar.SerializeIntPacked(ItemIndexPlusOne);
+		Ar << Orientation << Flags;
+		if (Ar.IsLoading())
+		{
+			Slot.SlotHandle = FRockInventorySlotHandle(SlotIndex);
+			// Generation is patched in once the items are read
+			Slot.ItemHandle = ItemIndexPlusOne == 0 ? FRockItemStackHandle::Invalid() : FRockItemStackHandle::Create(ItemIndexPlusOne - 1, 0);
+			Slot.Orientation = static_cast<ERockItemOrientation>(Orientation);
+			Slot.bIsLocked = (Flags & Slot_Locked) != 0;
+		}
+	}
+
+	FRockSaveNameTable NameTable;
+	if (Ar.IsSaving())
+	{
+		for (const FRockItemStackSaveData& Item : Items)
+		{
+			if (Item.bValid)
+			{
+				NameTable.Add(Item.ItemId);
+			}
+		}
+	}
+	NameTable.Serialize(Ar);
+
+	int32 NumItems = Items.Num();
+	// Flags and generation
+	SerializeElementCount(Ar, NumItems, 2);
+	if (Ar.IsLoading())
+	{
+		Items.SetNum(NumItems);
+	}
+	for (int32 ItemIndex = 0; ItemIndex < NumItems && !Ar.IsError(); ++ItemIndex)
+	{
+		SerializeItem(Ar, Items[ItemIndex], NameTable);
+	}
+
+	if (Ar.IsLoading() && !Ar.IsError())
+	{
+		for (FRockInventorySlotEntry& Slot : Slots)
+		{
+			if (!Slot.ItemHandle.IsValid())
+			{
+				continue;
+			}
+			const int32 ItemIndex = Slot.ItemHandle.GetIndex();
+			if (!Items.IsValidIndex(ItemIndex) || !Items[ItemIndex].bValid)
+			{
+				UE_LOG(LogRockInventory, Warning, TEXT("Inventory save data: slot %d references missing item %d"), Slot.SlotHandle.GetAbsoluteIndex(), ItemIndex);
+				Slot.ItemHandle = FRockItemStackHandle::Invalid();
+				continue;
+			}
+			Slot.ItemHandle = FRockItemStackHandle::Create(ItemIndex, Items[ItemIndex].Generation);
+		}
+	}
+	return !Ar.IsError();
+}
+
+bool FRockInventorySaveData::Restore(URockInventory* Inventory) const
+{
+	check(IsInGameThread());
+	if (!Inventory)
+	{
+		return false;
+	}
+	// AcquireAvailableItemIndex relies on this invariant
+	if (Items.Num() > Slots.Num() + 1)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("Restore - %d items can't fit %d slots"), Items.Num(), Slots.Num());
+		return false;
+	}
+	// The data may not come from Serialize, check everything the inventory indexes by before replacing anything
+	int64 NextSlotIndex = 0;
+	for (const FRockInventorySectionInfo& Section : Sections)
+	{
+		const int64 NumSectionSlots = static_cast<int64>(Section.GetColumns()) * Section.GetRows();
+		if (Section.GetFirstSlotIndex() != NextSlotIndex || Section.GetColumns() < 0 || Section.GetRows() < 0)
+		{
+			UE_LOG(LogRockInventory, Warning, TEXT("Restore - Section %d doesn't start at slot %lld"), Section.GetSectionIndex(), NextSlotIndex);
+			return false;
+		}
+		NextSlotIndex += NumSectionSlots;
+	}
+	if (NextSlotIndex != Slots.Num())
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("Restore - Sections cover %lld slots, the data has %d"), NextSlotIndex, Slots.Num());
+		return false;
+	}
+	for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+	{
+		const FRockItemStackHandle& ItemHandle = Slots[SlotIndex].ItemHandle;
+		if (ItemHandle.IsValid() && !Items.IsValidIndex(ItemHandle.GetIndex()))
+		{
+			UE_LOG(LogRockInventory, Warning, TEXT("Restore - Slot %d references item %d of %d"), SlotIndex, ItemHandle.GetIndex(), Items.Num());
+			return false;
+		}
+	}
+
+	// Old runtime instances go away with the old contents
+	for (const FRockItemStack& OldStack : Inventory->ItemData)
+	{
+		if (OldStack.RuntimeInstance)
+		{
+			OldStack.RuntimeInstance->UnregisterReplicationWithOwner();
+		}
+	}
+
+	Inventory->ItemData.SetOwningInventory(Inventory);
+	Inventory->SlotData.SetOwningInventory(Inventory);
+	Inventory->SlotSections = Sections;
+	Inventory->SlotData.AllSlots = Slots;
+	Inventory->ItemData.AllSlots.SetNum(Items.Num());
+	Inventory->FreeIndices.Reset();
+	if (InventoryId.IsValid())
+	{
+		Inventory->PersistentId = InventoryId;
+	}
+	// The restored contents are the new persisted baseline
+	Inventory->ChangedItemIndices.Reset();
+	Inventory->ChangedSlotIndices.Reset();
+	++Inventory->ChangeSerial;
+
+	// Single pass over the items: rebuild each stack and the free list.
+	TBitArray<> DroppedItems(false, Items.Num());
+	for (int32 ItemIndex = Items.Num() - 1; ItemIndex >= 0; --ItemIndex)
+	{
+		if (!RestoreItem(Inventory, ItemIndex, Items[ItemIndex]))
+		{
+			DroppedItems[ItemIndex] = true;
+		}
+		if (!Inventory->ItemData[ItemIndex].IsValid())
+		{
+			Inventory->FreeIndices.Add(ItemIndex);
+		}
+	}
+	Inventory->FreeIndices.Heapify();
+
+	for (FRockInventorySlotEntry& Slot : Inventory->SlotData.AllSlots)
+	{
+		if (Slot.ItemHandle.IsValid() && DroppedItems[Slot.ItemHandle.GetIndex()])
+		{
+			Slot.ItemHandle = FRockItemStackHandle::Invalid();
+		}
+		Slot.LastKnownItemHandle = Slot.ItemHandle;
+	}
+
+	Inventory->SlotData.MarkArrayDirty();
+	Inventory->ItemData.MarkArrayDirty();
+	Inventory->InvalidateSnapshot();
+	// Registers the inventory and every runtime instance in one go
+	Inventory->RegisterReplicationWithOwner();
+
+	for (const FRockInventorySlotEntry& Slot : Inventory->SlotData.AllSlots)
+	{
+		if (Slot.ItemHandle.IsValid())
+		{
+			Inventory->BroadcastSlotChanged(FRockSlotDelta(Inventory, Slot.SlotHandle, ERockSlotChangeType::ItemAdded, FRockItemStackHandle::Invalid()));
+		}
+	}
+	return true;
+}
+
+bool FRockInventorySaveData::SaveInventory(const URockInventory* Inventory, TArray<uint8>& OutBytes)
+{
+	FRockInventorySaveData SaveData = Capture(Inventory);
+	OutBytes.Reset();
+	FMemoryWriter Writer(OutBytes);
+	return SaveData.Serialize(Writer);
+}
+
+bool FRockInventorySaveData::LoadInventory(URockInventory* Inventory, TConstArrayView<uint8> Bytes)
+{
+	FRockInventorySaveData SaveData;
+	// FMemoryReaderView avoids copying the caller's buffer
+	FMemoryReaderView Reader(Bytes);
+	if (!SaveData.Serialize(Reader))
+	{
+		return false;
+	}
+	return SaveData.Restore(Inventory);
+}
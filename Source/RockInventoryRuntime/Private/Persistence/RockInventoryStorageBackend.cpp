@@ -0,0 +1,49 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Persistence/RockInventoryStorageBackend.h"
+
+#include "RockInventoryLogging.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+FRockInventoryFileStorageBackend::FRockInventoryFileStorageBackend(const FString& InDirectory)
+	: Directory(InDirectory)
+{
+	IFileManager::Get().MakeDirectory(*Directory, true);
+}
+
+int32 FRockInventoryFileStorageBackend::WriteBatch(TConstArrayView<FRockInventoryStorageRecord> Records)
+{
+	int32 NumWritten = 0;
+	for (const FRockInventoryStorageRecord& Record : Records)
+	{
+		// Write then rename, so a crash mid-write leaves the previous version intact
+		const FString Filename = GetFilename(Record.InventoryId);
+		const FString TempFilename = Filename + TEXT(".tmp");
+		if (FFileHelper::SaveArrayToFile(Record.Bytes, *TempFilename) && IFileManager::Get().Move(*Filename, *TempFilename, true))
+		{
+			++NumWritten;
+		}
+		else
+		{
+			UE_LOG(LogRockInventory, Error, TEXT("Inventory storage: failed to write %s"), *Filename);
+		}
+	}
+	return NumWritten;
+}
+
+bool FRockInventoryFileStorageBackend::Read(const FGuid& InventoryId, TArray<uint8>& OutBytes)
+{
+	return FFileHelper::LoadFileToArray(OutBytes, *GetFilename(InventoryId), FILEREAD_Silent);
+}
+
+bool FRockInventoryFileStorageBackend::Remove(const FGuid& InventoryId)
+{
+	return IFileManager::Get().Delete(*GetFilename(InventoryId), false, false, true);
+}
+
+FString FRockInventoryFileStorageBackend::GetFilename(const FGuid& InventoryId) const
+{
+	return FPaths::Combine(Directory, InventoryId.ToString(EGuidFormats::Digits) + TEXT(".rinv"));
+}
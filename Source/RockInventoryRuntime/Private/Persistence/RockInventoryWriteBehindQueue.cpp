@@ -0,0 +1,192 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Persistence/RockInventoryWriteBehindQueue.h"
+
+#include "RockInventoryLogging.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace RockInventoryWriteBehind
+{
+	constexpr uint32 CompressedMagic = 0x524B495A; // 'RKIZ'
+	// [magic][uncompressed size]
+	constexpr int32 CompressedHeaderSize = sizeof(uint32) * 2;
+	// Sanity limits on the size a blob header claims, before anything gets allocated for it
+	constexpr uint32 MaxUncompressedSize = 64 * 1024 * 1024;
+	constexpr int64 MaxCompressionRatio = 1024;
+}
+
+FRockInventoryWriteBehindQueue::FRockInventoryWriteBehindQueue(TSharedRef<IRockInventoryStorageBackend, ESPMode::ThreadSafe> InBackend)
+	: Backend(MoveTemp(InBackend))
+{
+}
+
+FRockInventoryWriteBehindQueue::~FRockInventoryWriteBehindQueue()
+{
+	// Tasks reference this queue's counters
+	WaitForCompletion();
+}
+
+void FRockInventoryWriteBehindQueue::Enqueue(FRockInventorySaveData&& SaveData)
+{
+	check(IsInGameThread());
+	const FGuid InventoryId = SaveData.InventoryId;
+	FSaveDataRef SaveDataRef = MakeShared<FRockInventorySaveData, ESPMode::ThreadSafe>(MoveTemp(SaveData));
+	if (const int32* ExistingIndex = QueuedIndices.Find(InventoryId))
+	{
+		Queued[*ExistingIndex] = SaveDataRef;
+		return;
+	}
+	QueuedIndices.Add(InventoryId, Queued.Add(SaveDataRef));
+}
+
+void FRockInventoryWriteBehindQueue::Submit(int32 BatchSize, bool bCompress)
+{
+	check(IsInGameThread());
+	if (Queued.IsEmpty())
+	{
+		return;
+	}
+	BatchSize = FMath::Max(BatchSize, 1);
+
+	InFlight.RemoveAll([](const UE::Tasks::FTask& Task) { return Task.IsCompleted(); });
+	// Everything still writing from earlier submits has to land before this one starts
+	const TArray<UE::Tasks::FTask> Prerequisites = MoveTemp(InFlight);
+	InFlight.Reset();
+
+	for (int32 Start = 0; Start < Queued.Num(); Start += BatchSize)
+	{
+		TArray<FSaveDataRef> Batch(Queued.GetData() + Start, FMath::Min(BatchSize, Queued.Num() - Start));
+		InFlight.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[this, Batch = MoveTemp(Batch), bCompress]()
+			{
+				WriteBatch(Batch, bCompress);
+			},
+			Prerequisites));
+	}
+	Queued.Reset();
+	QueuedIndices.Reset();
+}
+
+void FRockInventoryWriteBehindQueue::WaitForCompletion()
+{
+	UE::Tasks::Wait(InFlight);
+	InFlight.Reset();
+}
+
+bool FRockInventoryWriteBehindQueue::HasWritesInFlight() const
+{
+	for (const UE::Tasks::FTask& Task : InFlight)
+	{
+		if (!Task.IsCompleted())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+FRockInventoryWriteBehindStats FRockInventoryWriteBehindQueue::GetStats() const
+{
+	FRockInventoryWriteBehindStats Stats;
+	Stats.InventoriesWritten = InventoriesWritten.load(std::memory_order_relaxed);
+	Stats.BytesWritten = BytesWritten.load(std::memory_order_relaxed);
+	Stats.FailedWrites = FailedWrites.load(std::memory_order_relaxed);
+	Stats.BackgroundSeconds = FPlatformTime::ToSeconds64(BackgroundCycles.load(std::memory_order_relaxed));
+	return Stats;
+}
+
+void FRockInventoryWriteBehindQueue::SetBackend(TSharedRef<IRockInventoryStorageBackend, ESPMode::ThreadSafe> InBackend)
+{
+	check(IsInGameThread());
+	WaitForCompletion();
+	Backend = MoveTemp(InBackend);
+}
+
+void FRockInventoryWriteBehindQueue::WriteBatch(TConstArrayView<FSaveDataRef> Batch, bool bCompress)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	TArray<FRockInventoryStorageRecord> Records;
+	Records.Reserve(Batch.Num());
+	int64 NumBytes = 0;
+	for (const FSaveDataRef& SaveData : Batch)
+	{
+		FRockInventoryStorageRecord& Record = Records.AddDefaulted_GetRef();
+		Record.InventoryId = SaveData->InventoryId;
+		if (!EncodeBlob(*SaveData, bCompress, Record.Bytes))
+		{
+			UE_LOG(LogRockInventory, Error, TEXT("Inventory write-behind: failed to encode %s"), *SaveData->InventoryId.ToString());
+			Records.Pop(EAllowShrinking::No);
+			FailedWrites.fetch_add(1, std::memory_order_relaxed);
+			continue;
+		}
+		NumBytes += Record.Bytes.Num();
+	}
+
+	const int32 NumWritten = Backend->WriteBatch(Records);
+	InventoriesWritten.fetch_add(NumWritten, std::memory_order_relaxed);
+	FailedWrites.fetch_add(Records.Num() - NumWritten, std::memory_order_relaxed);
+	BytesWritten.fetch_add(NumBytes, std::memory_order_relaxed);
+	BackgroundCycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+}
+
+bool FRockInventoryWriteBehindQueue::EncodeBlob(FRockInventorySaveData& SaveData, bool bCompress, TArray<uint8>& OutBytes)
+{
+	using namespace RockInventoryWriteBehind;
+
+	TArray<uint8> SaveBytes;
+	FMemoryWriter Writer(SaveBytes);
+	if (!SaveData.Serialize(Writer))
+	{
+		return false;
+	}
+	if (!bCompress)
+	{
+		OutBytes = MoveTemp(SaveBytes);
+		return true;
+	}
+
+	const int32 UncompressedSize = SaveBytes.Num();
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, UncompressedSize);
+	OutBytes.SetNumUninitialized(CompressedHeaderSize + CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Oodle, OutBytes.GetData() + CompressedHeaderSize, CompressedSize, SaveBytes.GetData(), UncompressedSize))
+	{
+		return false;
+	}
+	OutBytes.SetNum(CompressedHeaderSize + CompressedSize, EAllowShrinking::No);
+
+	FMemoryWriter HeaderWriter(OutBytes);
+	uint32 BlobMagic = CompressedMagic;
+	uint32 BlobUncompressedSize = UncompressedSize;
+	HeaderWriter << BlobMagic << BlobUncompressedSize;
+	return true;
+}
+
+bool FRockInventoryWriteBehindQueue::DecodeBlob(TConstArrayView<uint8> Bytes, TArray<uint8>& OutSaveBytes)
+{
+	using namespace RockInventoryWriteBehind;
+
+	uint32 BlobMagic = 0;
+	uint32 UncompressedSize = 0;
+	FMemoryReaderView Reader(Bytes);
+	Reader << BlobMagic << UncompressedSize;
+	if (Reader.IsError() || BlobMagic != CompressedMagic)
+	{
+		// Uncompressed blobs are plain FRockInventorySaveData
+		OutSaveBytes.Reset(Bytes.Num());
+		OutSaveBytes.Append(Bytes.GetData(), Bytes.Num());
+		return true;
+	}
+
+	const int64 CompressedSize = Bytes.Num() - CompressedHeaderSize;
+	if (UncompressedSize == 0 || UncompressedSize > MaxUncompressedSize || UncompressedSize > CompressedSize * MaxCompressionRatio)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("Inventory snapshot blob claims %u bytes uncompressed from %lld compressed, rejecting it"), UncompressedSize, CompressedSize);
+		return false;
+	}
+	OutSaveBytes.SetNumUninitialized(UncompressedSize);
+	return FCompression::UncompressMemory(NAME_Oodle, OutSaveBytes.GetData(), UncompressedSize,
+		Bytes.GetData() + CompressedHeaderSize, Bytes.Num() - CompressedHeaderSize);
+}
@@ -0,0 +1,38 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "GameFramework/Pawn.h"
+#include "Misc/AutomationTest.h"
+#include "Transactions/Implementations/RockDropItemTransaction.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockDropItemTransactionTest, "RockInventory.Transactions.DropItem",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockDropItemTransactionTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	FScopedTestWorld TestWorld;
+	TestWorld.BeginPlay();
+	URockInventoryManagerComponent* Manager = SpawnManager(TestWorld.World);
+	AController* Controller = Cast<AController>(Manager->GetOwner());
+	URockInventory* Inventory = MakeInventory(4, 1);
+	AddItem(Inventory, MakeWorldDefinition(TEXT("Stone"), 10), 5);
+
+	// Turned down before anything leaves the inventory: there is nowhere to drop it without a pawn
+	const FRockDropItemTransaction Drop(Controller, Inventory, FRockInventorySlotHandle(0));
+	TestFalse(TEXT("No pawn, no drop"), Drop.Execute().bSuccess);
+	TestEqual(TEXT("The stack is still there"), DescribeLayout(Inventory), FString(TEXT("Stone:5 - - - ")));
+
+	Controller->Possess(TestWorld.World->SpawnActor<APawn>());
+	const FRockDropItemUndoTransaction Undo = Drop.Execute();
+	TestTrue(TEXT("Dropped"), Undo.bSuccess);
+	TestTrue(TEXT("Queued for spawning"), Undo.SpawnHandle.IsValid());
+	TestEqual(TEXT("Left the inventory"), DescribeLayout(Inventory), FString(TEXT("- - - - ")));
+	return true;
+}
+
+#endif
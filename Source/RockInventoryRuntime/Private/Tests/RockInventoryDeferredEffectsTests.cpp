@@ -0,0 +1,66 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Inventory/RockInventoryDeferredEffects.h"
+
+#include "Inventory/RockInventory.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RockInventoryDeferredEffectsTests
+{
+	FRockSlotDelta MakeSlotDelta(URockInventory* Inventory, int32 SlotIndex, ERockSlotChangeType ChangeType)
+	{
+		FRockSlotDelta SlotDelta;
+		SlotDelta.Inventory = Inventory;
+		SlotDelta.SlotHandle = FRockInventorySlotHandle(SlotIndex);
+		SlotDelta.ChangeType = ChangeType;
+		return SlotDelta;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryDeferredEffectsCoalesceTest, "RockInventory.Inventory.DeferredEffects.Coalesce",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryDeferredEffectsCoalesceTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryDeferredEffectsTests;
+
+	// Only broadcasts are recorded here, which don't need an initialized inventory
+	URockInventory* Source = NewObject<URockInventory>(GetTransientPackage());
+	URockInventory* Target = NewObject<URockInventory>(GetTransientPackage());
+	const FRockItemStackHandle First = FRockItemStackHandle::Create(0, 1);
+	const FRockItemStackHandle Second = FRockItemStackHandle::Create(1, 1);
+
+	FRockInventoryDeferredEffects Effects;
+	{
+		URockInventory* Inventories[] = {Source, Target};
+		FRockInventoryDeferredEffectsScope Scope(Effects, Inventories);
+		TestTrue(TEXT("Deferring inside the scope"), Source->IsDeferringEffects() && Target->IsDeferringEffects());
+
+		// What a transfer all looks like: the same items and slots touched over and over
+		for (int32 Pass = 0; Pass < 3; ++Pass)
+		{
+			Source->BroadcastItemChanged(First, ERockItemChangeType::Changed);
+			Source->BroadcastItemChanged(Second, ERockItemChangeType::Changed);
+			Source->BroadcastSlotChanged(MakeSlotDelta(Source, 0, ERockSlotChangeType::ItemAdded));
+			Target->BroadcastItemChanged(First, ERockItemChangeType::Added);
+		}
+		Source->BroadcastSlotChanged(MakeSlotDelta(Source, 0, ERockSlotChangeType::ItemRemoved));
+		Source->BroadcastSlotChanged(MakeSlotDelta(Source, 1, ERockSlotChangeType::ItemAdded));
+	}
+	TestFalse(TEXT("Not deferring after the scope"), Source->IsDeferringEffects() || Target->IsDeferringEffects());
+	TestEqual(TEXT("Everything was recorded"), Effects.Num(), 14);
+
+	Effects.Coalesce();
+	// Two items and two slots in Source, the same handle in Target is a different item
+	TestEqual(TEXT("One broadcast per item and slot"), Effects.Num(), 5);
+	Effects.Coalesce();
+	TestEqual(TEXT("Coalescing twice changes nothing"), Effects.Num(), 5);
+
+	Effects.Apply();
+	TestTrue(TEXT("Apply resets"), Effects.IsEmpty());
+	return true;
+}
+
+#endif
@@ -0,0 +1,136 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Persistence/RockInventoryJournal.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RockInventoryJournalTests
+{
+	/** A fresh directory per test, removed again with the scope */
+	struct FScopedJournalDirectory
+	{
+		FString Directory = FPaths::AutomationTransientDir() / TEXT("RockInventoryJournal") / FGuid::NewGuid().ToString();
+		~FScopedJournalDirectory() { IFileManager::Get().DeleteDirectory(*Directory, false, true); }
+		FString GetFilename() const { return Directory / TEXT("Inventory.journal"); }
+	};
+
+	FRockInventoryJournalRecord MakeRecord(const FGuid& InventoryId, int32 StackCount)
+	{
+		FRockInventoryJournalRecord Record;
+		Record.InventoryId = InventoryId;
+		Record.ItemIndices.Add(0);
+		FRockItemStackSaveData& Item = Record.Items.AddDefaulted_GetRef();
+		Item.ItemId = TEXT("Arrow");
+		Item.StackCount = StackCount;
+		Item.bValid = true;
+		return Record;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryJournalRoundTripTest, "RockInventory.Persistence.Journal.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryJournalRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryJournalTests;
+
+	const FScopedJournalDirectory Scope;
+	const FGuid InventoryId = FGuid::NewGuid();
+	{
+		FRockInventoryJournal Journal;
+		if (!TestTrue(TEXT("Opens a new journal"), Journal.Open(Scope.GetFilename(), true)))
+		{
+			return false;
+		}
+		for (int32 StackCount = 1; StackCount <= 3; ++StackCount)
+		{
+			FRockInventoryJournalRecord Record = MakeRecord(InventoryId, StackCount);
+			TestTrue(TEXT("Appends"), Journal.Append(Record));
+		}
+		TestEqual(TEXT("Record count"), Journal.GetNumRecords(), 3);
+	}
+
+	// Reopening continues the sequence behind the existing records
+	FRockInventoryJournal Journal;
+	TArray<FRockInventoryJournalRecord> Existing;
+	if (!TestTrue(TEXT("Reopens"), Journal.Open(Scope.GetFilename(), true, &Existing)) || !TestEqual(TEXT("Recovered records"), Existing.Num(), 3))
+	{
+		return false;
+	}
+	for (int32 Index = 0; Index < Existing.Num(); ++Index)
+	{
+		TestEqual(TEXT("Sequence"), Existing[Index].Sequence, static_cast<uint64>(Index + 1));
+		TestEqual(TEXT("InventoryId"), Existing[Index].InventoryId, InventoryId);
+		TestTrue(TEXT("After-image"), Existing[Index].Items.Num() == 1 && Existing[Index].Items[0].StackCount == Index + 1);
+	}
+	FRockInventoryJournalRecord Next = MakeRecord(InventoryId, 4);
+	Journal.Append(Next);
+	TestEqual(TEXT("Sequence continues"), Next.Sequence, static_cast<uint64>(4));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryJournalTornTailTest, "RockInventory.Persistence.Journal.TornTail",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryJournalTornTailTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryJournalTests;
+
+	const FScopedJournalDirectory Scope;
+	int64 IntactSize = 0;
+	{
+		FRockInventoryJournal Journal;
+		Journal.Open(Scope.GetFilename(), true);
+		FRockInventoryJournalRecord Record = MakeRecord(FGuid::NewGuid(), 1);
+		Journal.Append(Record);
+		IntactSize = Journal.GetSize();
+	}
+	// What a crash halfway through writing the next frame leaves behind
+	const TArray<uint8> Garbage = {0x40, 0x00, 0x00, 0x00, 0xDE, 0xAD};
+	FFileHelper::SaveArrayToFile(Garbage, *Scope.GetFilename(), &IFileManager::Get(), FILEWRITE_Append);
+
+	AddExpectedMessage(TEXT("torn/corrupt tail"), EAutomationExpectedMessageFlags::Contains, 1);
+	FRockInventoryJournal Journal;
+	TArray<FRockInventoryJournalRecord> Existing;
+	TestTrue(TEXT("Opens"), Journal.Open(Scope.GetFilename(), true, &Existing));
+	TestEqual(TEXT("Intact record is recovered"), Existing.Num(), 1);
+	TestEqual(TEXT("Tail is cut off"), Journal.GetSize(), IntactSize);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryJournalRejectedHeaderTest, "RockInventory.Persistence.Journal.RejectedHeader",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryJournalRejectedHeaderTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryJournalTests;
+
+	const FScopedJournalDirectory Scope;
+	const TArray<uint8> Foreign = {'N', 'O', 'T', 'A', 'J', 'O', 'U', 'R', 'N', 'A', 'L'};
+	FFileHelper::SaveArrayToFile(Foreign, *Scope.GetFilename());
+
+	AddExpectedMessage(TEXT("unknown magic/version"), EAutomationExpectedMessageFlags::Contains, 1);
+	AddExpectedMessage(TEXT("unreadable header, moved it"), EAutomationExpectedMessageFlags::Contains, 1);
+	FRockInventoryJournal Journal;
+	TestTrue(TEXT("Opens a new journal"), Journal.Open(Scope.GetFilename(), true));
+	TestEqual(TEXT("New journal is just a header"), Journal.GetSize(), FRockInventoryJournal::HeaderSize);
+
+	// The old file is kept next to it, untouched
+	TArray<FString> Rejected;
+	IFileManager::Get().FindFiles(Rejected, *(Scope.Directory / TEXT("Inventory.journal.rejected-*")), true, false);
+	if (!TestEqual(TEXT("Moved aside"), Rejected.Num(), 1))
+	{
+		return false;
+	}
+	TArray<uint8> RejectedBytes;
+	FFileHelper::LoadFileToArray(RejectedBytes, *(Scope.Directory / Rejected[0]));
+	TestTrue(TEXT("Moved file is unchanged"), RejectedBytes == Foreign);
+	return true;
+}
+
+#endif
@@ -0,0 +1,219 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "Async/ParallelFor.h"
+#include "Inventory/RockInventoryDeferredEffects.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "Transactions/Core/RockInventoryTransactionQueueSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RockParallelExecutionTests
+{
+	/**
+	 * Runs the same burst of moves, sorts and transfer-alls from four controllers through the transaction queue, some on their own
+	 * inventories and some on two shared ones. Returns everything the players could observe, one line each: the layouts,
+	 * every transaction's result and each controller's history. Empty if the queue isn't available.
+	 */
+	TArray<FString> RunQueuedBurst(bool bParallel, int64& OutParallelWaves)
+	{
+		using namespace RockInventoryTests;
+
+		URockInventoryDeveloperSettings* Settings = GetMutableDefault<URockInventoryDeveloperSettings>();
+		TGuardValue<bool> RateLimitGuard(Settings->bEnableTransactionRateLimiting, false);
+		TGuardValue<bool> QueueGuard(Settings->bEnableTransactionQueue, true);
+		TGuardValue<bool> ParallelGuard(Settings->bParallelTransactionExecution, bParallel);
+		TGuardValue<int32> MinGroupsGuard(Settings->MinParallelTransactionGroups, 2);
+		FScopedTestWorld TestWorld;
+		TestWorld.BeginPlay();
+		URockInventoryTransactionQueueSubsystem* Queue = TestWorld.World->GetSubsystem<URockInventoryTransactionQueueSubsystem>();
+		if (!Queue || !Queue->IsEnabled())
+		{
+			return {};
+		}
+
+		URockItemDefinition* Definitions[] = {
+			MakeDefinition(TEXT("Arrow"), 60, FIntPoint(1, 1), 1),
+			MakeDefinition(TEXT("Rifle"), 1, FIntPoint(2, 1), 500),
+			MakeDefinition(TEXT("Apple"), 10, FIntPoint(1, 1), 5),
+			MakeDefinition(TEXT("Gem"), 5, FIntPoint(1, 1), 50),
+		};
+		constexpr int32 NumControllers = 4;
+		TArray<URockInventoryManagerComponent*> Managers;
+		TArray<URockInventory*> Inventories;
+		for (int32 ControllerIndex = 0; ControllerIndex < NumControllers; ++ControllerIndex)
+		{
+			Managers.Add(SpawnManager(TestWorld.World));
+			URockInventory* Backpack = MakeInventory(6, 2);
+			for (int32 ItemIndex = 0; ItemIndex < 4 + ControllerIndex; ++ItemIndex)
+			{
+				AddItem(Backpack, Definitions[(ItemIndex * 3 + ControllerIndex) % UE_ARRAY_COUNT(Definitions)], ItemIndex + 1);
+			}
+			Inventories.Add(Backpack);
+		}
+		URockInventory* Crate = Inventories.Add_GetRef(MakeInventory(6, 2));
+		AddItem(Crate, Definitions[0], 30);
+		AddItem(Crate, Definitions[3], 2);
+		URockInventory* Chest = Inventories.Add_GetRef(MakeInventory(6, 2));
+
+		TMap<int32, ERockTransactionExecuteResult> Results;
+		for (URockInventoryManagerComponent* Manager : Managers)
+		{
+			Manager->OnQueuedTransactionFinished.AddLambda([&Results](const FInstancedStruct& Transaction, ERockTransactionExecuteResult Result)
+			{
+				Results.Add(Transaction.Get<FRockItemTransactionBase>().TransactionID, Result);
+			});
+		}
+
+		// Straight into the queue as the RPCs would, with ids that are the same in both runs
+		int32 NextTransactionID = 1;
+		auto Enqueue = [&](int32 ControllerIndex, auto Transaction)
+		{
+			Transaction.TransactionID = NextTransactionID++;
+			Queue->Enqueue(Managers[ControllerIndex], FInstancedStruct::Make(Transaction));
+		};
+		auto Controller = [&Managers](int32 ControllerIndex) { return Cast<AController>(Managers[ControllerIndex]->GetOwner()); };
+		FRockInventorySortParams SortParams;
+		SortParams.SortKeys = {ERockInventorySortKey::Value};
+
+		// Interleaved as they would arrive. The shared crate and chest make some controllers wait on others
+		Enqueue(0, MakeMove(Managers[0], Inventories[0], 0, 11));
+		Enqueue(1, MakeMove(Managers[1], Inventories[1], 0, 10));
+		Enqueue(2, FRockSortInventoryTransaction(Controller(2), Inventories[2], SortParams));
+		Enqueue(3, FRockTransferAllTransaction(Controller(3), Inventories[3], Chest));
+		Enqueue(0, FRockSortInventoryTransaction(Controller(0), Inventories[0], SortParams));
+		Enqueue(1, FRockTransferAllTransaction(Controller(1), Crate, Inventories[1]));
+		Enqueue(2, MakeMove(Managers[2], Inventories[2], 1, 9, 1));
+		Enqueue(3, FRockSortInventoryTransaction(Controller(3), Chest, SortParams));
+		Enqueue(0, FRockTransferAllTransaction(Controller(0), Inventories[0], Crate));
+		Enqueue(1, FRockSortInventoryTransaction(Controller(1), Inventories[1], SortParams));
+		Enqueue(2, FRockTransferAllTransaction(Controller(2), Inventories[2], Chest));
+		Enqueue(3, MakeMove(Managers[3], Chest, 0, 5));
+		// Backpack 0 was just transferred out, nothing is left to move
+		Enqueue(0, MakeMove(Managers[0], Inventories[0], 3, 4));
+		Enqueue(1, MakeMove(Managers[1], Crate, 0, 1));
+		Enqueue(2, FRockSortInventoryTransaction(Controller(2), Inventories[2], SortParams));
+		Enqueue(3, FRockTransferAllTransaction(Controller(3), Chest, Inventories[3]));
+
+		for (int32 Pass = 0; Pass < 100 && Queue->GetNumQueued() > 0; ++Pass)
+		{
+			Queue->ProcessQueue(1.0);
+		}
+		OutParallelWaves = Queue->GetStats().ParallelWaves;
+
+		TArray<FString> Observed;
+		for (int32 InventoryIndex = 0; InventoryIndex < Inventories.Num(); ++InventoryIndex)
+		{
+			Observed.Add(FString::Printf(TEXT("Inventory %d: %s"), InventoryIndex, *DescribeLayout(Inventories[InventoryIndex])));
+		}
+		// Groups commit one after the other, so only the per controller order is fixed
+		Results.KeySort(TLess<int32>());
+		for (const TPair<int32, ERockTransactionExecuteResult>& Result : Results)
+		{
+			Observed.Add(FString::Printf(TEXT("Transaction %d: %d"), Result.Key, static_cast<int32>(Result.Value)));
+		}
+		for (int32 ControllerIndex = 0; ControllerIndex < NumControllers; ++ControllerIndex)
+		{
+			const FRockInventoryTransactionHistory& History = Managers[ControllerIndex]->GetTransactionHistory();
+			FString Line = FString::Printf(TEXT("History %d:"), ControllerIndex);
+			for (int32 Index = 0; Index < History.Num(); ++Index)
+			{
+				Line += FString::Printf(TEXT(" %d"), History[Index].Command.Get<FRockItemTransactionBase>().TransactionID);
+			}
+			Observed.Add(Line);
+		}
+		return Observed;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryParallelSortTest, "RockInventory.Inventory.ParallelExecution.Sort",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryParallelSortTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	URockItemDefinition* Definitions[] = {
+		MakeDefinition(TEXT("Arrow"), 60, FIntPoint(1, 1), 1),
+		MakeDefinition(TEXT("Rifle"), 1, FIntPoint(2, 1), 500),
+		MakeDefinition(TEXT("Apple"), 10, FIntPoint(1, 1), 5),
+		MakeDefinition(TEXT("Crate"), 1, FIntPoint(2, 2), 50),
+	};
+
+	// Unrelated inventories with different contents, each with a twin sorted on the game thread for reference
+	constexpr int32 NumInventories = 8;
+	TArray<URockInventory*> Inventories;
+	TArray<FString> ExpectedLayouts;
+	FRockInventorySortParams Params;
+	Params.SortKeys = {ERockInventorySortKey::Value};
+	for (int32 InventoryIndex = 0; InventoryIndex < NumInventories; ++InventoryIndex)
+	{
+		URockInventory* Inventory = MakeInventory(6, 6);
+		URockInventory* Reference = MakeInventory(6, 6);
+		for (int32 ItemIndex = 0; ItemIndex < 6 + InventoryIndex; ++ItemIndex)
+		{
+			URockItemDefinition* Definition = Definitions[(ItemIndex * 3 + InventoryIndex) % UE_ARRAY_COUNT(Definitions)];
+			AddItem(Inventory, Definition, ItemIndex + 1);
+			AddItem(Reference, Definition, ItemIndex + 1);
+		}
+		URockInventoryLibrary::SortInventory(Reference, Params, nullptr);
+		Inventories.Add(Inventory);
+		ExpectedLayouts.Add(DescribeLayout(Reference));
+	}
+
+	// What a parallel wave does: each group runs on a worker with its effects held back, then they're applied here
+	TArray<FRockInventoryDeferredEffects> Effects;
+	Effects.SetNum(NumInventories);
+	TArray<bool> Sorted;
+	Sorted.SetNumZeroed(NumInventories);
+	ParallelFor(NumInventories, [&](int32 InventoryIndex)
+	{
+		URockInventory* Inventory = Inventories[InventoryIndex];
+		FRockInventoryDeferredEffectsScope Scope(Effects[InventoryIndex], MakeArrayView(&Inventory, 1));
+		Sorted[InventoryIndex] = URockInventoryLibrary::SortInventory(Inventory, Params, nullptr);
+	});
+
+	for (int32 InventoryIndex = 0; InventoryIndex < NumInventories; ++InventoryIndex)
+	{
+		TestTrue(TEXT("Sorted on a worker"), Sorted[InventoryIndex]);
+		TestFalse(TEXT("No longer deferring"), Inventories[InventoryIndex]->IsDeferringEffects());
+		TestFalse(TEXT("Side effects were held back"), Effects[InventoryIndex].IsEmpty());
+		Effects[InventoryIndex].Coalesce();
+		Effects[InventoryIndex].Apply();
+		TestEqual(TEXT("Same result as on the game thread"), DescribeLayout(Inventories[InventoryIndex]), ExpectedLayouts[InventoryIndex]);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryParallelQueueTest, "RockInventory.Inventory.ParallelExecution.QueueWaves",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryParallelQueueTest::RunTest(const FString& Parameters)
+{
+	using namespace RockParallelExecutionTests;
+
+	int64 SerialWaves = 0;
+	int64 ParallelWaves = 0;
+	const TArray<FString> Serial = RunQueuedBurst(false, SerialWaves);
+	const TArray<FString> Parallel = RunQueuedBurst(true, ParallelWaves);
+	if (!TestFalse(TEXT("The queue ran the burst"), Serial.IsEmpty() || Parallel.IsEmpty()))
+	{
+		return false;
+	}
+	TestEqual(TEXT("No waves with parallel execution off"), SerialWaves, static_cast<int64>(0));
+	TestTrue(TEXT("Waves ran on workers"), ParallelWaves > 0);
+
+	if (!TestEqual(TEXT("Same observations"), Parallel.Num(), Serial.Num()))
+	{
+		return false;
+	}
+	for (int32 Index = 0; Index < Serial.Num(); ++Index)
+	{
+		TestEqual(TEXT("Same as executing one by one on the game thread"), Parallel[Index], Serial[Index]);
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,214 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "Inventory/RockInventoryResyncData.h"
+#include "Inventory/RockInventoryShadowState.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RockPredictionTests
+{
+	/**
+	 * A client and the server it talks to, in one standalone world. The client's manager isn't the authority, so its moves are
+	 * predicted and its server RPCs are dropped. The test plays the server: it executes the moves on Server, answers through
+	 * Client_TransactionResult and replicates with Replicate, in whatever order the case needs
+	 */
+	struct FClientServer
+	{
+		FClientServer()
+		{
+			TestWorld.BeginPlay();
+			Manager = RockInventoryTests::SpawnManager(TestWorld.World);
+			Manager->GetOwner()->SetRole(ROLE_AutonomousProxy);
+
+			// Same contents on both sides: stones in the first slot, apples in the second
+			URockItemDefinition* Stone = RockInventoryTests::MakeDefinition(TEXT("Stone"), 10);
+			URockItemDefinition* Apple = RockInventoryTests::MakeDefinition(TEXT("Apple"), 10);
+			auto MakeSide = [Stone, Apple]()
+			{
+				URockInventory* Inventory = RockInventoryTests::MakeInventory(5, 1);
+				RockInventoryTests::AddItem(Inventory, Stone, 5);
+				RockInventoryTests::AddItem(Inventory, Apple, 2);
+				return Inventory;
+			};
+			Server = MakeSide();
+			Client = MakeSide();
+		}
+
+		/** Predicted on the client, returns the id the server answers with */
+		int32 Predict(int32 SourceSlot, int32 TargetSlot, int32 MoveCount = -1)
+		{
+			const FRockMoveItemTransaction Move = RockInventoryTests::MakeMove(Manager, Client, SourceSlot, TargetSlot, MoveCount);
+			Manager->MoveItem(Move);
+			return Move.TransactionID;
+		}
+
+		void ExecuteOnServer(int32 SourceSlot, int32 TargetSlot, int32 MoveCount = -1)
+		{
+			RockInventoryTests::MakeMove(Manager, Server, SourceSlot, TargetSlot, MoveCount).Execute();
+		}
+
+		/** What the inventory's replication does: the server's entries written over the client's, then OnDataReplicated */
+		void Replicate()
+		{
+			FRockInventoryResyncData Data;
+			Server->BuildResyncData(FRockInventoryResyncData::AllSections, Data);
+			Client->ApplyResyncData(Data);
+		}
+
+		RockInventoryTests::FScopedTestWorld TestWorld;
+		URockInventoryManagerComponent* Manager = nullptr;
+		URockInventory* Server = nullptr;
+		URockInventory* Client = nullptr;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryFreeItemIndexTest, "RockInventory.Inventory.Prediction.FreeItemIndex",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryFreeItemIndexTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	URockItemDefinition* Stone = MakeDefinition(TEXT("Stone"));
+	URockInventory* Inventory = MakeInventory(4, 4);
+	AddItem(Inventory, Stone);
+	AddItem(Inventory, Stone);
+	const FRockItemStackHandle Third = AddItem(Inventory, Stone);
+	const FRockItemStackHandle First = Inventory->GetSlotByHandle(FRockInventorySlotHandle(0)).ItemHandle;
+	TestTrue(TEXT("Indices handed out in order"), First.GetIndex() == 0 && Third.GetIndex() == 2);
+
+	// Freed out of order, the lowest comes back first whatever the removal order was
+	Inventory->RemoveItemFromInventory(Third);
+	Inventory->RemoveItemFromInventory(First);
+	TestEqual(TEXT("Predicts the lowest free index"), Inventory->FindFreeItemIndex(), 0);
+
+	const FRockItemStackHandle Reused = AddItem(Inventory, Stone);
+	TestEqual(TEXT("Server reuses the predicted index"), Reused.GetIndex(), 0);
+	TestTrue(TEXT("Reused with a new generation"), Reused.GetGeneration() != First.GetGeneration());
+	TestEqual(TEXT("Then the next lowest"), Inventory->FindFreeItemIndex(), 2);
+	TestEqual(TEXT("Server agrees again"), AddItem(Inventory, Stone).GetIndex(), 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryShadowStateTest, "RockInventory.Inventory.Prediction.ShadowState",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryShadowStateTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	URockItemDefinition* Stone = MakeDefinition(TEXT("Stone"), 5);
+	URockItemDefinition* Plank = MakeDefinition(TEXT("Plank"), 1, FIntPoint(2, 1));
+	URockInventory* Inventory = MakeInventory(4, 4);
+	AddItem(Inventory, Stone, 3);
+	AddItem(Inventory, Plank);
+
+	FRockInventoryShadowState Shadow;
+	Inventory->CaptureShadowState(Shadow);
+	const FString Layout = DescribeLayout(Inventory);
+	const int32 FreeIndex = Inventory->FindFreeItemIndex();
+
+	// What a rejected prediction leaves behind: removing the plank (right after the stones), a merge and an add into the freed index
+	URockInventoryLibrary::SplitItemStackAtLocation(Inventory, FRockInventorySlotHandle(1));
+	AddItem(Inventory, Stone, 2);
+	AddItem(Inventory, Plank);
+	TestNotEqual(TEXT("Changed after the capture"), DescribeLayout(Inventory), Layout);
+
+	Inventory->RestoreShadowState(Shadow);
+	TestEqual(TEXT("Slots and items are rolled back"), DescribeLayout(Inventory), Layout);
+	TestEqual(TEXT("Free indices are rolled back"), Inventory->FindFreeItemIndex(), FreeIndex);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryPredictionOutOfOrderTest, "RockInventory.Inventory.Prediction.OutOfOrderConfirms",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryPredictionOutOfOrderTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	RockPredictionTests::FClientServer Net;
+	const int32 First = Net.Predict(0, 2);
+	const int32 Second = Net.Predict(1, 3);
+	TestEqual(TEXT("Both in flight"), Net.Manager->GetNumPendingPredictions(), 2);
+	TestEqual(TEXT("Applied right away"), DescribeLayout(Net.Client), FString(TEXT("- - Stone:5 Apple:2 - ")));
+
+	Net.ExecuteOnServer(0, 2);
+	Net.ExecuteOnServer(1, 3);
+	Net.Manager->Client_TransactionResult(Second, true);
+	TestEqual(TEXT("Later one confirmed first"), Net.Manager->GetNumPendingPredictions(), 1);
+	TestEqual(TEXT("Nothing moves"), DescribeLayout(Net.Client), DescribeLayout(Net.Server));
+	Net.Manager->Client_TransactionResult(First, true);
+	TestEqual(TEXT("All confirmed"), Net.Manager->GetNumPendingPredictions(), 0);
+	TestEqual(TEXT("Still nothing moves"), DescribeLayout(Net.Client), DescribeLayout(Net.Server));
+
+	Net.Replicate();
+	TestEqual(TEXT("Replication agrees"), DescribeLayout(Net.Client), DescribeLayout(Net.Server));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryPredictionRejectedTest, "RockInventory.Inventory.Prediction.RejectedBehindConfirmed",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryPredictionRejectedTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	RockPredictionTests::FClientServer Net;
+	const int32 Split = Net.Predict(0, 2, 2);
+	const int32 Move = Net.Predict(1, 3);
+	TestEqual(TEXT("Predicted"), DescribeLayout(Net.Client), FString(TEXT("Stone:3 - Stone:2 Apple:2 - ")));
+
+	// Someone else took the apple first, so the server only accepts the split
+	Net.ExecuteOnServer(1, 4);
+	Net.ExecuteOnServer(0, 2, 2);
+	Net.Manager->Client_TransactionResult(Split, true);
+	TestEqual(TEXT("Confirming keeps the rest predicted"), DescribeLayout(Net.Client), FString(TEXT("Stone:3 - Stone:2 Apple:2 - ")));
+
+	AddExpectedMessage(TEXT("was rejected, rolling back"), EAutomationExpectedMessageFlags::Contains, 1);
+	Net.Manager->Client_TransactionResult(Move, false);
+	TestEqual(TEXT("Nothing in flight"), Net.Manager->GetNumPendingPredictions(), 0);
+	TestEqual(TEXT("Confirmed split kept, rejected move undone"), DescribeLayout(Net.Client), FString(TEXT("Stone:3 Apple:2 Stone:2 - - ")));
+
+	Net.Replicate();
+	TestEqual(TEXT("Replication brings the other player's move"), DescribeLayout(Net.Client), DescribeLayout(Net.Server));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryPredictionReplicatedFirstTest, "RockInventory.Inventory.Prediction.ReplicatedBeforeResult",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryPredictionReplicatedFirstTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	// The outcome replicates before the answer: applied once, not split a second time on top of the replicated split
+	{
+		RockPredictionTests::FClientServer Net;
+		const int32 Split = Net.Predict(0, 2, 2);
+		Net.ExecuteOnServer(0, 2, 2);
+		Net.Replicate();
+		TestEqual(TEXT("Still in flight"), Net.Manager->GetNumPendingPredictions(), 1);
+		TestEqual(TEXT("Split once"), DescribeLayout(Net.Client), FString(TEXT("Stone:3 Apple:2 Stone:2 - - ")));
+		Net.Manager->Client_TransactionResult(Split, true);
+		TestEqual(TEXT("Confirming doesn't split again"), DescribeLayout(Net.Client), DescribeLayout(Net.Server));
+	}
+
+	// The replicated outcome was already changed further by the server, the answer settles on it
+	{
+		RockPredictionTests::FClientServer Net;
+		const int32 Split = Net.Predict(0, 2, 2);
+		Net.ExecuteOnServer(0, 2, 2);
+		Net.Server->SetItemStackCount(Net.Server->GetSlotByHandle(FRockInventorySlotHandle(2)).ItemHandle, 4);
+		Net.Replicate();
+		Net.Manager->Client_TransactionResult(Split, true);
+		TestEqual(TEXT("Settles on the server's state"), DescribeLayout(Net.Client), FString(TEXT("Stone:3 Apple:2 Stone:4 - - ")));
+		TestEqual(TEXT("Nothing in flight"), Net.Manager->GetNumPendingPredictions(), 0);
+	}
+	return true;
+}
+
+#endif
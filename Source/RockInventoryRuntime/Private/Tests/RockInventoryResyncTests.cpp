@@ -0,0 +1,57 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "Inventory/RockInventoryResyncData.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryResyncTest, "RockInventory.Inventory.Resync",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryResyncTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	URockItemDefinition* Stone = MakeDefinition(TEXT("Stone"));
+	URockItemDefinition* Coin = MakeDefinition(TEXT("Coin"), 50);
+
+	// Two 2x2 sections with the same contents: four stones fill the first, the coins go to the second
+	URockInventory* Server = MakeInventory(2, 2, 2);
+	URockInventory* Client = MakeInventory(2, 2, 2);
+	for (URockInventory* Inventory : {Server, Client})
+	{
+		for (int32 Count = 0; Count < 4; ++Count)
+		{
+			AddItem(Inventory, Stone);
+		}
+		AddItem(Inventory, Coin, 10);
+	}
+	TestEqual(TEXT("Start in sync"), DescribeLayout(Client), DescribeLayout(Server));
+
+	// The client misses a removal in the first section and a count change in the second
+	URockInventoryLibrary::SplitItemStackAtLocation(Server, FRockInventorySlotHandle(1));
+	Server->SetItemStackCount(Server->GetSlotByHandle(FRockInventorySlotHandle(4)).ItemHandle, 20);
+	TestEqual(TEXT("Server layout"), DescribeLayout(Server), FString(TEXT("Stone:1 - Stone:1 Stone:1 Coin:20 - - - ")));
+
+	FRockInventoryResyncData FirstSection;
+	Server->BuildResyncData(1u << 0, FirstSection);
+	TestEqual(TEXT("Only the selected section is sent"), FirstSection.Slots.Num(), 4);
+	Client->ApplyResyncData(FirstSection);
+	TestEqual(TEXT("Selected section synced, the other untouched"), DescribeLayout(Client),
+		FString(TEXT("Stone:1 - Stone:1 Stone:1 Coin:10 - - - ")));
+
+	FRockInventoryResyncData Everything;
+	Server->BuildResyncData(FRockInventoryResyncData::AllSections, Everything);
+	Client->ApplyResyncData(Everything);
+	TestEqual(TEXT("Fully synced"), DescribeLayout(Client), DescribeLayout(Server));
+	TestEqual(TEXT("Client predicts the index the server reuses next"), Client->FindFreeItemIndex(), Server->FindFreeItemIndex());
+
+	// Applying the same data again is a no-op
+	Client->ApplyResyncData(Everything);
+	TestEqual(TEXT("Idempotent"), DescribeLayout(Client), DescribeLayout(Server));
+	return true;
+}
+
+#endif
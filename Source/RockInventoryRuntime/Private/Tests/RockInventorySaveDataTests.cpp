@@ -0,0 +1,260 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+#include "Persistence/RockInventorySaveData.h"
+
+#include "Item/ItemRegistry/RockItemDefinitionRegistry.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RockInventorySaveDataTests
+{
+	FRockItemStackSaveData MakeItem(FName ItemId, int32 StackCount, uint8 Generation, int32 CustomValue1 = 0)
+	{
+		FRockItemStackSaveData Item;
+		Item.ItemId = ItemId;
+		Item.StackCount = StackCount;
+		Item.Generation = Generation;
+		Item.CustomValue1 = CustomValue1;
+		Item.bValid = true;
+		Item.bInitialized = true;
+		return Item;
+	}
+
+	FRockInventorySaveData MakeSaveData()
+	{
+		FRockInventorySaveData SaveData;
+		SaveData.InventoryId = FGuid::NewGuid();
+		SaveData.Items.Add(MakeItem(TEXT("Arrow"), 42, 3));
+		// A freed index, kept so the item indices stay stable
+		SaveData.Items.AddDefaulted();
+		SaveData.Items.Add(MakeItem(TEXT("Arrow"), 7, 1, -5));
+		SaveData.Items.Add(MakeItem(TEXT("Sword"), 1, 0));
+
+		SaveData.Slots.SetNum(4);
+		for (int32 SlotIndex = 0; SlotIndex < SaveData.Slots.Num(); ++SlotIndex)
+		{
+			SaveData.Slots[SlotIndex].SlotHandle = FRockInventorySlotHandle(SlotIndex);
+		}
+		SaveData.Slots[0].ItemHandle = FRockItemStackHandle::Create(0, 3);
+		SaveData.Slots[2].ItemHandle = FRockItemStackHandle::Create(2, 1);
+		SaveData.Slots[2].Orientation = ERockItemOrientation::Vertical;
+		SaveData.Slots[3].ItemHandle = FRockItemStackHandle::Create(3, 0);
+		SaveData.Slots[3].bIsLocked = true;
+		return SaveData;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventorySaveDataRoundTripTest, "RockInventory.Persistence.SaveData.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventorySaveDataRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventorySaveDataTests;
+
+	FRockInventorySaveData SaveData = MakeSaveData();
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	TestTrue(TEXT("Saves"), SaveData.Serialize(Writer));
+
+	FRockInventorySaveData Loaded;
+	FMemoryReader Reader(Bytes);
+	if (!TestTrue(TEXT("Loads"), Loaded.Serialize(Reader)))
+	{
+		return false;
+	}
+	TestEqual(TEXT("InventoryId"), Loaded.InventoryId, SaveData.InventoryId);
+	if (!TestEqual(TEXT("Item count"), Loaded.Items.Num(), SaveData.Items.Num())
+		|| !TestEqual(TEXT("Slot count"), Loaded.Slots.Num(), SaveData.Slots.Num()))
+	{
+		return false;
+	}
+	for (int32 Index = 0; Index < SaveData.Items.Num(); ++Index)
+	{
+		const FRockItemStackSaveData& Expected = SaveData.Items[Index];
+		const FRockItemStackSaveData& Actual = Loaded.Items[Index];
+		TestEqual(FString::Printf(TEXT("Item %d valid"), Index), Actual.bValid, Expected.bValid);
+		if (Expected.bValid)
+		{
+			TestEqual(FString::Printf(TEXT("Item %d ItemId"), Index), Actual.ItemId, Expected.ItemId);
+			TestEqual(FString::Printf(TEXT("Item %d StackCount"), Index), Actual.StackCount, Expected.StackCount);
+			TestEqual(FString::Printf(TEXT("Item %d Generation"), Index), Actual.Generation, Expected.Generation);
+			TestEqual(FString::Printf(TEXT("Item %d CustomValue1"), Index), Actual.CustomValue1, Expected.CustomValue1);
+		}
+	}
+	// Slot item handles are stored as indices only, the generation comes back from the items
+	for (int32 Index = 0; Index < SaveData.Slots.Num(); ++Index)
+	{
+		TestTrue(FString::Printf(TEXT("Slot %d"), Index), Loaded.Slots[Index] == SaveData.Slots[Index]);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventorySaveDataVersionTest, "RockInventory.Persistence.SaveData.RejectsUnknownVersion",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventorySaveDataVersionTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventorySaveDataTests;
+
+	FRockInventorySaveData SaveData = MakeSaveData();
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	SaveData.Serialize(Writer);
+
+	// The version follows the magic, a newer writer's data must not be misread
+	uint32 NewerVersion = static_cast<uint32>(ERockInventorySaveVersion::LatestVersion) + 1;
+	FMemory::Memcpy(Bytes.GetData() + sizeof(uint32), &NewerVersion, sizeof(uint32));
+
+	AddExpectedMessage(TEXT("unknown magic/version"), EAutomationExpectedMessageFlags::Contains, 1);
+	FRockInventorySaveData Loaded;
+	FMemoryReader Reader(Bytes);
+	TestFalse(TEXT("Newer version is rejected"), Loaded.Serialize(Reader));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventorySaveDataBoundedCountsTest, "RockInventory.Persistence.SaveData.BoundsCounts",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventorySaveDataBoundedCountsTest::RunTest(const FString& Parameters)
+{
+	// A valid header followed by section counts the data can't back
+	for (const uint32 BogusCount : {1u << 19, 0xFFFFFFFFu})
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		uint32 Magic = FRockInventorySaveData::Magic;
+		uint32 Version = static_cast<uint32>(ERockInventorySaveVersion::LatestVersion);
+		FGuid InventoryId = FGuid::NewGuid();
+		uint32 NumSections = BogusCount;
+		Writer << Magic << Version << InventoryId;
+		Writer.SerializeIntPacked(NumSections);
+
+		AddExpectedMessage(TEXT("elements can't fit"), EAutomationExpectedMessageFlags::Contains, 1);
+		FRockInventorySaveData Loaded;
+		FMemoryReader Reader(Bytes);
+		TestFalse(FString::Printf(TEXT("%u sections are rejected"), BogusCount), Loaded.Serialize(Reader));
+		TestEqual(TEXT("Nothing was allocated for them"), Loaded.Sections.Num(), 0);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventorySaveDataRestoreValidationTest, "RockInventory.Persistence.SaveData.RestoreValidation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventorySaveDataRestoreValidationTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+	using namespace RockInventorySaveDataTests;
+
+	URockInventory* Inventory = MakeInventory(2, 2);
+	AddItem(Inventory, MakeDefinition(TEXT("Stone"), 10), 5);
+	const FString Layout = DescribeLayout(Inventory);
+
+	// MakeSaveData has 4 slots and 4 items
+	FRockInventorySaveData NoSections = MakeSaveData();
+
+	FRockInventorySaveData WrongSize = MakeSaveData();
+	WrongSize.Sections.Add(FRockInventorySectionInfo(FGameplayTag(), 0, 3, 3));
+
+	FRockInventorySaveData Gap = MakeSaveData();
+	Gap.Sections.Add(FRockInventorySectionInfo(FGameplayTag(), 0, 1, 2));
+	Gap.Sections.Add(FRockInventorySectionInfo(FGameplayTag(), 3, 1, 2));
+
+	FRockInventorySaveData MissingItem = MakeSaveData();
+	MissingItem.Sections.Add(FRockInventorySectionInfo(FGameplayTag(), 0, 2, 2));
+	MissingItem.Slots[1].ItemHandle = FRockItemStackHandle::Create(MissingItem.Items.Num(), 0);
+
+	AddExpectedMessage(TEXT("Sections cover"), EAutomationExpectedMessageFlags::Contains, 2);
+	AddExpectedMessage(TEXT("doesn't start at slot"), EAutomationExpectedMessageFlags::Contains, 1);
+	AddExpectedMessage(TEXT("references item"), EAutomationExpectedMessageFlags::Contains, 1);
+	TestFalse(TEXT("No sections"), NoSections.Restore(Inventory));
+	TestFalse(TEXT("Sections larger than the slots"), WrongSize.Restore(Inventory));
+	TestFalse(TEXT("Sections that don't tile the slots"), Gap.Restore(Inventory));
+	TestFalse(TEXT("A slot referencing a missing item"), MissingItem.Restore(Inventory));
+
+	TestEqual(TEXT("The inventory is untouched"), DescribeLayout(Inventory), Layout);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventorySaveDataBenchmarkTest, "RockInventory.Persistence.SaveData.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventorySaveDataBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	constexpr int32 NumInventories = 1000;
+	constexpr int32 NumItemsPerInventory = 200;
+	constexpr int32 NumDefinitions = 50;
+
+	// Loading resolves ItemIds, so the definitions have to be in a published registry snapshot
+	URockItemRegistrySubsystem* Registry = NewObject<URockItemRegistrySubsystem>();
+	TArray<URockItemDefinition*> Definitions;
+	for (int32 Index = 0; Index < NumDefinitions; ++Index)
+	{
+		URockItemDefinition* Definition = MakeDefinition(FName(TEXT("RockInventoryTest_SaveItem"), Index + 1), Index % 2 == 0 ? 1 : 20);
+		Definitions.Add(Definition);
+		Registry->DefinitionTable.Add(Definition);
+	}
+	Registry->PublishSnapshot();
+
+	// 200 slots filled with 200 stacks, full stacks so none of them merge
+	TArray<URockInventory*> Sources;
+	TArray<URockInventory*> Targets;
+	int32 NumAdded = 0;
+	for (int32 InventoryIndex = 0; InventoryIndex < NumInventories; ++InventoryIndex)
+	{
+		URockInventory* Source = MakeInventory(20, 10);
+		for (int32 ItemIndex = 0; ItemIndex < NumItemsPerInventory; ++ItemIndex)
+		{
+			URockItemDefinition* Definition = Definitions[(InventoryIndex + ItemIndex) % NumDefinitions];
+			NumAdded += AddItem(Source, Definition, Definition->MaxStackCount).IsValid() ? 1 : 0;
+		}
+		Sources.Add(Source);
+		Targets.Add(MakeInventory(20, 10));
+	}
+	TestEqual(TEXT("Every item added"), NumAdded, NumInventories * NumItemsPerInventory);
+
+	TArray<TArray<uint8>> Saves;
+	Saves.SetNum(NumInventories);
+	int32 NumSaved = 0;
+	const double SaveStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumInventories; ++Index)
+	{
+		NumSaved += FRockInventorySaveData::SaveInventory(Sources[Index], Saves[Index]) ? 1 : 0;
+	}
+	const double SaveSeconds = FPlatformTime::Seconds() - SaveStart;
+
+	int32 NumLoaded = 0;
+	const double LoadStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumInventories; ++Index)
+	{
+		NumLoaded += FRockInventorySaveData::LoadInventory(Targets[Index], Saves[Index]) ? 1 : 0;
+	}
+	const double LoadSeconds = FPlatformTime::Seconds() - LoadStart;
+
+	TestEqual(TEXT("Every inventory saved"), NumSaved, NumInventories);
+	TestEqual(TEXT("Every inventory loaded"), NumLoaded, NumInventories);
+	int32 NumMismatched = 0;
+	int64 TotalBytes = 0;
+	for (int32 Index = 0; Index < NumInventories; ++Index)
+	{
+		NumMismatched += DescribeLayout(Sources[Index]) != DescribeLayout(Targets[Index]) ? 1 : 0;
+		TotalBytes += Saves[Index].Num();
+	}
+	TestEqual(TEXT("Every loaded layout matches its source"), NumMismatched, 0);
+
+	const double MegaBytes = TotalBytes / (1024.0 * 1024.0);
+	AddInfo(FString::Printf(TEXT("%d inventories of %d items, %.0f bytes each: save %.1f ms (%.1f MB/s), load %.1f ms (%.1f MB/s)"),
+		NumInventories, NumItemsPerInventory, static_cast<double>(TotalBytes) / NumInventories,
+		SaveSeconds * 1000.0, MegaBytes / SaveSeconds, LoadSeconds * 1000.0, MegaBytes / LoadSeconds));
+
+	Registry->Deinitialize();
+	return true;
+}
+
+#endif
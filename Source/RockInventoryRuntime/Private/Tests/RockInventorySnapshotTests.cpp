@@ -0,0 +1,59 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "Inventory/RockInventorySnapshot.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventorySnapshotTest, "RockInventory.Inventory.Snapshot",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventorySnapshotTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	auto CountItems = [](const FRockInventorySnapshot& Snapshot)
+	{
+		int32 NumItems = 0;
+		Snapshot.ForEachItem([&NumItems](const FRockItemStack&) { ++NumItems; });
+		return NumItems;
+	};
+
+	// Two 8x4 sections, filled past the first item page so the second section and page hold the last items
+	URockItemDefinition* Stone = MakeDefinition(TEXT("Stone"));
+	URockInventory* Inventory = MakeInventory(8, 4, 2);
+	const int32 NumStones = FRockInventorySnapshot::ItemsPerPage + 8;
+	for (int32 Count = 0; Count < NumStones; ++Count)
+	{
+		AddItem(Inventory, Stone);
+	}
+
+	const FRockInventorySnapshotRef Before = Inventory->GetSnapshot();
+	TestEqual(TEXT("Every item is in the snapshot"), CountItems(*Before), NumStones);
+	TestTrue(TEXT("Unchanged inventory hands out the same snapshot"), &Before.Get() == &Inventory->GetSnapshot().Get());
+
+	const FRockInventorySlotHandle LastSlot(NumStones - 1);
+	const FRockItemStackHandle LastItem = Before->GetSlot(LastSlot)->ItemHandle;
+	URockInventoryLibrary::SplitItemStackAtLocation(Inventory, LastSlot);
+
+	const FRockInventorySnapshotRef After = Inventory->GetSnapshot();
+	TestTrue(TEXT("Modified inventory gets a new version"), After->GetVersion() != Before->GetVersion());
+	TestNull(TEXT("The removal shows in the new snapshot"), After->GetItem(LastItem));
+	TestEqual(TEXT("New item count"), CountItems(*After), NumStones - 1);
+
+	// The old snapshot is immutable, whoever still holds it keeps reading the old contents
+	TestNotNull(TEXT("The old snapshot still has the item"), Before->GetItem(LastItem));
+	TestTrue(TEXT("And its slot"), Before->GetSlot(LastSlot)->ItemHandle == LastItem);
+	TestEqual(TEXT("Old item count"), CountItems(*Before), NumStones);
+
+	// Only the modified section and item page were copied
+	TestTrue(TEXT("Untouched section is shared"), Before->GetSectionSlots(0).GetData() == After->GetSectionSlots(0).GetData());
+	TestTrue(TEXT("Modified section is copied"), Before->GetSectionSlots(1).GetData() != After->GetSectionSlots(1).GetData());
+	const FRockInventorySlotHandle FirstSlot(0);
+	TestTrue(TEXT("Untouched item page is shared"), Before->GetItemBySlot(FirstSlot) == After->GetItemBySlot(FirstSlot));
+	return true;
+}
+
+#endif
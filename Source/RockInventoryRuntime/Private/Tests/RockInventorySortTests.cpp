@@ -0,0 +1,129 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventorySortDeterministicTest, "RockInventory.Inventory.Sort.Deterministic",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventorySortDeterministicTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	URockItemDefinition* Arrow = MakeDefinition(TEXT("Arrow"), 60, FIntPoint(1, 1), 1);
+	URockItemDefinition* Rifle = MakeDefinition(TEXT("Rifle"), 1, FIntPoint(2, 1), 500);
+	URockItemDefinition* Apple = MakeDefinition(TEXT("Apple"), 10, FIntPoint(1, 1), 5);
+
+	// The same contents, looted in a different order so they start out in different slots
+	URockInventory* First = MakeInventory(6, 6);
+	AddItem(First, Arrow, 30);
+	AddItem(First, Apple, 4);
+	AddItem(First, Rifle);
+	AddItem(First, Arrow, 25);
+
+	URockInventory* Second = MakeInventory(6, 6);
+	AddItem(Second, Rifle);
+	AddItem(Second, Arrow, 25);
+	AddItem(Second, Arrow, 30);
+	AddItem(Second, Apple, 4);
+	TestNotEqual(TEXT("Layouts differ before sorting"), DescribeLayout(First), DescribeLayout(Second));
+
+	FRockInventorySortParams Params;
+	Params.SortKeys = {ERockInventorySortKey::Value};
+	TestTrue(TEXT("Sorts"), URockInventoryLibrary::SortInventory(First, Params, nullptr));
+	TestTrue(TEXT("Sorts"), URockInventoryLibrary::SortInventory(Second, Params, nullptr));
+
+	const FString Layout = DescribeLayout(First);
+	TestEqual(TEXT("Same contents sort to the same layout"), Layout, DescribeLayout(Second));
+	TestTrue(FString::Printf(TEXT("Highest value first (%s)"), *Layout), Layout.StartsWith(TEXT("Rifle:1 ")));
+	TestTrue(FString::Printf(TEXT("Nothing is lost (%s)"), *Layout), Layout.Contains(TEXT("Arrow:55 ")) && Layout.Contains(TEXT("Apple:4 ")));
+
+	// Sorting a sorted inventory is a no-op
+	TestTrue(TEXT("Sorts again"), URockInventoryLibrary::SortInventory(First, Params, nullptr));
+	TestEqual(TEXT("Stable"), DescribeLayout(First), Layout);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventorySortBenchmarkTest, "RockInventory.Inventory.Sort.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventorySortBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	constexpr int32 NumRounds = 10;
+
+	// 40 2x2, 100 2x1 and 250 1x1 items fill 610 of the 700 cells
+	TArray<URockItemDefinition*> Items;
+	auto AddItems = [&Items](const TCHAR* Name, int32 NumDefinitions, int32 NumItems, FIntPoint GridSize, int32 BaseValue)
+	{
+		TArray<URockItemDefinition*> Definitions;
+		for (int32 Index = 0; Index < NumDefinitions; ++Index)
+		{
+			Definitions.Add(MakeDefinition(FName(Name, Index + 1), 1, GridSize, BaseValue + Index));
+		}
+		for (int32 Index = 0; Index < NumItems; ++Index)
+		{
+			Items.Add(Definitions[Index % NumDefinitions]);
+		}
+	};
+	AddItems(TEXT("Armor"), 8, 40, FIntPoint(2, 2), 100);
+	AddItems(TEXT("Rifle"), 10, 100, FIntPoint(2, 1), 50);
+	AddItems(TEXT("Gem"), 25, 250, FIntPoint(1, 1), 0);
+
+	FRockInventorySortParams Params;
+	Params.SortKeys = {ERockInventorySortKey::Size, ERockInventorySortKey::Value};
+
+	FString SortedLayout;
+	double SortSeconds = 0.0;
+	double ResortSeconds = 0.0;
+	int32 NumSorted = 0;
+	int32 NumDifferentLayouts = 0;
+	for (int32 Round = 0; Round < NumRounds; ++Round)
+	{
+		// The same contents every round, looted in another order. Largest first, so they all fit
+		FRandomStream Random(Round);
+		TArray<URockItemDefinition*> Order = Items;
+		for (const FIntPoint Range : {FIntPoint(0, 40), FIntPoint(40, 140), FIntPoint(140, 390)})
+		{
+			for (int32 Index = Range.Y - 1; Index > Range.X; --Index)
+			{
+				Order.Swap(Index, Random.RandRange(Range.X, Index));
+			}
+		}
+		URockInventory* Stash = MakeInventory(10, 70);
+		for (URockItemDefinition* Definition : Order)
+		{
+			AddItem(Stash, Definition);
+		}
+
+		const double SortStart = FPlatformTime::Seconds();
+		NumSorted += URockInventoryLibrary::SortInventory(Stash, Params, nullptr) ? 1 : 0;
+		SortSeconds += FPlatformTime::Seconds() - SortStart;
+
+		const FString Layout = DescribeLayout(Stash);
+		if (Round == 0)
+		{
+			SortedLayout = Layout;
+		}
+		NumDifferentLayouts += Layout != SortedLayout ? 1 : 0;
+
+		const double ResortStart = FPlatformTime::Seconds();
+		URockInventoryLibrary::SortInventory(Stash, Params, nullptr);
+		ResortSeconds += FPlatformTime::Seconds() - ResortStart;
+		NumDifferentLayouts += DescribeLayout(Stash) != SortedLayout ? 1 : 0;
+	}
+
+	TestEqual(TEXT("Every stash sorted"), NumSorted, NumRounds);
+	TestEqual(TEXT("Every stash sorted to the same layout"), NumDifferentLayouts, 0);
+	TestTrue(TEXT("Largest first"), SortedLayout.StartsWith(TEXT("Armor")));
+
+	AddInfo(FString::Printf(TEXT("10x70 stash with 390 items: sort %.2f ms, sorting it again %.2f ms"),
+		SortSeconds * 1000.0 / NumRounds, ResortSeconds * 1000.0 / NumRounds));
+	return true;
+}
+
+#endif
@@ -0,0 +1,172 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/RockInventoryComponent.h"
+#include "Components/RockInventoryManagerComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Inventory/RockInventory.h"
+#include "Inventory/RockInventoryConfig.h"
+#include "Item/RockItemDefinition.h"
+#include "Library/RockInventoryLibrary.h"
+#include "TimerManager.h"
+#include "World/RockInventoryWorldItem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Shared setup for the automation tests. Everything is transient: item stacks hold their definition, so no assets or registry are involved */
+namespace RockInventoryTests
+{
+	inline URockItemDefinition* MakeDefinition(FName ItemId, int32 MaxStackCount = 1, FIntPoint GridSize = FIntPoint(1, 1), int32 ItemValue = 0)
+	{
+		URockItemDefinition* Definition = NewObject<URockItemDefinition>(GetTransientPackage());
+		Definition->ItemId = ItemId;
+		Definition->MaxStackCount = MaxStackCount;
+		Definition->GridSize = GridSize;
+		Definition->ItemValue = ItemValue;
+		return Definition;
+	}
+
+	/** Loaded up front, so world item visuals are answered right away and nothing streams or falls back during a test */
+	inline const TCHAR* WorldItemMeshPath = TEXT("/Engine/BasicShapes/Cube.Cube");
+
+	/** For items that end up in the world: a definition without a mesh warns about using the fallback mesh */
+	inline URockItemDefinition* MakeWorldDefinition(FName ItemId, int32 MaxStackCount = 1)
+	{
+		URockItemDefinition* Definition = MakeDefinition(ItemId, MaxStackCount);
+		Definition->ItemMesh = LoadObject<UStaticMesh>(nullptr, WorldItemMeshPath);
+		return Definition;
+	}
+
+	/** NumSections Columns x Rows grids, owned by a component outside of any world so it has something to replicate through */
+	inline URockInventory* MakeInventory(int32 Columns, int32 Rows, int32 NumSections = 1)
+	{
+		URockInventoryConfig* Config = NewObject<URockInventoryConfig>(GetTransientPackage());
+		for (int32 SectionIndex = 0; SectionIndex < NumSections; ++SectionIndex)
+		{
+			Config->InventoryTabs.Add(FRockInventorySectionInfo(FGameplayTag(), 0, Columns, Rows));
+		}
+
+		URockInventoryComponent* Component = NewObject<URockInventoryComponent>(GetTransientPackage());
+		URockInventory* Inventory = NewObject<URockInventory>(Component);
+		Inventory->Owner = Component;
+		Inventory->Init(Config);
+		Component->Inventory = Inventory;
+		return Inventory;
+	}
+
+	/** Auto-placed like a loot. Returns the new item's handle, invalid if it didn't fit */
+	inline FRockItemStackHandle AddItem(URockInventory* Inventory, URockItemDefinition* Definition, int32 StackCount = 1)
+	{
+		FRockInventorySlotHandle SlotHandle;
+		int32 Excess = 0;
+		if (!URockInventoryLibrary::LootItemToInventory(Inventory, FRockItemStack(Definition, StackCount), SlotHandle, Excess))
+		{
+			return FRockItemStackHandle::Invalid();
+		}
+		return Inventory->GetSlotByHandle(SlotHandle).ItemHandle;
+	}
+
+	/** ItemId:StackCount per slot, empty slots as '-'. Compares whole layouts in one TestEqual */
+	inline FString DescribeLayout(URockInventory* Inventory)
+	{
+		FString Layout;
+		Inventory->ForEachSlotInSection([Inventory, &Layout](const FRockInventorySectionInfo&, const FRockInventorySlotEntry& Slot)
+		{
+			const FRockItemStack* Item = Inventory->GetItemByHandlePtr(Slot.ItemHandle);
+			Layout += Item && Item->IsValid() ? FString::Printf(TEXT("%s:%d "), *Item->GetDefinition()->ItemId.ToString(), Item->GetStackCount()) : TEXT("- ");
+			return true;
+		});
+		return Layout;
+	}
+
+	/**
+	 * A game world that lives for the scope, so the world subsystems get created. Nothing ticks unless the test ticks it.
+	 * Settings read in the subsystems' Initialize must be changed before constructing it, those read in OnWorldBeginPlay before BeginPlay
+	 */
+	struct FScopedTestWorld
+	{
+		FScopedTestWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+			GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+		}
+
+		~FScopedTestWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+
+		UE_NONCOPYABLE(FScopedTestWorld);
+
+		/** Actors spawned from here on begin play as they finish spawning */
+		void BeginPlay()
+		{
+			const FURL URL;
+			World->SetGameMode(URL);
+			World->InitializeActorsForPlay(URL);
+			World->BeginPlay();
+		}
+
+		/** The timer manager only ticks once per frame, so this moves on to the next one like the engine loop would */
+		void TickTimers(float DeltaTime)
+		{
+			World->GetTimerManager().Tick(DeltaTime);
+			++GFrameCounter;
+		}
+
+		UWorld* World = nullptr;
+	};
+
+	/** A bare actor with a root component, so it has a location */
+	inline AActor* SpawnActorAt(UWorld* World, const FVector& Location)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+		USceneComponent* Root = NewObject<USceneComponent>(Actor);
+		Actor->SetRootComponent(Root);
+		Root->RegisterComponent();
+		Actor->SetActorLocation(Location);
+		return Actor;
+	}
+
+	/** On a player controller, like in a game. The world is standalone, so its server and client RPCs run locally */
+	inline URockInventoryManagerComponent* SpawnManager(UWorld* World)
+	{
+		APlayerController* Controller = World->SpawnActor<APlayerController>();
+		URockInventoryManagerComponent* Manager = NewObject<URockInventoryManagerComponent>(Controller);
+		Manager->RegisterComponent();
+		return Manager;
+	}
+
+	/** Moves the whole stack, or MoveCount of it, instigated by the manager's controller */
+	inline FRockMoveItemTransaction MakeMove(
+		URockInventoryManagerComponent* Manager, URockInventory* Inventory, int32 SourceSlot, int32 TargetSlot, int32 MoveCount = -1)
+	{
+		FRockMoveItemParams MoveParams;
+		if (MoveCount > 0)
+		{
+			MoveParams.MoveMode = ERockItemMoveMode::CustomAmount;
+			MoveParams.MoveCount = MoveCount;
+		}
+		return FRockMoveItemTransaction(Cast<AController>(Manager->GetOwner()),
+			Inventory, FRockInventorySlotHandle(SourceSlot), Inventory, FRockInventorySlotHandle(TargetSlot), MoveParams);
+	}
+
+	/** Spawned like URockWorldItemSpawnSubsystem does, at rest */
+	inline ARockInventoryWorldItemBase* SpawnWorldItem(UWorld* World, const FRockItemStack& ItemStack, const FVector& Location)
+	{
+		const FTransform Transform(Location);
+		ARockInventoryWorldItemBase* WorldItem = World->SpawnActorDeferred<ARockInventoryWorldItemBase>(ARockInventoryWorldItemBase::StaticClass(), Transform);
+		WorldItem->SetItemStack(ItemStack);
+		WorldItem->FinishSpawning(Transform);
+		return WorldItem;
+	}
+}
+
+#endif
@@ -0,0 +1,173 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "Serialization/BitWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryTransactionBatchTest, "RockInventory.Transactions.Batch",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryTransactionBatchTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	// Executed right away in the RPC handler
+	URockInventoryDeveloperSettings* Settings = GetMutableDefault<URockInventoryDeveloperSettings>();
+	TGuardValue<bool> RateLimitGuard(Settings->bEnableTransactionRateLimiting, false);
+	TGuardValue<bool> QueueGuard(Settings->bEnableTransactionQueue, false);
+	FScopedTestWorld TestWorld;
+	TestWorld.BeginPlay();
+	URockInventoryManagerComponent* Manager = SpawnManager(TestWorld.World);
+
+	URockInventory* Inventory = MakeInventory(4, 1);
+	AddItem(Inventory, MakeDefinition(TEXT("Stone"), 10), 5);
+	AddItem(Inventory, MakeDefinition(TEXT("Apple"), 10), 2);
+	const FString Layout = DescribeLayout(Inventory);
+	TestEqual(TEXT("Setup"), Layout, FString(TEXT("Stone:5 Apple:2 - - ")));
+
+	// Only moves can be rolled back, anything else turns an atomic batch away before it runs
+	FRockInventoryTransactionBatch NotUndoable;
+	NotUndoable.bAtomic = true;
+	NotUndoable.Add(MakeMove(Manager, Inventory, 0, 2));
+	NotUndoable.Add(FRockSortInventoryTransaction());
+	AddExpectedMessage(TEXT("contains a non undoable transaction"), EAutomationExpectedMessageFlags::Contains, 1);
+	TestEqual(TEXT("Ids handed out in order"), Manager->ExecuteTransactionBatch(NotUndoable), 1);
+	TestEqual(TEXT("Nothing ran"), DescribeLayout(Inventory), Layout);
+
+	// The last entry's source was emptied by the first, so it fails and the others are undone in reverse
+	AddExpectedMessage(TEXT("Source slot has no valid item"), EAutomationExpectedMessageFlags::Contains, 2);
+	FRockInventoryTransactionBatch Atomic;
+	Atomic.bAtomic = true;
+	Atomic.Add(MakeMove(Manager, Inventory, 0, 2));
+	Atomic.Add(MakeMove(Manager, Inventory, 1, 3));
+	Atomic.Add(MakeMove(Manager, Inventory, 0, 1));
+	TestEqual(TEXT("Ids handed out in order"), Manager->ExecuteTransactionBatch(Atomic), 2);
+	TestEqual(TEXT("Rolled back"), DescribeLayout(Inventory), Layout);
+
+	// Without bAtomic a failing entry only fails itself
+	FRockInventoryTransactionBatch Independent;
+	Independent.Add(MakeMove(Manager, Inventory, 0, 2));
+	Independent.Add(MakeMove(Manager, Inventory, 0, 3));
+	Independent.Add(MakeMove(Manager, Inventory, 1, 3));
+	TestEqual(TEXT("Ids handed out in order"), Manager->ExecuteTransactionBatch(Independent), 3);
+	TestEqual(TEXT("The others applied"), DescribeLayout(Inventory), FString(TEXT("- - Stone:5 Apple:2 ")));
+
+	AddExpectedMessage(TEXT("is empty or too large"), EAutomationExpectedMessageFlags::Contains, 1);
+	TestEqual(TEXT("Empty batches aren't sent"), Manager->ExecuteTransactionBatch(FRockInventoryTransactionBatch()), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryTransactionBatchBenchmarkTest, "RockInventory.Transactions.Batch.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryTransactionBatchBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	constexpr int32 NumMoves = 40;
+	// Odd, so every inventory ends up in the moved layout
+	constexpr int32 NumRounds = 101;
+
+	URockInventoryDeveloperSettings* Settings = GetMutableDefault<URockInventoryDeveloperSettings>();
+	TGuardValue<bool> RateLimitGuard(Settings->bEnableTransactionRateLimiting, false);
+	TGuardValue<bool> QueueGuard(Settings->bEnableTransactionQueue, false);
+	FScopedTestWorld TestWorld;
+	TestWorld.BeginPlay();
+	URockInventoryManagerComponent* Manager = SpawnManager(TestWorld.World);
+
+	// 40 items in the top half of the grid, each round moves every one of them to the other half
+	URockItemDefinition* Stone = MakeDefinition(TEXT("Stone"));
+	URockInventory* Inventories[3];
+	for (URockInventory*& Inventory : Inventories)
+	{
+		Inventory = MakeInventory(10, 8);
+		for (int32 Index = 0; Index < NumMoves; ++Index)
+		{
+			AddItem(Inventory, Stone);
+		}
+	}
+	URockInventory* Individual = Inventories[0];
+	auto MakeRoundMove = [Manager](URockInventory* Inventory, int32 Round, int32 Index)
+	{
+		return Round % 2 == 0 ? MakeMove(Manager, Inventory, Index, Index + NumMoves) : MakeMove(Manager, Inventory, Index + NumMoves, Index);
+	};
+	auto MakeRoundBatch = [&MakeRoundMove](URockInventory* Inventory, int32 Round, bool bAtomic)
+	{
+		FRockInventoryTransactionBatch Batch;
+		Batch.BatchID = Round + 1;
+		Batch.bAtomic = bAtomic;
+		for (int32 Index = 0; Index < NumMoves; ++Index)
+		{
+			Batch.Add(MakeRoundMove(Inventory, Round, Index));
+		}
+		return Batch;
+	};
+
+	double IndividualSeconds = 0.0;
+	double BatchSeconds[2] = {0.0, 0.0};
+	for (int32 Round = 0; Round < NumRounds; ++Round)
+	{
+		// The moves and batches are built outside the timed part, like they'd arrive from the connection
+		TArray<FRockMoveItemTransaction> Moves;
+		for (int32 Index = 0; Index < NumMoves; ++Index)
+		{
+			Moves.Add(MakeRoundMove(Individual, Round, Index));
+		}
+		const double IndividualStart = FPlatformTime::Seconds();
+		for (const FRockMoveItemTransaction& Move : Moves)
+		{
+			Manager->Server_MoveItem_Implementation(Move);
+		}
+		IndividualSeconds += FPlatformTime::Seconds() - IndividualStart;
+
+		for (int32 AtomicIndex = 0; AtomicIndex < 2; ++AtomicIndex)
+		{
+			const FRockInventoryTransactionBatch Batch = MakeRoundBatch(Inventories[1 + AtomicIndex], Round, AtomicIndex == 1);
+			const double BatchStart = FPlatformTime::Seconds();
+			Manager->Server_ExecuteTransactionBatch_Implementation(Batch);
+			BatchSeconds[AtomicIndex] += FPlatformTime::Seconds() - BatchStart;
+		}
+	}
+
+	const FString Moved = DescribeLayout(Individual);
+	TestTrue(TEXT("Individual moves applied"), Moved.StartsWith(TEXT("- ")) && Moved.EndsWith(TEXT("Stone:1 ")));
+	TestEqual(TEXT("Batch applied the same"), DescribeLayout(Inventories[1]), Moved);
+	TestEqual(TEXT("Atomic batch applied the same"), DescribeLayout(Inventories[2]), Moved);
+
+	// Payloads as the RPCs carry them. There's no package map here, so neither the RPC headers nor a batch entry's struct type are counted
+	int64 IndividualBits = 0;
+	for (int32 Index = 0; Index < NumMoves; ++Index)
+	{
+		bool bSuccess = false;
+		FBitWriter Writer(0, true);
+		MakeRoundMove(Individual, 0, Index).NetSerialize(Writer, nullptr, bSuccess);
+		// Answered by Client_TransactionResult(int32, bool)
+		IndividualBits += Writer.GetNumBits() + 33;
+	}
+
+	FRockInventoryTransactionBatch Batch = MakeRoundBatch(Individual, 0, false);
+	FBitWriter BatchWriter(0, true);
+	BatchWriter << Batch.BatchID;
+	BatchWriter.WriteBit(Batch.bAtomic);
+	uint32 NumTransactions = Batch.Num();
+	BatchWriter.SerializeIntPacked(NumTransactions);
+	for (FInstancedStruct& Transaction : Batch.Transactions)
+	{
+		bool bSuccess = false;
+		Transaction.NetSerialize(BatchWriter, nullptr, bSuccess);
+	}
+	// Answered by one FRockInventoryTransactionBatchResult: BatchID, two flags and an empty FailedIndices
+	const int64 BatchBits = BatchWriter.GetNumBits() + 32 + 2 + 8;
+
+	AddInfo(FString::Printf(TEXT("%d moves individually: %d RPCs, %lld bytes, %.1f us on the server"),
+		NumMoves, NumMoves * 2, (IndividualBits + 7) / 8, IndividualSeconds * 1e6 / NumRounds));
+	AddInfo(FString::Printf(TEXT("%d moves in a batch: 2 RPCs, %lld bytes, %.1f us on the server (%.1f us atomic)"),
+		NumMoves, (BatchBits + 7) / 8, BatchSeconds[0] * 1e6 / NumRounds, BatchSeconds[1] * 1e6 / NumRounds));
+	return true;
+}
+
+#endif
@@ -0,0 +1,126 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Transactions/Core/RockInventoryTransactionHistory.h"
+
+#include "Misc/AutomationTest.h"
+#include "Transactions/Implementations/RockMoveItemTransaction.h"
+#include "Transactions/Implementations/RockTransferAllTransaction.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RockInventoryTransactionHistoryTests
+{
+	FRockInventoryTransactionRecord MakeRecord(int32 TransactionID)
+	{
+		FRockMoveItemTransaction Move;
+		Move.TransactionID = TransactionID;
+		FRockInventoryTransactionRecord Record;
+		Record.Set(Move, FRockMoveItemUndoTransaction());
+		return Record;
+	}
+
+	/** Different command and undo types, so the soak doesn't only see one record size */
+	FRockInventoryTransactionRecord MakeTransferAllRecord(int32 TransactionID)
+	{
+		FRockTransferAllTransaction TransferAll;
+		TransferAll.TransactionID = TransactionID;
+		FRockInventoryTransactionRecord Record;
+		Record.Set(TransferAll, FRockTransferAllUndoTransaction());
+		return Record;
+	}
+
+	int32 GetTransactionID(const FRockInventoryTransactionHistory& History, int32 Index)
+	{
+		return History[Index].Command.Get<FRockMoveItemTransaction>().TransactionID;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryTransactionHistoryTest, "RockInventory.Transactions.History",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryTransactionHistoryTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTransactionHistoryTests;
+
+	FRockInventoryTransactionHistory History;
+	History.Configure(4, 0);
+	for (int32 TransactionID = 1; TransactionID <= 6; ++TransactionID)
+	{
+		History.Add(MakeRecord(TransactionID));
+	}
+	// The ring wrapped: the two oldest are gone and indexing still starts at the oldest
+	TestEqual(TEXT("Bounded by capacity"), History.Num(), 4);
+	TestEqual(TEXT("Oldest kept"), GetTransactionID(History, 0), 3);
+	TestEqual(TEXT("Newest"), GetTransactionID(History, 3), 6);
+
+	const int64 RecordSize = MakeRecord(0).GetAllocatedSize();
+	TestEqual(TEXT("Used bytes"), History.GetUsedBytes(), RecordSize * 4);
+
+	// Shrinking the budget drops the oldest until it fits
+	History.Configure(4, static_cast<int32>(RecordSize * 2));
+	TestEqual(TEXT("Bounded by budget"), History.Num(), 2);
+	TestEqual(TEXT("Newest survive the budget"), GetTransactionID(History, 0), 5);
+	History.Add(MakeRecord(7));
+	TestTrue(TEXT("Adding keeps within the budget"), History.Num() == 2 && History.GetUsedBytes() <= RecordSize * 2);
+
+	// Growing keeps the records in order across the old wrap point
+	History.Configure(8, 0);
+	History.Add(MakeRecord(8));
+	TestEqual(TEXT("Grown"), History.Num(), 3);
+	TestTrue(TEXT("Order kept"), GetTransactionID(History, 0) == 6 && GetTransactionID(History, 2) == 8);
+
+	History.TruncateAfter(0);
+	TestEqual(TEXT("Redo tail dropped"), History.Num(), 1);
+	TestEqual(TEXT("Truncation keeps the oldest"), GetTransactionID(History, 0), 6);
+
+	History.Reset();
+	TestTrue(TEXT("Reset frees everything"), History.IsEmpty() && History.GetUsedBytes() == 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryTransactionHistorySoakTest, "RockInventory.Transactions.History.Soak",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryTransactionHistorySoakTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTransactionHistoryTests;
+
+	constexpr int32 NumAdds = 1000000;
+	constexpr int32 BudgetBytes = 64 * 1024;
+
+	// The capacity alone would allow far more than the budget, so the budget is what bounds it
+	FRockInventoryTransactionHistory History;
+	History.Configure(16384, BudgetBytes);
+
+	int32 NumOverBudget = 0;
+	int64 PeakUsedBytes = 0;
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 TransactionID = 1; TransactionID <= NumAdds; ++TransactionID)
+	{
+		History.Add(TransactionID % 3 == 0 ? MakeTransferAllRecord(TransactionID) : MakeRecord(TransactionID));
+		PeakUsedBytes = FMath::Max(PeakUsedBytes, History.GetUsedBytes());
+		NumOverBudget += History.GetUsedBytes() > BudgetBytes ? 1 : 0;
+	}
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+	TestEqual(TEXT("Never over budget"), NumOverBudget, 0);
+	TestTrue(TEXT("Peak within budget"), PeakUsedBytes <= BudgetBytes);
+
+	// The running total hasn't drifted from what the records actually hold
+	int64 ActualBytes = 0;
+	for (int32 Index = 0; Index < History.Num(); ++Index)
+	{
+		ActualBytes += History[Index].GetAllocatedSize();
+	}
+	TestEqual(TEXT("Used bytes match the records"), History.GetUsedBytes(), ActualBytes);
+	TestTrue(TEXT("Budget is mostly used"), History.GetUsedBytes() > BudgetBytes - 2 * MakeTransferAllRecord(0).GetAllocatedSize());
+
+	const FRockInventoryTransactionRecord& Newest = History[History.Num() - 1];
+	TestEqual(TEXT("Newest record kept"), Newest.Command.Get<FRockMoveItemTransaction>().TransactionID, NumAdds);
+
+	AddInfo(FString::Printf(TEXT("%d adds in %.1f ms (%.0f ns each), %d records kept in %lld of %d bytes"),
+		NumAdds, Seconds * 1000.0, Seconds * 1e9 / NumAdds, History.Num(), PeakUsedBytes, BudgetBytes));
+	return true;
+}
+
+#endif
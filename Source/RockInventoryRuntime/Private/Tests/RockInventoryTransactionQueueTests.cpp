@@ -0,0 +1,179 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "Transactions/Core/RockInventoryTransactionQueueSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryTransactionQueueTest, "RockInventory.Transactions.Queue",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryTransactionQueueTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	URockInventoryDeveloperSettings* Settings = GetMutableDefault<URockInventoryDeveloperSettings>();
+	TGuardValue<bool> RateLimitGuard(Settings->bEnableTransactionRateLimiting, false);
+	TGuardValue<bool> QueueGuard(Settings->bEnableTransactionQueue, true);
+	TGuardValue<bool> ParallelGuard(Settings->bParallelTransactionExecution, false);
+	TGuardValue<int32> MaxQueuedGuard(Settings->MaxQueuedTransactionsPerController, 3);
+	FScopedTestWorld TestWorld;
+	TestWorld.BeginPlay();
+	URockInventoryTransactionQueueSubsystem* Queue = TestWorld.World->GetSubsystem<URockInventoryTransactionQueueSubsystem>();
+	if (!TestTrue(TEXT("Queue enabled"), Queue && Queue->IsEnabled()))
+	{
+		return false;
+	}
+	URockInventoryManagerComponent* First = SpawnManager(TestWorld.World);
+	URockInventoryManagerComponent* Second = SpawnManager(TestWorld.World);
+
+	URockInventory* Backpack = MakeInventory(4, 1);
+	URockInventory* Crate = MakeInventory(4, 1);
+	AddItem(Backpack, MakeDefinition(TEXT("Stone"), 10), 5);
+	AddItem(Crate, MakeDefinition(TEXT("Apple"), 10), 2);
+
+	// As the RPCs arrive. The second controller's move needs the first controller's crate move to have run before it
+	First->Server_MoveItem(MakeMove(First, Backpack, 0, 1));
+	First->Server_MoveItem(MakeMove(First, Backpack, 1, 2));
+	First->Server_MoveItem(MakeMove(First, Crate, 0, 1));
+	Second->Server_MoveItem(MakeMove(Second, Crate, 1, 2));
+	TestEqual(TEXT("Held back"), Queue->GetNumQueued(), 4);
+	TestEqual(TEXT("Nothing ran yet"), DescribeLayout(Backpack), FString(TEXT("Stone:5 - - - ")));
+
+	// The oldest always runs, even without any budget
+	TestEqual(TEXT("One over budget"), Queue->ProcessQueue(0.0), 1);
+	TestEqual(TEXT("Oldest first"), DescribeLayout(Backpack), FString(TEXT("- Stone:5 - - ")));
+
+	// The second controller is next in turn, but waits for the older crate move
+	TestEqual(TEXT("One over budget"), Queue->ProcessQueue(0.0), 1);
+	TestEqual(TEXT("Skipped the blocked controller"), DescribeLayout(Backpack), FString(TEXT("- - Stone:5 - ")));
+	TestEqual(TEXT("Crate untouched"), DescribeLayout(Crate), FString(TEXT("Apple:2 - - - ")));
+
+	TestEqual(TEXT("The rest"), Queue->ProcessQueue(1.0), 2);
+	TestEqual(TEXT("In arrival order across controllers"), DescribeLayout(Crate), FString(TEXT("- - Apple:2 - ")));
+
+	const FRockTransactionQueueStats Stats = Queue->GetStats();
+	TestEqual(TEXT("Processed"), Stats.Processed, static_cast<int64>(4));
+	TestEqual(TEXT("MaxQueued"), Stats.MaxQueued, 4);
+
+	// A controller can only have so many waiting
+	AddExpectedMessage(TEXT("transactions waiting, rejecting"), EAutomationExpectedMessageFlags::Contains, 1);
+	for (int32 Count = 0; Count < 4; ++Count)
+	{
+		First->Server_MoveItem(MakeMove(First, Backpack, 2, 3));
+	}
+	TestEqual(TEXT("Capped per controller"), Queue->GetNumQueued(), 3);
+	TestEqual(TEXT("Dropped"), Queue->GetStats().Dropped, static_cast<int64>(1));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryTransactionQueueBenchmarkTest, "RockInventory.Transactions.Queue.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryTransactionQueueBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	constexpr int32 NumPlayers = 40;
+	constexpr int32 NumLootsPerPlayer = 10;
+	constexpr double BudgetSeconds = 0.002;
+
+	URockInventoryDeveloperSettings* Settings = GetMutableDefault<URockInventoryDeveloperSettings>();
+	TGuardValue<bool> RateLimitGuard(Settings->bEnableTransactionRateLimiting, false);
+	TGuardValue<bool> ParallelGuard(Settings->bParallelTransactionExecution, false);
+	TGuardValue<int32> MaxQueuedGuard(Settings->MaxQueuedTransactionsPerController, NumLootsPerPlayer);
+	URockItemDefinition* Loot = MakeDefinition(TEXT("Loot"));
+
+	// The end of a raid: every player empties their half of a crate shared with another player into their backpack, all in the same frame
+	auto RunBurst = [&](bool bQueued, FString& OutLayouts)
+	{
+		TGuardValue<bool> QueueGuard(Settings->bEnableTransactionQueue, bQueued);
+		FScopedTestWorld TestWorld;
+		TestWorld.BeginPlay();
+
+		TArray<URockInventoryManagerComponent*> Managers;
+		TArray<URockInventory*> Backpacks;
+		TArray<URockInventory*> Crates;
+		for (int32 Player = 0; Player < NumPlayers; ++Player)
+		{
+			Managers.Add(SpawnManager(TestWorld.World));
+			Backpacks.Add(MakeInventory(NumLootsPerPlayer, 1));
+			if (Player % 2 == 0)
+			{
+				URockInventory* Crate = MakeInventory(NumLootsPerPlayer, 2);
+				for (int32 Index = 0; Index < NumLootsPerPlayer * 2; ++Index)
+				{
+					AddItem(Crate, Loot);
+				}
+				Crates.Add(Crate);
+			}
+		}
+
+		const double BurstStart = FPlatformTime::Seconds();
+		for (int32 LootIndex = 0; LootIndex < NumLootsPerPlayer; ++LootIndex)
+		{
+			for (int32 Player = 0; Player < NumPlayers; ++Player)
+			{
+				URockInventoryManagerComponent* Manager = Managers[Player];
+				Manager->Server_MoveItem(FRockMoveItemTransaction(Cast<AController>(Manager->GetOwner()),
+					Crates[Player / 2], FRockInventorySlotHandle((Player % 2) * NumLootsPerPlayer + LootIndex),
+					Backpacks[Player], FRockInventorySlotHandle(LootIndex), FRockMoveItemParams()));
+			}
+		}
+		const double BurstSeconds = FPlatformTime::Seconds() - BurstStart;
+
+		URockInventoryTransactionQueueSubsystem* Queue = TestWorld.World->GetSubsystem<URockInventoryTransactionQueueSubsystem>();
+		if (bQueued)
+		{
+			// Frames back to back, the measured latency leaves out the rest of each frame
+			int32 NumFrames = 0;
+			for (; Queue->GetNumQueued() > 0; ++NumFrames)
+			{
+				Queue->ProcessQueue(BudgetSeconds);
+			}
+			const FRockTransactionQueueStats Stats = Queue->GetStats();
+			TestEqual(TEXT("Every loot ran"), Stats.Processed, static_cast<int64>(NumPlayers * NumLootsPerPlayer));
+			// The RPCs arriving and the first processing would share a frame in a game, so the worst frame is an upper bound
+			AddInfo(FString::Printf(TEXT("%d loots queued: worst frame %.2f ms (%.2f ms receiving, %.2f ms processing), drained in %d frames, worst queue latency %.2f ms"),
+				NumPlayers * NumLootsPerPlayer, (BurstSeconds + Stats.MaxFrameSeconds) * 1000.0, BurstSeconds * 1000.0, Stats.MaxFrameSeconds * 1000.0,
+				NumFrames, Stats.MaxQueueLatencySeconds * 1000.0));
+		}
+		else
+		{
+			TestFalse(TEXT("Inline without the queue"), Queue && Queue->IsEnabled());
+			AddInfo(FString::Printf(TEXT("%d loots inline: worst frame %.2f ms"), NumPlayers * NumLootsPerPlayer, BurstSeconds * 1000.0));
+		}
+
+		OutLayouts.Reset();
+		for (URockInventory* Inventory : Backpacks)
+		{
+			OutLayouts += DescribeLayout(Inventory);
+		}
+		for (URockInventory* Inventory : Crates)
+		{
+			OutLayouts += DescribeLayout(Inventory);
+		}
+	};
+
+	FString InlineLayouts;
+	FString QueuedLayouts;
+	RunBurst(false, InlineLayouts);
+	RunBurst(true, QueuedLayouts);
+	FString Expected;
+	for (int32 Index = 0; Index < NumPlayers * NumLootsPerPlayer; ++Index)
+	{
+		Expected += TEXT("Loot:1 ");
+	}
+	for (int32 Index = 0; Index < NumPlayers * NumLootsPerPlayer; ++Index)
+	{
+		Expected += TEXT("- ");
+	}
+	TestEqual(TEXT("Every backpack filled and every crate emptied"), InlineLayouts, Expected);
+	TestEqual(TEXT("Queued ends like inline"), QueuedLayouts, InlineLayouts);
+	return true;
+}
+
+#endif
@@ -0,0 +1,107 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryTransferAllBenchmarkTest, "RockInventory.Inventory.TransferAll.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryTransferAllBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	constexpr int32 NumSingles = 150;
+	constexpr int32 NumAmmoTypes = 50;
+	constexpr int32 NumRounds = 10;
+
+	TArray<URockItemDefinition*> Singles;
+	TArray<URockItemDefinition*> Ammo;
+	for (int32 Index = 0; Index < 10; ++Index)
+	{
+		Singles.Add(MakeDefinition(FName(TEXT("Gear"), Index + 1)));
+	}
+	for (int32 Index = 0; Index < NumAmmoTypes; ++Index)
+	{
+		Ammo.Add(MakeDefinition(FName(TEXT("Ammo"), Index + 1), 60));
+	}
+
+	// 200 stacks in a full crate. The ammo merges into the target's partial stacks, the rest needs free slots
+	auto MakeCrate = [&Singles, &Ammo]
+	{
+		URockInventory* Crate = MakeInventory(20, 10);
+		for (int32 Index = 0; Index < NumSingles + NumAmmoTypes; ++Index)
+		{
+			if (Index % 4 == 3)
+			{
+				AddItem(Crate, Ammo[Index / 4], 10);
+			}
+			else
+			{
+				AddItem(Crate, Singles[Index % Singles.Num()]);
+			}
+		}
+		return Crate;
+	};
+	auto MakeTarget = [&Ammo]
+	{
+		URockInventory* Target = MakeInventory(20, 12);
+		for (URockItemDefinition* Definition : Ammo)
+		{
+			AddItem(Target, Definition, 30);
+		}
+		return Target;
+	};
+	const FString EmptyCrate = DescribeLayout(MakeInventory(20, 10));
+
+	double PerItemSeconds = 0.0;
+	double TransferAllSeconds = 0.0;
+	URockInventory* PerItemTarget = nullptr;
+	URockInventory* TransferAllTarget = nullptr;
+	int32 MovedCount = 0;
+	for (int32 Round = 0; Round < NumRounds; ++Round)
+	{
+		// One loot and one removal per item, like the UI did before
+		URockInventory* Crate = MakeCrate();
+		PerItemTarget = MakeTarget();
+		const double PerItemStart = FPlatformTime::Seconds();
+		for (int32 SlotIndex = 0; SlotIndex < 200; ++SlotIndex)
+		{
+			const FRockInventorySlotHandle SlotHandle(SlotIndex);
+			const FRockItemStack ItemStack = URockInventoryLibrary::GetItemBySlotHandle(Crate, SlotHandle);
+			FRockInventorySlotHandle LootedHandle;
+			int32 Excess = 0;
+			if (ItemStack.IsValid() && URockInventoryLibrary::LootItemToInventory(PerItemTarget, ItemStack, LootedHandle, Excess))
+			{
+				URockInventoryLibrary::SplitItemStackAtLocation(Crate, SlotHandle, ItemStack.GetStackCount() - Excess);
+			}
+		}
+		PerItemSeconds += FPlatformTime::Seconds() - PerItemStart;
+		TestEqual(TEXT("Per item emptied the crate"), DescribeLayout(Crate), EmptyCrate);
+
+		Crate = MakeCrate();
+		TransferAllTarget = MakeTarget();
+		TArray<FRockInventorySlotHandle> LeftoverSlots;
+		const double TransferAllStart = FPlatformTime::Seconds();
+		URockInventoryLibrary::TransferAllItems(Crate, TransferAllTarget, nullptr, MovedCount, LeftoverSlots);
+		TransferAllSeconds += FPlatformTime::Seconds() - TransferAllStart;
+		TestEqual(TEXT("Transfer all emptied the crate"), DescribeLayout(Crate), EmptyCrate);
+		TestEqual(TEXT("No leftovers"), LeftoverSlots.Num(), 0);
+	}
+
+	TestEqual(TEXT("Moved count"), MovedCount, NumSingles + NumAmmoTypes * 10);
+	for (URockItemDefinition* Definition : {Singles[0], Ammo[0], Ammo.Last()})
+	{
+		TestEqual(FString::Printf(TEXT("Both targets hold the same %s"), *Definition->ItemId.ToString()),
+			URockInventoryLibrary::GetItemCount(TransferAllTarget, Definition->ItemId), URockInventoryLibrary::GetItemCount(PerItemTarget, Definition->ItemId));
+	}
+	TestEqual(TEXT("Ammo merged into the partial stack"), URockInventoryLibrary::GetItemCount(TransferAllTarget, Ammo[0]->ItemId), 40);
+
+	AddInfo(FString::Printf(TEXT("%d stacks: transfer all %.1f us, one loot per item %.1f us"),
+		NumSingles + NumAmmoTypes, TransferAllSeconds * 1e6 / NumRounds, PerItemSeconds * 1e6 / NumRounds));
+	return true;
+}
+
+#endif
@@ -0,0 +1,178 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "Transactions/Implementations/RockDropItemTransaction.h"
+#include "World/RockInventoryWorldContainer.h"
+#include "World/RockWorldItemSpawnSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryWorldContainerDropTest, "RockInventory.World.Container.Drop",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryWorldContainerDropTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	// Nothing written to disk
+	URockInventoryDeveloperSettings* Settings = GetMutableDefault<URockInventoryDeveloperSettings>();
+	TGuardValue<bool> JournalGuard(Settings->bEnableInventoryJournal, false);
+	TGuardValue<bool> AutosaveGuard(Settings->bEnableInventoryAutosave, false);
+	FScopedTestWorld TestWorld;
+	TestWorld.BeginPlay();
+	URockWorldItemSpawnSubsystem* Spawner = TestWorld.World->GetSubsystem<URockWorldItemSpawnSubsystem>();
+	if (!TestNotNull(TEXT("Spawner exists in game worlds"), Spawner))
+	{
+		return false;
+	}
+
+	// Creates its inventory as it begins play, like a player's
+	URockInventoryConfig* Config = NewObject<URockInventoryConfig>(GetTransientPackage());
+	Config->InventoryTabs.Add(FRockInventorySectionInfo(FGameplayTag(), 0, 4, 4));
+	AActor* Player = SpawnActorAt(TestWorld.World, FVector::ZeroVector);
+	URockInventoryComponent* Component = NewObject<URockInventoryComponent>(Player);
+	Component->InventoryConfig = Config;
+	Component->RegisterComponent();
+	URockInventory* Dropped = Component->Inventory;
+	if (!TestNotNull(TEXT("Inventory created on BeginPlay"), Dropped))
+	{
+		return false;
+	}
+	AddItem(Dropped, MakeDefinition(TEXT("Stone"), 10), 5);
+	AddItem(Dropped, MakeDefinition(TEXT("Rifle"), 1, FIntPoint(2, 1)), 1);
+	const FString Layout = DescribeLayout(Dropped);
+	const FGuid PersistentId = Dropped->GetPersistentId();
+
+	const FRockWorldItemSpawnHandle Handle = Component->DropInventoryAsContainer(FTransform(FVector(200.0, 0.0, 0.0)), nullptr);
+	TestTrue(TEXT("Queued"), Handle.IsValid() && Spawner->GetSpawnState(Handle) == ERockWorldItemSpawnState::Pending);
+	URockInventory* Fresh = Component->Inventory;
+	TestTrue(TEXT("Starts over with a fresh inventory"), Fresh && Fresh != Dropped);
+	TestEqual(TEXT("Which keeps the persistent id"), Fresh ? Fresh->GetPersistentId() : FGuid(), PersistentId);
+	TestEqual(TEXT("And is empty"), Fresh ? DescribeLayout(Fresh) : FString(), DescribeLayout(MakeInventory(4, 4)));
+
+	// The inventory object itself changes hands, before the container begins play
+	Spawner->FlushPendingSpawns();
+	ARockInventoryWorldContainer* Container = Cast<ARockInventoryWorldContainer>(Spawner->GetSpawnedActor(Handle));
+	if (!TestNotNull(TEXT("Container spawned"), Container))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Adopted, not copied"), Container->GetInventory() == Dropped);
+	TestTrue(TEXT("Owned by the container"), Dropped->GetOwner() == Container->InventoryComponent && Dropped->GetOuter() == Container->InventoryComponent);
+	TestNotEqual(TEXT("With an id of its own"), Dropped->GetPersistentId(), PersistentId);
+	TestEqual(TEXT("Same contents"), DescribeLayout(Dropped), Layout);
+
+	// Taking everything out destroys it on the next tick
+	int32 MovedCount = 0;
+	TArray<FRockInventorySlotHandle> LeftoverSlots;
+	TestTrue(TEXT("Taken back"), URockInventoryLibrary::TransferAllItems(Dropped, Fresh, nullptr, MovedCount, LeftoverSlots));
+	TestEqual(TEXT("All of it"), MovedCount, 6);
+	TestTrue(TEXT("Not while transferring"), IsValid(Container));
+	TestWorld.TickTimers(0.0f);
+	TestFalse(TEXT("Destroyed once empty"), IsValid(Container));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryWorldContainerDropBenchmarkTest, "RockInventory.World.Container.Drop.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryWorldContainerDropBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	constexpr int32 Columns = 12;
+	constexpr int32 Rows = 10;
+	constexpr int32 NumItems = Columns * Rows;
+
+	// Nothing written to disk, and every dropped item stays an actor
+	URockInventoryDeveloperSettings* Settings = GetMutableDefault<URockInventoryDeveloperSettings>();
+	TGuardValue<bool> JournalGuard(Settings->bEnableInventoryJournal, false);
+	TGuardValue<bool> AutosaveGuard(Settings->bEnableInventoryAutosave, false);
+	TGuardValue<bool> ClustersGuard(Settings->bEnableWorldItemClusters, false);
+	FScopedTestWorld TestWorld;
+	TestWorld.BeginPlay();
+	URockWorldItemSpawnSubsystem* Spawner = TestWorld.World->GetSubsystem<URockWorldItemSpawnSubsystem>();
+	if (!TestNotNull(TEXT("Spawner exists in game worlds"), Spawner))
+	{
+		return false;
+	}
+
+	// Single items, so every slot is its own drop
+	TArray<URockItemDefinition*> Definitions;
+	for (int32 Index = 0; Index < 12; ++Index)
+	{
+		Definitions.Add(MakeWorldDefinition(*FString::Printf(TEXT("Item%d"), Index)));
+	}
+	auto Fill = [&Definitions](URockInventory* Inventory)
+	{
+		for (int32 Index = 0; Index < NumItems; ++Index)
+		{
+			AddItem(Inventory, Definitions[Index % Definitions.Num()]);
+		}
+	};
+	auto CountWorldActors = [&TestWorld]()
+	{
+		int32 NumActors = 0;
+		for (TActorIterator<AActor> It(TestWorld.World); It; ++It)
+		{
+			NumActors += (It->IsA<ARockInventoryWorldItemBase>() || It->IsA<ARockInventoryWorldContainer>()) ? 1 : 0;
+		}
+		return NumActors;
+	};
+
+	// One drop transaction per item, as dying used to
+	URockInventoryManagerComponent* Manager = SpawnManager(TestWorld.World);
+	AController* Controller = Cast<AController>(Manager->GetOwner());
+	Controller->Possess(TestWorld.World->SpawnActor<APawn>());
+	URockInventory* PerItemInventory = MakeInventory(Columns, Rows);
+	Fill(PerItemInventory);
+
+	int32 NumDropped = 0;
+	const double PerItemStart = FPlatformTime::Seconds();
+	for (int32 SlotIndex = 0; SlotIndex < NumItems; ++SlotIndex)
+	{
+		NumDropped += FRockDropItemTransaction(Controller, PerItemInventory, FRockInventorySlotHandle(SlotIndex)).Execute().bSuccess ? 1 : 0;
+	}
+	const double PerItemQueuedSeconds = FPlatformTime::Seconds() - PerItemStart;
+	Spawner->FlushPendingSpawns();
+	const double PerItemSeconds = FPlatformTime::Seconds() - PerItemStart;
+	TestEqual(TEXT("Every item dropped"), NumDropped, NumItems);
+	const int32 NumPerItemActors = CountWorldActors();
+	TestEqual(TEXT("An actor per item"), NumPerItemActors, NumItems);
+
+	// The whole inventory handed to one container
+	URockInventoryConfig* Config = NewObject<URockInventoryConfig>(GetTransientPackage());
+	Config->InventoryTabs.Add(FRockInventorySectionInfo(FGameplayTag(), 0, Columns, Rows));
+	AActor* Player = SpawnActorAt(TestWorld.World, FVector::ZeroVector);
+	URockInventoryComponent* Component = NewObject<URockInventoryComponent>(Player);
+	Component->InventoryConfig = Config;
+	Component->RegisterComponent();
+	Fill(Component->Inventory);
+	const FString Layout = DescribeLayout(Component->Inventory);
+
+	const double ContainerStart = FPlatformTime::Seconds();
+	const FRockWorldItemSpawnHandle Handle = Component->DropInventoryAsContainer(FTransform(FVector(200.0, 0.0, 0.0)), nullptr);
+	const double ContainerQueuedSeconds = FPlatformTime::Seconds() - ContainerStart;
+	Spawner->FlushPendingSpawns();
+	const double ContainerSeconds = FPlatformTime::Seconds() - ContainerStart;
+	const ARockInventoryWorldContainer* Container = Cast<ARockInventoryWorldContainer>(Spawner->GetSpawnedActor(Handle));
+	if (!TestNotNull(TEXT("Container spawned"), Container))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Same contents"), DescribeLayout(Container->GetInventory()), Layout);
+	const int32 NumContainerActors = CountWorldActors() - NumPerItemActors;
+	TestEqual(TEXT("A single actor"), NumContainerActors, 1);
+
+	AddInfo(FString::Printf(TEXT("Death drop of %d items: %.3f ms (%.3f ms queuing) for %d actors one transaction per item, %.3f ms (%.3f ms queuing) for %d as a container"),
+		NumItems, PerItemSeconds * 1000.0, PerItemQueuedSeconds * 1000.0, NumPerItemActors,
+		ContainerSeconds * 1000.0, ContainerQueuedSeconds * 1000.0, NumContainerActors));
+	return true;
+}
+
+#endif
@@ -0,0 +1,119 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "World/RockWorldItemClusterSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryWorldItemRestTest, "RockInventory.World.WorldItem.Rest",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryWorldItemRestTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	URockInventoryDeveloperSettings* Settings = GetMutableDefault<URockInventoryDeveloperSettings>();
+	TGuardValue<bool> ClustersGuard(Settings->bEnableWorldItemClusters, true);
+	TGuardValue<float> DemoteDelayGuard(Settings->WorldItemClusterDemoteDelay, 5.0f);
+	FScopedTestWorld TestWorld;
+	TestWorld.BeginPlay();
+	URockWorldItemClusterSubsystem* Clusters = TestWorld.World->GetSubsystem<URockWorldItemClusterSubsystem>();
+	if (!TestTrue(TEXT("Clusters enabled"), Clusters && Clusters->IsEnabled()))
+	{
+		return false;
+	}
+
+	// Placed rather than thrown, so it comes to rest as soon as it begins play
+	URockItemDefinition* Stone = MakeWorldDefinition(TEXT("Stone"), 10);
+	ARockInventoryWorldItemBase* WorldItem = SpawnWorldItem(TestWorld.World, FRockItemStack(Stone, 3), FVector(100.0, 0.0, 0.0));
+	TestFalse(TEXT("Resting items don't tick"), WorldItem->IsActorTickEnabled());
+	TestTrue(TEXT("Resting items are dormant"), WorldItem->NetDormancy == DORM_DormantAll);
+	TestEqual(TEXT("Still an actor before the delay"), Clusters->GetNumItems(), 0);
+
+	// Throwing wakes it up again and cancels its demotion
+	ARockInventoryWorldItemBase* Thrown = SpawnWorldItem(TestWorld.World, FRockItemStack(Stone, 1), FVector(3000.0, 0.0, 0.0));
+	Thrown->ApplyThrowImpulse(FVector(0.0, 0.0, 500.0));
+	TestTrue(TEXT("Thrown items tick"), Thrown->IsActorTickEnabled());
+	TestTrue(TEXT("Thrown items are awake"), Thrown->NetDormancy == DORM_Awake);
+
+	TestWorld.TickTimers(4.0f);
+	TestTrue(TEXT("Not demoted early"), IsValid(WorldItem));
+	TestWorld.TickTimers(2.0f);
+	TestFalse(TEXT("Demoted after resting for the delay"), IsValid(WorldItem));
+	TestTrue(TEXT("Moving items stay actors"), IsValid(Thrown));
+	TestEqual(TEXT("Now a cluster entry"), Clusters->GetNumItems(), 1);
+
+	TArray<FRockWorldItemClusterHit> Hits;
+	Clusters->FindItemsInRadius(FVector(100.0, 0.0, 0.0), 1.0f, 0, Hits);
+	const FRockWorldItemClusterEntry* Entry = Hits.Num() == 1 ? Hits[0].Cluster->FindEntry(Hits[0].EntryId) : nullptr;
+	TestTrue(TEXT("Same stack, same place"), Entry && Entry->ItemStack.GetStackCount() == 3 && Entry->ItemStack.GetDefinition() == Stone);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryWorldItemRestBenchmarkTest, "RockInventory.World.WorldItem.Rest.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryWorldItemRestBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	constexpr int32 NumWorldItems = 5000;
+	constexpr int32 NumFrames = 30;
+
+	// Actors only, so nothing is demoted into a cluster
+	TGuardValue<bool> ClustersGuard(GetMutableDefault<URockInventoryDeveloperSettings>()->bEnableWorldItemClusters, false);
+	FScopedTestWorld TestWorld;
+	TestWorld.BeginPlay();
+
+	URockItemDefinition* Stone = MakeWorldDefinition(TEXT("Stone"), 10);
+	FRandomStream Random(47);
+	TArray<ARockInventoryWorldItemBase*> WorldItems;
+	for (int32 Index = 0; Index < NumWorldItems; ++Index)
+	{
+		WorldItems.Add(SpawnWorldItem(TestWorld.World, FRockItemStack(Stone, 1),
+			FVector(Random.FRandRange(0.0, 30000.0), Random.FRandRange(0.0, 30000.0), 0.0)));
+	}
+
+	// The net driver has no work for dormant actors until they're flushed, so what it would look at each frame is the awake ones
+	auto Measure = [&TestWorld, &WorldItems](int32& OutNumTicking, int32& OutNumAwake)
+	{
+		OutNumTicking = 0;
+		OutNumAwake = 0;
+		for (const ARockInventoryWorldItemBase* WorldItem : WorldItems)
+		{
+			OutNumTicking += WorldItem->IsActorTickEnabled() ? 1 : 0;
+			OutNumAwake += WorldItem->NetDormancy <= DORM_Awake ? 1 : 0;
+		}
+		const double TickStart = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			TestWorld.World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+		}
+		return (FPlatformTime::Seconds() - TickStart) / NumFrames;
+	};
+
+	int32 NumRestingTicking = 0;
+	int32 NumRestingAwake = 0;
+	const double RestingFrameSeconds = Measure(NumRestingTicking, NumRestingAwake);
+	TestEqual(TEXT("No resting item ticks"), NumRestingTicking, 0);
+	TestEqual(TEXT("Every resting item is dormant"), NumRestingAwake, 0);
+
+	// How the same items were before they could rest
+	for (ARockInventoryWorldItemBase* WorldItem : WorldItems)
+	{
+		WorldItem->SetActorTickEnabled(true);
+		WorldItem->SetNetDormancy(DORM_Awake);
+	}
+	int32 NumAwakeTicking = 0;
+	int32 NumAwake = 0;
+	const double AwakeFrameSeconds = Measure(NumAwakeTicking, NumAwake);
+
+	AddInfo(FString::Printf(TEXT("%d resting world items: server tick %.3f ms with %d ticking and %d awake for the net driver, %.3f ms with %d ticking and %d awake"),
+		NumWorldItems, RestingFrameSeconds * 1000.0, NumRestingTicking, NumRestingAwake, AwakeFrameSeconds * 1000.0, NumAwakeTicking, NumAwake));
+	return true;
+}
+
+#endif
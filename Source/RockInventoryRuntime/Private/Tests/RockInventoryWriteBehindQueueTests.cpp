@@ -0,0 +1,161 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+#include "Persistence/RockInventoryWriteBehindQueue.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RockInventoryWriteBehindQueueTests
+{
+	FRockInventorySaveData MakeSaveData(int32 NumItems)
+	{
+		FRockInventorySaveData SaveData;
+		SaveData.InventoryId = FGuid::NewGuid();
+		for (int32 Index = 0; Index < NumItems; ++Index)
+		{
+			FRockItemStackSaveData& Item = SaveData.Items.AddDefaulted_GetRef();
+			Item.ItemId = TEXT("Arrow");
+			Item.StackCount = Index + 1;
+			Item.bValid = true;
+		}
+		return SaveData;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryWriteBehindBlobTest, "RockInventory.Persistence.WriteBehind.BlobRoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryWriteBehindBlobTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryWriteBehindQueueTests;
+
+	for (const bool bCompress : {false, true})
+	{
+		FRockInventorySaveData SaveData = MakeSaveData(200);
+		TArray<uint8> Blob;
+		if (!TestTrue(TEXT("Encodes"), FRockInventoryWriteBehindQueue::EncodeBlob(SaveData, bCompress, Blob)))
+		{
+			return false;
+		}
+		TArray<uint8> SaveBytes;
+		if (!TestTrue(TEXT("Decodes"), FRockInventoryWriteBehindQueue::DecodeBlob(Blob, SaveBytes)))
+		{
+			return false;
+		}
+		FRockInventorySaveData Loaded;
+		FMemoryReader Reader(SaveBytes);
+		TestTrue(TEXT("Decoded bytes are save data"), Loaded.Serialize(Reader));
+		TestEqual(TEXT("InventoryId"), Loaded.InventoryId, SaveData.InventoryId);
+		TestTrue(TEXT("Items"), Loaded.Items.Num() == 200 && Loaded.Items.Last().StackCount == 200);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryWriteBehindForgedSizeTest, "RockInventory.Persistence.WriteBehind.RejectsForgedSize",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryWriteBehindForgedSizeTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryWriteBehindQueueTests;
+
+	FRockInventorySaveData SaveData = MakeSaveData(8);
+	TArray<uint8> Blob;
+	FRockInventoryWriteBehindQueue::EncodeBlob(SaveData, true, Blob);
+
+	// The uncompressed size follows the magic. Each of these must be refused before anything is allocated for it
+	AddExpectedMessage(TEXT("rejecting it"), EAutomationExpectedMessageFlags::Contains, 3);
+	for (const uint32 ForgedSize : {0u, MAX_uint32, static_cast<uint32>(Blob.Num()) * 4096u})
+	{
+		TArray<uint8> Forged = Blob;
+		FMemory::Memcpy(Forged.GetData() + sizeof(uint32), &ForgedSize, sizeof(uint32));
+		TArray<uint8> SaveBytes;
+		TestFalse(FString::Printf(TEXT("Claimed size %u is rejected"), ForgedSize), FRockInventoryWriteBehindQueue::DecodeBlob(Forged, SaveBytes));
+		TestTrue(TEXT("Nothing was allocated"), SaveBytes.Max() == 0);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockInventoryWriteBehindBenchmarkTest, "RockInventory.Persistence.WriteBehind.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockInventoryWriteBehindBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	constexpr int32 NumInventories = 500;
+	constexpr int32 NumItemsPerInventory = 100;
+	constexpr int32 BatchSize = 32;
+
+	URockItemDefinition* Arrow = MakeDefinition(TEXT("Arrow"), 60);
+	URockItemDefinition* Sword = MakeDefinition(TEXT("Sword"));
+	TArray<URockInventory*> Inventories;
+	for (int32 InventoryIndex = 0; InventoryIndex < NumInventories; ++InventoryIndex)
+	{
+		URockInventory* Inventory = MakeInventory(20, 10);
+		for (int32 ItemIndex = 0; ItemIndex < NumItemsPerInventory; ++ItemIndex)
+		{
+			AddItem(Inventory, ItemIndex % 2 == 0 ? Sword : Arrow, ItemIndex % 2 == 0 ? 1 : 60);
+		}
+		Inventories.Add(Inventory);
+	}
+
+	const FString Directory = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("RockInventoryWriteBehindBenchmark"));
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	TSharedRef<FRockInventoryFileStorageBackend, ESPMode::ThreadSafe> Backend = MakeShared<FRockInventoryFileStorageBackend, ESPMode::ThreadSafe>(Directory);
+
+	// What an autosave costs when the game thread does all of it
+	const double InlineStart = FPlatformTime::Seconds();
+	int32 NumInlineWritten = 0;
+	for (URockInventory* Inventory : Inventories)
+	{
+		FRockInventoryStorageRecord Record;
+		FRockInventorySaveData SaveData = FRockInventorySaveData::Capture(Inventory);
+		Record.InventoryId = SaveData.InventoryId;
+		FRockInventoryWriteBehindQueue::EncodeBlob(SaveData, true, Record.Bytes);
+		NumInlineWritten += Backend->WriteBatch(MakeArrayView(&Record, 1));
+	}
+	const double InlineSeconds = FPlatformTime::Seconds() - InlineStart;
+	TestEqual(TEXT("Every inline write landed"), NumInlineWritten, NumInventories);
+
+	// The write-behind autosave: only Capture, Enqueue and Submit stay on the game thread
+	FRockInventoryWriteBehindQueue Queue(Backend);
+	const double GameThreadStart = FPlatformTime::Seconds();
+	for (URockInventory* Inventory : Inventories)
+	{
+		Queue.Enqueue(FRockInventorySaveData::Capture(Inventory));
+	}
+	Queue.Submit(BatchSize, true);
+	const double GameThreadSeconds = FPlatformTime::Seconds() - GameThreadStart;
+	Queue.WaitForCompletion();
+	const double TotalSeconds = FPlatformTime::Seconds() - GameThreadStart;
+
+	const FRockInventoryWriteBehindStats Stats = Queue.GetStats();
+	TestEqual(TEXT("Every inventory written"), Stats.InventoriesWritten, static_cast<int64>(NumInventories));
+	TestEqual(TEXT("No failed writes"), Stats.FailedWrites, static_cast<int64>(0));
+
+	TArray<uint8> Blob;
+	TArray<uint8> SaveBytes;
+	FRockInventorySaveData Loaded;
+	if (TestTrue(TEXT("Last inventory is readable"), Backend->Read(Inventories.Last()->GetPersistentId(), Blob)
+		&& FRockInventoryWriteBehindQueue::DecodeBlob(Blob, SaveBytes)))
+	{
+		FMemoryReader Reader(SaveBytes);
+		TestTrue(TEXT("Last inventory decodes"), Loaded.Serialize(Reader));
+		TestEqual(TEXT("Last inventory's id"), Loaded.InventoryId, Inventories.Last()->GetPersistentId());
+	}
+
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+
+	const double MegaBytes = Stats.BytesWritten / (1024.0 * 1024.0);
+	AddInfo(FString::Printf(TEXT("%d dirty inventories: game thread %.2f ms with write-behind vs %.2f ms inline. %.2f MB written in %.1f ms (%.1f MB/s, %.1f MB/s per busy worker)"),
+		NumInventories, GameThreadSeconds * 1000.0, InlineSeconds * 1000.0, MegaBytes, TotalSeconds * 1000.0,
+		MegaBytes / TotalSeconds, Stats.GetBytesPerSecond() / (1024.0 * 1024.0)));
+	return true;
+}
+
+#endif
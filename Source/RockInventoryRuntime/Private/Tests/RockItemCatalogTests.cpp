@@ -0,0 +1,175 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Item/ItemRegistry/RockItemCatalog.h"
+
+#include "HAL/FileManager.h"
+#include "Item/ItemRegistry/RockItemDefinitionTable.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Misc/RockInventoryTags.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RockItemCatalogTests
+{
+	FRockItemCatalogEntry MakeEntry(FName ItemId, FGameplayTag Rarity, int32 MaxStackCount)
+	{
+		FRockItemCatalogEntry Entry;
+		Entry.ItemId = ItemId;
+		Entry.AssetPath = FSoftObjectPath(FString::Printf(TEXT("/Game/Items/%s.%s"), *ItemId.ToString(), *ItemId.ToString()));
+		Entry.ItemRarity = Rarity;
+		Entry.ItemType.AddTag(Rarity);
+		Entry.GridSize = FIntPoint(2, 3);
+		Entry.MaxStackCount = MaxStackCount;
+		Entry.Weight = 1500;
+		return Entry;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockItemCatalogRoundTripTest, "RockInventory.ItemRegistry.Catalog.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockItemCatalogRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace RockItemCatalogTests;
+
+	FRockItemCatalog Catalog;
+	Catalog.AddEntry(MakeEntry(TEXT("Sword"), RockInventoryTags::Item_Rarity_Rare, 1));
+	Catalog.AddEntry(MakeEntry(TEXT("Arrow"), RockInventoryTags::Item_Rarity_Common, 60));
+	Catalog.SourceHash = 0xC0FFEE;
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	TestTrue(TEXT("Saves"), Catalog.Serialize(Writer));
+
+	FRockItemCatalog Loaded;
+	FMemoryReader Reader(Bytes);
+	if (!TestTrue(TEXT("Loads"), Loaded.Serialize(Reader)))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Entry count"), Loaded.Num(), 2);
+	TestEqual(TEXT("SourceHash"), Loaded.SourceHash, 0xC0FFEEu);
+
+	const FRockItemCatalogEntry* Arrow = Loaded.Find(TEXT("Arrow"));
+	if (!TestNotNull(TEXT("Find"), Arrow))
+	{
+		return false;
+	}
+	TestEqual(TEXT("DenseId is the entry order"), Arrow->DenseId, 1);
+	TestEqual(TEXT("AssetPath"), Arrow->AssetPath.ToString(), FString(TEXT("/Game/Items/Arrow.Arrow")));
+	TestTrue(TEXT("ItemRarity"), Arrow->ItemRarity == RockInventoryTags::Item_Rarity_Common);
+	TestTrue(TEXT("ItemType"), Arrow->ItemType.HasTagExact(RockInventoryTags::Item_Rarity_Common));
+	TestEqual(TEXT("GridSize"), Arrow->GridSize, FIntPoint(2, 3));
+	TestEqual(TEXT("MaxStackCount"), Arrow->MaxStackCount, 60);
+	TestEqual(TEXT("Weight"), Arrow->Weight, static_cast<int64>(1500));
+
+	// A catalog from another build must be rejected, not half read
+	Bytes[0] ^= 0xFF;
+	FRockItemCatalog Corrupt;
+	FMemoryReader CorruptReader(Bytes);
+	TestFalse(TEXT("Unknown magic is rejected"), Corrupt.Serialize(CorruptReader));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockItemCatalogSourceHashTest, "RockInventory.ItemRegistry.Catalog.SourceHash",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockItemCatalogSourceHashTest::RunTest(const FString& Parameters)
+{
+	const FSoftObjectPath Sword(TEXT("/Game/Items/Sword.Sword"));
+	const FSoftObjectPath Arrow(TEXT("/Game/Items/Arrow.Arrow"));
+	const FSoftObjectPath Bow(TEXT("/Game/Items/Bow.Bow"));
+	const uint32 Hash = FRockItemCatalog::HashSourceAssets({Sword, Arrow});
+
+	TestEqual(TEXT("Enumeration order doesn't matter"), FRockItemCatalog::HashSourceAssets({Arrow, Sword}), Hash);
+	// The count alone would let all of these through
+	TestNotEqual(TEXT("A renamed asset"), FRockItemCatalog::HashSourceAssets({Sword, FSoftObjectPath(TEXT("/Game/Items/Arrows.Arrows"))}), Hash);
+	TestNotEqual(TEXT("A moved asset"), FRockItemCatalog::HashSourceAssets({Sword, FSoftObjectPath(TEXT("/Game/Ammo/Arrow.Arrow"))}), Hash);
+	TestNotEqual(TEXT("One asset swapped for another"), FRockItemCatalog::HashSourceAssets({Sword, Bow}), Hash);
+	TestNotEqual(TEXT("An added asset"), FRockItemCatalog::HashSourceAssets({Sword, Arrow, Bow}), Hash);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockItemCatalogTableTest, "RockInventory.ItemRegistry.Catalog.InitializeTable",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockItemCatalogTableTest::RunTest(const FString& Parameters)
+{
+	using namespace RockItemCatalogTests;
+
+	FRockItemCatalog Catalog;
+	Catalog.AddEntry(MakeEntry(TEXT("Sword"), RockInventoryTags::Item_Rarity_Rare, 1));
+	Catalog.AddEntry(MakeEntry(TEXT("Arrow"), RockInventoryTags::Item_Rarity_Common, 60));
+	Catalog.AddEntry(MakeEntry(TEXT("Crown"), RockInventoryTags::Item_Rarity_Rare, 1));
+
+	FRockItemDefinitionTable Table;
+	Table.InitializeFromCatalog(Catalog);
+	TestEqual(TEXT("One slot per entry"), Table.Num(), 3);
+	TestEqual(TEXT("Dense index matches the catalog"), Table.FindIndex(TEXT("Crown")), 2);
+	TestNull(TEXT("Definitions stay unset until loaded"), Table.GetDefinition(2));
+
+	// Queries work before a single asset is loaded
+	const TConstArrayView<int32> Rare = Table.GetIndicesOfRarity(RockInventoryTags::Item_Rarity_Rare);
+	TestTrue(TEXT("Rarity posting list"), Rare.Num() == 2 && Rare[0] == 0 && Rare[1] == 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockItemCatalogBenchmarkTest, "RockInventory.ItemRegistry.Catalog.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockItemCatalogBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockItemCatalogTests;
+
+	constexpr int32 NumEntries = 10000;
+	const FGameplayTag Rarities[] = {RockInventoryTags::Item_Rarity_Common, RockInventoryTags::Item_Rarity_Uncommon, RockInventoryTags::Item_Rarity_Rare};
+
+	FRockItemCatalog Catalog;
+	TArray<FSoftObjectPath> SourceAssetPaths;
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		FRockItemCatalogEntry Entry = MakeEntry(*FString::Printf(TEXT("Item_%d"), Index), Rarities[Index % UE_ARRAY_COUNT(Rarities)], 1 + Index % 60);
+		SourceAssetPaths.Add(Entry.AssetPath);
+		Catalog.AddEntry(MoveTemp(Entry));
+	}
+	Catalog.SourceHash = FRockItemCatalog::HashSourceAssets(SourceAssetPaths);
+
+	const FString Filename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("RockItemCatalogBenchmark.bin"));
+	if (!TestTrue(TEXT("Saves"), Catalog.SaveToFile(Filename)))
+	{
+		return false;
+	}
+	const int64 FileSize = IFileManager::Get().FileSize(*Filename);
+
+	// Everything BuildRegistryFromCatalog does before IDs and metadata can be queried: read the file, check it's current, build the table.
+	// The asset manager scan it replaces needs real definition assets, so it can't be measured from here
+	FRockItemCatalog Loaded;
+	FRockItemDefinitionTable Table;
+	const double StartTime = FPlatformTime::Seconds();
+	const bool bLoaded = Loaded.LoadFromFile(Filename);
+	const double LoadedTime = FPlatformTime::Seconds();
+	const uint32 SourceHash = FRockItemCatalog::HashSourceAssets(SourceAssetPaths);
+	const double HashedTime = FPlatformTime::Seconds();
+	Table.InitializeFromCatalog(Loaded);
+	const double ReadyTime = FPlatformTime::Seconds();
+
+	IFileManager::Get().Delete(*Filename);
+
+	if (!TestTrue(TEXT("Loads"), bLoaded))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Source hash matches"), SourceHash, Loaded.SourceHash);
+	TestEqual(TEXT("One slot per entry"), Table.Num(), NumEntries);
+	TestEqual(TEXT("Last entry is found"), Table.FindIndex(*FString::Printf(TEXT("Item_%d"), NumEntries - 1)), NumEntries - 1);
+
+	AddInfo(FString::Printf(TEXT("%d entry catalog (%lld bytes) ready in %.2f ms: read %.2f ms, source hash %.2f ms, table %.2f ms"),
+		NumEntries, FileSize, (ReadyTime - StartTime) * 1000.0, (LoadedTime - StartTime) * 1000.0,
+		(HashedTime - LoadedTime) * 1000.0, (ReadyTime - HashedTime) * 1000.0));
+	return true;
+}
+
+#endif
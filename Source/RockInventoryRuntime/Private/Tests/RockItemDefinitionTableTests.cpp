@@ -0,0 +1,129 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Item/ItemRegistry/RockItemDefinitionTable.h"
+
+#include "Item/RockItemDefinition.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/RockInventoryTags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RockItemDefinitionTableTests
+{
+	URockItemDefinition* MakeDefinition(FName ItemId, FGameplayTag Rarity)
+	{
+		URockItemDefinition* Definition = NewObject<URockItemDefinition>(GetTransientPackage());
+		Definition->ItemId = ItemId;
+		Definition->ItemRarity = Rarity;
+		// Only the rarity tags are native to this module, so they stand in for item types as well
+		Definition->ItemType.AddTag(Rarity);
+		return Definition;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockItemDefinitionTableTest, "RockInventory.ItemRegistry.DefinitionTable",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockItemDefinitionTableTest::RunTest(const FString& Parameters)
+{
+	using namespace RockItemDefinitionTableTests;
+
+	FRockItemDefinitionTable Table;
+	URockItemDefinition* Sword = MakeDefinition(TEXT("Sword"), RockInventoryTags::Item_Rarity_Rare);
+	URockItemDefinition* Apple = MakeDefinition(TEXT("Apple"), RockInventoryTags::Item_Rarity_Common);
+	URockItemDefinition* Crown = MakeDefinition(TEXT("Crown"), RockInventoryTags::Item_Rarity_Rare);
+
+	TestEqual(TEXT("Dense indices follow insertion order"), Table.Add(Sword), 0);
+	TestEqual(TEXT("Dense indices follow insertion order"), Table.Add(Apple), 1);
+	TestEqual(TEXT("Dense indices follow insertion order"), Table.Add(Crown), 2);
+	TestEqual(TEXT("A duplicate ItemId is refused"), Table.Add(MakeDefinition(TEXT("Apple"), RockInventoryTags::Item_Rarity_Epic)), INDEX_NONE);
+	TestEqual(TEXT("An unnamed definition is refused"), Table.Add(MakeDefinition(NAME_None, RockInventoryTags::Item_Rarity_Epic)), INDEX_NONE);
+	TestEqual(TEXT("Num"), Table.Num(), 3);
+
+	TestEqual(TEXT("FindIndex"), Table.FindIndex(TEXT("Crown")), 2);
+	TestEqual(TEXT("FindIndex of an unknown id"), Table.FindIndex(TEXT("Missing")), INDEX_NONE);
+	TestTrue(TEXT("FindDefinition"), Table.FindDefinition(TEXT("Apple")) == Apple);
+
+	const TConstArrayView<int32> Rare = Table.GetIndicesOfRarity(RockInventoryTags::Item_Rarity_Rare);
+	TestTrue(TEXT("Rarity posting list is sorted and exact"), Rare.Num() == 2 && Rare[0] == 0 && Rare[1] == 2);
+	TestEqual(TEXT("Unused rarity has an empty posting list"), Table.GetIndicesOfRarity(RockInventoryTags::Item_Rarity_Legendary).Num(), 0);
+
+	// Indexed with their parents, so the parent tag matches every child
+	const FGameplayTag RarityParent = RockInventoryTags::Item_Rarity_Rare.GetTag().RequestDirectParent();
+	TestEqual(TEXT("Parent tag matches all children"), Table.GetIndicesOfType(RarityParent).Num(), 3);
+	TestEqual(TEXT("Child tag only matches itself"), Table.GetIndicesOfType(RockInventoryTags::Item_Rarity_Common).Num(), 1);
+
+	TArray<URockItemDefinition*> Resolved;
+	Table.ResolveIndices(Rare, Resolved);
+	TestTrue(TEXT("ResolveIndices keeps the order"), Resolved.Num() == 2 && Resolved[0] == Sword && Resolved[1] == Crown);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockItemDefinitionTableBenchmarkTest, "RockInventory.ItemRegistry.DefinitionTable.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockItemDefinitionTableBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockItemDefinitionTableTests;
+
+	constexpr int32 NumDefinitions = 10000;
+	constexpr int32 NumQueries = 1000;
+
+	// Skewed like a real catalog, so the rare queries return a small slice of it
+	TArray<URockItemDefinition*> Definitions;
+	Definitions.Reserve(NumDefinitions);
+	for (int32 Index = 0; Index < NumDefinitions; ++Index)
+	{
+		const FGameplayTag Rarity = Index % 100 == 0 ? RockInventoryTags::Item_Rarity_Legendary
+			: Index % 20 == 0 ? RockInventoryTags::Item_Rarity_Epic
+			: Index % 5 == 0 ? RockInventoryTags::Item_Rarity_Rare
+			: Index % 2 == 0 ? RockInventoryTags::Item_Rarity_Uncommon
+			: RockInventoryTags::Item_Rarity_Common;
+		Definitions.Add(MakeDefinition(*FString::Printf(TEXT("Item_%d"), Index), Rarity));
+	}
+
+	FRockItemDefinitionTable Table;
+	const double BuildStart = FPlatformTime::Seconds();
+	for (URockItemDefinition* Definition : Definitions)
+	{
+		Table.Add(Definition);
+	}
+	Table.Compact();
+	const double BuildSeconds = FPlatformTime::Seconds() - BuildStart;
+	TestEqual(TEXT("Every definition added"), Table.Num(), NumDefinitions);
+
+	const FGameplayTag Queries[] = {RockInventoryTags::Item_Rarity_Legendary, RockInventoryTags::Item_Rarity_Epic, RockInventoryTags::Item_Rarity_Common};
+	for (const FGameplayTag& Query : Queries)
+	{
+		// What a lookup costs without the inverted index: a check of every definition
+		int32 NumScanned = 0;
+		const double ScanStart = FPlatformTime::Seconds();
+		for (int32 Round = 0; Round < NumQueries; ++Round)
+		{
+			NumScanned = 0;
+			for (const URockItemDefinition* Definition : Table.GetDefinitions())
+			{
+				NumScanned += Definition->ItemType.HasTag(Query) ? 1 : 0;
+			}
+		}
+		const double ScanSeconds = FPlatformTime::Seconds() - ScanStart;
+
+		TArray<URockItemDefinition*> Resolved;
+		const double IndexStart = FPlatformTime::Seconds();
+		for (int32 Round = 0; Round < NumQueries; ++Round)
+		{
+			Resolved.Reset();
+			Table.ResolveIndices(Table.GetIndicesOfType(Query), Resolved);
+		}
+		const double IndexSeconds = FPlatformTime::Seconds() - IndexStart;
+
+		TestEqual(*FString::Printf(TEXT("%s matches the scan"), *Query.ToString()), Resolved.Num(), NumScanned);
+		AddInfo(FString::Printf(TEXT("%s: %d results, scan %.2f us, index %.2f us per query"),
+			*Query.ToString(), Resolved.Num(), ScanSeconds * 1e6 / NumQueries, IndexSeconds * 1e6 / NumQueries));
+	}
+
+	AddInfo(FString::Printf(TEXT("Built a %d definition table in %.2f ms"), NumDefinitions, BuildSeconds * 1000.0));
+	return true;
+}
+
+#endif
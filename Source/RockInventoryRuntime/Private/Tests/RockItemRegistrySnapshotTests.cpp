@@ -0,0 +1,224 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Item/ItemRegistry/RockItemRegistrySnapshot.h"
+
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Item/ItemRegistry/RockItemDefinitionRegistry.h"
+#include "Library/RockItemStackLibrary.h"
+#include "Misc/AutomationTest.h"
+#include "Tasks/Task.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockItemRegistrySnapshotTest, "RockInventory.ItemRegistry.Snapshot.WorkerReads",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockItemRegistrySnapshotTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumItems = 512;
+	FRockItemCatalog Catalog;
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		FRockItemCatalogEntry Entry;
+		Entry.ItemId = FName(TEXT("Item"), Index + 1);
+		Entry.MaxStackCount = Index;
+		Catalog.AddEntry(MoveTemp(Entry));
+	}
+	FRockItemDefinitionTable Table;
+	Table.InitializeFromCatalog(Catalog);
+	TArray<FRockItemCatalogEntry> Metadata = Catalog.GetEntries();
+	const FRockItemRegistrySnapshot Snapshot(Table, MoveTemp(Metadata), 1);
+
+	// Every worker reads the whole snapshot, nothing synchronizes them
+	std::atomic<int32> NumMismatches = 0;
+	ParallelFor(32, [&Snapshot, &NumMismatches](int32)
+	{
+		for (int32 Index = 0; Index < NumItems; ++Index)
+		{
+			const FRockItemCatalogEntry* Entry = Snapshot.FindMetadata(FName(TEXT("Item"), Index + 1));
+			if (!Entry || Entry->DenseId != Index || Entry->MaxStackCount != Index)
+			{
+				NumMismatches.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	});
+	TestEqual(TEXT("Worker reads see the published data"), NumMismatches.load(), 0);
+	TestNull(TEXT("Unknown ids have no metadata"), Snapshot.FindMetadata(TEXT("Missing")));
+
+	// Off the game thread, a miss must not fall back to the registry's on demand loading
+	UE::Tasks::TTask<URockItemDefinition*> Lookup = UE::Tasks::Launch(UE_SOURCE_LOCATION, []
+	{
+		return URockItemStackLibrary::GetItemDefinitionById(TEXT("RockInventoryTest_Missing"));
+	});
+	TestNull(TEXT("Worker lookup of a missing id"), Lookup.GetResult());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockItemRegistrySnapshotPublishTest, "RockInventory.ItemRegistry.Snapshot.ReadsDuringPublish",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockItemRegistrySnapshotPublishTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumItems = 256;
+	constexpr int32 NumRounds = 200;
+	constexpr int32 NumReaders = 16;
+
+	// Round R has NumItems + R % 7 entries, entry I carries MaxStackCount R * 1000 + I. A read mixing two publishes can't satisfy both.
+	URockItemRegistrySubsystem* Registry = NewObject<URockItemRegistrySubsystem>();
+	auto BuildRound = [Registry](int32 Round)
+	{
+		Registry->Catalog.Reset();
+		for (int32 Index = 0; Index < NumItems + Round % 7; ++Index)
+		{
+			FRockItemCatalogEntry Entry;
+			Entry.ItemId = FName(TEXT("Item"), Index + 1);
+			Entry.MaxStackCount = Round * 1000 + Index;
+			Registry->Catalog.AddEntry(MoveTemp(Entry));
+		}
+		Registry->DefinitionTable.Reset();
+		Registry->DefinitionTable.InitializeFromCatalog(Registry->Catalog);
+	};
+	BuildRound(0);
+	Registry->PublishSnapshot();
+
+	struct FObservation
+	{
+		uint32 Version = 0;
+		int32 Round = 0;
+	};
+	TArray<TArray<FObservation>> Observations;
+	Observations.SetNum(NumReaders);
+	std::atomic<int32> NumInconsistentReads = 0;
+	std::atomic<int32> NumVersionsGoingBack = 0;
+	std::atomic<bool> bPublishing = true;
+
+	UE::Tasks::TTask<void> Readers = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&]
+	{
+		ParallelFor(NumReaders, [&](int32 ReaderIndex)
+		{
+			uint32 LastVersion = 0;
+			// One more pass after publishing stops, so every reader reads at least once
+			for (bool bLastPass = false; !bLastPass; )
+			{
+				bLastPass = !bPublishing.load(std::memory_order_acquire);
+				const FRockItemRegistrySnapshot* Snapshot = URockItemRegistrySubsystem::GetSnapshot();
+				if (!Snapshot)
+				{
+					NumInconsistentReads.fetch_add(1, std::memory_order_relaxed);
+					continue;
+				}
+				if (Snapshot->GetVersion() < LastVersion)
+				{
+					NumVersionsGoingBack.fetch_add(1, std::memory_order_relaxed);
+				}
+				LastVersion = Snapshot->GetVersion();
+
+				const FRockItemCatalogEntry* First = Snapshot->GetMetadata(0);
+				const int32 Round = First ? First->MaxStackCount / 1000 : -1;
+				bool bConsistent = Round >= 0 && Snapshot->Num() == NumItems + Round % 7;
+				for (int32 Index = 0; bConsistent && Index < Snapshot->Num(); ++Index)
+				{
+					const FRockItemCatalogEntry* Entry = Snapshot->FindMetadata(FName(TEXT("Item"), Index + 1));
+					bConsistent = Entry && Entry->DenseId == Index && Entry->MaxStackCount == Round * 1000 + Index
+						&& Snapshot->FindIndex(Entry->ItemId) == Index;
+				}
+				if (!bConsistent)
+				{
+					NumInconsistentReads.fetch_add(1, std::memory_order_relaxed);
+				}
+				Observations[ReaderIndex].Add({Snapshot->GetVersion(), Round});
+			}
+		});
+	});
+
+	for (int32 Round = 1; Round <= NumRounds; ++Round)
+	{
+		BuildRound(Round);
+		Registry->PublishSnapshot();
+	}
+	bPublishing.store(false, std::memory_order_release);
+	Readers.Wait();
+
+	TestEqual(TEXT("Every read saw a single publish"), NumInconsistentReads.load(), 0);
+	TestEqual(TEXT("Versions never go back"), NumVersionsGoingBack.load(), 0);
+
+	// A version always carries the same contents, whichever reader saw it
+	TMap<uint32, int32> RoundOfVersion;
+	int32 NumReads = 0;
+	int32 NumVersionMismatches = 0;
+	for (const TArray<FObservation>& ReaderObservations : Observations)
+	{
+		NumReads += ReaderObservations.Num();
+		for (const FObservation& Observation : ReaderObservations)
+		{
+			const int32& Round = RoundOfVersion.FindOrAdd(Observation.Version, Observation.Round);
+			NumVersionMismatches += Round != Observation.Round ? 1 : 0;
+		}
+	}
+	TestEqual(TEXT("One version, one content"), NumVersionMismatches, 0);
+	TestTrue(TEXT("Every reader read"), NumReads >= NumReaders);
+	AddInfo(FString::Printf(TEXT("%d reads across %d published versions"), NumReads, RoundOfVersion.Num()));
+
+	// Unpublishes and frees every snapshot
+	Registry->Deinitialize();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockItemRegistrySnapshotBenchmarkTest, "RockInventory.ItemRegistry.Snapshot.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockItemRegistrySnapshotBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumItems = 10000;
+	constexpr int32 NumLookupsPerTask = 1000000;
+	constexpr int32 NumTasks = 16;
+
+	URockItemRegistrySubsystem* Registry = NewObject<URockItemRegistrySubsystem>();
+	TArray<FName> ItemIds;
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		FRockItemCatalogEntry Entry;
+		Entry.ItemId = FName(TEXT("Item"), Index + 1);
+		Entry.MaxStackCount = Index;
+		ItemIds.Add(Entry.ItemId);
+		Registry->Catalog.AddEntry(MoveTemp(Entry));
+	}
+	Registry->DefinitionTable.InitializeFromCatalog(Registry->Catalog);
+	Registry->PublishSnapshot();
+
+	// Like a worker would: fetch the snapshot for every lookup rather than holding on to it
+	auto RunLookups = [&ItemIds](int32 Seed)
+	{
+		int32 NumFound = 0;
+		for (int32 Lookup = 0; Lookup < NumLookupsPerTask; ++Lookup)
+		{
+			const FRockItemCatalogEntry* Entry = URockItemRegistrySubsystem::GetSnapshot()->FindMetadata(ItemIds[(Seed + Lookup * 7919) % NumItems]);
+			NumFound += Entry ? 1 : 0;
+		}
+		return NumFound;
+	};
+
+	const double SingleStart = FPlatformTime::Seconds();
+	const int32 NumFoundSingle = RunLookups(0);
+	const double SingleSeconds = FPlatformTime::Seconds() - SingleStart;
+	TestEqual(TEXT("Every single threaded lookup found"), NumFoundSingle, NumLookupsPerTask);
+
+	std::atomic<int32> NumFoundParallel = 0;
+	const double ParallelStart = FPlatformTime::Seconds();
+	ParallelFor(NumTasks, [&RunLookups, &NumFoundParallel](int32 TaskIndex)
+	{
+		NumFoundParallel.fetch_add(RunLookups(TaskIndex), std::memory_order_relaxed);
+	});
+	const double ParallelSeconds = FPlatformTime::Seconds() - ParallelStart;
+	TestEqual(TEXT("Every parallel lookup found"), NumFoundParallel.load(), NumLookupsPerTask * NumTasks);
+
+	AddInfo(FString::Printf(TEXT("%d entries: %.1f M lookups/s on one thread (%.0f ns each), %.1f M lookups/s across %d tasks on %d workers"),
+		NumItems, NumLookupsPerTask / SingleSeconds / 1e6, SingleSeconds * 1e9 / NumLookupsPerTask,
+		static_cast<double>(NumLookupsPerTask) * NumTasks / ParallelSeconds / 1e6, NumTasks, FTaskGraphInterface::Get().GetNumWorkerThreads()));
+
+	Registry->Deinitialize();
+	return true;
+}
+
+#endif
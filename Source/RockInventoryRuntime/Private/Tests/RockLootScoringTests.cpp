@@ -0,0 +1,200 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "Inventory/RockInventorySnapshot.h"
+#include "Library/RockLootScoring.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RockLootScoringTests
+{
+	URockItemDefinition* MakeLoot(FName ItemId, int32 ItemValue, int64 WeightMg)
+	{
+		URockItemDefinition* Definition = RockInventoryTests::MakeDefinition(ItemId, 1, FIntPoint(1, 1), ItemValue);
+		Definition->Weight = WeightMg;
+		return Definition;
+	}
+
+	FString DescribeCandidates(TConstArrayView<FRockLootSource> Sources, TConstArrayView<FRockLootCandidate> Candidates)
+	{
+		FString Description;
+		for (const FRockLootCandidate& Candidate : Candidates)
+		{
+			const FRockLootSource& Source = Sources[Candidate.SourceIndex];
+			const FRockItemStack* Item = Source.Snapshot ? Source.Snapshot->GetItem(Candidate.ItemHandle) : &Source.WorldItemStack;
+			Description += FString::Printf(TEXT("%d:%s "), Candidate.SourceIndex, Item ? *Item->GetDefinition()->ItemId.ToString() : TEXT("?"));
+		}
+		return Description;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockLootScoringTest, "RockInventory.Library.LootScoring",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockLootScoringTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+	using namespace RockLootScoringTests;
+
+	// Value per kilogram: Gold 100000, Rifle 125, Apple 50, Junk is worthless and never a candidate
+	URockItemDefinition* Gold = MakeLoot(TEXT("Gold"), 100, 1000);
+	URockItemDefinition* Rifle = MakeLoot(TEXT("Rifle"), 500, 4000000);
+	URockItemDefinition* Apple = MakeLoot(TEXT("Apple"), 5, 100000);
+	URockItemDefinition* Junk = MakeLoot(TEXT("Junk"), 0, 1000);
+
+	URockInventory* NearChest = MakeInventory(4, 4);
+	AddItem(NearChest, Apple);
+	AddItem(NearChest, Junk);
+	const FRockItemStackHandle RifleHandle = AddItem(NearChest, Rifle);
+	URockInventory* FarChest = MakeInventory(4, 4);
+	AddItem(FarChest, Gold);
+
+	TArray<FRockLootSource> Sources;
+	Sources.Add(FRockLootSource::FromInventory(NearChest, FVector::ZeroVector));
+	Sources.Add(FRockLootSource::FromInventory(FarChest, FVector(5000.0, 0.0, 0.0)));
+	// A world item source doesn't need an actor to be scored
+	FRockLootSource GroundGold;
+	GroundGold.WorldItemStack = FRockItemStack(Gold, 1);
+	GroundGold.Location = FVector(100.0, 0.0, 0.0);
+	Sources.Add(GroundGold);
+
+	// The sources are copies, the rifle taken meanwhile is still scored
+	NearChest->RemoveItemFromInventory(RifleHandle);
+
+	TArray<FRockLootScoringRequest> Requests;
+	FRockLootScoringRequest& Anywhere = Requests.AddDefaulted_GetRef();
+	Anywhere.ScoreFunction = RockLootScoring::ValuePerWeight();
+	Anywhere.MaxResults = 2;
+	FRockLootScoringRequest& Nearby = Requests.AddDefaulted_GetRef();
+	Nearby.ScoreFunction = RockLootScoring::ValuePerWeight();
+	Nearby.MaxDistance = 1000.0f;
+	FRockLootScoringRequest& NoGold = Requests.AddDefaulted_GetRef();
+	NoGold.ScoreFunction = RockLootScoring::ValuePerWeight();
+	NoGold.Filter.ItemPredicate = [Gold](const FRockItemStack* Item) { return Item->GetDefinition() != Gold; };
+
+	TArray<TArray<FRockLootCandidate>> Results;
+	RockLootScoring::ScoreLoot(Sources, Requests, Results);
+	if (!TestEqual(TEXT("A result per request"), Results.Num(), Requests.Num()))
+	{
+		return false;
+	}
+	// Equal scores keep the source order
+	TestEqual(TEXT("Best K, ties in source order"), DescribeCandidates(Sources, Results[0]), FString(TEXT("1:Gold 2:Gold ")));
+	TestEqual(TEXT("Far sources skipped"), DescribeCandidates(Sources, Results[1]), FString(TEXT("2:Gold 0:Rifle 0:Apple ")));
+	TestEqual(TEXT("Filtered"), DescribeCandidates(Sources, Results[2]), FString(TEXT("0:Rifle 0:Apple ")));
+	TestTrue(TEXT("Inventory candidates point at their slot"), Results[2].Num() > 0 && Results[2][0].SlotHandle.GetAbsoluteIndex() == 2);
+	TestTrue(TEXT("World item candidates have no slot"), Results[1].Num() > 0 && Results[1][0].SlotHandle.GetAbsoluteIndex() == INDEX_NONE);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockLootScoringBenchmarkTest, "RockInventory.Library.LootScoring.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockLootScoringBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+	using namespace RockLootScoringTests;
+
+	constexpr int32 NumRequesters = 50;
+	constexpr int32 NumContainers = 400;
+	constexpr int32 NumWorldItems = 100;
+	constexpr int32 NumItemsPerContainer = 20;
+
+	TArray<URockItemDefinition*> Definitions;
+	for (int32 Index = 0; Index < 40; ++Index)
+	{
+		Definitions.Add(MakeLoot(FName(TEXT("Loot"), Index + 1), 10 + Index * 7 % 90, 1000 + Index * 3571 % 50000));
+	}
+	TArray<URockInventory*> Containers;
+	for (int32 ContainerIndex = 0; ContainerIndex < NumContainers; ++ContainerIndex)
+	{
+		URockInventory* Container = MakeInventory(6, 6);
+		for (int32 ItemIndex = 0; ItemIndex < NumItemsPerContainer; ++ItemIndex)
+		{
+			AddItem(Container, Definitions[(ContainerIndex * 13 + ItemIndex) % Definitions.Num()]);
+		}
+		Containers.Add(Container);
+	}
+
+	// 500 sources, captured on the game thread
+	const double CaptureStart = FPlatformTime::Seconds();
+	TArray<FRockLootSource> Sources;
+	for (int32 ContainerIndex = 0; ContainerIndex < NumContainers; ++ContainerIndex)
+	{
+		Sources.Add(FRockLootSource::FromInventory(Containers[ContainerIndex], FVector(ContainerIndex * 100.0, 0.0, 0.0)));
+	}
+	const double CaptureSeconds = FPlatformTime::Seconds() - CaptureStart;
+	for (int32 Index = 0; Index < NumWorldItems; ++Index)
+	{
+		FRockLootSource& WorldItem = Sources.AddDefaulted_GetRef();
+		WorldItem.WorldItemStack = FRockItemStack(Definitions[Index % Definitions.Num()], 1);
+		WorldItem.Location = FVector(Index * 100.0, 500.0, 0.0);
+	}
+
+	TArray<FRockLootScoringRequest> Requests;
+	for (int32 Index = 0; Index < NumRequesters; ++Index)
+	{
+		FRockLootScoringRequest& Request = Requests.AddDefaulted_GetRef();
+		Request.ScoreFunction = RockLootScoring::ValuePerWeight();
+		Request.Location = FVector(Index * 800.0, 0.0, 0.0);
+		Request.MaxDistance = 10000.0f;
+	}
+
+	TArray<TArray<FRockLootCandidate>> Results;
+	const double ScoreStart = FPlatformTime::Seconds();
+	RockLootScoring::ScoreLoot(Sources, Requests, Results);
+	const double ScoreSeconds = FPlatformTime::Seconds() - ScoreStart;
+
+	// What every bot did on its own before: walk each live container and world item on the game thread
+	TArray<TArray<float>> SerialScores;
+	const double SerialStart = FPlatformTime::Seconds();
+	for (const FRockLootScoringRequest& Request : Requests)
+	{
+		TArray<float>& Scores = SerialScores.AddDefaulted_GetRef();
+		for (int32 SourceIndex = 0; SourceIndex < Sources.Num(); ++SourceIndex)
+		{
+			const FRockLootSource& Source = Sources[SourceIndex];
+			if (FVector::DistSquared(Request.Location, Source.Location) > FMath::Square(static_cast<double>(Request.MaxDistance)))
+			{
+				continue;
+			}
+			if (SourceIndex >= NumContainers)
+			{
+				Scores.Add(Request.ScoreFunction(Source.WorldItemStack, Source));
+				continue;
+			}
+			URockInventory* Container = Containers[SourceIndex];
+			Container->ForEachSlotInSection([&Request, &Source, &Scores, Container](const FRockInventorySectionInfo&, const FRockInventorySlotEntry& Slot)
+			{
+				if (const FRockItemStack* Item = Container->GetItemByHandlePtr(Slot.ItemHandle); Item && Item->IsValid())
+				{
+					Scores.Add(Request.ScoreFunction(*Item, Source));
+				}
+				return true;
+			});
+		}
+		Scores.Sort(TGreater<float>());
+		Scores.SetNum(FMath::Min(Scores.Num(), Request.MaxResults));
+	}
+	const double SerialSeconds = FPlatformTime::Seconds() - SerialStart;
+
+	int32 NumMismatched = 0;
+	for (int32 Index = 0; Index < NumRequesters; ++Index)
+	{
+		NumMismatched += Results[Index].Num() != SerialScores[Index].Num() ? 1 : 0;
+		for (int32 Rank = 0; Rank < FMath::Min(Results[Index].Num(), SerialScores[Index].Num()); ++Rank)
+		{
+			NumMismatched += FMath::IsNearlyEqual(Results[Index][Rank].Score, SerialScores[Index][Rank]) ? 0 : 1;
+		}
+	}
+	TestEqual(TEXT("Same top K as a serial walk"), NumMismatched, 0);
+	TestEqual(TEXT("Top K found"), Results[0].Num(), Requests[0].MaxResults);
+
+	AddInfo(FString::Printf(TEXT("%d requesters over %d sources: ScoreLoot %.2f ms (after %.2f ms capturing the containers), serial walk %.2f ms"),
+		NumRequesters, Sources.Num(), ScoreSeconds * 1000.0, CaptureSeconds * 1000.0, SerialSeconds * 1000.0));
+	return true;
+}
+
+#endif
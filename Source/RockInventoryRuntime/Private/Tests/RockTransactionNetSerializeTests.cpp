@@ -0,0 +1,95 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Transactions/Implementations/RockDropItemTransaction.h"
+#include "Transactions/Implementations/RockMoveItemTransaction.h"
+
+#include "Misc/AutomationTest.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RockTransactionNetSerializeTests
+{
+	/** Writes Transaction, reads it back into OutTransaction and returns the bits it took. No package map, objects cost nothing */
+	template <typename TransactionT>
+	int64 RoundTrip(TransactionT& Transaction, TransactionT& OutTransaction)
+	{
+		bool bSuccess = false;
+		FBitWriter Writer(0, true);
+		Transaction.NetSerialize(Writer, nullptr, bSuccess);
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		OutTransaction.NetSerialize(Reader, nullptr, bSuccess);
+		return Writer.GetNumBits();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockMoveTransactionNetSerializeTest, "RockInventory.Transactions.NetSerialize.Move",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockMoveTransactionNetSerializeTest::RunTest(const FString& Parameters)
+{
+	using namespace RockTransactionNetSerializeTests;
+
+	FRockMoveItemTransaction Move;
+	Move.TransactionID = 12;
+	Move.SourceSlotHandle = FRockInventorySlotHandle(3);
+	Move.TargetSlotHandle = FRockInventorySlotHandle(40);
+
+	FRockMoveItemTransaction Loaded;
+	Loaded.MoveParams.MoveMode = ERockItemMoveMode::SingleItem;
+	const int64 NumBits = RoundTrip(Move, Loaded);
+	// Two flag bits and three one byte packed ints, for the common same inventory full stack move
+	TestTrue(FString::Printf(TEXT("Plain move fits in 4 bytes (%lld bits)"), NumBits), NumBits <= 32);
+	TestEqual(TEXT("TransactionID"), Loaded.TransactionID, 12);
+	TestEqual(TEXT("SourceSlotHandle"), Loaded.SourceSlotHandle.GetAbsoluteIndex(), 3);
+	TestEqual(TEXT("TargetSlotHandle"), Loaded.TargetSlotHandle.GetAbsoluteIndex(), 40);
+	TestTrue(TEXT("Default params are restored"), Loaded.MoveParams.MoveMode == ERockItemMoveMode::FullStack);
+
+	FRockMoveItemTransaction Custom;
+	Custom.SourceSlotHandle = FRockInventorySlotHandle(INDEX_NONE);
+	Custom.TargetSlotHandle = FRockInventorySlotHandle(1000);
+	Custom.MoveParams.DesiredOrientation = ERockItemOrientation::Vertical;
+	Custom.MoveParams.MoveMode = ERockItemMoveMode::CustomAmount;
+	Custom.MoveParams.MoveCount = 7;
+
+	FRockMoveItemTransaction LoadedCustom;
+	RoundTrip(Custom, LoadedCustom);
+	TestEqual(TEXT("INDEX_NONE slot"), LoadedCustom.SourceSlotHandle.GetAbsoluteIndex(), static_cast<int32>(INDEX_NONE));
+	TestEqual(TEXT("Large slot index"), LoadedCustom.TargetSlotHandle.GetAbsoluteIndex(), 1000);
+	TestTrue(TEXT("Orientation"), LoadedCustom.MoveParams.DesiredOrientation == ERockItemOrientation::Vertical);
+	TestTrue(TEXT("MoveMode"), LoadedCustom.MoveParams.MoveMode == ERockItemMoveMode::CustomAmount);
+	TestEqual(TEXT("MoveCount"), LoadedCustom.MoveParams.MoveCount, 7);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockDropTransactionNetSerializeTest, "RockInventory.Transactions.NetSerialize.Drop",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockDropTransactionNetSerializeTest::RunTest(const FString& Parameters)
+{
+	using namespace RockTransactionNetSerializeTests;
+
+	FRockDropItemTransaction Drop;
+	Drop.SourceSlotHandle = FRockInventorySlotHandle(5);
+
+	FRockDropItemTransaction Loaded;
+	Loaded.DropLocationOffset = FVector(1.0);
+	Loaded.Impulse = FVector(1.0);
+	const int64 PlainBits = RoundTrip(Drop, Loaded);
+	TestTrue(FString::Printf(TEXT("Plain drop fits in 4 bytes (%lld bits)"), PlainBits), PlainBits <= 32);
+	TestEqual(TEXT("SourceSlotHandle"), Loaded.SourceSlotHandle.GetAbsoluteIndex(), 5);
+	TestTrue(TEXT("Zero vectors are restored"), Loaded.DropLocationOffset.IsZero() && Loaded.Impulse.IsZero());
+
+	Drop.DropLocationOffset = FVector(100.0, 0.0, 50.0);
+	Drop.Impulse = FVector(0.0, 250.0, 400.0);
+	FRockDropItemTransaction LoadedThrow;
+	RoundTrip(Drop, LoadedThrow);
+	// Quantized on the wire
+	TestTrue(TEXT("DropLocationOffset"), LoadedThrow.DropLocationOffset.Equals(Drop.DropLocationOffset, 1.0));
+	TestTrue(TEXT("Impulse"), LoadedThrow.Impulse.Equals(Drop.Impulse, 1.0));
+	return true;
+}
+
+#endif
@@ -0,0 +1,63 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Transactions/Core/RockTransactionRateLimiter.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockTransactionRateLimiterTest, "RockInventory.Transactions.RateLimiter",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockTransactionRateLimiterTest::RunTest(const FString& Parameters)
+{
+	// Known limits for the duration of the test, whatever the project configured
+	URockInventoryDeveloperSettings* Settings = GetMutableDefault<URockInventoryDeveloperSettings>();
+	TGuardValue<bool> EnabledGuard(Settings->bEnableTransactionRateLimiting, true);
+	TGuardValue<FRockTokenBucketConfig> DefaultGuard(Settings->DefaultTransactionRateLimit, FRockTokenBucketConfig(2.0f, 3.0f));
+	TMap<ERockRateLimitedRequest, FRockTokenBucketConfig> Overrides;
+	Overrides.Add(ERockRateLimitedRequest::Resync, FRockTokenBucketConfig(0.5f, 1.0f));
+	TGuardValue<TMap<ERockRateLimitedRequest, FRockTokenBucketConfig>> OverridesGuard(Settings->TransactionRateLimitOverrides, Overrides);
+
+	FRockTransactionRateLimiter Limiter;
+	Limiter.Configure();
+	TestTrue(TEXT("Enabled"), Limiter.IsEnabled());
+
+	// Starts full: the whole burst goes through, then nothing until it refills
+	double Now = 10.0;
+	for (int32 Request = 0; Request < 3; ++Request)
+	{
+		TestTrue(TEXT("Within the burst"), Limiter.TryConsume(ERockRateLimitedRequest::MoveItem, Now));
+	}
+	TestFalse(TEXT("Burst exhausted"), Limiter.TryConsume(ERockRateLimitedRequest::MoveItem, Now));
+	TestTrue(TEXT("Other kinds have their own bucket"), Limiter.TryConsume(ERockRateLimitedRequest::DropItem, Now));
+
+	Now += 0.5;
+	TestTrue(TEXT("One token back after half a second"), Limiter.TryConsume(ERockRateLimitedRequest::MoveItem, Now));
+	TestFalse(TEXT("Only one"), Limiter.TryConsume(ERockRateLimitedRequest::MoveItem, Now));
+	TestFalse(TEXT("A batch the bucket can't cover is rejected"), Limiter.TryConsume(ERockRateLimitedRequest::MoveItem, Now + 0.5, 2.0f));
+	TestTrue(TEXT("And takes nothing"), Limiter.TryConsume(ERockRateLimitedRequest::MoveItem, Now + 0.5));
+
+	// Idle time refills up to the burst and no further
+	Now += 100.0;
+	TestTrue(TEXT("Full burst after idling"), Limiter.TryConsume(ERockRateLimitedRequest::MoveItem, Now, 3.0f));
+	TestFalse(TEXT("Not more than the burst"), Limiter.TryConsume(ERockRateLimitedRequest::MoveItem, Now));
+
+	TestTrue(TEXT("Override used"), Limiter.TryConsume(ERockRateLimitedRequest::Resync, Now));
+	TestFalse(TEXT("Override burst of one"), Limiter.TryConsume(ERockRateLimitedRequest::Resync, Now + 1.0));
+
+	FRockRateLimitStats Stats;
+	Limiter.GetStats(Stats);
+	TestEqual(TEXT("Total rejected"), Stats.TotalRejected, static_cast<int64>(5));
+	TestEqual(TEXT("Rejected moves"), Stats.RejectedByRequest[static_cast<int32>(ERockRateLimitedRequest::MoveItem)], static_cast<int64>(4));
+	TestEqual(TEXT("Rejected resyncs"), Stats.RejectedByRequest[static_cast<int32>(ERockRateLimitedRequest::Resync)], static_cast<int64>(1));
+
+	// Turned off in the settings, nothing is limited
+	Settings->bEnableTransactionRateLimiting = false;
+	Limiter.Configure();
+	TestTrue(TEXT("Disabled lets everything through"), Limiter.TryConsume(ERockRateLimitedRequest::Resync, Now, 100.0f));
+	return true;
+}
+
+#endif
@@ -0,0 +1,208 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "Engine/StaticMeshActor.h"
+#include "EngineUtils.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "World/RockWorldItemCluster.h"
+#include "World/RockWorldItemClusterSubsystem.h"
+#include "World/RockWorldItemSpawnSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RockWorldItemClusterSubsystemTests
+{
+	/** Class sizes plus what the actor and its components report owning. Engine side state (physics bodies, render proxies) isn't included */
+	int64 EstimateActorBytes(AActor* Actor)
+	{
+		int64 Bytes = Actor->GetClass()->GetStructureSize() + Actor->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		for (UActorComponent* Component : Actor->GetComponents())
+		{
+			Bytes += Component->GetClass()->GetStructureSize() + Component->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		}
+		return Bytes;
+	}
+
+	struct FWorldItemCosts
+	{
+		int32 NumActors = 0;
+		int32 NumAwakeReplicatedActors = 0;
+		int32 NumTickingActors = 0;
+		int64 Bytes = 0;
+		double AddSeconds = 0.0;
+		double FrameSeconds = 0.0;
+	};
+
+	/** Measured over every actor of the class in the world, then averaged over a few world ticks */
+	template <typename ActorT>
+	void MeasureWorld(UWorld* World, FWorldItemCosts& OutCosts)
+	{
+		for (TActorIterator<ActorT> It(World); It; ++It)
+		{
+			++OutCosts.NumActors;
+			OutCosts.NumAwakeReplicatedActors += It->NetDormancy <= DORM_Awake ? 1 : 0;
+			OutCosts.NumTickingActors += It->IsActorTickEnabled() ? 1 : 0;
+			OutCosts.Bytes += EstimateActorBytes(*It);
+		}
+
+		constexpr int32 NumFrames = 10;
+		const double TickStart = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+		}
+		OutCosts.FrameSeconds = (FPlatformTime::Seconds() - TickStart) / NumFrames;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockWorldItemClusterSubsystemTest, "RockInventory.World.Clusters",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockWorldItemClusterSubsystemTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	// A static mesh actor stands in for the world item class, the clusters don't care what it is
+	URockInventoryDeveloperSettings* Settings = GetMutableDefault<URockInventoryDeveloperSettings>();
+	TGuardValue<bool> EnabledGuard(Settings->bEnableWorldItemClusters, true);
+	TGuardValue<float> ClusterSizeGuard(Settings->WorldItemClusterSize, 5000.0f);
+	TGuardValue<TSubclassOf<AActor>> WorldItemClassGuard(Settings->DefaultWorldItemClass, AStaticMeshActor::StaticClass());
+	FScopedTestWorld TestWorld;
+	URockWorldItemClusterSubsystem* Clusters = TestWorld.World->GetSubsystem<URockWorldItemClusterSubsystem>();
+	URockWorldItemSpawnSubsystem* Spawner = TestWorld.World->GetSubsystem<URockWorldItemSpawnSubsystem>();
+	if (!TestTrue(TEXT("Subsystems exist and clusters are enabled"), Clusters && Spawner && Clusters->IsEnabled()))
+	{
+		return false;
+	}
+
+	// Two in the cluster at the origin, one in the next cluster over
+	URockItemDefinition* Stone = MakeWorldDefinition(TEXT("Stone"), 10);
+	TestTrue(TEXT("Clustered"), Clusters->AddItem(FRockItemStack(Stone, 1), FTransform(FVector(0.0, 0.0, 0.0))));
+	TestTrue(TEXT("Clustered"), Clusters->AddItem(FRockItemStack(Stone, 2), FTransform(FVector(200.0, 0.0, 0.0))));
+	TestTrue(TEXT("Clustered"), Clusters->AddItem(FRockItemStack(Stone, 3), FTransform(FVector(6000.0, 0.0, 0.0))));
+	TestFalse(TEXT("Invalid items stay out"), Clusters->AddItem(FRockItemStack(), FTransform::Identity));
+	TestEqual(TEXT("Stored as entries"), Clusters->GetNumItems(), 3);
+
+	TArray<FRockWorldItemClusterHit> Hits;
+	Clusters->FindItemsInRadius(FVector(150.0, 0.0, 0.0), 500.0f, 0, Hits);
+	TestTrue(TEXT("Nearest first"), Hits.Num() == 2 && Hits[0].DistanceSquared < Hits[1].DistanceSquared);
+	Clusters->FindItemsInRadius(FVector(150.0, 0.0, 0.0), 500.0f, 1, Hits);
+	TestEqual(TEXT("MaxItems"), Hits.Num(), 1);
+	Clusters->FindItemsInRadius(FVector(150.0, 0.0, 0.0), 10000.0f, 0, Hits);
+	TestEqual(TEXT("Across clusters"), Hits.Num(), 3);
+
+	// Promoting the far one right away
+	Clusters->FindItemsInRadius(FVector(6000.0, 0.0, 0.0), 10.0f, 0, Hits);
+	AActor* Promoted = Hits.Num() == 1 ? Clusters->PromoteItem(Hits[0].Cluster, Hits[0].EntryId) : nullptr;
+	TestTrue(TEXT("Promoted in place"), Promoted && Promoted->GetActorLocation().Equals(FVector(6000.0, 0.0, 0.0)));
+	TestEqual(TEXT("No longer an entry"), Clusters->GetNumItems(), 2);
+
+	// Area promotion goes through the spawn queue: until spawned the items are neither entries nor actors
+	TArray<AActor*> AreaPromoted;
+	const int32 NumQueued = Clusters->PromoteItemsInRadius(FVector::ZeroVector, 500.0f, 0, [&AreaPromoted](AActor* WorldItem)
+	{
+		AreaPromoted.Add(WorldItem);
+	});
+	TestEqual(TEXT("Queued"), NumQueued, 2);
+	TestEqual(TEXT("Pending spawns"), Spawner->GetNumPendingSpawns(), 2);
+	TestEqual(TEXT("Removed from the clusters while pending"), Clusters->GetNumItems(), 0);
+	Spawner->FlushPendingSpawns();
+	TestEqual(TEXT("OnPromoted called per actor"), AreaPromoted.Num(), 2);
+	TestFalse(TEXT("With the actor"), AreaPromoted.Contains(nullptr));
+
+	// A promotion that fails to spawn puts the item back instead of losing it
+	TestTrue(TEXT("Clustered"), Clusters->AddItem(FRockItemStack(Stone, 4), FTransform(FVector(0.0, 0.0, 0.0))));
+	Settings->DefaultWorldItemClass = nullptr;
+	AddExpectedMessage(TEXT("no class was specified"), EAutomationExpectedMessageFlags::Contains, 1);
+	AddExpectedMessage(TEXT("Failed to spawn world item"), EAutomationExpectedMessageFlags::Contains, 1);
+	AreaPromoted.Reset();
+	Clusters->PromoteItemsInRadius(FVector::ZeroVector, 500.0f, 0, [&AreaPromoted](AActor* WorldItem) { AreaPromoted.Add(WorldItem); });
+	Spawner->FlushPendingSpawns();
+	TestEqual(TEXT("Back in its cluster"), Clusters->GetNumItems(), 1);
+	TestTrue(TEXT("OnPromoted not called for a failed spawn"), AreaPromoted.IsEmpty());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockWorldItemClusterBenchmarkTest, "RockInventory.World.Clusters.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockWorldItemClusterBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+	using namespace RockWorldItemClusterSubsystemTests;
+
+	constexpr int32 NumItems = 20000;
+
+	URockInventoryDeveloperSettings* Settings = GetMutableDefault<URockInventoryDeveloperSettings>();
+	TGuardValue<float> ClusterSizeGuard(Settings->WorldItemClusterSize, 5000.0f);
+	TGuardValue<bool> ConsolidationGuard(Settings->bEnableWorldItemConsolidation, false);
+
+	// The same 20,000 resting items over 500 x 500 m, 100 clusters worth
+	TArray<URockItemDefinition*> Definitions;
+	for (int32 Index = 0; Index < 10; ++Index)
+	{
+		Definitions.Add(MakeWorldDefinition(FName(TEXT("Loot"), Index + 1), 10));
+	}
+	FRandomStream Random(46);
+	TArray<FVector> Locations;
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		Locations.Add(FVector(Random.FRandRange(0.0, 50000.0), Random.FRandRange(0.0, 50000.0), 0.0));
+	}
+
+	FWorldItemCosts ActorCosts;
+	{
+		TGuardValue<bool> EnabledGuard(Settings->bEnableWorldItemClusters, false);
+		FScopedTestWorld TestWorld;
+		TestWorld.BeginPlay();
+		const double AddStart = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumItems; ++Index)
+		{
+			SpawnWorldItem(TestWorld.World, FRockItemStack(Definitions[Index % Definitions.Num()], 1), Locations[Index]);
+		}
+		ActorCosts.AddSeconds = FPlatformTime::Seconds() - AddStart;
+		MeasureWorld<ARockInventoryWorldItemBase>(TestWorld.World, ActorCosts);
+	}
+	TestEqual(TEXT("An actor per item"), ActorCosts.NumActors, NumItems);
+
+	FWorldItemCosts ClusterCosts;
+	{
+		TGuardValue<bool> EnabledGuard(Settings->bEnableWorldItemClusters, true);
+		FScopedTestWorld TestWorld;
+		TestWorld.BeginPlay();
+		URockWorldItemClusterSubsystem* Clusters = TestWorld.World->GetSubsystem<URockWorldItemClusterSubsystem>();
+		if (!TestTrue(TEXT("Clusters are enabled"), Clusters && Clusters->IsEnabled()))
+		{
+			return false;
+		}
+		const double AddStart = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumItems; ++Index)
+		{
+			Clusters->AddItem(FRockItemStack(Definitions[Index % Definitions.Num()], 1), FTransform(Locations[Index]));
+		}
+		ClusterCosts.AddSeconds = FPlatformTime::Seconds() - AddStart;
+		TestEqual(TEXT("Every item is an entry"), Clusters->GetNumItems(), NumItems);
+
+		MeasureWorld<ARockWorldItemCluster>(TestWorld.World, ClusterCosts);
+		// The entries live in the cluster's array, which the class size doesn't cover
+		for (TActorIterator<ARockWorldItemCluster> It(TestWorld.World); It; ++It)
+		{
+			ClusterCosts.Bytes += It->GetEntries().Num() * sizeof(FRockWorldItemClusterEntry);
+		}
+	}
+	TestTrue(TEXT("Far fewer actors"), ClusterCosts.NumActors <= 100);
+
+	auto LogCosts = [this](const TCHAR* Name, const FWorldItemCosts& Costs)
+	{
+		AddInfo(FString::Printf(TEXT("%s for %d items: %d replicated actors (%d ticking, %d not dormant), ~%.1f MB, added in %.1f ms, world tick %.2f ms"),
+			Name, NumItems, Costs.NumActors, Costs.NumTickingActors, Costs.NumAwakeReplicatedActors,
+			Costs.Bytes / (1024.0 * 1024.0), Costs.AddSeconds * 1000.0, Costs.FrameSeconds * 1000.0));
+	};
+	LogCosts(TEXT("Actors"), ActorCosts);
+	LogCosts(TEXT("Clusters"), ClusterCosts);
+	return true;
+}
+
+#endif
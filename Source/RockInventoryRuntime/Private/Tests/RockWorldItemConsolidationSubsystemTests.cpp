@@ -0,0 +1,150 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "World/RockWorldItemConsolidationSubsystem.h"
+#include "World/RockWorldItemGridSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockWorldItemConsolidationSubsystemTest, "RockInventory.World.Consolidation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockWorldItemConsolidationSubsystemTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	URockInventoryDeveloperSettings* Settings = GetMutableDefault<URockInventoryDeveloperSettings>();
+	TGuardValue<bool> EnabledGuard(Settings->bEnableWorldItemConsolidation, true);
+	TGuardValue<float> RadiusGuard(Settings->WorldItemConsolidationRadius, 150.0f);
+	// Resting items would otherwise become cluster entries, which the grid doesn't know about
+	TGuardValue<bool> ClustersGuard(Settings->bEnableWorldItemClusters, false);
+	FScopedTestWorld TestWorld;
+	TestWorld.BeginPlay();
+	URockWorldItemConsolidationSubsystem* Consolidation = TestWorld.World->GetSubsystem<URockWorldItemConsolidationSubsystem>();
+	URockWorldItemGridSubsystem* Grid = TestWorld.World->GetSubsystem<URockWorldItemGridSubsystem>();
+	if (!TestTrue(TEXT("Subsystems exist and consolidation is enabled"), Consolidation && Grid && Consolidation->IsEnabled()))
+	{
+		return false;
+	}
+
+	URockItemDefinition* Stone = MakeWorldDefinition(TEXT("Stone"), 10);
+	URockItemDefinition* Apple = MakeWorldDefinition(TEXT("Apple"), 10);
+	// Each registers itself with the grid and as a candidate on BeginPlay
+	ARockInventoryWorldItemBase* Small = SpawnWorldItem(TestWorld.World, FRockItemStack(Stone, 4), FVector(0.0, 0.0, 0.0));
+	ARockInventoryWorldItemBase* Nearby = SpawnWorldItem(TestWorld.World, FRockItemStack(Stone, 5), FVector(50.0, 0.0, 0.0));
+	ARockInventoryWorldItemBase* OtherItem = SpawnWorldItem(TestWorld.World, FRockItemStack(Apple, 1), FVector(20.0, 0.0, 0.0));
+	ARockInventoryWorldItemBase* OutOfRange = SpawnWorldItem(TestWorld.World, FRockItemStack(Stone, 2), FVector(1000.0, 0.0, 0.0));
+	// Together more than a full stack
+	ARockInventoryWorldItemBase* PileA = SpawnWorldItem(TestWorld.World, FRockItemStack(Stone, 8), FVector(5000.0, 0.0, 0.0));
+	ARockInventoryWorldItemBase* PileB = SpawnWorldItem(TestWorld.World, FRockItemStack(Stone, 8), FVector(5030.0, 0.0, 0.0));
+	TestEqual(TEXT("All in the grid"), Grid->GetNumWorldItems(), 6);
+
+	const int32 NumMerged = Consolidation->ConsolidateCandidates(64);
+	TestEqual(TEXT("One actor merged away"), NumMerged, 1);
+	TestEqual(TEXT("Counted"), Consolidation->GetNumMergedActors(), static_cast<int64>(1));
+	TestFalse(TEXT("Emptied item destroyed"), IsValid(Nearby));
+	TestEqual(TEXT("Its stack moved over"), Small->GetItemStack(nullptr).GetStackCount(), 9);
+	TestEqual(TEXT("Different items are left alone"), OtherItem->GetItemStack(nullptr).GetStackCount(), 1);
+	TestEqual(TEXT("Items out of range are left alone"), OutOfRange->GetItemStack(nullptr).GetStackCount(), 2);
+
+	// Stacks are capped at MaxStackCount, what doesn't fit stays where it was
+	const int32 PileACount = PileA->GetItemStack(nullptr).GetStackCount();
+	const int32 PileBCount = PileB->GetItemStack(nullptr).GetStackCount();
+	TestTrue(TEXT("Both piles remain"), IsValid(PileA) && IsValid(PileB));
+	TestEqual(TEXT("Nothing lost"), PileACount + PileBCount, 16);
+	TestEqual(TEXT("One full stack"), FMath::Max(PileACount, PileBCount), 10);
+	TestEqual(TEXT("Destroyed items leave the grid"), Grid->GetNumWorldItems(), 5);
+
+	// Candidates are consumed by the pass
+	TestEqual(TEXT("Nothing left to do"), Consolidation->ConsolidateCandidates(64), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockWorldItemConsolidationBenchmarkTest, "RockInventory.World.Consolidation.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockWorldItemConsolidationBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	constexpr int32 NumPiles = 20;
+	constexpr int32 NumItemsPerPile = 30;
+	constexpr int32 NumDefinitions = 5;
+
+	URockInventoryDeveloperSettings* Settings = GetMutableDefault<URockInventoryDeveloperSettings>();
+	TGuardValue<bool> EnabledGuard(Settings->bEnableWorldItemConsolidation, true);
+	TGuardValue<float> RadiusGuard(Settings->WorldItemConsolidationRadius, 150.0f);
+	TGuardValue<bool> ClustersGuard(Settings->bEnableWorldItemClusters, false);
+	FScopedTestWorld TestWorld;
+	TestWorld.BeginPlay();
+	URockWorldItemConsolidationSubsystem* Consolidation = TestWorld.World->GetSubsystem<URockWorldItemConsolidationSubsystem>();
+	if (!TestTrue(TEXT("Consolidation is enabled"), Consolidation && Consolidation->IsEnabled()))
+	{
+		return false;
+	}
+
+	TArray<URockItemDefinition*> Definitions;
+	for (int32 Index = 0; Index < NumDefinitions; ++Index)
+	{
+		Definitions.Add(MakeWorldDefinition(FName(TEXT("Ammo"), Index + 1), 20));
+	}
+
+	// Mass death drops: a pile of small stacks where each player fell
+	FRandomStream Random(45);
+	TArray<ARockInventoryWorldItemBase*> WorldItems;
+	int32 ExpectedCounts[NumDefinitions] = {};
+	for (int32 Pile = 0; Pile < NumPiles; ++Pile)
+	{
+		const FVector PileCenter(Pile * 5000.0, 0.0, 0.0);
+		for (int32 Index = 0; Index < NumItemsPerPile; ++Index)
+		{
+			const int32 DefinitionIndex = Random.RandRange(0, NumDefinitions - 1);
+			const int32 StackCount = Random.RandRange(1, 5);
+			ExpectedCounts[DefinitionIndex] += StackCount;
+			const FVector Offset(Random.FRandRange(-60.0, 60.0), Random.FRandRange(-60.0, 60.0), 0.0);
+			WorldItems.Add(SpawnWorldItem(TestWorld.World, FRockItemStack(Definitions[DefinitionIndex], StackCount), PileCenter + Offset));
+		}
+	}
+
+	// As many throttled passes as it takes to see every candidate once, and one more that must find nothing left
+	const int32 MaxPerPass = 64;
+	const int32 NumPasses = FMath::DivideAndRoundUp(WorldItems.Num(), MaxPerPass);
+	double TotalSeconds = 0.0;
+	double WorstPassSeconds = 0.0;
+	for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+	{
+		const double PassStart = FPlatformTime::Seconds();
+		Consolidation->ConsolidateCandidates(MaxPerPass);
+		const double PassSeconds = FPlatformTime::Seconds() - PassStart;
+		TotalSeconds += PassSeconds;
+		WorstPassSeconds = FMath::Max(WorstPassSeconds, PassSeconds);
+	}
+	TestEqual(TEXT("Nothing left to merge"), Consolidation->ConsolidateCandidates(MaxPerPass), 0);
+
+	int32 NumActorsLeft = 0;
+	int32 Counts[NumDefinitions] = {};
+	for (ARockInventoryWorldItemBase* WorldItem : WorldItems)
+	{
+		if (IsValid(WorldItem))
+		{
+			++NumActorsLeft;
+			const FRockItemStack ItemStack = WorldItem->GetItemStack(nullptr);
+			Counts[Definitions.IndexOfByKey(ItemStack.GetDefinition())] += ItemStack.GetStackCount();
+		}
+	}
+	for (int32 Index = 0; Index < NumDefinitions; ++Index)
+	{
+		TestEqual(FString::Printf(TEXT("No %s lost"), *Definitions[Index]->ItemId.ToString()), Counts[Index], ExpectedCounts[Index]);
+	}
+	TestEqual(TEXT("Merged actors counted"), static_cast<int64>(WorldItems.Num() - NumActorsLeft), Consolidation->GetNumMergedActors());
+	TestTrue(TEXT("Most actors merged away"), NumActorsLeft * 2 < WorldItems.Num());
+
+	AddInfo(FString::Printf(TEXT("%d world items in %d piles merged into %d: %d passes of %d candidates, worst pass %.2f ms, %.2f ms in total"),
+		WorldItems.Num(), NumPiles, NumActorsLeft, NumPasses, MaxPerPass, WorstPassSeconds * 1000.0, TotalSeconds * 1000.0));
+	return true;
+}
+
+#endif
@@ -0,0 +1,148 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "World/RockWorldItemGridSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockWorldItemGridSubsystemTest, "RockInventory.World.Grid",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockWorldItemGridSubsystemTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	TGuardValue<float> CellSizeGuard(GetMutableDefault<URockInventoryDeveloperSettings>()->WorldItemGridCellSize, 1000.0f);
+	FScopedTestWorld TestWorld;
+	URockWorldItemGridSubsystem* Grid = TestWorld.World->GetSubsystem<URockWorldItemGridSubsystem>();
+	if (!TestNotNull(TEXT("Grid exists in game worlds"), Grid))
+	{
+		return false;
+	}
+
+	// Spread over several cells, including negative ones
+	AActor* Origin = SpawnActorAt(TestWorld.World, FVector(0.0, 0.0, 0.0));
+	AActor* East = SpawnActorAt(TestWorld.World, FVector(300.0, 0.0, 0.0));
+	AActor* SouthWest = SpawnActorAt(TestWorld.World, FVector(-200.0, -200.0, 0.0));
+	AActor* NextCell = SpawnActorAt(TestWorld.World, FVector(1500.0, 0.0, 0.0));
+	AActor* FarAway = SpawnActorAt(TestWorld.World, FVector(50000.0, 50000.0, 0.0));
+	for (AActor* WorldItem : {Origin, East, SouthWest, NextCell, FarAway})
+	{
+		Grid->RegisterWorldItem(WorldItem);
+	}
+	Grid->RegisterWorldItem(Origin);
+	TestEqual(TEXT("Registering twice doesn't duplicate"), Grid->GetNumWorldItems(), 5);
+
+	TArray<AActor*> Found;
+	Grid->QueryRadius(FVector::ZeroVector, 1000.0f, Found);
+	TestTrue(TEXT("Radius, nearest first"), Found == TArray<AActor*>({Origin, SouthWest, East}));
+
+	Grid->QueryBox(FBox(FVector(1000.0, -100.0, -100.0), FVector(2000.0, 100.0, 100.0)), Found);
+	TestTrue(TEXT("Box"), Found == TArray<AActor*>({NextCell}));
+
+	// Moved into range: picked up on update, from a different cell
+	NextCell->SetActorLocation(FVector(100.0, 0.0, 0.0));
+	Grid->UpdateWorldItem(NextCell);
+	Grid->QueryRadius(FVector::ZeroVector, 1000.0f, Found);
+	TestTrue(TEXT("Follows moves across cells"), Found == TArray<AActor*>({Origin, NextCell, SouthWest, East}));
+
+	Grid->UnregisterWorldItem(Origin);
+	Grid->QueryRadius(FVector::ZeroVector, 1000.0f, Found);
+	TestFalse(TEXT("Unregistered"), Found.Contains(Origin));
+	TestEqual(TEXT("Count after unregistering"), Grid->GetNumWorldItems(), 4);
+
+	// Far more cells than are occupied, walks the occupied ones
+	Grid->QueryBox(FBox(FVector(-1.0e7), FVector(1.0e7)), Found);
+	TestEqual(TEXT("Huge box finds everything"), Found.Num(), 4);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockWorldItemGridBenchmarkTest, "RockInventory.World.Grid.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockWorldItemGridBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	constexpr int32 NumWorldItems = 10000;
+	constexpr int32 NumQueries = 1000;
+	constexpr float QueryRadius = 500.0f;
+	constexpr double Extent = 20000.0;
+
+	TGuardValue<float> CellSizeGuard(GetMutableDefault<URockInventoryDeveloperSettings>()->WorldItemGridCellSize, 1000.0f);
+	FScopedTestWorld TestWorld;
+	URockWorldItemGridSubsystem* Grid = TestWorld.World->GetSubsystem<URockWorldItemGridSubsystem>();
+	if (!TestNotNull(TEXT("Grid exists in game worlds"), Grid))
+	{
+		return false;
+	}
+
+	// A 200 x 200 m battlefield littered with loot
+	FRandomStream Random(44);
+	TArray<AActor*> WorldItems;
+	for (int32 Index = 0; Index < NumWorldItems; ++Index)
+	{
+		WorldItems.Add(SpawnActorAt(TestWorld.World, FVector(Random.FRandRange(0.0, Extent), Random.FRandRange(0.0, Extent), 0.0)));
+	}
+
+	const double RegisterStart = FPlatformTime::Seconds();
+	for (AActor* WorldItem : WorldItems)
+	{
+		Grid->RegisterWorldItem(WorldItem);
+	}
+	const double RegisterSeconds = FPlatformTime::Seconds() - RegisterStart;
+	TestEqual(TEXT("Every item registered"), Grid->GetNumWorldItems(), NumWorldItems);
+
+	TArray<FVector> Centers;
+	for (int32 Index = 0; Index < NumQueries; ++Index)
+	{
+		Centers.Add(FVector(Random.FRandRange(0.0, Extent), Random.FRandRange(0.0, Extent), 0.0));
+	}
+
+	TArray<AActor*> Found;
+	int64 NumFound = 0;
+	const double QueryStart = FPlatformTime::Seconds();
+	for (const FVector& Center : Centers)
+	{
+		Grid->QueryRadius(Center, QueryRadius, Found);
+		NumFound += Found.Num();
+	}
+	const double QuerySeconds = FPlatformTime::Seconds() - QueryStart;
+
+	// What finding nearby loot cost before: a distance check against every world item
+	int64 NumScanned = 0;
+	const double ScanStart = FPlatformTime::Seconds();
+	for (const FVector& Center : Centers)
+	{
+		for (const AActor* WorldItem : WorldItems)
+		{
+			NumScanned += FVector::DistSquared(WorldItem->GetActorLocation(), Center) <= FMath::Square(QueryRadius) ? 1 : 0;
+		}
+	}
+	const double ScanSeconds = FPlatformTime::Seconds() - ScanStart;
+	TestEqual(TEXT("Same items as a full scan"), NumFound, NumScanned);
+
+	// Everything shuffles a little, some of it across cells
+	for (AActor* WorldItem : WorldItems)
+	{
+		WorldItem->SetActorLocation(WorldItem->GetActorLocation() + FVector(Random.FRandRange(-200.0, 200.0), Random.FRandRange(-200.0, 200.0), 0.0));
+	}
+	const double UpdateStart = FPlatformTime::Seconds();
+	for (AActor* WorldItem : WorldItems)
+	{
+		Grid->UpdateWorldItem(WorldItem);
+	}
+	const double UpdateSeconds = FPlatformTime::Seconds() - UpdateStart;
+	Grid->QueryRadius(WorldItems[0]->GetActorLocation(), 1.0f, Found);
+	TestTrue(TEXT("Found at its new location"), Found.Contains(WorldItems[0]));
+
+	AddInfo(FString::Printf(TEXT("%d world items: register %.2f ms, update %.2f ms, %.0f m radius query %.2f us (%.1f items) vs full scan %.2f us"),
+		NumWorldItems, RegisterSeconds * 1000.0, UpdateSeconds * 1000.0, QueryRadius / 100.0f, QuerySeconds * 1e6 / NumQueries,
+		static_cast<double>(NumFound) / NumQueries, ScanSeconds * 1e6 / NumQueries));
+	return true;
+}
+
+#endif
@@ -0,0 +1,149 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "Engine/StaticMeshActor.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "World/RockWorldItemSpawnSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockWorldItemSpawnSubsystemTest, "RockInventory.World.SpawnQueue",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockWorldItemSpawnSubsystemTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	// No time budget: every tick spawns exactly one, the minimum
+	URockInventoryDeveloperSettings* Settings = GetMutableDefault<URockInventoryDeveloperSettings>();
+	TGuardValue<float> BudgetGuard(Settings->WorldItemSpawnBudgetMs, 0.0f);
+	TGuardValue<TSubclassOf<AActor>> WorldItemClassGuard(Settings->DefaultWorldItemClass, AStaticMeshActor::StaticClass());
+	FScopedTestWorld TestWorld;
+	URockWorldItemSpawnSubsystem* Spawner = TestWorld.World->GetSubsystem<URockWorldItemSpawnSubsystem>();
+	if (!TestNotNull(TEXT("Spawner exists in game worlds"), Spawner))
+	{
+		return false;
+	}
+
+	URockItemDefinition* Stone = MakeDefinition(TEXT("Stone"), 10);
+	const FTransform Transform(FVector(100.0, 0.0, 0.0));
+	const FRockWorldItemSpawnHandle First = Spawner->QueueSpawn(FRockItemStack(Stone, 1), Transform);
+	const FRockWorldItemSpawnHandle Cancelled = Spawner->QueueSpawn(FRockItemStack(Stone, 7), Transform);
+
+	// Whole inventories drop through QueueActorSpawn, the actor is set up before it finishes spawning
+	TArray<FString> Calls;
+	const FRockWorldItemSpawnHandle Container = Spawner->QueueActorSpawn(AStaticMeshActor::StaticClass(), Transform,
+		[&Calls](AActor*) { Calls.Add(TEXT("BeforeFinish")); },
+		[&Calls](AActor* Actor) { Calls.Add(Actor ? TEXT("Spawned") : TEXT("Failed")); });
+	TestTrue(TEXT("Handles are valid before the actor exists"), First.IsValid() && Container.IsValid());
+	TestTrue(TEXT("Pending"), Spawner->GetSpawnState(First) == ERockWorldItemSpawnState::Pending);
+	TestNull(TEXT("No actor yet"), Spawner->GetSpawnedActor(First));
+
+	FRockItemStack PendingStack;
+	FTransform PendingTransform;
+	TestTrue(TEXT("Pending spawn can be looked at"), Spawner->GetPendingSpawn(Cancelled, PendingStack, PendingTransform));
+	TestEqual(TEXT("Pending stack"), PendingStack.GetStackCount(), 7);
+
+	// Cancelling hands the item back, so a loot that beats the spawn doesn't duplicate it
+	FRockItemStack ReturnedStack;
+	TestTrue(TEXT("Cancelled"), Spawner->CancelSpawn(Cancelled, ReturnedStack));
+	TestEqual(TEXT("Item handed back"), ReturnedStack.GetStackCount(), 7);
+	TestFalse(TEXT("Only once"), Spawner->CancelSpawn(Cancelled, ReturnedStack));
+	TestEqual(TEXT("Left in the queue"), Spawner->GetNumPendingSpawns(), 2);
+
+	// Spread over frames
+	Spawner->Tick(0.0f);
+	TestTrue(TEXT("First spawned on the first tick"), Spawner->GetSpawnState(First) == ERockWorldItemSpawnState::Spawned);
+	TestTrue(TEXT("At its transform"), Spawner->GetSpawnedActor(First) && Spawner->GetSpawnedActor(First)->GetActorLocation().Equals(Transform.GetLocation()));
+	TestTrue(TEXT("Container still pending"), Spawner->GetSpawnState(Container) == ERockWorldItemSpawnState::Pending && Calls.IsEmpty());
+	Spawner->Tick(0.0f);
+	TestTrue(TEXT("Container spawned on the next tick"), Spawner->GetSpawnState(Container) == ERockWorldItemSpawnState::Spawned);
+	TestTrue(TEXT("Set up, then handed out"), Calls == TArray<FString>({TEXT("BeforeFinish"), TEXT("Spawned")}));
+	TestEqual(TEXT("Queue drained"), Spawner->GetNumPendingSpawns(), 0);
+
+	// Flushing ignores the budget
+	for (int32 Count = 0; Count < 3; ++Count)
+	{
+		Spawner->QueueSpawn(FRockItemStack(Stone, 1), Transform);
+	}
+	Spawner->FlushPendingSpawns();
+	TestEqual(TEXT("Flushed at once"), Spawner->GetNumPendingSpawns(), 0);
+
+	Spawner->GetSpawnedActor(First)->Destroy();
+	TestTrue(TEXT("Gone again"), Spawner->GetSpawnState(First) == ERockWorldItemSpawnState::None);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockWorldItemSpawnSubsystemBenchmarkTest, "RockInventory.World.SpawnQueue.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockWorldItemSpawnSubsystemBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	constexpr int32 NumWorldItems = 300;
+	constexpr float BudgetMs = 1.0f;
+
+	// Real world items, kept as actors
+	URockInventoryDeveloperSettings* Settings = GetMutableDefault<URockInventoryDeveloperSettings>();
+	TGuardValue<float> BudgetGuard(Settings->WorldItemSpawnBudgetMs, BudgetMs);
+	TGuardValue<bool> ClustersGuard(Settings->bEnableWorldItemClusters, false);
+	FScopedTestWorld TestWorld;
+	TestWorld.BeginPlay();
+	URockWorldItemSpawnSubsystem* Spawner = TestWorld.World->GetSubsystem<URockWorldItemSpawnSubsystem>();
+	if (!TestNotNull(TEXT("Spawner exists in game worlds"), Spawner))
+	{
+		return false;
+	}
+
+	URockItemDefinition* Stone = MakeWorldDefinition(TEXT("Stone"), 10);
+	FRandomStream Random(50);
+	auto QueueBurst = [Spawner, Stone, &Random]()
+	{
+		TArray<FRockWorldItemSpawnHandle> Handles;
+		for (int32 Index = 0; Index < NumWorldItems; ++Index)
+		{
+			const FVector Location(Random.FRandRange(-2000.0, 2000.0), Random.FRandRange(-2000.0, 2000.0), 0.0);
+			Handles.Add(Spawner->QueueSpawn(FRockItemStack(Stone, 1), FTransform(Location)));
+		}
+		return Handles;
+	};
+	auto CountSpawned = [Spawner](const TArray<FRockWorldItemSpawnHandle>& Handles)
+	{
+		return Handles.FilterByPredicate([Spawner](const FRockWorldItemSpawnHandle& Handle)
+		{
+			return Spawner->GetSpawnState(Handle) == ERockWorldItemSpawnState::Spawned;
+		}).Num();
+	};
+
+	// The whole burst in one frame, like the tight loop it replaces
+	const TArray<FRockWorldItemSpawnHandle> FlushedHandles = QueueBurst();
+	const double FlushStart = FPlatformTime::Seconds();
+	Spawner->FlushPendingSpawns();
+	const double FlushSeconds = FPlatformTime::Seconds() - FlushStart;
+	TestEqual(TEXT("Flushed burst spawned"), CountSpawned(FlushedHandles), NumWorldItems);
+
+	// The same burst under the budget
+	const TArray<FRockWorldItemSpawnHandle> BudgetedHandles = QueueBurst();
+	double MaxFrameSeconds = 0.0;
+	double TotalSeconds = 0.0;
+	int32 NumFrames = 0;
+	while (Spawner->GetNumPendingSpawns() > 0 && NumFrames < NumWorldItems)
+	{
+		const double FrameStart = FPlatformTime::Seconds();
+		Spawner->Tick(1.0f / 60.0f);
+		const double FrameSeconds = FPlatformTime::Seconds() - FrameStart;
+		MaxFrameSeconds = FMath::Max(MaxFrameSeconds, FrameSeconds);
+		TotalSeconds += FrameSeconds;
+		++NumFrames;
+	}
+	TestEqual(TEXT("Budgeted burst spawned"), CountSpawned(BudgetedHandles), NumWorldItems);
+
+	AddInfo(FString::Printf(TEXT("%d world items: %.3f ms in one frame flushed, worst frame %.3f ms over %d frames (%.3f ms total) with a %.1f ms budget"),
+		NumWorldItems, FlushSeconds * 1000.0, MaxFrameSeconds * 1000.0, NumFrames, TotalSeconds * 1000.0, BudgetMs));
+	return true;
+}
+
+#endif
@@ -0,0 +1,129 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "RockInventoryTestHelpers.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Misc/AutomationTest.h"
+#include "World/RockWorldItemVisualSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockWorldItemVisualSubsystemTest, "RockInventory.World.Visuals",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockWorldItemVisualSubsystemTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	FScopedTestWorld TestWorld;
+	URockWorldItemVisualSubsystem* Visuals = TestWorld.World->GetSubsystem<URockWorldItemVisualSubsystem>();
+	if (!TestNotNull(TEXT("Visuals exist in game worlds"), Visuals))
+	{
+		return false;
+	}
+
+	// Resident meshes are answered right away, without streaming anything
+	URockItemDefinition* Stone = MakeWorldDefinition(TEXT("Stone"));
+	UStaticMesh* StoneMesh = nullptr;
+	Visuals->RequestVisuals(Stone, Stone, [&StoneMesh](UStaticMesh* Mesh) { StoneMesh = Mesh; });
+	TestTrue(TEXT("Answered right away"), StoneMesh && StoneMesh == Stone->ItemMesh.Get());
+	Visuals->FlushPendingRequests();
+	TestEqual(TEXT("Nothing streamed"), Visuals->GetNumStreamingRequests(), 0);
+
+	// Never resident, so these have to stream. The world is gone before the loads finish, which drops the callbacks
+	TArray<URockItemDefinition*> Streamed;
+	for (int32 Index = 0; Index < 3; ++Index)
+	{
+		URockItemDefinition* Definition = MakeDefinition(*FString::Printf(TEXT("Streamed%d"), Index));
+		Definition->ItemMesh = TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(FString::Printf(TEXT("/Game/RockInventoryTests/Missing%d.Missing%d"), Index, Index)));
+		Streamed.Add(Definition);
+	}
+
+	// A burst of spawns, some sharing a definition
+	int32 NumAnswered = 0;
+	for (int32 Index = 0; Index < 6; ++Index)
+	{
+		URockItemDefinition* Definition = Streamed[Index % Streamed.Num()];
+		Visuals->RequestVisuals(Definition, Definition, [&NumAnswered](UStaticMesh*) { ++NumAnswered; });
+	}
+	TestEqual(TEXT("Waiting for the end of the frame"), NumAnswered, 0);
+	TestEqual(TEXT("Nothing streamed before the flush"), Visuals->GetNumStreamingRequests(), 0);
+	Visuals->FlushPendingRequests();
+	TestEqual(TEXT("One request for the whole burst"), Visuals->GetNumStreamingRequests(), 1);
+
+	// Joining a request already in flight doesn't issue another one
+	Visuals->RequestVisuals(Streamed[0], Streamed[0], [&NumAnswered](UStaticMesh*) { ++NumAnswered; });
+	Visuals->FlushPendingRequests();
+	TestEqual(TEXT("Joined the one in flight"), Visuals->GetNumStreamingRequests(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRockWorldItemVisualSubsystemBenchmarkTest, "RockInventory.World.Visuals.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRockWorldItemVisualSubsystemBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RockInventoryTests;
+
+	constexpr int32 NumWorldItems = 200;
+	constexpr int32 NumDefinitions = 20;
+
+	FScopedTestWorld TestWorld;
+	URockWorldItemVisualSubsystem* Visuals = TestWorld.World->GetSubsystem<URockWorldItemVisualSubsystem>();
+	if (!TestNotNull(TEXT("Visuals exist in game worlds"), Visuals))
+	{
+		return false;
+	}
+
+	// Separate paths for each side, so neither joins a load the other left in flight
+	auto MakeStreamedDefinitions = [](const TCHAR* Prefix)
+	{
+		TArray<URockItemDefinition*> Definitions;
+		for (int32 Index = 0; Index < NumDefinitions; ++Index)
+		{
+			const FString Name = FString::Printf(TEXT("%s%d"), Prefix, Index);
+			URockItemDefinition* Definition = MakeDefinition(*Name);
+			Definition->ItemMesh = TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(FString::Printf(TEXT("/Game/RockInventoryTests/%s.%s"), *Name, *Name)));
+			Definitions.Add(Definition);
+		}
+		return Definitions;
+	};
+
+	// What every actor used to do on its own, one streaming request each
+	const TArray<URockItemDefinition*> PerActorDefinitions = MakeStreamedDefinitions(TEXT("PerActor"));
+	TArray<TSharedPtr<FStreamableHandle>> PerActorHandles;
+	const double PerActorStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumWorldItems; ++Index)
+	{
+		PerActorHandles.Add(UAssetManager::GetStreamableManager().RequestAsyncLoad(PerActorDefinitions[Index % NumDefinitions]->ItemMesh.ToSoftObjectPath()));
+	}
+	const double PerActorSeconds = FPlatformTime::Seconds() - PerActorStart;
+	for (const TSharedPtr<FStreamableHandle>& Handle : PerActorHandles)
+	{
+		if (Handle.IsValid())
+		{
+			Handle->CancelHandle();
+		}
+	}
+
+	// The same burst through the subsystem, flushed as it would be at the end of the frame
+	const TArray<URockItemDefinition*> SharedDefinitions = MakeStreamedDefinitions(TEXT("Shared"));
+	const int32 NumRequestsBefore = Visuals->GetNumStreamingRequests();
+	const double SharedStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumWorldItems; ++Index)
+	{
+		URockItemDefinition* Definition = SharedDefinitions[Index % NumDefinitions];
+		Visuals->RequestVisuals(Definition, Definition, [](UStaticMesh*) {});
+	}
+	Visuals->FlushPendingRequests();
+	const double SharedSeconds = FPlatformTime::Seconds() - SharedStart;
+	const int32 NumSharedRequests = Visuals->GetNumStreamingRequests() - NumRequestsBefore;
+	TestEqual(TEXT("One request for the whole burst"), NumSharedRequests, 1);
+
+	AddInfo(FString::Printf(TEXT("%d world items over %d definitions: %d streaming requests in %.3f ms one per actor, %d in %.3f ms shared"),
+		NumWorldItems, NumDefinitions, PerActorHandles.Num(), PerActorSeconds * 1000.0, NumSharedRequests, SharedSeconds * 1000.0));
+	return true;
+}
+
+#endif
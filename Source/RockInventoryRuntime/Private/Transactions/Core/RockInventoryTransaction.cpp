@@ -2,6 +2,9 @@
 
 #include "Transactions/Core/RockInventoryTransaction.h"
 
+#include "GameFramework/Controller.h"
+#include "UObject/CoreNet.h"
+
 namespace RockInventoryTransaction::Internal
 {
 static std::atomic<int32> GRockTransactionCount{1};
@@ -25,3 +28,53 @@ void FRockItemTransactionBase::GenerateNewHandle()
 	// Generate a new handle for the transaction
 	TransactionID = RockInventoryTransaction::Internal::GRockTransactionCount.fetch_add(1);
 }
+
+void FRockItemTransactionBase::NetSerializeBase(FArchive& Ar, UPackageMap* Map)
+{
+	UObject* InstigatorObject = Instigator.Get();
+	RockTransactionNet::SerializeObject(Ar, Map, AController::StaticClass(), InstigatorObject);
+
+	uint32 PackedID = static_cast<uint32>(TransactionID);
+	Ar.SerializeIntPacked(PackedID);
+
+	if (Ar.IsLoading())
+	{
+		Instigator = Cast<AController>(InstigatorObject);
+		TransactionID = static_cast<int32>(PackedID);
+	}
+}
+
+namespace RockTransactionNet
+{
+	void SerializeSlotHandle(FArchive& Ar, FRockInventorySlotHandle& SlotHandle)
+	{
+		// +1 so INDEX_NONE encodes as 0
+		uint32 Packed = static_cast<uint32>(SlotHandle.GetAbsoluteIndex() + 1);
+		Ar.SerializeIntPacked(Packed);
+		if (Ar.IsLoading())
+		{
+			SlotHandle = FRockInventorySlotHandle(static_cast<int32>(Packed) - 1);
+		}
+	}
+
+	void SerializeOptionalCount(FArchive& Ar, int32& Count)
+	{
+		uint32 Packed = static_cast<uint32>(FMath::Max(Count, -1) + 1);
+		Ar.SerializeIntPacked(Packed);
+		if (Ar.IsLoading())
+		{
+			Count = static_cast<int32>(Packed) - 1;
+		}
+	}
+
+	void SerializeObject(FArchive& Ar, UPackageMap* Map, UClass* ObjectClass, UObject*& Object)
+	{
+		if (!Map)
+		{
+			// Not a network archive, e.g. when measuring the encoding
+			Ar << Object;
+			return;
+		}
+		Map->SerializeObject(Ar, ObjectClass, Object);
+	}
+}
@@ -0,0 +1,124 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Transactions/Core/RockInventoryTransactionHistory.h"
+
+#include "Transactions/Implementations/RockMoveItemTransaction.h"
+
+bool FRockInventoryTransactionRecord::ExecuteUndo()
+{
+	if (Undo.GetScriptStruct() == FRockMoveItemUndoTransaction::StaticStruct())
+	{
+		FRockMoveItemUndoTransaction UndoData = Undo.Get<FRockMoveItemUndoTransaction>();
+		return UndoData.Undo();
+	}
+	return false;
+	// can't undo anything other than Move at this time. So don't even try.
+}
+
+void FRockInventoryTransactionRecord::Reset()
+{
+	Command.Reset();
+	Undo.Reset();
+}
+
+int32 FRockInventoryTransactionRecord::GetAllocatedSize() const
+{
+	int32 Size = sizeof(FRockInventoryTransactionRecord);
+	if (const UScriptStruct* CommandType = Command.GetScriptStruct())
+	{
+		Size += CommandType->GetStructureSize();
+	}
+	if (const UScriptStruct* UndoType = Undo.GetScriptStruct())
+	{
+		Size += UndoType->GetStructureSize();
+	}
+	return Size;
+}
+
+void FRockInventoryTransactionHistory::Configure(int32 InCapacity, int32 InBudgetBytes)
+{
+	InCapacity = FMath::Max(InCapacity, 1);
+	BudgetBytes = FMath::Max(InBudgetBytes, 0);
+	if (InCapacity != Records.Num())
+	{
+		while (Count > InCapacity)
+		{
+			PopOldest();
+		}
+		TArray<FRockInventoryTransactionRecord> Resized;
+		Resized.SetNum(InCapacity);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Resized[Index] = MoveTemp(Records[ToStorageIndex(Index)]);
+		}
+		Records = MoveTemp(Resized);
+		Head = 0;
+	}
+	while (BudgetBytes > 0 && UsedBytes > BudgetBytes && Count > 0)
+	{
+		PopOldest();
+	}
+}
+
+void FRockInventoryTransactionHistory::Add(FRockInventoryTransactionRecord&& Record)
+{
+	if (Records.IsEmpty())
+	{
+		Configure(1, BudgetBytes);
+	}
+	const int32 RecordSize = Record.GetAllocatedSize();
+	while (Count > 0 && (Count == Records.Num() || (BudgetBytes > 0 && UsedBytes + RecordSize > BudgetBytes)))
+	{
+		PopOldest();
+	}
+	Records[ToStorageIndex(Count)] = MoveTemp(Record);
+	++Count;
+	UsedBytes += RecordSize;
+}
+
+void FRockInventoryTransactionHistory::TruncateAfter(int32 Index)
+{
+	while (Count > FMath::Max(Index + 1, 0))
+	{
+		PopNewest();
+	}
+}
+
+void FRockInventoryTransactionHistory::Reset()
+{
+	while (Count > 0)
+	{
+		PopNewest();
+	}
+	Head = 0;
+}
+
+FRockInventoryTransactionRecord& FRockInventoryTransactionHistory::operator[](int32 Index)
+{
+	check(Index >= 0 && Index < Count);
+	return Records[ToStorageIndex(Index)];
+}
+
+const FRockInventoryTransactionRecord& FRockInventoryTransactionHistory::operator[](int32 Index) const
+{
+	check(Index >= 0 && Index < Count);
+	return Records[ToStorageIndex(Index)];
+}
+
+void FRockInventoryTransactionHistory::PopOldest()
+{
+	FRockInventoryTransactionRecord& Oldest = Records[Head];
+	UsedBytes -= Oldest.GetAllocatedSize();
+	// Release the payloads now rather than when the slot gets reused
+	Oldest.Reset();
+	Head = (Head + 1) % Records.Num();
+	--Count;
+}
+
+void FRockInventoryTransactionHistory::PopNewest()
+{
+	FRockInventoryTransactionRecord& Newest = Records[ToStorageIndex(Count - 1)];
+	UsedBytes -= Newest.GetAllocatedSize();
+	Newest.Reset();
+	--Count;
+}
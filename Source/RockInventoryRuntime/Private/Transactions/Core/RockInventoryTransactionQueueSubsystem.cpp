@@ -0,0 +1,319 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Transactions/Core/RockInventoryTransactionQueueSubsystem.h"
+
+#include "RockInventoryLogging.h"
+#include "Components/RockInventoryManagerComponent.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "Inventory/RockInventory.h"
+#include "Inventory/RockInventoryDeferredEffects.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "Transactions/Core/RockInventoryTransactionHistory.h"
+
+namespace RockTransactionQueue::Internal
+{
+	// Keeps one controller's burst from making its worker the long pole of the wave
+	constexpr int32 MaxParallelGroupSize = 16;
+}
+
+struct URockInventoryTransactionQueueSubsystem::FParallelGroup
+{
+	URockInventoryManagerComponent* Manager = nullptr;
+	TArray<FQueuedTransaction, TInlineAllocator<4>> Entries;
+	TArray<URockInventory*, TInlineAllocator<4>> Inventories;
+
+	// Filled on the worker
+	TArray<ERockTransactionExecuteResult, TInlineAllocator<4>> Results;
+	TArray<FRockInventoryTransactionRecord, TInlineAllocator<4>> Records;
+	FRockInventoryDeferredEffects Effects;
+};
+
+void URockInventoryTransactionQueueSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const URockInventoryDeveloperSettings* Settings = GetDefault<URockInventoryDeveloperSettings>();
+	bEnabled = Settings->bEnableTransactionQueue && InWorld.GetNetMode() != NM_Client;
+	BudgetSeconds = Settings->TransactionQueueBudgetMs / 1000.0;
+	MaxQueuedPerController = Settings->MaxQueuedTransactionsPerController;
+	bParallelExecution = Settings->bParallelTransactionExecution;
+	MinParallelGroups = Settings->MinParallelTransactionGroups;
+}
+
+void URockInventoryTransactionQueueSubsystem::Deinitialize()
+{
+	// Whatever is left belongs to a world that is going away
+	Queues.Reset();
+	InventoryOrder.Reset();
+	NumQueued = 0;
+	bEnabled = false;
+	Super::Deinitialize();
+}
+
+bool URockInventoryTransactionQueueSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URockInventoryTransactionQueueSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	ProcessQueue(BudgetSeconds);
+}
+
+TStatId URockInventoryTransactionQueueSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URockInventoryTransactionQueueSubsystem, STATGROUP_Tickables);
+}
+
+bool URockInventoryTransactionQueueSubsystem::Enqueue(URockInventoryManagerComponent* Manager, FInstancedStruct&& Transaction)
+{
+	check(Manager);
+	FControllerQueue* Queue = Queues.FindByPredicate([Manager](const FControllerQueue& Candidate) { return Candidate.Manager == Manager; });
+	if (!Queue)
+	{
+		Queue = &Queues.AddDefaulted_GetRef();
+		Queue->Manager = Manager;
+	}
+	if (Queue->Pending.Num() >= MaxQueuedPerController)
+	{
+		++Stats.Dropped;
+		UE_LOG(LogRockInventory, Warning, TEXT("TransactionQueue - %s has %d transactions waiting, rejecting"),
+			*GetNameSafe(Manager->GetOwner()), Queue->Pending.Num());
+		return false;
+	}
+
+	FQueuedTransaction& Entry = Queue->Pending.AddDefaulted_GetRef();
+	Entry.Sequence = NextSequence++;
+	Entry.EnqueueTime = FPlatformTime::Seconds();
+
+	TArray<URockInventory*, TInlineAllocator<2>> Inventories;
+	URockInventoryManagerComponent::GetTouchedInventories(Transaction, Inventories);
+	for (URockInventory* Inventory : Inventories)
+	{
+		Entry.Inventories.Add(Inventory);
+		InventoryOrder.FindOrAdd(Inventory).Add(Entry.Sequence);
+	}
+	Entry.Transaction = MoveTemp(Transaction);
+
+	++NumQueued;
+	Stats.MaxQueued = FMath::Max(Stats.MaxQueued, NumQueued);
+	return true;
+}
+
+int32 URockInventoryTransactionQueueSubsystem::ProcessQueue(double InBudgetSeconds)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumProcessed = 0;
+	// Queues visited in a row without running anything. Once it covers every queue, everything left is blocked
+	int32 NumSkipped = 0;
+
+	// A wave is collected once per pass over the controllers, so looking for one stays cheap when nothing qualifies
+	bool bTryParallelWave = bParallelExecution;
+	while (NumQueued > 0 && NumSkipped < Queues.Num())
+	{
+		if (NumProcessed > 0 && FPlatformTime::Seconds() - StartTime >= InBudgetSeconds)
+		{
+			break;
+		}
+		if (NextQueue >= Queues.Num())
+		{
+			NextQueue = 0;
+			bTryParallelWave = bParallelExecution;
+		}
+		if (bTryParallelWave)
+		{
+			bTryParallelWave = false;
+			const int32 NumRan = ProcessParallelWave();
+			if (NumRan > 0)
+			{
+				NumProcessed += NumRan;
+				NumSkipped = 0;
+				continue;
+			}
+		}
+		FControllerQueue& Queue = Queues[NextQueue++];
+		if (Queue.Pending.IsEmpty() || !CanExecute(Queue.Pending[0]))
+		{
+			++NumSkipped;
+			continue;
+		}
+		NumSkipped = 0;
+
+		FQueuedTransaction Entry;
+		if (!PopForExecution(Queue, Entry))
+		{
+			continue;
+		}
+		// May enqueue again (e.g. a delegate moving another item), which only appends
+		Queue.Manager->ExecuteQueuedTransaction(Entry.Transaction);
+		++Stats.Processed;
+		++NumProcessed;
+	}
+	// Every pass always finds the oldest transaction runnable, so only a bug ends up here
+	ensureMsgf(NumQueued == 0 || NumSkipped < Queues.Num(), TEXT("TransactionQueue - Every queue is blocked"));
+
+	// Forget controllers that left
+	for (int32 Index = Queues.Num() - 1; Index >= 0; --Index)
+	{
+		if (Queues[Index].Pending.IsEmpty() && !Queues[Index].Manager.IsValid())
+		{
+			Queues.RemoveAt(Index);
+		}
+	}
+
+	Stats.MaxFrameSeconds = FMath::Max(Stats.MaxFrameSeconds, FPlatformTime::Seconds() - StartTime);
+	return NumProcessed;
+}
+
+int32 URockInventoryTransactionQueueSubsystem::ProcessParallelWave()
+{
+	using namespace RockTransactionQueue::Internal;
+
+	// Collect: groups in round robin order, each inventory claimed by at most one group
+	TArray<FParallelGroup> Groups;
+	TMap<URockInventory*, int32> ClaimedBy;
+	for (int32 Offset = 0; Offset < Queues.Num(); ++Offset)
+	{
+		FControllerQueue& Queue = Queues[(NextQueue + Offset) % Queues.Num()];
+		URockInventoryManagerComponent* Manager = Queue.Manager.Get();
+		if (!Manager)
+		{
+			continue;
+		}
+		const int32 GroupIndex = Groups.Num();
+		while (!Queue.Pending.IsEmpty() && (Groups.Num() == GroupIndex || Groups[GroupIndex].Entries.Num() < MaxParallelGroupSize))
+		{
+			const FQueuedTransaction& Head = Queue.Pending[0];
+			if (!CanExecute(Head) || !URockInventoryManagerComponent::CanExecuteOffGameThread(Head.Transaction))
+			{
+				break;
+			}
+			const bool bClaimedByOther = Head.Inventories.ContainsByPredicate([&ClaimedBy, GroupIndex](const TWeakObjectPtr<URockInventory>& Inventory)
+			{
+				const int32* Claim = ClaimedBy.Find(Inventory.Get());
+				return Claim && *Claim != GroupIndex;
+			});
+			if (bClaimedByOther)
+			{
+				break;
+			}
+
+			if (Groups.Num() == GroupIndex)
+			{
+				Groups.AddDefaulted_GetRef().Manager = Manager;
+			}
+			FParallelGroup& Group = Groups[GroupIndex];
+			FQueuedTransaction& Entry = Group.Entries.AddDefaulted_GetRef();
+			PopForExecution(Queue, Entry);
+			for (const TWeakObjectPtr<URockInventory>& Inventory : Entry.Inventories)
+			{
+				// Checked valid by CanExecuteOffGameThread
+				Group.Inventories.AddUnique(Inventory.Get());
+				ClaimedBy.Add(Inventory.Get(), GroupIndex);
+			}
+		}
+	}
+	if (Groups.IsEmpty())
+	{
+		return 0;
+	}
+
+	int32 NumRan = 0;
+	if (Groups.Num() < MinParallelGroups)
+	{
+		// Not worth the tasks. Already popped, so run them here in the same order
+		for (FParallelGroup& Group : Groups)
+		{
+			for (FQueuedTransaction& Entry : Group.Entries)
+			{
+				Group.Manager->ExecuteQueuedTransaction(Entry.Transaction);
+				++NumRan;
+			}
+		}
+		Stats.Processed += NumRan;
+		return NumRan;
+	}
+
+	for (FParallelGroup& Group : Groups)
+	{
+		Group.Manager->BeginParallelTransactions();
+		Group.Results.SetNum(Group.Entries.Num());
+		Group.Records.SetNum(Group.Entries.Num());
+	}
+
+	// Groups share no inventory, and each has its own manager, so nothing below is touched by two workers
+	ParallelFor(Groups.Num(), [&Groups](int32 GroupIndex)
+	{
+		FParallelGroup& Group = Groups[GroupIndex];
+		FRockInventoryDeferredEffectsScope DeferredScope(Group.Effects, Group.Inventories);
+		for (int32 Index = 0; Index < Group.Entries.Num(); ++Index)
+		{
+			Group.Results[Index] = Group.Manager->ExecuteParallelTransaction(Group.Entries[Index].Transaction, Group.Records[Index]);
+		}
+	});
+
+	// Commit on the game thread. Delegates may enqueue again, which only appends to Queues
+	for (FParallelGroup& Group : Groups)
+	{
+		Group.Effects.Apply();
+		for (int32 Index = 0; Index < Group.Entries.Num(); ++Index)
+		{
+			Group.Manager->FinishQueuedTransaction(Group.Entries[Index].Transaction, Group.Results[Index], MoveTemp(Group.Records[Index]));
+			++NumRan;
+		}
+		Group.Manager->EndParallelTransactions();
+	}
+	Stats.Processed += NumRan;
+	++Stats.ParallelWaves;
+	return NumRan;
+}
+
+bool URockInventoryTransactionQueueSubsystem::PopForExecution(FControllerQueue& Queue, FQueuedTransaction& OutEntry)
+{
+	OutEntry = MoveTemp(Queue.Pending[0]);
+	Queue.Pending.RemoveAt(0, EAllowShrinking::No);
+	--NumQueued;
+	ReleaseInventoryOrder(OutEntry);
+
+	const double Now = FPlatformTime::Seconds();
+	Stats.MaxQueueLatencySeconds = FMath::Max(Stats.MaxQueueLatencySeconds, Now - OutEntry.EnqueueTime);
+
+	if (!Queue.Manager.IsValid())
+	{
+		++Stats.Dropped;
+		return false;
+	}
+	return true;
+}
+
+bool URockInventoryTransactionQueueSubsystem::CanExecute(const FQueuedTransaction& Entry) const
+{
+	for (const TWeakObjectPtr<URockInventory>& Inventory : Entry.Inventories)
+	{
+		const TArray<uint64, TInlineAllocator<4>>* Order = InventoryOrder.Find(Inventory);
+		if (Order && Order->Num() > 0 && (*Order)[0] != Entry.Sequence)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void URockInventoryTransactionQueueSubsystem::ReleaseInventoryOrder(const FQueuedTransaction& Entry)
+{
+	for (const TWeakObjectPtr<URockInventory>& Inventory : Entry.Inventories)
+	{
+		TArray<uint64, TInlineAllocator<4>>* Order = InventoryOrder.Find(Inventory);
+		if (!Order)
+		{
+			continue;
+		}
+		Order->RemoveSingle(Entry.Sequence);
+		if (Order->IsEmpty())
+		{
+			InventoryOrder.Remove(Inventory);
+		}
+	}
+}
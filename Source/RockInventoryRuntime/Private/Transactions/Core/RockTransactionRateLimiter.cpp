@@ -0,0 +1,54 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Transactions/Core/RockTransactionRateLimiter.h"
+
+#include "Misc/RockInventoryDeveloperSettings.h"
+
+void FRockTransactionRateLimiter::Configure()
+{
+	const URockInventoryDeveloperSettings* Settings = GetDefault<URockInventoryDeveloperSettings>();
+	bEnabled = Settings->bEnableTransactionRateLimiting;
+	for (const ERockRateLimitedRequest Request : TEnumRange<ERockRateLimitedRequest>())
+	{
+		FBucket& Bucket = Buckets[static_cast<int32>(Request)];
+		const FRockTokenBucketConfig* Override = Settings->TransactionRateLimitOverrides.Find(Request);
+		Bucket.Config = Override ? *Override : Settings->DefaultTransactionRateLimit;
+		// Start full, a fresh connection shouldn't be throttled
+		Bucket.Tokens = Bucket.Config.BurstSize;
+		Bucket.LastRefillTime = -1.0;
+	}
+}
+
+bool FRockTransactionRateLimiter::TryConsume(ERockRateLimitedRequest Request, double Now, float Cost)
+{
+	if (!bEnabled)
+	{
+		return true;
+	}
+	FBucket& Bucket = Buckets[static_cast<int32>(Request)];
+	if (Bucket.LastRefillTime >= 0.0)
+	{
+		const double Elapsed = FMath::Max(Now - Bucket.LastRefillTime, 0.0);
+		Bucket.Tokens = FMath::Min(Bucket.Config.BurstSize, Bucket.Tokens + static_cast<float>(Elapsed * Bucket.Config.TokensPerSecond));
+	}
+	Bucket.LastRefillTime = Now;
+
+	if (Bucket.Tokens < Cost)
+	{
+		++Bucket.Rejected;
+		++TotalRejected;
+		return false;
+	}
+	Bucket.Tokens -= Cost;
+	return true;
+}
+
+void FRockTransactionRateLimiter::GetStats(FRockRateLimitStats& OutStats) const
+{
+	OutStats.TotalRejected = TotalRejected;
+	OutStats.RejectedByRequest.SetNum(Buckets.Num());
+	for (int32 Index = 0; Index < Buckets.Num(); ++Index)
+	{
+		OutStats.RejectedByRequest[Index] = Buckets[Index].Rejected;
+	}
+}
@@ -23,14 +23,15 @@ FRockDropItemUndoTransaction FRockDropItemTransaction::Execute() const
 		UE_LOG(LogRockInventory, Warning, TEXT("DropItemTransaction::Execute - Invalid Instigator"));
 		return UndoTransaction;
 	}
-
-
-	const FRockItemStack Item = URockInventoryLibrary::SplitItemStackAtLocation(SourceInventory, SourceSlotHandle);
-	if (!Item.IsValid())
+	// Looked up before the item leaves the inventory, so it can't get lost
+	URockWorldItemSpawnSubsystem* Spawner = Instigator->GetWorld()->GetSubsystem<URockWorldItemSpawnSubsystem>();
+	if (!Spawner)
 	{
+		UE_LOG(LogRockInventory, Warning, TEXT("DropItemTransaction::Execute - No spawn subsystem in this world"));
 		return UndoTransaction;
 	}
 
+	// Everything that can turn the drop down is checked before the item leaves the inventory
 	const FRockPendingSlotOperation TargetPendingSlot = SourceInventory->GetPendingSlotState(SourceSlotHandle);
 	if (TargetPendingSlot.IsClaimedByOther(Instigator.Get()))
 	{
@@ -38,8 +39,6 @@ FRockDropItemUndoTransaction FRockDropItemTransaction::Execute() const
 		return UndoTransaction;
 	}
 
-	UndoTransaction.ExistingOrientation = SourceInventory->GetSlotByHandle(SourceSlotHandle).Orientation;
-
 	// Prefer the instigator's transform if available
 	const AController* DropInstigator = Instigator.Get();
 	if (!DropInstigator)
@@ -62,32 +61,26 @@ FRockDropItemUndoTransaction FRockDropItemTransaction::Execute() const
 	const FVector safeOffset = FindSafeDropLocation(DropInstigator, pawn->GetActorLocation() + desiredOffset);
 	transform.SetLocation(safeOffset);
 
-	UClass* WorldItemClass = Item.GetDefinition()->GetWorldItemClass();
-	AActor* NewWorldItem = pawn->GetWorld()->SpawnActorDeferred<AActor>(WorldItemClass, transform);
-	checkf(NewWorldItem, TEXT("Failed to spawn world item actor of class. Possibly DefaultWorldItemClass is unset in Project Settings"));
+	// Queued so a bulk drop is spread over frames, the impulse is applied once it spawns
+	// TODO: What if we wanted to 'place' an item instead of 'drop/throw' it
+	const FVector LocalImpulse = throwRotation.RotateVector(Impulse);
 
-	if (!IsValid(NewWorldItem))
+	UndoTransaction.ExistingOrientation = SourceInventory->GetSlotByHandle(SourceSlotHandle).Orientation;
+	const FRockItemStack Item = URockInventoryLibrary::SplitItemStackAtLocation(SourceInventory, SourceSlotHandle);
+	if (!Item.IsValid())
 	{
 		return UndoTransaction;
 	}
-	IRockLootableInterface* WorldItemInterfaceActor = Cast<IRockLootableInterface>(NewWorldItem);
-	if (WorldItemInterfaceActor)
+	UndoTransaction.SpawnHandle = Spawner->QueueSpawn(Item, transform, LocalImpulse);
+	UndoTransaction.bSuccess = UndoTransaction.SpawnHandle.IsValid();
+	if (!UndoTransaction.bSuccess)
 	{
-		WorldItemInterfaceActor->SetItemStack(Item);
+		// Nothing is going to spawn it, so it goes back where it was
+		FRockInventorySlotEntry SourceSlot = SourceInventory->GetSlotByHandle(SourceSlotHandle);
+		SourceSlot.ItemHandle = SourceInventory->AddItemToInventory(Item);
+		SourceSlot.Orientation = UndoTransaction.ExistingOrientation;
+		SourceInventory->SetSlotByHandle(SourceSlotHandle, SourceSlot);
 	}
-
-	UGameplayStatics::FinishSpawningActor(NewWorldItem, transform);
-
-	// Does this work if we do it before FinishSpawningActor?
-	if (WorldItemInterfaceActor)
-	{
-		// TODO: What if we wanted to 'place' an item instead of 'drop/throw' it
-		FVector LocalImpulse = throwRotation.RotateVector(Impulse);
-		WorldItemInterfaceActor->ApplyThrowImpulse(LocalImpulse);
-	}
-
-	UndoTransaction.bSuccess = true;
-	UndoTransaction.SpawnedItemStack = NewWorldItem;
 	return UndoTransaction;
 }
 
@@ -96,6 +89,40 @@ bool FRockDropItemTransaction::AttemptPredict() const
 	return false;
 }
 
+bool FRockDropItemTransaction::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	NetSerializeBase(Ar, Map);
+	RockTransactionNet::SerializeObject(Ar, Map, SourceInventory);
+	RockTransactionNet::SerializeSlotHandle(Ar, SourceSlotHandle);
+
+	// Plain drops leave both vectors zeroed, which then costs a bit each instead of a quantized vector
+	uint8 bHasOffset = !DropLocationOffset.IsZero();
+	uint8 bHasImpulse = !Impulse.IsZero();
+	Ar.SerializeBits(&bHasOffset, 1);
+	Ar.SerializeBits(&bHasImpulse, 1);
+
+	bool bVectorSuccess = true;
+	if (bHasOffset)
+	{
+		DropLocationOffset.NetSerialize(Ar, Map, bVectorSuccess);
+	}
+	else if (Ar.IsLoading())
+	{
+		DropLocationOffset = FVector::ZeroVector;
+	}
+	if (bHasImpulse)
+	{
+		Impulse.NetSerialize(Ar, Map, bVectorSuccess);
+	}
+	else if (Ar.IsLoading())
+	{
+		Impulse = FVector::ZeroVector;
+	}
+
+	bOutSuccess = bVectorSuccess && !Ar.IsError();
+	return true;
+}
+
 FVector FRockDropItemTransaction::FindThrowDirection(const AController* Controller) const
 {
 	if (const APlayerController* PC = Cast<APlayerController>(Controller))
@@ -115,3 +115,13 @@ bool FRockLootWorldItemTransaction::AttemptPredict() const
 {
 	return false;
 }
+
+bool FRockLootWorldItemTransaction::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	NetSerializeBase(Ar, Map);
+	RockTransactionNet::SerializeObject(Ar, Map, SourceWorldItemActor);
+	RockTransactionNet::SerializeObject(Ar, Map, TargetInventory);
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
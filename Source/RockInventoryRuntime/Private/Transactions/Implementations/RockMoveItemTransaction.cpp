@@ -4,6 +4,7 @@
 
 #include "RockInventoryLogging.h"
 #include "Inventory/RockInventory.h"
+#include "Item/RockItemDefinition.h"
 #include "Library/RockInventoryLibrary.h"
 
 bool FRockMoveItemUndoTransaction::CanUndo() const
@@ -26,7 +27,7 @@ bool FRockMoveItemUndoTransaction::CanUndo() const
 	const FRockItemStack& CurrentTargetItem = TargetInventory->GetItemBySlotHandle(TargetSlotHandle);
 
 	// If the items have been modified since our operation, we can't safely undo
-	if (CurrentSourceItem != PostMoveSourceItem || CurrentTargetItem != PostMoveTargetItem)
+	if (CurrentSourceItem.GetFingerprint() != PostMoveSourceFingerprint || CurrentTargetItem.GetFingerprint() != PostMoveTargetFingerprint)
 	{
 		UE_LOG(LogRockInventory, Warning, TEXT("MoveItemTransaction::CanUndo - Item states have changed since the move was performed"));
 		return false;
@@ -40,7 +41,7 @@ bool FRockMoveItemUndoTransaction::Undo() const
 	// Skip undo if execute didn't succeed
 
 	// CanUndo should have been called first. Don't need to check again.
-	checkf(!bSuccess, TEXT("MoveItemTransaction::Undo - Original move failed, nothing to undo"));
+	checkf(bSuccess, TEXT("MoveItemTransaction::Undo - Original move failed, nothing to undo"));
 	checkf(SourceInventory && TargetInventory, TEXT("MoveItemTransaction::Undo - Source or Target inventory is null"));
 
 	// Only try to undo if we can verify the state is still valid
@@ -142,32 +143,38 @@ FRockMoveItemUndoTransaction FRockMoveItemTransaction::Execute() const
 		
 	
 
+	UndoTransaction.Instigator = Instigator;
+	UndoTransaction.SourceInventory = SourceInventory;
+	UndoTransaction.SourceSlotHandle = SourceSlotHandle;
+	UndoTransaction.TargetInventory = TargetInventory;
+	UndoTransaction.TargetSlotHandle = TargetSlotHandle;
+
 	const FRockInventorySlotEntry& OriginalSlot = SourceInventory->GetSlotByHandle(SourceSlotHandle);
 	UndoTransaction.OriginalOrientation = OriginalSlot.Orientation;
 
-	// Store the original states before the move
-	UndoTransaction.OriginalSourceItem = SourceInventory->GetItemBySlotHandle(SourceSlotHandle);
-	UndoTransaction.OriginalTargetItem = TargetInventory->GetItemBySlotHandle(TargetSlotHandle);
+	// Only the original target count is needed, to work out how much was moved
+	const FRockItemStack OriginalTargetItem = TargetInventory->GetItemBySlotHandle(TargetSlotHandle);
 
 	// Execute the move operation
-	UndoTransaction.bSuccess = URockInventoryLibrary::MoveItem(SourceInventory, SourceSlotHandle, TargetInventory, TargetSlotHandle);
+	UndoTransaction.bSuccess = URockInventoryLibrary::MoveItem(SourceInventory, SourceSlotHandle, TargetInventory, TargetSlotHandle, MoveParams);
 
 	// Store the post-move states for future validation
-	UndoTransaction.PostMoveSourceItem = SourceInventory->GetItemBySlotHandle(SourceSlotHandle);
-	UndoTransaction.PostMoveTargetItem = TargetInventory->GetItemBySlotHandle(TargetSlotHandle);
+	const FRockItemStack PostMoveTargetItem = TargetInventory->GetItemBySlotHandle(TargetSlotHandle);
+	UndoTransaction.PostMoveSourceFingerprint = SourceInventory->GetItemBySlotHandle(SourceSlotHandle).GetFingerprint();
+	UndoTransaction.PostMoveTargetFingerprint = PostMoveTargetItem.GetFingerprint();
 
 	// Calculate the actual amount moved for proper undoing
 	if (UndoTransaction.bSuccess)
 	{
 		// For a new stack, this is the final target stack size
 		// For a merged stack, this is the difference from original
-		if (UndoTransaction.OriginalTargetItem.IsValid())
+		if (OriginalTargetItem.IsValid())
 		{
-			UndoTransaction.MoveCount = UndoTransaction.PostMoveTargetItem.GetStackCount() - UndoTransaction.OriginalTargetItem.GetStackCount();
+			UndoTransaction.MoveCount = PostMoveTargetItem.GetStackCount() - OriginalTargetItem.GetStackCount();
 		}
 		else
 		{
-			UndoTransaction.MoveCount = UndoTransaction.PostMoveTargetItem.GetStackCount();
+			UndoTransaction.MoveCount = PostMoveTargetItem.GetStackCount();
 		}
 	}
 
@@ -176,5 +183,75 @@ FRockMoveItemUndoTransaction FRockMoveItemTransaction::Execute() const
 
 bool FRockMoveItemTransaction::AttemptPredict() const
 {
+	if (!SourceInventory || !TargetInventory)
+	{
+		return false;
+	}
+	const FRockItemStack SourceItem = SourceInventory->GetItemBySlotHandle(SourceSlotHandle);
+	if (!SourceItem.IsValid())
+	{
+		return false;
+	}
+	// Runtime instances are server owned objects, a client can't move or create them
+	if (SourceItem.GetRuntimeInstance() || !SourceItem.GetDefinition()->RuntimeInstanceClass.IsNull())
+	{
+		return false;
+	}
+	// Anything but a full stack move within one inventory may allocate a new item on the target.
+	// Only predict it when the target can reuse an index, the server will pick the same one
+	const bool bMayAllocate = SourceInventory != TargetInventory || MoveParams.MoveMode != ERockItemMoveMode::FullStack;
+	if (bMayAllocate && TargetInventory->FindFreeItemIndex() == INDEX_NONE)
+	{
+		return false;
+	}
+	return true;
+}
+
+bool FRockMoveItemTransaction::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	NetSerializeBase(Ar, Map);
+
+	// Most moves stay within one inventory and use the default params, so both get a single bit
+	uint8 bSameInventory = SourceInventory == TargetInventory;
+	uint8 bCustomParams = MoveParams.DesiredOrientation != ERockItemOrientation::Horizontal || MoveParams.MoveMode != ERockItemMoveMode::FullStack;
+	Ar.SerializeBits(&bSameInventory, 1);
+	Ar.SerializeBits(&bCustomParams, 1);
+
+	RockTransactionNet::SerializeObject(Ar, Map, SourceInventory);
+	if (!bSameInventory)
+	{
+		RockTransactionNet::SerializeObject(Ar, Map, TargetInventory);
+	}
+	else if (Ar.IsLoading())
+	{
+		TargetInventory = SourceInventory;
+	}
+	RockTransactionNet::SerializeSlotHandle(Ar, SourceSlotHandle);
+	RockTransactionNet::SerializeSlotHandle(Ar, TargetSlotHandle);
+
+	if (bCustomParams)
+	{
+		uint8 Orientation = static_cast<uint8>(MoveParams.DesiredOrientation);
+		uint32 MoveMode = static_cast<uint32>(MoveParams.MoveMode);
+		Ar.SerializeBits(&Orientation, 1);
+		Ar.SerializeInt(MoveMode, 4);
+		if (Ar.IsLoading())
+		{
+			MoveParams.DesiredOrientation = static_cast<ERockItemOrientation>(Orientation);
+			MoveParams.MoveMode = static_cast<ERockItemMoveMode>(MoveMode);
+			MoveParams.MoveCount = -1;
+		}
+		// The count is only meaningful for custom amounts
+		if (MoveParams.MoveMode == ERockItemMoveMode::CustomAmount)
+		{
+			RockTransactionNet::SerializeOptionalCount(Ar, MoveParams.MoveCount);
+		}
+	}
+	else if (Ar.IsLoading())
+	{
+		MoveParams = FRockMoveItemParams();
+	}
+
+	bOutSuccess = !Ar.IsError();
 	return true;
 }
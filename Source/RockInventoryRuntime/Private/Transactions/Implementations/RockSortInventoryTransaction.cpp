@@ -0,0 +1,97 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Transactions/Implementations/RockSortInventoryTransaction.h"
+
+#include "RockInventoryLogging.h"
+#include "Inventory/RockInventory.h"
+#include "Library/RockInventoryLibrary.h"
+
+namespace RockSortInventoryTransaction::Internal
+{
+	// Plenty for any meaningful ordering, and bounds what a client can make the server loop over
+	constexpr int32 MaxSortKeys = 8;
+	constexpr int32 MaxRarities = 16;
+}
+
+FRockSortInventoryTransaction::FRockSortInventoryTransaction()
+{
+	GenerateNewHandle();
+}
+
+FRockSortInventoryTransaction::FRockSortInventoryTransaction(
+	AController* InInstigator, URockInventory* InInventory, const FRockInventorySortParams& InSortParams)
+	: Super(InInstigator), Inventory(InInventory), SortParams(InSortParams)
+{
+	GenerateNewHandle();
+}
+
+bool FRockSortInventoryTransaction::CanExecute() const
+{
+	if (!Inventory)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("SortInventoryTransaction::CanExecute - Invalid Inventory"));
+		return false;
+	}
+	return true;
+}
+
+FRockSortInventoryUndoTransaction FRockSortInventoryTransaction::Execute() const
+{
+	FRockSortInventoryUndoTransaction UndoTransaction;
+
+	if (!Instigator.IsValid() || !IsValid(Inventory))
+	{
+		UE_LOG(LogRockInventory, Error, TEXT("SortInventoryTransaction::Execute - Invalid Instigator or Inventory"));
+		return UndoTransaction;
+	}
+
+	UndoTransaction.bSuccess = URockInventoryLibrary::SortInventory(Inventory, SortParams, Instigator.Get());
+	return UndoTransaction;
+}
+
+bool FRockSortInventoryTransaction::AttemptPredict() const
+{
+	return false;
+}
+
+bool FRockSortInventoryTransaction::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	using namespace RockSortInventoryTransaction::Internal;
+
+	NetSerializeBase(Ar, Map);
+	RockTransactionNet::SerializeObject(Ar, Map, Inventory);
+
+	uint32 NumKeys = FMath::Min(SortParams.SortKeys.Num(), MaxSortKeys);
+	Ar.SerializeInt(NumKeys, MaxSortKeys + 1);
+	if (Ar.IsLoading())
+	{
+		SortParams.SortKeys.SetNum(NumKeys);
+	}
+	for (uint32 Index = 0; Index < NumKeys; ++Index)
+	{
+		uint8 Key = static_cast<uint8>(SortParams.SortKeys[Index]);
+		Ar << Key;
+		SortParams.SortKeys[Index] = static_cast<ERockInventorySortKey>(Key);
+	}
+
+	uint8 bConsolidateStacks = SortParams.bConsolidateStacks;
+	Ar.SerializeBits(&bConsolidateStacks, 1);
+	SortParams.bConsolidateStacks = !!bConsolidateStacks;
+
+	bool bTagSuccess = true;
+	SortParams.SectionTag.NetSerialize(Ar, Map, bTagSuccess);
+
+	uint32 NumRarities = FMath::Min(SortParams.RarityOrder.Num(), MaxRarities);
+	Ar.SerializeInt(NumRarities, MaxRarities + 1);
+	if (Ar.IsLoading())
+	{
+		SortParams.RarityOrder.SetNum(NumRarities);
+	}
+	for (uint32 Index = 0; Index < NumRarities; ++Index)
+	{
+		SortParams.RarityOrder[Index].NetSerialize(Ar, Map, bTagSuccess);
+	}
+
+	bOutSuccess = bTagSuccess && !Ar.IsError();
+	return true;
+}
@@ -0,0 +1,64 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "Transactions/Implementations/RockTransferAllTransaction.h"
+
+#include "RockInventoryLogging.h"
+#include "Inventory/RockInventory.h"
+#include "Library/RockInventoryLibrary.h"
+
+FRockTransferAllTransaction::FRockTransferAllTransaction()
+{
+	GenerateNewHandle();
+}
+
+FRockTransferAllTransaction::FRockTransferAllTransaction(
+	AController* InInstigator, URockInventory* InSourceInventory, URockInventory* InTargetInventory)
+	: Super(InInstigator), SourceInventory(InSourceInventory), TargetInventory(InTargetInventory)
+{
+	GenerateNewHandle();
+}
+
+bool FRockTransferAllTransaction::CanExecute() const
+{
+	if (!SourceInventory || !TargetInventory)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("TransferAllTransaction::CanExecute - Invalid Source or Target Inventory"));
+		return false;
+	}
+	if (SourceInventory == TargetInventory)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("TransferAllTransaction::CanExecute - Source and Target are the same inventory"));
+		return false;
+	}
+	return true;
+}
+
+FRockTransferAllUndoTransaction FRockTransferAllTransaction::Execute() const
+{
+	FRockTransferAllUndoTransaction UndoTransaction;
+
+	if (!Instigator.IsValid() || !IsValid(SourceInventory) || !IsValid(TargetInventory))
+	{
+		UE_LOG(LogRockInventory, Error, TEXT("TransferAllTransaction::Execute - Invalid Instigator, Source or Target Inventory"));
+		return UndoTransaction;
+	}
+
+	UndoTransaction.bSuccess = URockInventoryLibrary::TransferAllItems(
+		SourceInventory, TargetInventory, Instigator.Get(), UndoTransaction.MovedCount, UndoTransaction.LeftoverSlots);
+	return UndoTransaction;
+}
+
+bool FRockTransferAllTransaction::AttemptPredict() const
+{
+	return false;
+}
+
+bool FRockTransferAllTransaction::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	NetSerializeBase(Ar, Map);
+	RockTransactionNet::SerializeObject(Ar, Map, SourceInventory);
+	RockTransactionNet::SerializeObject(Ar, Map, TargetInventory);
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
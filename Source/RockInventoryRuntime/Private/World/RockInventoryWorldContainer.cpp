@@ -0,0 +1,62 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "World/RockInventoryWorldContainer.h"
+
+#include "Components/RockInventoryComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Inventory/RockInventory.h"
+#include "TimerManager.h"
+
+ARockInventoryWorldContainer::ARockInventoryWorldContainer(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = false;
+	bReplicates = true;
+	bReplicateUsingRegisteredSubObjectList = true;
+
+	StaticMeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("StaticMesh"));
+	StaticMeshComponent->CanCharacterStepUpOn = ECanBeCharacterBase::ECB_No;
+	RootComponent = StaticMeshComponent;
+
+	InventoryComponent = CreateDefaultSubobject<URockInventoryComponent>(TEXT("Inventory"));
+}
+
+URockInventory* ARockInventoryWorldContainer::GetInventory() const
+{
+	return InventoryComponent ? InventoryComponent->Inventory : nullptr;
+}
+
+void ARockInventoryWorldContainer::BeginPlay()
+{
+	Super::BeginPlay();
+	URockInventory* Inventory = GetInventory();
+	if (HasAuthority() && bDestroyWhenEmpty && Inventory)
+	{
+		Inventory->OnItemChanged.AddDynamic(this, &ARockInventoryWorldContainer::OnInventoryItemChanged);
+	}
+}
+
+void ARockInventoryWorldContainer::OnInventoryItemChanged(const FRockItemDelta& ItemDelta)
+{
+	// Not in the middle of the transaction that emptied it
+	GetWorldTimerManager().SetTimerForNextTick(this, &ARockInventoryWorldContainer::DestroyIfEmpty);
+}
+
+void ARockInventoryWorldContainer::DestroyIfEmpty()
+{
+	const URockInventory* Inventory = GetInventory();
+	if (!Inventory || IsActorBeingDestroyed())
+	{
+		return;
+	}
+	bool bEmpty = true;
+	Inventory->ForEachItemStack([&bEmpty](const FRockItemStack& Item)
+	{
+		bEmpty = !Item.IsValid();
+		return bEmpty;
+	});
+	if (bEmpty)
+	{
+		Destroy();
+	}
+}
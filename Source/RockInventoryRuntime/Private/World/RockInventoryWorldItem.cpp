@@ -13,11 +13,18 @@
 #include "Library/RockInventoryLibrary.h"
 #include "Misc/RockInventoryDeveloperSettings.h"
 #include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
+#include "World/RockWorldItemClusterSubsystem.h"
+#include "World/RockWorldItemConsolidationSubsystem.h"
+#include "World/RockWorldItemGridSubsystem.h"
+#include "World/RockWorldItemVisualSubsystem.h"
 
 ARockInventoryWorldItemBase::ARockInventoryWorldItemBase(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 	PrimaryActorTick.bCanEverTick = true;
+	// Only while moving, see ExitRest
+	PrimaryActorTick.bStartWithTickEnabled = false;
 	bReplicates = true;
 	bReplicateUsingRegisteredSubObjectList = true;
 
@@ -25,6 +32,8 @@ ARockInventoryWorldItemBase::ARockInventoryWorldItemBase(const FObjectInitialize
 	StaticMeshComponent->SetMobility(EComponentMobility::Movable);
 	StaticMeshComponent->SetSimulatePhysics(false);
 	StaticMeshComponent->CanCharacterStepUpOn = ECanBeCharacterBase::ECB_No;
+	// For OnComponentSleep/OnComponentWake
+	StaticMeshComponent->BodyInstance.bGenerateWakeEvents = true;
 
 	RootComponent = StaticMeshComponent; // Set the root component to the static mesh component
 
@@ -39,6 +48,11 @@ void ARockInventoryWorldItemBase::BeginPlay()
 	// What if it was stale, then we would. Need more testing.
 	SetItemStack(ItemStack);
 
+	if (URockWorldItemGridSubsystem* Grid = UWorld::GetSubsystem<URockWorldItemGridSubsystem>(GetWorld()))
+	{
+		Grid->RegisterWorldItem(this);
+		StaticMeshComponent->TransformUpdated.AddUObject(this, &ARockInventoryWorldItemBase::OnRootTransformUpdated);
+	}
 
 	if (HasAuthority() && ItemSeed == 0 && !ItemStack.bInitialized)
 	{
@@ -54,6 +68,92 @@ void ARockInventoryWorldItemBase::BeginPlay()
 		// Perhaps we'd need to ask the Settings what the 'rules' are regarding items.
 		// This is the place to leverage that
 	}
+
+	if (HasAuthority())
+	{
+		URockWorldItemConsolidationSubsystem* Consolidation = UWorld::GetSubsystem<URockWorldItemConsolidationSubsystem>(GetWorld());
+		if (Consolidation && Consolidation->IsEnabled())
+		{
+			Consolidation->AddCandidate(this);
+		}
+
+		StaticMeshComponent->OnComponentSleep.AddDynamic(this, &ARockInventoryWorldItemBase::OnStaticMeshSleep);
+		StaticMeshComponent->OnComponentWake.AddDynamic(this, &ARockInventoryWorldItemBase::OnStaticMeshWake);
+		// Thrown items leave again right away through ApplyThrowImpulse
+		if (!StaticMeshComponent->IsSimulatingPhysics())
+		{
+			EnterRest();
+		}
+	}
+}
+
+void ARockInventoryWorldItemBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (URockWorldItemGridSubsystem* Grid = UWorld::GetSubsystem<URockWorldItemGridSubsystem>(GetWorld()))
+	{
+		StaticMeshComponent->TransformUpdated.RemoveAll(this);
+		Grid->UnregisterWorldItem(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void ARockInventoryWorldItemBase::OnRootTransformUpdated(
+	USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	if (URockWorldItemGridSubsystem* Grid = UWorld::GetSubsystem<URockWorldItemGridSubsystem>(GetWorld()))
+	{
+		Grid->UpdateWorldItem(this);
+	}
+}
+
+void ARockInventoryWorldItemBase::OnStaticMeshSleep(UPrimitiveComponent* SleepingComponent, FName BoneName)
+{
+	URockWorldItemClusterSubsystem* Clusters = UWorld::GetSubsystem<URockWorldItemClusterSubsystem>(GetWorld());
+	if (Clusters && Clusters->DemoteWorldItem(this))
+	{
+		return;
+	}
+	EnterRest();
+}
+
+void ARockInventoryWorldItemBase::OnStaticMeshWake(UPrimitiveComponent* WakingComponent, FName BoneName)
+{
+	ExitRest();
+}
+
+void ARockInventoryWorldItemBase::EnterRest()
+{
+	SetActorTickEnabled(false);
+	if (bDormantWhenResting)
+	{
+		// The net driver still sends the final state before closing the channels
+		SetNetDormancy(DORM_DormantAll);
+	}
+
+	const URockWorldItemClusterSubsystem* Clusters = UWorld::GetSubsystem<URockWorldItemClusterSubsystem>(GetWorld());
+	const float DemoteDelay = GetDefault<URockInventoryDeveloperSettings>()->WorldItemClusterDemoteDelay;
+	if (Clusters && Clusters->IsEnabled() && DemoteDelay > 0.0f)
+	{
+		GetWorldTimerManager().SetTimer(DemoteTimerHandle, FTimerDelegate::CreateUObject(this, &ThisClass::DemoteToCluster), DemoteDelay, false);
+	}
+}
+
+void ARockInventoryWorldItemBase::ExitRest()
+{
+	GetWorldTimerManager().ClearTimer(DemoteTimerHandle);
+	SetActorTickEnabled(true);
+	if (bDormantWhenResting)
+	{
+		SetNetDormancy(DORM_Awake);
+	}
+}
+
+void ARockInventoryWorldItemBase::DemoteToCluster()
+{
+	if (URockWorldItemClusterSubsystem* Clusters = UWorld::GetSubsystem<URockWorldItemClusterSubsystem>(GetWorld()))
+	{
+		Clusters->DemoteWorldItem(this);
+	}
 }
 
 void ARockInventoryWorldItemBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -75,6 +175,8 @@ void ARockInventoryWorldItemBase::SetItemStack(const FRockItemStack& InItemStack
 	ItemStack.TransferOwnership(this, nullptr);
 	if (GetLocalRole() == ROLE_Authority)
 	{
+		// Replicates once and stays dormant if resting
+		this->FlushNetDormancy();
 		this->ForceNetUpdate();
 	}
 
@@ -112,6 +214,10 @@ void ARockInventoryWorldItemBase::OnLooted(AActor* InstigatorPawn, const FRockIt
 	{
 		this->Destroy();
 	}
+	else
+	{
+		this->FlushNetDormancy();
+	}
 }
 
 void ARockInventoryWorldItemBase::ApplyThrowImpulse(const FVector& Impulse)
@@ -121,6 +227,7 @@ void ARockInventoryWorldItemBase::ApplyThrowImpulse(const FVector& Impulse)
 		// Is there a better place to do this? We didn't want to always simulate on intentionally placed locations, so if we are 'throwing' it 
 		StaticMeshComponent->SetSimulatePhysics(true);
 		StaticMeshComponent->AddImpulse(Impulse, NAME_None, true);
+		ExitRest();
 	}
 }
 
@@ -128,38 +235,51 @@ void ARockInventoryWorldItemBase::UpdateItemVisuals()
 {
 	// Update the static mesh component with the item definition's mesh
 	const URockItemDefinition* Definition = ItemStack.GetDefinition();
-	const TSoftObjectPtr<UStaticMesh> Mesh = Definition ? Definition->ItemMesh : nullptr;
+	const bool bHasOwnMesh = Definition && !Definition->ItemMesh.IsNull();
+	auto OnMeshLoaded = [this, Definition, bHasOwnMesh](UStaticMesh* LoadedMesh)
+	{
+		// Superseded by a newer ItemStack while loading
+		if (ItemStack.GetDefinition() != Definition)
+		{
+			return;
+		}
+		if (!LoadedMesh)
+		{
+			UE_LOG(LogRockInventory, Error, TEXT("ARockInventoryWorldItemBase::UpdateItemVisuals - Failed to load static mesh"));
+			return;
+		}
+		StaticMeshComponent->SetStaticMesh(LoadedMesh);
+		if (bHasOwnMesh)
+		{
+			ApplyItemVisuals();
+		}
+	};
 
-	// Check if the mesh is already loaded
-	if (Mesh.IsNull())
+	// Shared with, and streamed in one request along, every other world item asking this frame
+	if (URockWorldItemVisualSubsystem* Visuals = UWorld::GetSubsystem<URockWorldItemVisualSubsystem>(GetWorld()))
 	{
-		const URockInventoryDeveloperSettings* Settings = GetDefault<URockInventoryDeveloperSettings>();
-		StaticMeshComponent->SetStaticMesh(Settings->FallbackWorldItemMesh.LoadSynchronous());
-		UE_LOG(LogRockInventory, Warning, TEXT("ARockInventoryWorldItemBase::UpdateItemVisuals - Mesh is null, using fallback mesh"));
+		Visuals->RequestVisuals(Definition, this, MoveTemp(OnMeshLoaded));
 		return;
 	}
 
+	// Preview worlds have no subsystem, load for this actor alone
+	const TSoftObjectPtr<UStaticMesh> Mesh = bHasOwnMesh ? Definition->ItemMesh : GetDefault<URockInventoryDeveloperSettings>()->FallbackWorldItemMesh;
+	if (Mesh.IsNull())
+	{
+		return;
+	}
 	TArray<FSoftObjectPath> PathsToLoad;
 	PathsToLoad.Add(Mesh.ToSoftObjectPath());
-	if (const auto* MatOverride = FRockItemFragment_MeshMaterialOverride::Find(Definition))
+	if (const auto* MatOverride = bHasOwnMesh ? FRockItemFragment_MeshMaterialOverride::Find(Definition) : nullptr)
 	{
 		MatOverride->AppendSoftPaths(PathsToLoad);
 	}
 
 	// LoadAndExecute internally handles both fast path and async path
-	URockAssetLibrary::LoadAndExecute(
-		PathsToLoad, this, [this, Mesh]
-		{
-			if (UStaticMesh* LoadedMesh = Mesh.Get())
-			{
-				StaticMeshComponent->SetStaticMesh(LoadedMesh);
-				ApplyItemVisuals();
-			}
-			else
-			{
-				UE_LOG(LogRockInventory, Error, TEXT("ARockInventoryWorldItemBase::UpdateItemVisuals - Failed to load static mesh"));
-			}
-		});
+	URockAssetLibrary::LoadAndExecute(PathsToLoad, this, [Mesh, OnMeshLoaded]
+	{
+		OnMeshLoaded(Mesh.Get());
+	});
 
 	// TODO: Do we need to call if there is a runtime instance
 	// RegisterReplicationWithOwner since we aren't replicating the internal runtime instance
@@ -0,0 +1,202 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "World/RockWorldItemCluster.h"
+
+#include "RockInventoryLogging.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/World.h"
+#include "Item/RockItemDefinition.h"
+#include "Item/Fragment/RockItemFragment_MeshMaterialOverride.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "Net/UnrealNetwork.h"
+#include "World/RockWorldItemVisualSubsystem.h"
+
+void FRockWorldItemClusterEntry::PreReplicatedRemove(const FRockWorldItemClusterEntryList& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->RemoveVisual(EntryId);
+	}
+}
+
+void FRockWorldItemClusterEntry::PostReplicatedAdd(const FRockWorldItemClusterEntryList& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->AddVisual(*this);
+	}
+}
+
+void FRockWorldItemClusterEntry::PostReplicatedChange(const FRockWorldItemClusterEntryList& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->RemoveVisual(EntryId);
+		InArraySerializer.Owner->AddVisual(*this);
+	}
+}
+
+ARockWorldItemCluster::ARockWorldItemCluster(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = false;
+	bReplicates = true;
+	// Only wakes up to send entry changes, see FlushNetDormancy in Add/RemoveEntry
+	NetDormancy = DORM_DormantAll;
+
+	const float NetCullDistance = GetDefault<URockInventoryDeveloperSettings>()->WorldItemClusterNetCullDistance;
+	SetNetCullDistanceSquared(FMath::Square(NetCullDistance));
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+	Entries.Owner = this;
+}
+
+void ARockWorldItemCluster::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(ARockWorldItemCluster, Entries);
+}
+
+int32 ARockWorldItemCluster::AddEntry(const FRockItemStack& ItemStack, const FTransform& Transform)
+{
+	checkf(HasAuthority(), TEXT("ARockWorldItemCluster::AddEntry - Server only"));
+	FRockWorldItemClusterEntry& Entry = Entries.Items.AddDefaulted_GetRef();
+	Entry.EntryId = NextEntryId++;
+	Entry.ItemStack = ItemStack;
+	Entry.ItemStack.TransferOwnership(this, nullptr);
+	Entry.Location = Transform.GetLocation();
+	Entry.Rotation = Transform.Rotator();
+	Entries.MarkItemDirty(Entry);
+	FlushNetDormancy();
+
+	if (HasVisuals())
+	{
+		AddVisual(Entry);
+	}
+	return Entry.EntryId;
+}
+
+bool ARockWorldItemCluster::RemoveEntry(int32 EntryId, FRockItemStack& OutItemStack, FTransform& OutTransform)
+{
+	checkf(HasAuthority(), TEXT("ARockWorldItemCluster::RemoveEntry - Server only"));
+	const int32 Index = Entries.Items.IndexOfByPredicate([EntryId](const FRockWorldItemClusterEntry& Entry) { return Entry.EntryId == EntryId; });
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+	OutItemStack = Entries.Items[Index].ItemStack;
+	OutTransform = Entries.Items[Index].GetTransform();
+
+	if (HasVisuals())
+	{
+		RemoveVisual(EntryId);
+	}
+	Entries.Items.RemoveAtSwap(Index);
+	Entries.MarkArrayDirty();
+	FlushNetDormancy();
+	return true;
+}
+
+const FRockWorldItemClusterEntry* ARockWorldItemCluster::FindEntry(int32 EntryId) const
+{
+	return Entries.Items.FindByPredicate([EntryId](const FRockWorldItemClusterEntry& Entry) { return Entry.EntryId == EntryId; });
+}
+
+int32 ARockWorldItemCluster::GetEntryIdForInstance(const UPrimitiveComponent* Component, int32 InstanceIndex) const
+{
+	const TArray<int32>* EntryIds = EntryIdsByComponent.Find(Component);
+	return EntryIds && EntryIds->IsValidIndex(InstanceIndex) ? (*EntryIds)[InstanceIndex] : INDEX_NONE;
+}
+
+bool ARockWorldItemCluster::HasVisuals() const
+{
+	return GetNetMode() != NM_DedicatedServer;
+}
+
+void ARockWorldItemCluster::AddVisual(const FRockWorldItemClusterEntry& Entry)
+{
+	const URockItemDefinition* Definition = Entry.ItemStack.GetDefinition();
+	URockWorldItemVisualSubsystem* Visuals = UWorld::GetSubsystem<URockWorldItemVisualSubsystem>(GetWorld());
+	if (!Definition || !Visuals)
+	{
+		return;
+	}
+
+	const int32 EntryId = Entry.EntryId;
+	Visuals->RequestVisuals(
+		Definition, this, [this, EntryId, Definition](UStaticMesh* LoadedMesh)
+		{
+			// The entry may have been removed (or already drawn) while loading
+			const FRockWorldItemClusterEntry* LoadedEntry = FindEntry(EntryId);
+			if (!LoadedEntry || InstanceByEntryId.Contains(EntryId))
+			{
+				return;
+			}
+			UInstancedStaticMeshComponent* Component = FindOrCreateComponent(Definition, LoadedMesh);
+			if (!Component)
+			{
+				UE_LOG(LogRockInventory, Error, TEXT("ARockWorldItemCluster::AddVisual - Failed to load static mesh"));
+				return;
+			}
+			FInstanceRef& Ref = InstanceByEntryId.Add(EntryId);
+			Ref.Component = Component;
+			Ref.InstanceIndex = Component->AddInstance(LoadedEntry->GetTransform(), true);
+			TArray<int32>& EntryIds = EntryIdsByComponent.FindOrAdd(Component);
+			check(EntryIds.Num() == Ref.InstanceIndex);
+			EntryIds.Add(EntryId);
+		});
+}
+
+void ARockWorldItemCluster::RemoveVisual(int32 EntryId)
+{
+	FInstanceRef Ref;
+	if (!InstanceByEntryId.RemoveAndCopyValue(EntryId, Ref))
+	{
+		return;
+	}
+
+	// Move the last instance into the hole ourselves, so the indices don't depend on how the component removes instances
+	TArray<int32>& EntryIds = EntryIdsByComponent.FindChecked(Ref.Component);
+	const int32 LastIndex = EntryIds.Num() - 1;
+	if (Ref.InstanceIndex != LastIndex)
+	{
+		FTransform LastTransform;
+		Ref.Component->GetInstanceTransform(LastIndex, LastTransform, true);
+		Ref.Component->UpdateInstanceTransform(Ref.InstanceIndex, LastTransform, true, false, true);
+
+		const int32 MovedEntryId = EntryIds[LastIndex];
+		EntryIds[Ref.InstanceIndex] = MovedEntryId;
+		InstanceByEntryId.FindChecked(MovedEntryId).InstanceIndex = Ref.InstanceIndex;
+	}
+	EntryIds.Pop(EAllowShrinking::No);
+	Ref.Component->RemoveInstance(LastIndex);
+}
+
+UInstancedStaticMeshComponent* ARockWorldItemCluster::FindOrCreateComponent(const URockItemDefinition* Definition, UStaticMesh* Mesh)
+{
+	if (UInstancedStaticMeshComponent** Existing = ComponentByDefinition.Find(Definition))
+	{
+		return *Existing;
+	}
+	if (!Mesh)
+	{
+		return nullptr;
+	}
+
+	UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(this);
+	Component->SetStaticMesh(Mesh);
+	Component->CanCharacterStepUpOn = ECanBeCharacterBase::ECB_No;
+	Component->SetupAttachment(RootComponent);
+	// Overrides are authored for the definition's own mesh, not the fallback
+	const FRockItemFragment_MeshMaterialOverride* MatOverride = FRockItemFragment_MeshMaterialOverride::Find(Definition);
+	if (MatOverride && !Definition->ItemMesh.IsNull())
+	{
+		MatOverride->ApplyTo(Component);
+	}
+	Component->RegisterComponent();
+
+	MeshComponents.Add(Component);
+	ComponentByDefinition.Add(Definition, Component);
+	return Component;
+}
@@ -0,0 +1,217 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "World/RockWorldItemClusterSubsystem.h"
+
+#include "RockInventoryLogging.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "Item/RockItemDefinition.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "World/RockLootableInterface.h"
+#include "World/RockWorldItemCluster.h"
+#include "World/RockWorldItemSpawnSubsystem.h"
+
+void URockWorldItemClusterSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const URockInventoryDeveloperSettings* Settings = GetDefault<URockInventoryDeveloperSettings>();
+	bEnabled = Settings->bEnableWorldItemClusters;
+	ClusterSize = Settings->WorldItemClusterSize;
+}
+
+void URockWorldItemClusterSubsystem::Deinitialize()
+{
+	Clusters.Reset();
+	Super::Deinitialize();
+}
+
+bool URockWorldItemClusterSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool URockWorldItemClusterSubsystem::IsEnabled() const
+{
+	return bEnabled && GetWorld()->GetNetMode() != NM_Client;
+}
+
+bool URockWorldItemClusterSubsystem::AddItem(const FRockItemStack& ItemStack, const FTransform& Transform)
+{
+	if (!IsEnabled() || !ItemStack.IsValid() || ItemStack.GetRuntimeInstance())
+	{
+		return false;
+	}
+	ARockWorldItemCluster* Cluster = FindOrSpawnCluster(Transform.GetLocation());
+	if (!Cluster)
+	{
+		return false;
+	}
+	Cluster->AddEntry(ItemStack, Transform);
+	return true;
+}
+
+AActor* URockWorldItemClusterSubsystem::PromoteItem(ARockWorldItemCluster* Cluster, int32 EntryId)
+{
+	if (!IsEnabled() || !IsValid(Cluster))
+	{
+		return nullptr;
+	}
+	FRockItemStack ItemStack;
+	FTransform Transform;
+	if (!Cluster->RemoveEntry(EntryId, ItemStack, Transform))
+	{
+		return nullptr;
+	}
+
+	UClass* WorldItemClass = ItemStack.GetDefinition()->GetWorldItemClass();
+	AActor* WorldItem = GetWorld()->SpawnActorDeferred<AActor>(WorldItemClass, Transform);
+	if (!WorldItem)
+	{
+		// Put it back rather than lose it
+		UE_LOG(LogRockInventory, Error, TEXT("URockWorldItemClusterSubsystem::PromoteItem - Failed to spawn world item. Possibly DefaultWorldItemClass is unset in Project Settings"));
+		Cluster->AddEntry(ItemStack, Transform);
+		return nullptr;
+	}
+	if (IRockLootableInterface* Lootable = Cast<IRockLootableInterface>(WorldItem))
+	{
+		Lootable->SetItemStack(ItemStack);
+	}
+	UGameplayStatics::FinishSpawningActor(WorldItem, Transform);
+	return WorldItem;
+}
+
+int32 URockWorldItemClusterSubsystem::PromoteItemsInRadius(const FVector& Center, float Radius, int32 MaxItems, TFunction<void(AActor*)> OnPromoted)
+{
+	URockWorldItemSpawnSubsystem* Spawner = GetWorld()->GetSubsystem<URockWorldItemSpawnSubsystem>();
+	if (!Spawner)
+	{
+		return 0;
+	}
+	TArray<FRockWorldItemClusterHit> Hits;
+	FindItemsInRadius(Center, Radius, MaxItems, Hits);
+
+	int32 NumQueued = 0;
+	for (const FRockWorldItemClusterHit& Hit : Hits)
+	{
+		FRockItemStack ItemStack;
+		FTransform Transform;
+		if (!Hit.Cluster->RemoveEntry(Hit.EntryId, ItemStack, Transform))
+		{
+			continue;
+		}
+		Spawner->QueueSpawn(ItemStack, Transform, FVector::ZeroVector,
+			[WeakCluster = TWeakObjectPtr<ARockWorldItemCluster>(Hit.Cluster), ItemStack, Transform, OnPromoted](AActor* WorldItem)
+			{
+				if (!WorldItem)
+				{
+					// Put it back rather than lose it
+					if (ARockWorldItemCluster* Cluster = WeakCluster.Get())
+					{
+						Cluster->AddEntry(ItemStack, Transform);
+					}
+					return;
+				}
+				if (OnPromoted)
+				{
+					OnPromoted(WorldItem);
+				}
+			});
+		++NumQueued;
+	}
+	return NumQueued;
+}
+
+int32 URockWorldItemClusterSubsystem::K2_PromoteItemsInRadius(const FVector& Center, float Radius, int32 MaxItems)
+{
+	return PromoteItemsInRadius(Center, Radius, MaxItems);
+}
+
+void URockWorldItemClusterSubsystem::FindItemsInRadius(const FVector& Center, float Radius, int32 MaxItems, TArray<FRockWorldItemClusterHit>& OutHits) const
+{
+	OutHits.Reset();
+	if (!IsEnabled() || Radius < 0.0f)
+	{
+		return;
+	}
+	const FIntPoint MinCell = GetCell(Center - FVector(Radius));
+	const FIntPoint MaxCell = GetCell(Center + FVector(Radius));
+	const double RadiusSquared = FMath::Square(Radius);
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			ARockWorldItemCluster* Cluster = Clusters.FindRef(FIntPoint(X, Y));
+			if (!IsValid(Cluster))
+			{
+				continue;
+			}
+			for (const FRockWorldItemClusterEntry& Entry : Cluster->GetEntries())
+			{
+				const double DistanceSquared = FVector::DistSquared(Entry.Location, Center);
+				if (DistanceSquared <= RadiusSquared)
+				{
+					OutHits.Add({Cluster, Entry.EntryId, DistanceSquared});
+				}
+			}
+		}
+	}
+	OutHits.Sort([](const FRockWorldItemClusterHit& A, const FRockWorldItemClusterHit& B) { return A.DistanceSquared < B.DistanceSquared; });
+	if (MaxItems > 0 && OutHits.Num() > MaxItems)
+	{
+		OutHits.SetNum(MaxItems);
+	}
+}
+
+bool URockWorldItemClusterSubsystem::DemoteWorldItem(AActor* WorldItem)
+{
+	const IRockLootableInterface* Lootable = Cast<IRockLootableInterface>(WorldItem);
+	if (!IsEnabled() || !IsValid(WorldItem) || !Lootable)
+	{
+		return false;
+	}
+	const UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(WorldItem->GetRootComponent());
+	if (Primitive && Primitive->IsSimulatingPhysics() && Primitive->RigidBodyIsAwake())
+	{
+		return false;
+	}
+	const FRockItemStack ItemStack = Lootable->GetItemStack(nullptr);
+	if (!AddItem(ItemStack, WorldItem->GetActorTransform()))
+	{
+		return false;
+	}
+	WorldItem->Destroy();
+	return true;
+}
+
+int32 URockWorldItemClusterSubsystem::GetNumItems() const
+{
+	int32 NumItems = 0;
+	for (const TPair<FIntPoint, TObjectPtr<ARockWorldItemCluster>>& Pair : Clusters)
+	{
+		NumItems += IsValid(Pair.Value) ? Pair.Value->GetNumEntries() : 0;
+	}
+	return NumItems;
+}
+
+FIntPoint URockWorldItemClusterSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / ClusterSize), FMath::FloorToInt32(Location.Y / ClusterSize));
+}
+
+ARockWorldItemCluster* URockWorldItemClusterSubsystem::FindOrSpawnCluster(const FVector& Location)
+{
+	const FIntPoint Cell = GetCell(Location);
+	TObjectPtr<ARockWorldItemCluster>& Cluster = Clusters.FindOrAdd(Cell);
+	if (!IsValid(Cluster))
+	{
+		// Centered on the cell, at the height of its first item, which is what its network relevancy is measured from
+		const FVector Center((Cell.X + 0.5) * ClusterSize, (Cell.Y + 0.5) * ClusterSize, Location.Z);
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		Cluster = GetWorld()->SpawnActor<ARockWorldItemCluster>(Center, FRotator::ZeroRotator, SpawnParams);
+	}
+	return Cluster;
+}
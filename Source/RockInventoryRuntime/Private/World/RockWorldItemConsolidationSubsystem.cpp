@@ -0,0 +1,157 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "World/RockWorldItemConsolidationSubsystem.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "World/RockLootableInterface.h"
+#include "World/RockWorldItemGridSubsystem.h"
+
+void URockWorldItemConsolidationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const URockInventoryDeveloperSettings* Settings = GetDefault<URockInventoryDeveloperSettings>();
+	bEnabled = Settings->bEnableWorldItemConsolidation && InWorld.GetNetMode() != NM_Client;
+	Radius = Settings->WorldItemConsolidationRadius;
+	Interval = Settings->WorldItemConsolidationInterval;
+	MaxPerInterval = Settings->MaxWorldItemConsolidationsPerInterval;
+	TimeUntilNextPass = Interval;
+}
+
+void URockWorldItemConsolidationSubsystem::Deinitialize()
+{
+	Candidates.Reset();
+	bEnabled = false;
+	Super::Deinitialize();
+}
+
+bool URockWorldItemConsolidationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URockWorldItemConsolidationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	TimeUntilNextPass -= DeltaTime;
+	if (TimeUntilNextPass > 0.0f)
+	{
+		return;
+	}
+	TimeUntilNextPass = Interval;
+	ConsolidateCandidates(MaxPerInterval);
+}
+
+TStatId URockWorldItemConsolidationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URockWorldItemConsolidationSubsystem, STATGROUP_Tickables);
+}
+
+void URockWorldItemConsolidationSubsystem::AddCandidate(AActor* WorldItem)
+{
+	if (bEnabled && IsValid(WorldItem))
+	{
+		Candidates.AddUnique(WorldItem);
+	}
+}
+
+int32 URockWorldItemConsolidationSubsystem::ConsolidateCandidates(int32 MaxCandidates)
+{
+	int32 NumMerged = 0;
+	TArray<TWeakObjectPtr<AActor>> Retry;
+	const int32 NumToProcess = FMath::Min(MaxCandidates, Candidates.Num());
+	for (int32 Index = 0; Index < NumToProcess; ++Index)
+	{
+		// Merged away by an earlier candidate of this pass, or looted meanwhile
+		AActor* WorldItem = Candidates[Index].Get();
+		if (!IsValid(WorldItem))
+		{
+			continue;
+		}
+		const int32 Result = Consolidate(WorldItem);
+		if (Result == INDEX_NONE)
+		{
+			Retry.Add(WorldItem);
+			continue;
+		}
+		NumMerged += Result;
+	}
+	Candidates.RemoveAt(0, NumToProcess, EAllowShrinking::No);
+	Candidates.Append(Retry);
+	NumMergedActors += NumMerged;
+	return NumMerged;
+}
+
+int32 URockWorldItemConsolidationSubsystem::Consolidate(AActor* WorldItem)
+{
+	const URockWorldItemGridSubsystem* Grid = UWorld::GetSubsystem<URockWorldItemGridSubsystem>(GetWorld());
+	IRockLootableInterface* Lootable = Cast<IRockLootableInterface>(WorldItem);
+	if (!Grid || !Lootable)
+	{
+		return 0;
+	}
+	auto IsMoving = [](const AActor* Actor)
+	{
+		const UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Actor->GetRootComponent());
+		return Primitive && Primitive->IsSimulatingPhysics() && Primitive->RigidBodyIsAwake();
+	};
+	if (IsMoving(WorldItem))
+	{
+		return INDEX_NONE;
+	}
+
+	FRockItemStack Stack = Lootable->GetItemStack(nullptr);
+	const int32 MaxStackCount = Stack.GetMaxStackCount();
+	if (!Stack.IsValid() || Stack.RuntimeInstance || Stack.StackCount >= MaxStackCount)
+	{
+		return 0;
+	}
+
+	TArray<AActor*> Neighbours;
+	Grid->QueryRadius(WorldItem->GetActorLocation(), Radius, Neighbours);
+
+	int32 NumEmptied = 0;
+	const int32 OriginalCount = Stack.StackCount;
+	for (AActor* Neighbour : Neighbours)
+	{
+		if (Stack.StackCount >= MaxStackCount)
+		{
+			break;
+		}
+		if (Neighbour == WorldItem || !IsValid(Neighbour) || IsMoving(Neighbour))
+		{
+			continue;
+		}
+		IRockLootableInterface* NeighbourLootable = Cast<IRockLootableInterface>(Neighbour);
+		if (!NeighbourLootable)
+		{
+			continue;
+		}
+		FRockItemStack NeighbourStack = NeighbourLootable->GetItemStack(nullptr);
+		if (!NeighbourStack.IsValid() || NeighbourStack.RuntimeInstance || !Stack.CanStackWith(NeighbourStack))
+		{
+			continue;
+		}
+
+		const int32 Moved = FMath::Min(NeighbourStack.StackCount, MaxStackCount - Stack.StackCount);
+		Stack.StackCount += Moved;
+		NeighbourStack.StackCount -= Moved;
+		if (NeighbourStack.StackCount <= 0)
+		{
+			Neighbour->Destroy();
+			++NumEmptied;
+		}
+		else
+		{
+			NeighbourLootable->SetItemStack(NeighbourStack);
+		}
+	}
+	if (Stack.StackCount != OriginalCount)
+	{
+		Lootable->SetItemStack(Stack);
+	}
+	return NumEmptied;
+}
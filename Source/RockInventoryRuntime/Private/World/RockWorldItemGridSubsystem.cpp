@@ -0,0 +1,184 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "World/RockWorldItemGridSubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+
+void URockWorldItemGridSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	CellSize = FMath::Max(GetDefault<URockInventoryDeveloperSettings>()->WorldItemGridCellSize, 1.0f);
+}
+
+void URockWorldItemGridSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	EntryIndexByActor.Empty();
+	Cells.Empty();
+	Super::Deinitialize();
+}
+
+bool URockWorldItemGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URockWorldItemGridSubsystem::RegisterWorldItem(AActor* WorldItem)
+{
+	if (!IsValid(WorldItem))
+	{
+		return;
+	}
+	if (EntryIndexByActor.Contains(WorldItem))
+	{
+		UpdateWorldItem(WorldItem);
+		return;
+	}
+	FEntry Entry;
+	Entry.Actor = WorldItem;
+	Entry.Location = WorldItem->GetActorLocation();
+	Entry.Cell = GetCell(Entry.Location);
+	const int32 EntryIndex = Entries.Add(Entry);
+	EntryIndexByActor.Add(WorldItem, EntryIndex);
+	AddToCell(EntryIndex);
+}
+
+void URockWorldItemGridSubsystem::UnregisterWorldItem(AActor* WorldItem)
+{
+	int32 EntryIndex = INDEX_NONE;
+	if (!EntryIndexByActor.RemoveAndCopyValue(WorldItem, EntryIndex))
+	{
+		return;
+	}
+	RemoveFromCell(EntryIndex);
+	Entries.RemoveAt(EntryIndex);
+}
+
+void URockWorldItemGridSubsystem::UpdateWorldItem(AActor* WorldItem)
+{
+	const int32* EntryIndex = EntryIndexByActor.Find(WorldItem);
+	if (!EntryIndex || !IsValid(WorldItem))
+	{
+		return;
+	}
+	FEntry& Entry = Entries[*EntryIndex];
+	Entry.Location = WorldItem->GetActorLocation();
+	const FIntPoint NewCell = GetCell(Entry.Location);
+	if (NewCell != Entry.Cell)
+	{
+		RemoveFromCell(*EntryIndex);
+		Entry.Cell = NewCell;
+		AddToCell(*EntryIndex);
+	}
+}
+
+void URockWorldItemGridSubsystem::QueryRadius(const FVector& Center, float Radius, TArray<AActor*>& OutWorldItems) const
+{
+	OutWorldItems.Reset();
+	if (Radius < 0.0f)
+	{
+		return;
+	}
+	const double RadiusSquared = FMath::Square(static_cast<double>(Radius));
+	TArray<TPair<double, AActor*>, TInlineAllocator<32>> Found;
+	ForEachEntryInBounds(FBox(Center - FVector(Radius), Center + FVector(Radius)), [&](const FEntry& Entry)
+	{
+		const double DistanceSquared = FVector::DistSquared(Center, Entry.Location);
+		if (DistanceSquared <= RadiusSquared)
+		{
+			Found.Emplace(DistanceSquared, Entry.Actor.Get());
+		}
+	});
+	Found.Sort([](const TPair<double, AActor*>& A, const TPair<double, AActor*>& B) { return A.Key < B.Key; });
+	OutWorldItems.Reserve(Found.Num());
+	for (const TPair<double, AActor*>& Pair : Found)
+	{
+		OutWorldItems.Add(Pair.Value);
+	}
+}
+
+void URockWorldItemGridSubsystem::QueryBox(const FBox& Box, TArray<AActor*>& OutWorldItems) const
+{
+	OutWorldItems.Reset();
+	if (!Box.IsValid)
+	{
+		return;
+	}
+	ForEachEntryInBounds(Box, [&](const FEntry& Entry)
+	{
+		if (Box.IsInsideOrOn(Entry.Location))
+		{
+			OutWorldItems.Add(Entry.Actor.Get());
+		}
+	});
+}
+
+FIntPoint URockWorldItemGridSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+void URockWorldItemGridSubsystem::AddToCell(int32 EntryIndex)
+{
+	Cells.FindOrAdd(Entries[EntryIndex].Cell).Add(EntryIndex);
+}
+
+void URockWorldItemGridSubsystem::RemoveFromCell(int32 EntryIndex)
+{
+	const FIntPoint Cell = Entries[EntryIndex].Cell;
+	TArray<int32>* CellEntries = Cells.Find(Cell);
+	if (!ensureMsgf(CellEntries, TEXT("WorldItemGrid - Entry missing from its cell")))
+	{
+		return;
+	}
+	CellEntries->RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+	if (CellEntries->IsEmpty())
+	{
+		Cells.Remove(Cell);
+	}
+}
+
+void URockWorldItemGridSubsystem::ForEachEntryInBounds(const FBox& Bounds, const TFunctionRef<void(const FEntry&)>& Visitor) const
+{
+	const FIntPoint MinCell = GetCell(Bounds.Min);
+	const FIntPoint MaxCell = GetCell(Bounds.Max);
+	const int64 NumCellsInBounds = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1);
+
+	auto VisitCell = [this, &Visitor](const TArray<int32>& CellEntries)
+	{
+		for (const int32 EntryIndex : CellEntries)
+		{
+			const FEntry& Entry = Entries[EntryIndex];
+			// Destroyed without EndPlay (e.g. the world is tearing down), skip until it's unregistered
+			if (Entry.Actor.IsValid())
+			{
+				Visitor(Entry);
+			}
+		}
+	};
+
+	// Huge bounds cover more cells than are occupied, walk the occupied ones instead
+	if (NumCellsInBounds > Cells.Num())
+	{
+		for (const TPair<FIntPoint, TArray<int32>>& Pair : Cells)
+		{
+			if (Pair.Key.X >= MinCell.X && Pair.Key.X <= MaxCell.X && Pair.Key.Y >= MinCell.Y && Pair.Key.Y <= MaxCell.Y)
+			{
+				VisitCell(Pair.Value);
+			}
+		}
+		return;
+	}
+	for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			if (const TArray<int32>* CellEntries = Cells.Find(FIntPoint(X, Y)))
+			{
+				VisitCell(*CellEntries);
+			}
+		}
+	}
+}
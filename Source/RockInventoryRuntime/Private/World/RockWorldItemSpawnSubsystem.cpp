@@ -0,0 +1,266 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "World/RockWorldItemSpawnSubsystem.h"
+
+#include "RockInventoryLogging.h"
+#include "Algo/StableSort.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Item/RockItemDefinition.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+#include "World/RockLootableInterface.h"
+
+void URockWorldItemSpawnSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	BudgetSeconds = GetDefault<URockInventoryDeveloperSettings>()->WorldItemSpawnBudgetMs / 1000.0;
+}
+
+void URockWorldItemSpawnSubsystem::Deinitialize()
+{
+	Pending.Reset();
+	Spawned.Reset();
+	Super::Deinitialize();
+}
+
+bool URockWorldItemSpawnSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URockWorldItemSpawnSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UpdatePriorities();
+	TGuardValue<bool> SpawningGuard(bSpawning, true);
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumProcessed = 0;
+	int32 NumSpawned = 0;
+	// At least one per frame, so a tiny budget still makes progress
+	while (NumProcessed < Pending.Num() && (NumSpawned == 0 || FPlatformTime::Seconds() - StartTime < BudgetSeconds))
+	{
+		// Moved out, OnSpawned may queue more and grow the array
+		FPendingSpawn Spawn = MoveTemp(Pending[NumProcessed]);
+		Pending[NumProcessed].Id = 0;
+		++NumProcessed;
+		if (Spawn.Id == 0)
+		{
+			// Cancelled from an OnSpawned
+			continue;
+		}
+		SpawnNow(Spawn);
+		++NumSpawned;
+	}
+	Pending.RemoveAt(0, NumProcessed, EAllowShrinking::No);
+
+	if (Spawned.Num() > PurgeThreshold)
+	{
+		PurgeSpawned();
+	}
+}
+
+TStatId URockWorldItemSpawnSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URockWorldItemSpawnSubsystem, STATGROUP_Tickables);
+}
+
+FRockWorldItemSpawnHandle URockWorldItemSpawnSubsystem::QueueSpawn(
+	const FRockItemStack& ItemStack, const FTransform& Transform, const FVector& Impulse, TFunction<void(AActor*)>&& OnSpawned)
+{
+	FRockWorldItemSpawnHandle Handle;
+	if (GetWorld()->GetNetMode() == NM_Client || !ItemStack.IsValid())
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("URockWorldItemSpawnSubsystem::QueueSpawn - Server only, with a valid item"));
+		return Handle;
+	}
+	Handle.Id = ++LastId;
+
+	FPendingSpawn& Spawn = Pending.AddDefaulted_GetRef();
+	Spawn.Id = Handle.Id;
+	Spawn.ItemStack = ItemStack;
+	Spawn.Transform = Transform;
+	Spawn.Impulse = Impulse;
+	Spawn.OnSpawned = MoveTemp(OnSpawned);
+	return Handle;
+}
+
+FRockWorldItemSpawnHandle URockWorldItemSpawnSubsystem::QueueActorSpawn(TSubclassOf<AActor> ActorClass, const FTransform& Transform,
+	TFunction<void(AActor*)>&& OnBeforeFinish, TFunction<void(AActor*)>&& OnSpawned)
+{
+	FRockWorldItemSpawnHandle Handle;
+	if (GetWorld()->GetNetMode() == NM_Client || !ActorClass)
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("URockWorldItemSpawnSubsystem::QueueActorSpawn - Server only, with a class"));
+		return Handle;
+	}
+	Handle.Id = ++LastId;
+
+	FPendingSpawn& Spawn = Pending.AddDefaulted_GetRef();
+	Spawn.Id = Handle.Id;
+	Spawn.ActorClass = ActorClass;
+	Spawn.Transform = Transform;
+	Spawn.OnBeforeFinish = MoveTemp(OnBeforeFinish);
+	Spawn.OnSpawned = MoveTemp(OnSpawned);
+	return Handle;
+}
+
+FRockWorldItemSpawnHandle URockWorldItemSpawnSubsystem::K2_QueueSpawn(const FRockItemStack& ItemStack, const FTransform& Transform, const FVector& Impulse)
+{
+	return QueueSpawn(ItemStack, Transform, Impulse);
+}
+
+ERockWorldItemSpawnState URockWorldItemSpawnSubsystem::GetSpawnState(const FRockWorldItemSpawnHandle& Handle) const
+{
+	if (!Handle.IsValid())
+	{
+		return ERockWorldItemSpawnState::None;
+	}
+	if (const TWeakObjectPtr<AActor>* Actor = Spawned.Find(Handle.Id))
+	{
+		return Actor->IsValid() ? ERockWorldItemSpawnState::Spawned : ERockWorldItemSpawnState::None;
+	}
+	const bool bPending = Pending.ContainsByPredicate([&Handle](const FPendingSpawn& Spawn) { return Spawn.Id == Handle.Id; });
+	return bPending ? ERockWorldItemSpawnState::Pending : ERockWorldItemSpawnState::None;
+}
+
+AActor* URockWorldItemSpawnSubsystem::GetSpawnedActor(const FRockWorldItemSpawnHandle& Handle) const
+{
+	const TWeakObjectPtr<AActor>* Actor = Spawned.Find(Handle.Id);
+	return Actor ? Actor->Get() : nullptr;
+}
+
+bool URockWorldItemSpawnSubsystem::GetPendingSpawn(const FRockWorldItemSpawnHandle& Handle, FRockItemStack& OutItemStack, FTransform& OutTransform) const
+{
+	if (!Handle.IsValid())
+	{
+		return false;
+	}
+	const FPendingSpawn* Spawn = Pending.FindByPredicate([&Handle](const FPendingSpawn& Candidate) { return Candidate.Id == Handle.Id; });
+	if (!Spawn)
+	{
+		return false;
+	}
+	OutItemStack = Spawn->ItemStack;
+	OutTransform = Spawn->Transform;
+	return true;
+}
+
+bool URockWorldItemSpawnSubsystem::CancelSpawn(const FRockWorldItemSpawnHandle& Handle, FRockItemStack& OutItemStack)
+{
+	if (!Handle.IsValid())
+	{
+		return false;
+	}
+	const int32 Index = Pending.IndexOfByPredicate([&Handle](const FPendingSpawn& Spawn) { return Spawn.Id == Handle.Id; });
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+	OutItemStack = MoveTemp(Pending[Index].ItemStack);
+	if (bSpawning)
+	{
+		// Tick is walking the array, it drops the entry when it gets there
+		Pending[Index].Id = 0;
+	}
+	else
+	{
+		Pending.RemoveAt(Index);
+	}
+	return true;
+}
+
+void URockWorldItemSpawnSubsystem::FlushPendingSpawns()
+{
+	if (!ensureMsgf(!bSpawning, TEXT("URockWorldItemSpawnSubsystem::FlushPendingSpawns - Not from an OnSpawned")))
+	{
+		return;
+	}
+	// OnSpawned may queue more, those are flushed too
+	while (Pending.Num() > 0)
+	{
+		TArray<FPendingSpawn> ToSpawn = MoveTemp(Pending);
+		for (FPendingSpawn& Spawn : ToSpawn)
+		{
+			if (Spawn.Id != 0)
+			{
+				SpawnNow(Spawn);
+			}
+		}
+	}
+}
+
+AActor* URockWorldItemSpawnSubsystem::SpawnNow(FPendingSpawn& Spawn)
+{
+	UClass* WorldItemClass = Spawn.ActorClass ? Spawn.ActorClass.Get() : Spawn.ItemStack.GetDefinition()->GetWorldItemClass();
+	AActor* WorldItem = GetWorld()->SpawnActorDeferred<AActor>(WorldItemClass, Spawn.Transform);
+	if (!WorldItem)
+	{
+		UE_LOG(LogRockInventory, Error, TEXT("URockWorldItemSpawnSubsystem - Failed to spawn world item. Possibly DefaultWorldItemClass is unset in Project Settings"));
+	}
+	else
+	{
+		IRockLootableInterface* Lootable = Cast<IRockLootableInterface>(WorldItem);
+		if (Lootable && Spawn.ItemStack.IsValid())
+		{
+			Lootable->SetItemStack(Spawn.ItemStack);
+		}
+		if (Spawn.OnBeforeFinish)
+		{
+			Spawn.OnBeforeFinish(WorldItem);
+		}
+		UGameplayStatics::FinishSpawningActor(WorldItem, Spawn.Transform);
+		if (Lootable && !Spawn.Impulse.IsZero())
+		{
+			Lootable->ApplyThrowImpulse(Spawn.Impulse);
+		}
+		Spawned.Add(Spawn.Id, WorldItem);
+	}
+
+	if (Spawn.OnSpawned)
+	{
+		Spawn.OnSpawned(WorldItem);
+	}
+	return WorldItem;
+}
+
+void URockWorldItemSpawnSubsystem::UpdatePriorities()
+{
+	TArray<FVector, TInlineAllocator<16>> PlayerLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APawn* Pawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(Pawn->GetActorLocation());
+		}
+	}
+	if (PlayerLocations.IsEmpty())
+	{
+		return;
+	}
+
+	for (FPendingSpawn& Spawn : Pending)
+	{
+		Spawn.Priority = TNumericLimits<double>::Max();
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			Spawn.Priority = FMath::Min(Spawn.Priority, FVector::DistSquared(PlayerLocation, Spawn.Transform.GetLocation()));
+		}
+	}
+	// Stable, so equally distant items keep their queue order
+	Algo::StableSortBy(Pending, &FPendingSpawn::Priority);
+}
+
+void URockWorldItemSpawnSubsystem::PurgeSpawned()
+{
+	for (auto It = Spawned.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	PurgeThreshold = FMath::Max(1024, Spawned.Num() * 2);
+}
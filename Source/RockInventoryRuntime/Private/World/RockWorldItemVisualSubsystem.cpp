@@ -0,0 +1,138 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#include "World/RockWorldItemVisualSubsystem.h"
+
+#include "RockInventoryLogging.h"
+#include "Algo/AllOf.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StreamableManager.h"
+#include "Item/RockItemDefinition.h"
+#include "Item/Fragment/RockItemFragment_MeshMaterialOverride.h"
+#include "Misc/RockInventoryDeveloperSettings.h"
+
+void URockWorldItemVisualSubsystem::Deinitialize()
+{
+	// Releases the handles, a batch still in flight then finds nothing to answer
+	Visuals.Reset();
+	PendingDefinitions.Reset();
+	Super::Deinitialize();
+}
+
+void URockWorldItemVisualSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	FlushPendingRequests();
+}
+
+TStatId URockWorldItemVisualSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URockWorldItemVisualSubsystem, STATGROUP_Tickables);
+}
+
+void URockWorldItemVisualSubsystem::RequestVisuals(
+	const URockItemDefinition* Definition, const UObject* Owner, TFunction<void(UStaticMesh*)>&& OnLoaded)
+{
+	FDefinitionVisuals& Entry = FindOrAddVisuals(Definition);
+	if (Entry.bLoaded)
+	{
+		OnLoaded(Entry.Mesh.Get());
+		return;
+	}
+
+	FWaiter& Waiter = Entry.Waiters.AddDefaulted_GetRef();
+	Waiter.Owner = Owner;
+	Waiter.OnLoaded = MoveTemp(OnLoaded);
+	if (!Entry.bRequested)
+	{
+		Entry.bRequested = true;
+		PendingDefinitions.Add(Definition);
+	}
+}
+
+void URockWorldItemVisualSubsystem::FlushPendingRequests()
+{
+	if (PendingDefinitions.IsEmpty())
+	{
+		return;
+	}
+	TArray<TObjectKey<URockItemDefinition>> Definitions = MoveTemp(PendingDefinitions);
+
+	TArray<FSoftObjectPath> PathsToLoad;
+	for (const TObjectKey<URockItemDefinition>& Definition : Definitions)
+	{
+		for (const FSoftObjectPath& Path : Visuals.FindChecked(Definition).Paths)
+		{
+			PathsToLoad.AddUnique(Path);
+		}
+	}
+
+	++NumStreamingRequests;
+	const TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		PathsToLoad, FStreamableDelegate::CreateUObject(this, &URockWorldItemVisualSubsystem::OnBatchLoaded, Definitions));
+	for (const TObjectKey<URockItemDefinition>& Definition : Definitions)
+	{
+		// May already be loaded, if the request completed synchronously
+		if (FDefinitionVisuals* Entry = Visuals.Find(Definition); Entry && !Entry->bLoaded)
+		{
+			Entry->Handle = Handle;
+		}
+	}
+}
+
+URockWorldItemVisualSubsystem::FDefinitionVisuals& URockWorldItemVisualSubsystem::FindOrAddVisuals(const URockItemDefinition* Definition)
+{
+	if (FDefinitionVisuals* Existing = Visuals.Find(Definition))
+	{
+		return *Existing;
+	}
+
+	FDefinitionVisuals& Entry = Visuals.Add(Definition);
+	Entry.Mesh = Definition ? Definition->ItemMesh : nullptr;
+	if (Entry.Mesh.IsNull())
+	{
+		UE_LOG(LogRockInventory, Warning, TEXT("URockWorldItemVisualSubsystem - %s has no mesh, using fallback mesh"), *GetNameSafe(Definition));
+		Entry.Mesh = GetDefault<URockInventoryDeveloperSettings>()->FallbackWorldItemMesh;
+	}
+	else if (const FRockItemFragment_MeshMaterialOverride* MatOverride = FRockItemFragment_MeshMaterialOverride::Find(Definition))
+	{
+		MatOverride->AppendSoftPaths(Entry.Paths);
+	}
+	if (!Entry.Mesh.IsNull())
+	{
+		Entry.Paths.Add(Entry.Mesh.ToSoftObjectPath());
+	}
+
+	// Already resident, e.g. referenced by something else. A handle still keeps them that way once that something lets go,
+	// and completes right away without streaming anything
+	Entry.bLoaded = Algo::AllOf(Entry.Paths, [](const FSoftObjectPath& Path) { return Path.ResolveObject() != nullptr; });
+	if (Entry.bLoaded && !Entry.Paths.IsEmpty())
+	{
+		Entry.Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Entry.Paths);
+	}
+	return Entry;
+}
+
+void URockWorldItemVisualSubsystem::OnBatchLoaded(TArray<TObjectKey<URockItemDefinition>> Definitions)
+{
+	for (const TObjectKey<URockItemDefinition>& Definition : Definitions)
+	{
+		FDefinitionVisuals* Entry = Visuals.Find(Definition);
+		if (!Entry)
+		{
+			continue;
+		}
+		Entry->bLoaded = true;
+		UStaticMesh* LoadedMesh = Entry->Mesh.Get();
+
+		// A callback may request more visuals, so don't hold on to Entry while calling them
+		TArray<FWaiter> Waiters = MoveTemp(Entry->Waiters);
+		for (FWaiter& Waiter : Waiters)
+		{
+			if (Waiter.Owner.IsValid())
+			{
+				Waiter.OnLoaded(LoadedMesh);
+			}
+		}
+	}
+}
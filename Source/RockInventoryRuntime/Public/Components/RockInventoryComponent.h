@@ -5,8 +5,10 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Inventory/RockInventory.h"
+#include "World/RockWorldItemSpawnSubsystem.h"
 #include "RockInventoryComponent.generated.h"
 
+class ARockInventoryWorldContainer;
 class URockInventoryConfig;
 
 /**
@@ -30,6 +32,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="RockInventory")
 	TObjectPtr<URockInventoryConfig> InventoryConfig;
 
+	/**
+	 * Identifies the inventory in snapshots and the journal. Set it before BeginPlay (on a placed actor, or between
+	 * SpawnActorDeferred and FinishSpawning) to get a saved inventory back. Generated when left unset, and kept in sync
+	 * with the inventory afterwards so the game can put it in its own save data.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="RockInventory|Persistence")
+	FGuid PersistentId;
+
+	/** Server: restores the snapshot and journal records saved under PersistentId when BeginPlay creates the inventory */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="RockInventory|Persistence")
+	bool bRecoverOnBeginPlay = true;
+
 	// TODO: Consider adding a tarray/variable of controllers currently interacting with this top level Inventory?
 	// But to what end? conditional replication?  
 	/** The underlying inventory data */
@@ -65,12 +79,33 @@ public:
 	UFUNCTION(BlueprintCallable, Category="RockInventory|Items", Meta=(DisplayName="Remove Item"))
 	FRockItemStack K2_RemoveItem(const FRockInventorySlotHandle& InHandle);
 
+	/**
+	 * Server: moves the whole inventory into a new world container, e.g. on death, and starts over with an empty one.
+	 * The inventory object itself changes hands, so no item stack is copied, and the runtime instances follow it along
+	 * with their nested inventories. The fresh inventory keeps the persistent id and is saved immediately, the dropped one
+	 * gets a new id and isn't persisted (the container is as transient as a world item).
+	 * The container is queued in URockWorldItemSpawnSubsystem, so a wave of deaths doesn't spawn them all in one frame.
+	 * The dropped inventory is held by the queue until then; GetSpawnedActor on the handle returns the container once spawned.
+	 * @param ContainerClass ARockInventoryWorldContainer if unset
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="RockInventory")
+	FRockWorldItemSpawnHandle DropInventoryAsContainer(const FTransform& Transform, TSubclassOf<ARockInventoryWorldContainer> ContainerClass);
+
 	// Misc
 	bool K2_HasItem(FName ItemId, int32 MinQuantity);
 	int32 K2_GetItemCount(FName ItemId);
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	// virtual bool ReplicateSubobjects(UActorChannel* Channel, FOutBunch* Bunch, FReplicationFlags* RepFlags) override;
+private:
+	/** Server: creates and tracks a fresh inventory from InventoryConfig */
+	void CreateInventory(const FGuid& InPersistentId);
+	/** Stops replicating and persisting the inventory, and lets go of it */
+	URockInventory* DetachInventory();
+	/** Server: takes over an inventory detached from another component */
+	void AdoptInventory(URockInventory* InInventory);
+
+public:
 #if WITH_EDITOR
 	// Validation
 	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
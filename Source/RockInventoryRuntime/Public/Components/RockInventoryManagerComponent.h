@@ -4,37 +4,52 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Inventory/RockInventoryResyncData.h"
+#include "Inventory/RockInventoryShadowState.h"
 #include "Inventory/RockPendingSlotOperation.h"
 #include "StructUtils/InstancedStruct.h"
+#include "Transactions/Core/RockInventoryTransactionBatch.h"
+#include "Transactions/Core/RockInventoryTransactionHistory.h"
+#include "Transactions/Core/RockTransactionRateLimiter.h"
 #include "Transactions/Implementations/RockDropItemTransaction.h"
 #include "Transactions/Implementations/RockLootWorldItemTransaction.h"
 #include "Transactions/Implementations/RockMoveItemTransaction.h"
+#include "Transactions/Implementations/RockSortInventoryTransaction.h"
+#include "Transactions/Implementations/RockTransferAllTransaction.h"
 #include "RockInventoryManagerComponent.generated.h"
 
+class ARockWorldItemCluster;
 class URockInventory;
 class URockInventoryComponent;
+class URockInventoryTransactionQueueSubsystem;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRockTransactionBatchResultDelegate, const FRockInventoryTransactionBatchResult&, Result);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRockInventoryResyncedDelegate, URockInventory*, Inventory);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FRockQueuedTransactionFinishedNative, const FInstancedStruct& /*Transaction*/, ERockTransactionExecuteResult /*Result*/);
+
+/** A transaction the client already applied locally and is waiting on the server to confirm */
 USTRUCT()
-struct FRockInventoryTransactionRecord
+struct ROCKINVENTORYRUNTIME_API FRockPredictedTransaction
 {
 	GENERATED_BODY()
 
 	UPROPERTY()
-	FInstancedStruct Command;
-	// TODO: Rewrite to try and use this?
-	// TInstancedStruct<FRockItemTransactionBase> Command;
+	int32 TransactionID = 0;
 
+	/** Kept to replay the prediction after an older one was rolled back */
 	UPROPERTY()
-	FInstancedStruct Undo;
+	FInstancedStruct Transaction;
 
-	template <typename CommandT, typename UndoT>
-	void Set(const CommandT& Cmd, const UndoT& UndoData)
-	{
-		Command.InitializeAs<CommandT>(Cmd);
-		Undo.InitializeAs<UndoT>(UndoData);
-	}
+	/** Source and target item fingerprints right after the prediction, to recognize replicated state that already contains it */
+	UPROPERTY()
+	uint32 PostSourceFingerprint = 0;
 
-	bool ExecuteUndo();
+	UPROPERTY()
+	uint32 PostTargetFingerprint = 0;
+
+	/** Put back on top of replicated state since it was predicted, which may have contained its outcome along with later changes */
+	UPROPERTY()
+	bool bReplayedOnReplicatedState = false;
 };
 
 // Should put this on the PlayerController?
@@ -47,22 +62,118 @@ public:
 
 	// TODO: static URockInventoryManagerComponent* Get(UObject* WorldContextObject);
 
+protected:
+	virtual void BeginPlay() override;
+
 private:
-	// TODO: Spin into a custom CircularBuffer later...
 	UPROPERTY()
-	TArray<FRockInventoryTransactionRecord> TransactionHistoryData;
+	FRockInventoryTransactionHistory TransactionHistory;
 
 	// Current position in the transaction history
 	int32 CurrentTransactionIndex = -1;
 	// Maximum history length
+	UPROPERTY(EditAnywhere, Category = "Inventory|Transactions", meta = (AllowPrivateAccess = true, ClampMin = 1))
 	int32 MaxHistoryLength = 25;
+	// Per player memory budget for the history, the oldest records are dropped first when exceeded. 0 = only MaxHistoryLength applies
+	UPROPERTY(EditAnywhere, Category = "Inventory|Transactions", meta = (AllowPrivateAccess = true, ClampMin = 0))
+	int32 HistoryMemoryBudgetKB = 16;
+
+	/** The single way into the history for client and server alike, so both trim the same way */
+	void AddToHistory(FRockInventoryTransactionRecord&& TransactionRecord);
+
+	/** Server: append every successfully executed transaction to the inventory journal (URockInventoryPersistenceSubsystem) */
+	UPROPERTY(EditAnywhere, Category = "Inventory|Persistence", meta = (AllowPrivateAccess = true))
+	bool bJournalTransactions = false;
+
+	/** Journals the inventories touched by an executed transaction */
+	void JournalTransaction(URockInventory* InventoryA, URockInventory* InventoryB = nullptr);
+
+	/** Server: upper bound on entries in a single batch, larger batches are rejected as a whole */
+	UPROPERTY(EditAnywhere, Category = "Inventory|Transactions", meta = (AllowPrivateAccess = true, ClampMin = 1))
+	int32 MaxTransactionsPerBatch = 64;
+
+	/** While a batch executes, journaling is deferred so each touched inventory gets a single record for the whole batch */
+	int32 JournalDeferDepth = 0;
+	TArray<TWeakObjectPtr<URockInventory>, TInlineAllocator<4>> DeferredJournalInventories;
+	void FlushDeferredJournal();
+
+	/** Last batch id handed out by ExecuteTransactionBatch */
+	int32 LastBatchID = 0;
+
+	/**
+	 * Server side execution shared by the single transaction RPCs and the batch RPC.
+	 * Fills OutRecord (unless rejected) and journals on success, but doesn't touch the history or notify the client.
+	 */
+	ERockTransactionExecuteResult ExecuteServerTransaction(FInstancedStruct& Transaction, FRockInventoryTransactionRecord& OutRecord);
+	ERockTransactionExecuteResult ExecuteServerLootWorldItem(FRockLootWorldItemTransaction& ItemTransaction, FRockInventoryTransactionRecord& OutRecord);
+	/** Queues or executes a rate limited loot, then records and answers it */
+	void SubmitServerLootWorldItem(FRockLootWorldItemTransaction& ItemTransaction);
+	/** Runs an already validated batch in one go, then records and answers it */
+	void ExecuteServerTransactionBatch(const FRockInventoryTransactionBatch& Batch);
+	ERockTransactionExecuteResult ExecuteServerMoveItem(const FRockMoveItemTransaction& ItemTransaction, FRockInventoryTransactionRecord& OutRecord);
+	ERockTransactionExecuteResult ExecuteServerDropItem(const FRockDropItemTransaction& ItemTransaction, FRockInventoryTransactionRecord& OutRecord);
+	ERockTransactionExecuteResult ExecuteServerTransferAllItems(const FRockTransferAllTransaction& ItemTransaction, FRockInventoryTransactionRecord& OutRecord);
+	ERockTransactionExecuteResult ExecuteServerSortInventory(const FRockSortInventoryTransaction& ItemTransaction, FRockInventoryTransactionRecord& OutRecord);
+
+	/** Client: apply moves, splits and merges locally right away instead of waiting a round trip for replication */
+	UPROPERTY(EditAnywhere, Category = "Inventory|Prediction", meta = (AllowPrivateAccess = true))
+	bool bEnablePredictiveExecution = true;
+
+	/** Client: predictions in flight at once. Further transactions are still sent, just not predicted */
+	UPROPERTY(EditAnywhere, Category = "Inventory|Prediction", meta = (AllowPrivateAccess = true, ClampMin = 1))
+	int32 MaxPendingPredictions = 8;
+
+	/** Predictions waiting on Client_TransactionResult, oldest first. The server answers in the same order */
+	UPROPERTY()
+	TArray<FRockPredictedTransaction> PendingPredictions;
+
+	/** Authoritative state of every inventory touched by a pending prediction, taken before the first of them */
+	UPROPERTY()
+	TMap<TObjectPtr<URockInventory>, FRockInventoryShadowState> PredictionShadows;
+
+	/** Applies the move locally and tracks it until the server answers. False if it failed locally and shouldn't be sent */
+	bool PredictMoveItem(const FRockMoveItemTransaction& ItemTransaction, FRockMoveItemUndoTransaction& OutUndo);
+	bool ApplyPrediction(const FRockPredictedTransaction& Prediction);
+	void CapturePredictionShadow(URockInventory* Inventory);
+	/** Restores every shadowed inventory to its last confirmed state */
+	void RewindPredictions();
+	/** Re-applies the pending predictions on top of the restored shadows, dropping those that no longer apply */
+	void ReplayPredictions();
+	void ReleasePredictionShadows();
+	void OnPredictedInventoryReplicated(URockInventory* Inventory, TConstArrayView<int32> ItemIndices, TConstArrayView<int32> SlotIndices);
+
+	/** Client: a rejected or dropped prediction may have left the sections it touched out of sync */
+	void RequestResyncForTransaction(const FInstancedStruct& Transaction);
+
+	/** Server: minimum time between two resyncs sent to this client. Requests in between are merged into the next one */
+	UPROPERTY(EditAnywhere, Category = "Inventory|Resync", meta = (AllowPrivateAccess = true, ClampMin = 0))
+	float ResyncMinInterval = 0.5f;
+
+	/** Server: inventories that can wait for a resync at once, further requests are dropped until the next flush */
+	UPROPERTY(EditAnywhere, Category = "Inventory|Resync", meta = (AllowPrivateAccess = true, ClampMin = 1))
+	int32 MaxPendingResyncs = 8;
+
+	/** Server: a client may only be sent inventories its controller owns (pawn, player state...) or stands next to (containers) */
+	bool CanAccessInventory(URockInventory* Inventory) const;
+
+	/** Server: a client may only instigate as its own controller, on inventories it can access. Logs and returns false otherwise */
+	bool CanClientRequest(const TCHAR* Context, const FRockItemTransactionBase& Transaction, URockInventory* InventoryA, URockInventory* InventoryB = nullptr) const;
 
-	bool bAwaitingServerSync = false;
-	bool bHasPendingPredictiveMove = false;
-	bool bEnablePredictiveExecution = false;
-	// This was used to track pending transactions form the client that were sent to the server. Waiting on 'reconcilation'
-	// UPROPERTY()
-	// TMap<int32, FRockInventoryPendingTransaction> PendingServerTransactions;
+	/** Server: the queue subsystem when transactions should go through it, null to execute them inline */
+	URockInventoryTransactionQueueSubsystem* GetTransactionQueue() const;
+
+	/** Server: per request kind token buckets for the owning controller, see URockInventoryDeveloperSettings */
+	FRockTransactionRateLimiter RateLimiter;
+	double LastRateLimitLogTime = 0.0;
+	/** Server: false if the request must be dropped. Call before doing any work for it */
+	bool ConsumeRateLimit(ERockRateLimitedRequest Request, float Cost = 1.0f);
+
+	/** Server: requested sections per inventory, waiting for the next flush */
+	UPROPERTY()
+	TMap<TObjectPtr<URockInventory>, uint32> PendingResyncSections;
+	double LastResyncTime = 0.0;
+	FTimerHandle ResyncTimerHandle;
+	void FlushResyncRequests();
 
 public:
 	/**
@@ -75,6 +186,44 @@ public:
 	void Client_TransactionResult(int32 ClientTransactionID, bool bSuccess);
 	void Client_TransactionResult_Implementation(int32 ClientTransactionID, bool bSuccess);
 
+	/** Inventories a transaction reads or writes, each reported once. Unknown transaction types report none */
+	static void GetTouchedInventories(const FInstancedStruct& Transaction, TArray<URockInventory*, TInlineAllocator<2>>& OutInventories);
+
+	/** Server: runs a transaction URockInventoryTransactionQueueSubsystem held back and answers the client like the RPC would have */
+	void ExecuteQueuedTransaction(FInstancedStruct& Transaction);
+
+	/**
+	 * True if the transaction only reads and writes its inventories' own data: moves, transfer all and sort, with no RuntimeInstances
+	 * in the inventories. Those can run on a worker while other transactions run on other inventories.
+	 */
+	static bool CanExecuteOffGameThread(const FInstancedStruct& Transaction);
+
+	/**
+	 * Server: the queue's parallel execution, split in the part that may run on a worker and the part that must run on the game thread.
+	 * Begin/EndParallelTransactions bracket a wave on the game thread and hold back journaling until it is over.
+	 * ExecuteParallelTransaction is the only one called from a worker, with the inventories' side effects deferred
+	 * (FRockInventoryDeferredEffectsScope) and no other worker using this manager.
+	 * FinishQueuedTransaction then records the result and answers the client, in order.
+	 */
+	void BeginParallelTransactions();
+	ERockTransactionExecuteResult ExecuteParallelTransaction(FInstancedStruct& Transaction, FRockInventoryTransactionRecord& OutRecord);
+	void FinishQueuedTransaction(const FInstancedStruct& Transaction, ERockTransactionExecuteResult Result, FRockInventoryTransactionRecord&& Record);
+	void EndParallelTransactions();
+
+	/** Server: broadcast by FinishQueuedTransaction, once the result is recorded and before the client is answered */
+	FRockQueuedTransactionFinishedNative OnQueuedTransactionFinished;
+
+	/** Oldest record first */
+	const FRockInventoryTransactionHistory& GetTransactionHistory() const { return TransactionHistory; }
+
+	/** Server: requests dropped by the rate limiter for this controller */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Networking")
+	FRockRateLimitStats GetRateLimitStats() const;
+
+	/** Client: number of predicted transactions the server hasn't answered yet */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Prediction")
+	int32 GetNumPendingPredictions() const { return PendingPredictions.Num(); }
+
 	// Basic Inventory CRUD functions
 	UFUNCTION(BlueprintCallable)
 	void LootWorldItem(const FRockLootWorldItemTransaction& ItemTransaction);
@@ -82,6 +231,25 @@ public:
 	void Server_LootWorldItem(FRockLootWorldItemTransaction ItemTransaction);
 	void Server_LootWorldItem_Implementation(FRockLootWorldItemTransaction ItemTransaction);
 
+	/**
+	 * Loots an item stored in an ARockWorldItemCluster, e.g. from a trace hit (ARockWorldItemCluster::GetEntryIdForInstance).
+	 * The server promotes the entry to a world item actor, then loots it as SourceWorldItemActor. Not predicted.
+	 */
+	UFUNCTION(BlueprintCallable)
+	void LootClusteredWorldItem(const FRockLootWorldItemTransaction& ItemTransaction, ARockWorldItemCluster* Cluster, int32 EntryId);
+	UFUNCTION(Server, Reliable)
+	void Server_LootClusteredWorldItem(FRockLootWorldItemTransaction ItemTransaction, ARockWorldItemCluster* Cluster, int32 EntryId);
+	void Server_LootClusteredWorldItem_Implementation(FRockLootWorldItemTransaction ItemTransaction, ARockWorldItemCluster* Cluster, int32 EntryId);
+
+	/**
+	 * Area loot: loots the world items within Radius of Center into TargetInventory, nearest first and at most MaxItems,
+	 * as one non atomic batch (see ExecuteTransactionBatch). The items are found through URockWorldItemGridSubsystem.
+	 * On the server, clustered items compete by distance with the actors, and only the ones picked are promoted (URockWorldItemClusterSubsystem).
+	 * @return The batch id, or 0 if nothing was in range
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Transactions")
+	int32 LootItemsInRadius(AController* Instigator, URockInventory* TargetInventory, FVector Center, float Radius, int32 MaxItems = 16);
+
 	// TODO: Give a 'preferred location' option, and what to do if it can't place it there (fallback to other slots or 'fail')
 	// TODO: For a server to do an action like 'give players to the item' from a task reward or something.  Need a more fleshed out UX dev consumer pattern
 
@@ -97,6 +265,56 @@ public:
 	void Server_DropItem(FRockDropItemTransaction ItemTransaction);
 	void Server_DropItem_Implementation(FRockDropItemTransaction ItemTransaction);
 
+	/** Moves everything from one inventory to another with a single RPC. Not predicted, the result comes back through replication */
+	UFUNCTION(BlueprintCallable)
+	void TransferAllItems(const FRockTransferAllTransaction& ItemTransaction);
+	UFUNCTION(Server, Reliable)
+	void Server_TransferAllItems(FRockTransferAllTransaction ItemTransaction);
+	void Server_TransferAllItems_Implementation(FRockTransferAllTransaction ItemTransaction);
+
+	/** Sorts an inventory on the server. The new layout is applied all at once or not at all, and replicates back */
+	UFUNCTION(BlueprintCallable)
+	void SortInventory(const FRockSortInventoryTransaction& ItemTransaction);
+	UFUNCTION(Server, Reliable)
+	void Server_SortInventory(FRockSortInventoryTransaction ItemTransaction);
+	void Server_SortInventory_Implementation(FRockSortInventoryTransaction ItemTransaction);
+
+	/**
+	 * Sends several transactions to the server in one reliable RPC, answered by a single Client_TransactionBatchResult.
+	 * Not predicted, the client sees the changes through replication.
+	 * @return The batch id, or 0 if the batch was empty or too large
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Transactions")
+	int32 ExecuteTransactionBatch(FRockInventoryTransactionBatch Batch);
+	UFUNCTION(Server, Reliable)
+	void Server_ExecuteTransactionBatch(const FRockInventoryTransactionBatch& Batch);
+	void Server_ExecuteTransactionBatch_Implementation(const FRockInventoryTransactionBatch& Batch);
+
+	UFUNCTION(Client, Reliable)
+	void Client_TransactionBatchResult(const FRockInventoryTransactionBatchResult& Result);
+	void Client_TransactionBatchResult_Implementation(const FRockInventoryTransactionBatchResult& Result);
+
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Transactions")
+	FRockTransactionBatchResultDelegate OnTransactionBatchResult;
+
+	/**
+	 * Asks the server for its copy of an inventory section, for when the client suspects it's out of sync.
+	 * Rejected predictions request this automatically. Throttled and merged on the server.
+	 * @param SectionIndex - Section to resync, INDEX_NONE for all of them
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Resync")
+	void RequestResync(URockInventory* Inventory, int32 SectionIndex = -1);
+	UFUNCTION(Server, Reliable)
+	void Server_RequestResync(URockInventory* Inventory, uint32 SectionMask);
+	void Server_RequestResync_Implementation(URockInventory* Inventory, uint32 SectionMask);
+
+	UFUNCTION(Client, Reliable)
+	void Client_InventoryResync(const FRockInventoryResyncData& ResyncData);
+	void Client_InventoryResync_Implementation(const FRockInventoryResyncData& ResyncData);
+
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Resync")
+	FRockInventoryResyncedDelegate OnInventoryResynced;
+
 	UFUNCTION(BlueprintCallable, Server, Reliable)
 	void Server_RegisterSlotStatus(
 		URockInventory* Inventory, AController* Instigator, const FRockInventorySlotHandle& InSlotHandle, ERockSlotStatus InStatus);
@@ -26,6 +26,14 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventorySlotChanged, const FRock
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryItemStackChanged, const FRockItemDelta&, ItemDelta);
 
+/** Client only. Item and slot indices that were just overwritten by replication */
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnInventoryDataReplicated, URockInventory*, TConstArrayView<int32>, TConstArrayView<int32>);
+
+class FRockInventorySnapshot;
+struct FRockInventoryDeferredEffects;
+struct FRockInventoryResyncData;
+struct FRockInventoryShadowState;
+
 // URockInventory*, Inventory, const FRockItemStackHandle&, ItemHandle);
 
 /**
@@ -50,7 +58,7 @@ private:
 	UPROPERTY(VisibleAnywhere, Replicated)
 	FRockInventoryItemContainer ItemData;
 
-	/** Stack of available slot indices for reuse */
+	/** Min-heap of available item indices for reuse, so the lowest one is taken first in O(log n) */
 	UPROPERTY()
 	TArray<uint32> FreeIndices;
 
@@ -71,6 +79,40 @@ private:
 	/** Snapshot of the previous replication state; diffed in OnRep to detect added/removed pending operations. */
 	UPROPERTY()
 	TArray<FRockPendingSlotOperation> PreviousPendingSlotOperations;
+
+	/** Stable identity across sessions, used to match save snapshots and journal records. Assigned on Init, restored by the save data */
+	UPROPERTY(VisibleAnywhere, SaveGame)
+	FGuid PersistentId;
+
+	/** Item and slot indices modified since the last ConsumeChangedIndices. Only read by persistence (server side) */
+	TBitArray<> ChangedItemIndices;
+	TBitArray<> ChangedSlotIndices;
+	/** Bumped on every tracked modification, lets persistence cheaply tell if anything changed since it last looked */
+	uint32 ChangeSerial = 0;
+
+	void MarkItemIndexChanged(int32 ItemIndex);
+	void MarkSlotIndexChanged(int32 SlotIndex);
+
+	/** > 0 while a client predicts a transaction against this inventory, see FRockInventoryPredictionScope */
+	int32 PredictionScopeCount = 0;
+
+	/** Set while a transaction runs off the game thread, see FRockInventoryDeferredEffectsScope */
+	FRockInventoryDeferredEffects* DeferredEffects = nullptr;
+
+	/** Last snapshot handed out by GetSnapshot, and the sections and item pages modified since */
+	mutable TSharedPtr<const FRockInventorySnapshot, ESPMode::ThreadSafe> CachedSnapshot;
+	mutable TBitArray<> SnapshotDirtySections;
+	mutable TBitArray<> SnapshotDirtyItemPages;
+
+	void MarkSnapshotItemDirty(int32 ItemIndex);
+	void MarkSnapshotSlotDirty(int32 SlotIndex);
+	/** For bulk changes that bypass the per index tracking (Init, loading). The next snapshot copies everything */
+	void InvalidateSnapshot();
+
+	/** FastArray dirtying, held back while DeferredEffects is set */
+	void MarkItemEntryDirty(int32 ItemIndex);
+	void MarkItemArrayDirty();
+	void MarkSlotEntryDirty(int32 SlotIndex);
 public:
 	/** Broadcast when a slot's state changes (item assigned, removed, etc). */
 	UPROPERTY(BlueprintAssignable, Category = "Rock|Inventory")
@@ -80,6 +122,10 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Rock|Inventory")
 	FOnInventoryItemStackChanged OnItemChanged;
 
+	/** Client only. Fired after OnSlotChanged/OnItemChanged for replicated changes, used to reconcile predictions */
+	FOnInventoryDataReplicated OnDataReplicated;
+	void NotifyDataReplicated(TConstArrayView<int32> ItemIndices, TConstArrayView<int32> SlotIndices);
+
 	/* The owner of this inventory, most likely the InventoryComponent */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated)
 	TObjectPtr<UObject> Owner;
@@ -99,12 +145,20 @@ public:
 	/** Sets up slots and sections from the given config. Must be called before use. */
 	void Init(const URockInventoryConfig* config);
 
+	const FGuid& GetPersistentId() const { return PersistentId; }
+	uint32 GetChangeSerial() const { return ChangeSerial; }
+	bool HasChangedIndices() const { return ChangedItemIndices.Contains(true) || ChangedSlotIndices.Contains(true); }
+	/** Returns (ascending) and clears the item and slot indices modified since the last call */
+	void ConsumeChangedIndices(TArray<int32>& OutItemIndices, TArray<int32>& OutSlotIndices);
+
 	/** Returns section info by SectionTag, or an empty struct if not found. */
 	const FRockInventorySectionInfo& GetSectionInfo(const FGameplayTag& SectionTag) const;
 	const FRockInventorySectionInfo& GetSectionInfoBySlotHandle(const FRockInventorySlotHandle& InSlotHandle) const;
 
 	/** Returns the index of the section with the given SectionTag, or INDEX_NONE if not found. */
 	int32 GetSectionIndex(const FGameplayTag& SectionTag) const;
+	/** Returns the index of the section containing the slot, or INDEX_NONE if not found. */
+	int32 GetSectionIndexBySlotHandle(const FRockInventorySlotHandle& InSlotHandle) const;
 
 
 	/** Returns the slot entry for the given handle, or a default entry if the handle is invalid. */
@@ -164,6 +218,53 @@ public:
 	UFUNCTION(BlueprintCallable)
 	FRockPendingSlotOperation GetPendingSlotState(const FRockInventorySlotHandle& InSlotHandle) const;
 
+	/////////////////////////////////////////////////////////////////
+	/// Prediction
+
+	bool IsPredicting() const { return PredictionScopeCount > 0; }
+	/** True inside a FRockInventoryDeferredEffectsScope, dirtying and broadcasts are recorded instead of applied */
+	bool IsDeferringEffects() const { return DeferredEffects != nullptr; }
+
+	/**
+	 * Lowest item index an AddItemToInventory would reuse, or INDEX_NONE if it would have to grow the array.
+	 * Server and client agree on it, so a predicted split lands on the same handle the server assigns.
+	 */
+	int32 FindFreeItemIndex() const;
+
+	/** Copies the item and slot arrays */
+	void CaptureShadowState(FRockInventoryShadowState& OutState) const;
+	/** Folds the current (just replicated) value of the given entries into the shadow state */
+	void RebaseShadowState(FRockInventoryShadowState& InOutState, TConstArrayView<int32> ItemIndices, TConstArrayView<int32> SlotIndices) const;
+	/** Puts back the entries that differ from the shadow state and broadcasts them */
+	void RestoreShadowState(const FRockInventoryShadowState& InState);
+
+	/////////////////////////////////////////////////////////////////
+	/// Parallel execution
+
+	/**
+	 * True if any item has, or would create on add, a RuntimeInstance.
+	 * Moving those renames and (un)registers UObjects, so transactions touching this inventory must stay on the game thread.
+	 */
+	bool HasRuntimeInstances() const;
+
+	/////////////////////////////////////////////////////////////////
+	/// Snapshots
+
+	/**
+	 * Game thread only. Immutable copy of the slots and items that can be handed to worker threads (AI, pricing, analytics)
+	 * and read there while this inventory keeps changing. Returns the previous snapshot if nothing changed since,
+	 * otherwise only the modified sections and item pages are copied. See FRockInventorySnapshot
+	 */
+	TSharedRef<const FRockInventorySnapshot, ESPMode::ThreadSafe> GetSnapshot() const;
+
+	/////////////////////////////////////////////////////////////////
+	/// Resync
+
+	/** Server: copies the selected sections (FRockInventoryResyncData::SectionMask) */
+	void BuildResyncData(uint32 SectionMask, FRockInventoryResyncData& OutData) const;
+	/** Client: overwrites the local entries with the server's, broadcasting only what differs. FastArray bookkeeping is kept */
+	void ApplyResyncData(const FRockInventoryResyncData& InData);
+
 	/////////////////////////////////////////////////////////////////
 
 	/** Get a debug string representation of the inventory */
@@ -185,6 +286,8 @@ public:
 private:
 	// Internal use only
 	uint32 AcquireAvailableItemIndex();
+	/** Overwrites the item data at the index (keeping FastArray bookkeeping) and broadcasts the change, if any */
+	void OverwriteItemAtIndex(int32 ItemIndex, const FRockItemStack& InItemStack);
 public:
 	int32 GetItemStackCount();
 	int32 GetItemTotalCount();
@@ -212,6 +315,11 @@ public:
 	friend class URockInventoryLibrary;
 	friend class URockItemInstanceLibrary;
 	friend class URockInventoryComponent;
+	friend struct FRockInventorySaveData;
+	friend struct FRockInventoryJournalRecord;
+	friend struct FRockInventoryPredictionScope;
+	friend struct FRockInventoryDeferredEffects;
+	friend struct FRockInventoryDeferredEffectsScope;
 };
 
 
@@ -0,0 +1,75 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Events/RockItemChangeType.h"
+#include "Events/RockSlotDelta.h"
+#include "Item/RockItemStackHandle.h"
+
+class URockInventory;
+
+/**
+ * Replication dirtying and delegate broadcasts held back while a transaction runs off the game thread.
+ * Neither is thread safe (Iris dirty tracking, Blueprint listeners), so they are recorded in the order they happened
+ * and replayed by Apply on the game thread. See URockInventoryTransactionQueueSubsystem.
+ */
+struct ROCKINVENTORYRUNTIME_API FRockInventoryDeferredEffects
+{
+	/** Game thread only. Replays everything recorded so far and resets */
+	void Apply();
+
+	/**
+	 * Collapses repeated effects before Apply, for bulk operations that touch the same entries many times.
+	 * Every entry is dirtied once (not at all if its whole array is), and every item and slot is broadcast once,
+	 * at its first position, with the latest change type. A slot keeps the item handle it had before the first change.
+	 */
+	void Coalesce();
+
+	bool IsEmpty() const { return Effects.IsEmpty(); }
+	/** Effects Apply would replay */
+	int32 Num() const { return Effects.Num(); }
+	void Reset();
+
+private:
+	friend class URockInventory;
+
+	enum class EEffectType : uint8
+	{
+		ItemDirty,
+		ItemArrayDirty,
+		SlotDirty,
+		ItemChanged,
+		SlotChanged,
+	};
+
+	struct FEffect
+	{
+		URockInventory* Inventory = nullptr;
+		EEffectType Type = EEffectType::ItemDirty;
+		ERockItemChangeType ItemChangeType = ERockItemChangeType::None;
+		/** Item or slot index, or the index into SlotDeltas for SlotChanged */
+		int32 Index = INDEX_NONE;
+		FRockItemStackHandle ItemHandle;
+	};
+
+	void Add(URockInventory* Inventory, EEffectType Type, int32 Index = INDEX_NONE);
+
+	TArray<FEffect> Effects;
+	TArray<FRockSlotDelta> SlotDeltas;
+};
+
+/**
+ * Routes the inventories' side effects into Effects for the lifetime of the scope, instead of applying them.
+ * The inventories must not be touched by anything else while the scope is alive.
+ */
+struct ROCKINVENTORYRUNTIME_API FRockInventoryDeferredEffectsScope
+{
+	FRockInventoryDeferredEffectsScope(FRockInventoryDeferredEffects& InEffects, TConstArrayView<URockInventory*> InInventories);
+	~FRockInventoryDeferredEffectsScope();
+
+	UE_NONCOPYABLE(FRockInventoryDeferredEffectsScope);
+
+private:
+	TArray<URockInventory*, TInlineAllocator<2>> Inventories;
+};
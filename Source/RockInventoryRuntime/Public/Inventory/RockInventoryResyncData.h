@@ -0,0 +1,43 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RockInventorySlot.h"
+#include "Item/RockItemStack.h"
+#include "RockInventoryResyncData.generated.h"
+
+class URockInventory;
+
+/**
+ * Authoritative copy of some sections of an inventory, sent to a single client that fell out of sync
+ * (see URockInventoryManagerComponent::RequestResync). Holds the section slots, the items they reference
+ * and the free item entries, nothing else.
+ */
+USTRUCT()
+struct ROCKINVENTORYRUNTIME_API FRockInventoryResyncData
+{
+	GENERATED_BODY()
+
+	/** Bit N selects section N. Sections from 32 up are always included */
+	static constexpr uint32 AllSections = MAX_uint32;
+
+	UPROPERTY()
+	TObjectPtr<URockInventory> Inventory = nullptr;
+
+	UPROPERTY()
+	uint32 SectionMask = 0;
+
+	/** Every slot of the selected sections, the SlotHandle says where it goes */
+	UPROPERTY()
+	TArray<FRockInventorySlotEntry> Slots;
+
+	/** Item array index of each entry in Items */
+	UPROPERTY()
+	TArray<int32> ItemIndices;
+
+	UPROPERTY()
+	TArray<FRockItemStack> Items;
+
+	bool IsEmpty() const { return Slots.IsEmpty() && Items.IsEmpty(); }
+};
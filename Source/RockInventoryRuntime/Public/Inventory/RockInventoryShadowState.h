@@ -0,0 +1,46 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RockInventorySlot.h"
+#include "Item/RockItemStack.h"
+#include "RockInventoryShadowState.generated.h"
+
+class URockInventory;
+
+/**
+ * Copy of an inventory's item and slot arrays, taken by the client before it predicts a transaction.
+ * It holds the last state the server is known to agree with: replicated entries are folded in as they arrive,
+ * and a rejected prediction restores it before the remaining predictions are replayed on top.
+ */
+USTRUCT()
+struct ROCKINVENTORYRUNTIME_API FRockInventoryShadowState
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FRockItemStack> Items;
+
+	UPROPERTY()
+	TArray<FRockInventorySlotEntry> Slots;
+
+	UPROPERTY()
+	TArray<uint32> FreeIndices;
+};
+
+/**
+ * Marks the inventories as being predicted for the lifetime of the scope.
+ * Lets a client run the same item add/remove code the server does, see URockInventory::AddItemToInventory
+ */
+struct ROCKINVENTORYRUNTIME_API FRockInventoryPredictionScope
+{
+	FRockInventoryPredictionScope(URockInventory* InInventoryA, URockInventory* InInventoryB = nullptr);
+	~FRockInventoryPredictionScope();
+
+	UE_NONCOPYABLE(FRockInventoryPredictionScope);
+
+private:
+	URockInventory* InventoryA = nullptr;
+	URockInventory* InventoryB = nullptr;
+};
@@ -0,0 +1,71 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RockInventorySectionInfo.h"
+#include "RockInventorySlot.h"
+#include "RockSlotHandle.h"
+#include "Item/RockItemStack.h"
+
+class URockInventory;
+
+/**
+ * Immutable copy of an inventory's slots and items, see URockInventory::GetSnapshot.
+ * Safe to read from any thread, while the inventory itself keeps changing on the game thread.
+ *
+ * Consecutive snapshots share everything that didn't change between them: slots are stored per section and items in fixed size pages,
+ * and a new snapshot only copies the sections and pages that were modified since the previous one.
+ *
+ * The UObjects the items point to (definitions, runtime instances) aren't kept alive by the snapshot. Definitions are loaded assets
+ * and safe to read, runtime instances should only be dereferenced on the game thread.
+ */
+class ROCKINVENTORYRUNTIME_API FRockInventorySnapshot
+{
+public:
+	/** Items per page. A page is the unit that gets copied when one of its items changes */
+	static constexpr int32 ItemsPerPage = 32;
+
+	/** Increases with every snapshot that differs from the previous one. Equal versions mean equal contents */
+	uint32 GetVersion() const { return Version; }
+
+	int32 GetNumSections() const { return Sections.Num(); }
+	const FRockInventorySectionInfo& GetSectionInfo(int32 SectionIndex) const { return Sections[SectionIndex]->Info; }
+	TConstArrayView<FRockInventorySlotEntry> GetSectionSlots(int32 SectionIndex) const { return Sections[SectionIndex]->Slots; }
+
+	int32 GetNumSlots() const { return NumSlots; }
+	int32 GetNumItems() const { return NumItems; }
+
+	/** nullptr if the handle is outside the inventory */
+	const FRockInventorySlotEntry* GetSlot(const FRockInventorySlotHandle& SlotHandle) const;
+	/** nullptr if the handle is stale (the item was removed or replaced) or doesn't point at a valid item */
+	const FRockItemStack* GetItem(const FRockItemStackHandle& ItemHandle) const;
+	const FRockItemStack* GetItemBySlot(const FRockInventorySlotHandle& SlotHandle) const;
+
+	/** Visits every valid item, in item index order */
+	void ForEachItem(const TFunctionRef<void(const FRockItemStack&)>& Visitor) const;
+
+private:
+	friend class URockInventory;
+
+	struct FSection
+	{
+		FRockInventorySectionInfo Info;
+		TArray<FRockInventorySlotEntry> Slots;
+	};
+
+	struct FItemPage
+	{
+		TArray<FRockItemStack> Items;
+	};
+
+	const FRockItemStack* GetItemAtIndex(int32 ItemIndex) const;
+
+	TArray<TSharedPtr<const FSection, ESPMode::ThreadSafe>> Sections;
+	TArray<TSharedPtr<const FItemPage, ESPMode::ThreadSafe>> ItemPages;
+	uint32 Version = 0;
+	int32 NumSlots = 0;
+	int32 NumItems = 0;
+};
+
+using FRockInventorySnapshotRef = TSharedRef<const FRockInventorySnapshot, ESPMode::ThreadSafe>;
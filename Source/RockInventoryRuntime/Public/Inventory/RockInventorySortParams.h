@@ -0,0 +1,47 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "RockInventorySortParams.generated.h"
+
+UENUM(BlueprintType)
+enum class ERockInventorySortKey : uint8
+{
+	// First ItemType tag, alphabetical
+	ItemType,
+	// Highest rarity first, ranked by FRockInventorySortParams::RarityOrder
+	Rarity,
+	// Largest footprint first, which also packs tighter
+	Size,
+	// Highest ItemValue first
+	Value,
+	// ItemId, alphabetical
+	ItemId,
+};
+
+USTRUCT(BlueprintType)
+struct ROCKINVENTORYRUNTIME_API FRockInventorySortParams
+{
+	GENERATED_BODY()
+
+	FRockInventorySortParams();
+
+	// Compared in order, ties fall through to the next key. Remaining ties are broken by item id, stack count and the
+	// original slot, so the same inventory always sorts to the same layout
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<ERockInventorySortKey> SortKeys;
+
+	// Only sort this section. When empty, every section that respects item size (the grids, not equipment slots) is sorted
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FGameplayTag SectionTag;
+
+	// Merge partial stacks of the same item before packing
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bConsolidateStacks = true;
+
+	// Lowest to highest. Empty uses Item.Rarity.Common, Uncommon, Rare, Epic, Legendary
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Categories = "Item.Rarity"))
+	TArray<FGameplayTag> RarityOrder;
+};
@@ -0,0 +1,73 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+class URockItemDefinition;
+
+/**
+ * Per definition metadata stored in the cooked item catalog.
+ * Enough to answer ID lookups and common metadata queries without loading the definition asset.
+ */
+struct ROCKINVENTORYRUNTIME_API FRockItemCatalogEntry
+{
+	FName ItemId;
+	FSoftObjectPath AssetPath;
+	int32 DenseId = INDEX_NONE;
+	FGameplayTagContainer ItemType;
+	FGameplayTagContainer ItemTags;
+	FGameplayTag ItemRarity;
+	FIntPoint GridSize = FIntPoint(1, 1);
+	int32 MaxStackCount = 1;
+	int64 Weight = 0;
+
+	static FRockItemCatalogEntry FromDefinition(const URockItemDefinition* Definition, int32 DenseId);
+	/** Returns false (and a reason) if the entry no longer matches the live asset */
+	bool MatchesDefinition(const URockItemDefinition* Definition, FString& OutMismatch) const;
+};
+
+/**
+ * Compact binary catalog of every item definition, emitted at build time by the RockItemCatalog commandlet
+ * and bulk read by the item registry at startup.
+ *
+ * Layout: header (magic, version, counts, source hash), a shared name table (ItemIds, tags and asset paths), then fixed order entries
+ * referencing the name table by packed index. Dense IDs are the entry order, which the registry reuses for its table.
+ *
+ * The file lives outside of the uasset pipeline, so the containing directory has to be staged
+ * (DirectoriesToAlwaysStageAsUFS) for packaged builds.
+ */
+struct ROCKINVENTORYRUNTIME_API FRockItemCatalog
+{
+	static constexpr uint32 Magic = 0x524B4354; // 'RKCT'
+	static constexpr uint32 Version = 2;
+
+	/** HashSourceAssets of every definition asset the catalog was built from, including the ones it skipped */
+	uint32 SourceHash = 0;
+
+	void Reset();
+	bool IsEmpty() const { return Entries.IsEmpty(); }
+	int32 Num() const { return Entries.Num(); }
+
+	/** Adds an entry at the next dense id. */
+	void AddEntry(FRockItemCatalogEntry&& Entry);
+	const FRockItemCatalogEntry* Find(FName ItemId) const;
+	const TArray<FRockItemCatalogEntry>& GetEntries() const { return Entries; }
+
+	bool SaveToFile(const FString& Filename) const;
+	bool LoadFromFile(const FString& Filename);
+	bool Serialize(FArchive& Ar);
+
+	/** Full path of the catalog as configured in the developer settings */
+	static FString GetCatalogFilename();
+	/**
+	 * Order independent hash of a set of definition asset paths. Only needs the asset registry, so the registry can tell
+	 * a catalog built from other assets (added, removed, renamed or moved) without loading anything.
+	 */
+	static uint32 HashSourceAssets(TArray<FSoftObjectPath> AssetPaths);
+
+private:
+	TArray<FRockItemCatalogEntry> Entries;
+	TMap<FName, int32> ItemIdToIndex;
+};
@@ -3,10 +3,15 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "RockItemCatalog.h"
+#include "RockItemDefinitionTable.h"
+#include "RockItemRegistrySnapshot.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "RockItemDefinitionRegistry.generated.h"
 
 class URockItemDefinition;
+struct FStreamableHandle;
 /**
  * A central registry system that manages all available item definitions in the game.
  * This subsystem loads and provides access to all URockItemDefinition assets,
@@ -18,7 +23,14 @@ class ROCKINVENTORYRUNTIME_API URockItemRegistrySubsystem : public UGameInstance
 	GENERATED_BODY()
 
 public:
+	/** Game thread only. Worker threads should use GetSnapshot instead. */
 	static URockItemRegistrySubsystem* GetInstance();
+
+	/**
+	 * Latest published registry snapshot, or nullptr before the registry is built.
+	 * Lock-free and callable from any thread. The pointer stays valid until the publishing registry deinitializes.
+	 */
+	static const FRockItemRegistrySnapshot* GetSnapshot();
 	//~ Begin USubsystem Interface
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
@@ -42,10 +54,38 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Item Registry") // Expose to Blueprint if needed
 	void GetAllDefinitions(TArray<URockItemDefinition*>& OutDefinitions) const;
 
+	/** All definitions that have Tag (or a child of Tag) in their ItemType or ItemTags. */
+	UFUNCTION(BlueprintPure, Category = "Item Registry")
+	void GetDefinitionsWithTag(FGameplayTag Tag, TArray<URockItemDefinition*>& OutDefinitions) const;
+
+	/** All definitions that have every tag in Tags. Cost scales with the rarest tag, not the catalog. */
+	UFUNCTION(BlueprintPure, Category = "Item Registry")
+	void GetDefinitionsWithAllTags(const FGameplayTagContainer& Tags, TArray<URockItemDefinition*>& OutDefinitions) const;
+
+	/** All definitions whose ItemType contains TypeTag (or a child of it). */
+	UFUNCTION(BlueprintPure, Category = "Item Registry")
+	void GetDefinitionsOfType(FGameplayTag TypeTag, TArray<URockItemDefinition*>& OutDefinitions) const;
+
+	/** All definitions with the given ItemRarity. Passing the parent Item.Rarity returns everything with a rarity. */
+	UFUNCTION(BlueprintPure, Category = "Item Registry")
+	void GetDefinitionsOfRarity(FGameplayTag RarityTag, TArray<URockItemDefinition*>& OutDefinitions) const;
+
+	/** Native access to the dense table, for systems that want to work with indices directly */
+	const FRockItemDefinitionTable& GetDefinitionTable() const { return DefinitionTable; }
+
+	/** Cooked metadata for ItemID. Available before the definition itself is loaded, nullptr if no catalog is in use. */
+	const FRockItemCatalogEntry* FindCatalogEntry(FName ItemID) const;
+	bool IsUsingCatalog() const { return !Catalog.IsEmpty(); }
+
 private:
-	/** Map storing ItemId -> ItemDefinition associations for quick lookup. */
+	// Publish snapshots from fabricated catalogs for workers to read
+	friend class FRockItemRegistrySnapshotPublishTest;
+	friend class FRockItemRegistrySnapshotBenchmarkTest;
+	friend class FRockInventorySaveDataBenchmarkTest;
+
+	/** Dense ItemDefinition storage plus the ItemId and tag indices. */
 	UPROPERTY(Transient) // Transient as it's populated at runtime
-	TMap<FName, TObjectPtr<URockItemDefinition>> ItemDefinitionMap;
+	FRockItemDefinitionTable DefinitionTable;
 
 	/** Primary Asset Type for URockItemDefinition as configured in Project Settings. */
 	UPROPERTY() // Allow configuration via DefaultGame.ini if needed
@@ -54,6 +94,26 @@ private:
 	/** Flag to track if the registry has been successfully initialized. */
 	bool bIsInitialized = false;
 
+	/** Cooked catalog loaded at startup, empty if disabled or missing */
+	FRockItemCatalog Catalog;
+
+	/** Keeps the bulk async load of catalog definitions alive */
+	TSharedPtr<FStreamableHandle> CatalogLoadHandle;
+
+	/**
+	 * Every snapshot this registry published. Readers hold raw pointers without refcounting, so retired snapshots
+	 * are only freed on Deinitialize. Rebuilds happen a handful of times per session at most.
+	 */
+	TArray<TUniquePtr<const FRockItemRegistrySnapshot>> PublishedSnapshots;
+
 	/** Internal function to scan and load item definitions using the Asset Manager. */
 	void BuildRegistry();
+	/** Populates the table from the cooked catalog and streams the definitions in the background. */
+	bool BuildRegistryFromCatalog();
+	void OnCatalogDefinitionsLoaded();
+	/** Copies the current table into a new immutable snapshot and swaps it in */
+	void PublishSnapshot();
+	/** Catalog entries can be queried before their definition is streamed in; this loads one on demand. */
+	URockItemDefinition* ResolveDefinition(int32 DenseIndex) const;
+	void ResolveDefinitions(TConstArrayView<int32> Indices, TArray<URockItemDefinition*>& OutDefinitions) const;
 };
@@ -0,0 +1,71 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "RockItemDefinitionTable.generated.h"
+
+class URockItemDefinition;
+struct FRockItemCatalog;
+
+/**
+ * Dense, index addressed table of item definitions.
+ * Definitions live in a contiguous array and are referred to by their dense index.
+ * Tags, ItemType and Rarity each get an inverted index (tag -> sorted dense indices), so filtered
+ * catalog queries cost O(results) instead of a walk over every definition.
+ *
+ * Tags are indexed together with their parents, so a query for Item.Type.Weapon also returns Item.Type.Weapon.Rifle.
+ */
+USTRUCT()
+struct ROCKINVENTORYRUNTIME_API FRockItemDefinitionTable
+{
+	GENERATED_BODY()
+
+public:
+	/** Adds a definition and returns its dense index, or INDEX_NONE if the ItemId is None or already present */
+	int32 Add(URockItemDefinition* Definition);
+	/**
+	 * Builds the ID and tag indices from a cooked catalog. Dense indices match the catalog's DenseId,
+	 * definition slots stay null until SetDefinition is called for them.
+	 */
+	void InitializeFromCatalog(const FRockItemCatalog& Catalog);
+	/** Fills a definition slot reserved by InitializeFromCatalog */
+	void SetDefinition(int32 DenseIndex, URockItemDefinition* Definition);
+	void Reset();
+	/** Shrinks the posting lists once the table is fully built */
+	void Compact();
+
+	int32 Num() const { return Definitions.Num(); }
+	bool IsValidIndex(int32 DenseIndex) const { return Definitions.IsValidIndex(DenseIndex); }
+
+	int32 FindIndex(FName ItemId) const;
+	URockItemDefinition* FindDefinition(FName ItemId) const;
+	URockItemDefinition* GetDefinition(int32 DenseIndex) const;
+	const TArray<TObjectPtr<URockItemDefinition>>& GetDefinitions() const { return Definitions; }
+
+	// Posting lists. Always sorted ascending, empty view if nothing matches.
+	TConstArrayView<int32> GetIndicesWithTag(FGameplayTag Tag) const;
+	TConstArrayView<int32> GetIndicesOfType(FGameplayTag TypeTag) const;
+	TConstArrayView<int32> GetIndicesOfRarity(FGameplayTag RarityTag) const;
+
+	/** Intersects the posting lists of every tag, starting from the shortest one */
+	void GetIndicesWithAllTags(const FGameplayTagContainer& Tags, TArray<int32>& OutIndices) const;
+	/** Union of the posting lists of every tag, without duplicates */
+	void GetIndicesWithAnyTags(const FGameplayTagContainer& Tags, TArray<int32>& OutIndices) const;
+
+	void ResolveIndices(TConstArrayView<int32> Indices, TArray<URockItemDefinition*>& OutDefinitions) const;
+
+private:
+	static void AddToIndex(TMap<FGameplayTag, TArray<int32>>& Index, const FGameplayTagContainer& Tags, int32 DenseIndex);
+	static TConstArrayView<int32> FindInIndex(const TMap<FGameplayTag, TArray<int32>>& Index, FGameplayTag Tag);
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<URockItemDefinition>> Definitions;
+
+	TMap<FName, int32> ItemIdToIndex;
+	// ItemType + ItemTags (GetAllTags), expanded with parents
+	TMap<FGameplayTag, TArray<int32>> TagIndex;
+	TMap<FGameplayTag, TArray<int32>> TypeIndex;
+	TMap<FGameplayTag, TArray<int32>> RarityIndex;
+};
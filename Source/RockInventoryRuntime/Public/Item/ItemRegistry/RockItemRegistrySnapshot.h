@@ -0,0 +1,37 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RockItemCatalog.h"
+#include "RockItemDefinitionTable.h"
+
+/**
+ * Immutable copy of the item registry.
+ * Published atomically by URockItemRegistrySubsystem and readable lock-free from any thread
+ * (task graph workers doing loot scoring, economy sims, etc.).
+ *
+ * Metadata is plain data and always present. Definition pointers can be null while a cooked catalog is still streaming;
+ * the registry publishes a new snapshot once they are loaded. Only read immutable asset data through them.
+ */
+struct ROCKINVENTORYRUNTIME_API FRockItemRegistrySnapshot
+{
+	FRockItemRegistrySnapshot(const FRockItemDefinitionTable& InTable, TArray<FRockItemCatalogEntry>&& InMetadata, uint32 InVersion);
+
+	uint32 GetVersion() const { return Version; }
+	int32 Num() const { return Table.Num(); }
+	const FRockItemDefinitionTable& GetTable() const { return Table; }
+
+	int32 FindIndex(FName ItemId) const { return Table.FindIndex(ItemId); }
+	URockItemDefinition* FindDefinition(FName ItemId) const { return Table.FindDefinition(ItemId); }
+	URockItemDefinition* GetDefinition(int32 DenseIndex) const { return Table.GetDefinition(DenseIndex); }
+
+	const FRockItemCatalogEntry* FindMetadata(FName ItemId) const;
+	const FRockItemCatalogEntry* GetMetadata(int32 DenseIndex) const;
+
+private:
+	const FRockItemDefinitionTable Table;
+	// Indexed by dense index
+	const TArray<FRockItemCatalogEntry> Metadata;
+	const uint32 Version;
+};
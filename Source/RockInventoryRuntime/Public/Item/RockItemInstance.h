@@ -93,6 +93,12 @@ public:
 	/** Gets the item stack associated with this item instance */
 	FRockItemStack GetItemStack() const;
 
+	/**
+	 * Reads/writes the instance state for the inventory save format (FRockInventorySaveData).
+	 * The base version handles Tags, StatTags and the nested inventory. Override to persist extra state, call Super first.
+	 */
+	virtual void SerializeSaveData(FArchive& Ar);
+
 	/** Gets the item definition for this item instance */
 	UFUNCTION(BlueprintCallable, Category = "RockInventory|Core")
 	const URockItemDefinition* GetItemDefinition() const;
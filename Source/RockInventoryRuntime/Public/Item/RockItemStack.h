@@ -39,6 +39,8 @@ private:
 	friend class ARockInventoryWorldItemBase; // I don't like this being here, redesign to not need?
 	friend struct FRockItemFragment_SetStats;
 	friend struct FRockInventoryItemContainer;
+	friend struct FRockInventorySaveData;
+	friend class URockWorldItemConsolidationSubsystem;
 	
 	/** Unique identifier for the item */
 	UPROPERTY(EditAnywhere)
@@ -98,6 +100,8 @@ public:
 
 	bool operator==(const FRockItemStack& Other) const;
 	bool operator!=(const FRockItemStack& Other) const;
+	/** Hash of everything operator== compares. Lets undo data verify an item is unchanged without keeping a copy of it */
+	uint32 GetFingerprint() const;
 	bool IsEmpty() const;
 	void CopyDataFrom(const FRockItemStack& InItemStack);
 
@@ -5,12 +5,14 @@
 #include "CoreMinimal.h"
 #include "Enums/RockEnums.h"
 #include "Inventory/RockInventorySectionInfo.h"
+#include "Inventory/RockInventorySortParams.h"
 #include "Inventory/RockSlotHandle.h"
 #include "Item/RockItemStack.h"
 #include "Item/RockMoveItemParams.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "RockInventoryLibrary.generated.h"
 
+class AController;
 class URockInventoryComponent;
 class URockInventory;
 
@@ -56,6 +58,31 @@ public:
 		URockInventory* TargetInventory, const FRockInventorySlotHandle& TargetSlotHandle,
 		const FRockMoveItemParams& InMoveParams = FRockMoveItemParams());
 
+	/**
+	 * Move everything from one inventory to another in a single pass, e.g. 'take all' from a crate or corpse.
+	 * Stacks are first merged into matching partial stacks of the target, the rest is placed using one shared occupancy grid.
+	 * Replication dirtying and change broadcasts are batched: each touched item and slot is reported once, after the transfer.
+	 * @param SourceInventory - The inventory to empty
+	 * @param TargetInventory - The inventory receiving the items
+	 * @param Instigator - Slots claimed by another controller are left alone
+	 * @param OutMovedCount - Number of items (not stacks) moved
+	 * @param OutLeftoverSlots - Source slots still holding an item that didn't (fully) fit
+	 * @return true if anything was moved
+	 */
+	static bool TransferAllItems(
+		URockInventory* SourceInventory, URockInventory* TargetInventory, AController* Instigator,
+		int32& OutMovedCount, TArray<FRockInventorySlotHandle>& OutLeftoverSlots);
+
+	/**
+	 * Sort and compact an inventory. The complete layout is planned up front and only applied if every item fits,
+	 * so the inventory is either fully sorted or left untouched.
+	 * @param Inventory - The inventory to sort
+	 * @param Params - Ordering keys, which sections to sort and whether to consolidate partial stacks
+	 * @param Instigator - Sorting is refused while another controller has a slot claimed in the sorted sections
+	 * @return true if the inventory was sorted
+	 */
+	static bool SortInventory(URockInventory* Inventory, const FRockInventorySortParams& Params, AController* Instigator);
+
 	// Misc helpers
 
 	static bool CanMergeItemAtGridPosition(
@@ -17,7 +17,7 @@ class ROCKINVENTORYRUNTIME_API URockItemStackLibrary : public UBlueprintFunction
 {
 	GENERATED_BODY()
 public:
-	/** Returns the item definition for this item stack */
+	/** Returns the item definition for this item ID. Safe off the game thread, but only resolves definitions already in the registry snapshot there. */
 	UFUNCTION(BlueprintCallable, Category = "RockInventory|ItemStack")
 	static URockItemDefinition* GetItemDefinitionById(const FName& ItemId);
 
@@ -0,0 +1,93 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Inventory/RockInventoryQuery.h"
+#include "Inventory/RockSlotHandle.h"
+#include "Item/RockItemStack.h"
+#include "Item/RockItemStackHandle.h"
+#include "RockLootScoring.generated.h"
+
+class AActor;
+class FRockInventorySnapshot;
+class URockInventory;
+
+/**
+ * Something that can be looted from: an inventory (container, corpse) or a single world item.
+ * Captured on the game thread, after which it can be read from any thread.
+ */
+struct ROCKINVENTORYRUNTIME_API FRockLootSource
+{
+	static FRockLootSource FromInventory(URockInventory* Inventory, const FVector& Location);
+	/** Any actor implementing IRockLootableInterface, e.g. ARockInventoryWorldItemBase */
+	static FRockLootSource FromWorldItem(AActor* WorldItem);
+
+	TWeakObjectPtr<URockInventory> Inventory;
+	TSharedPtr<const FRockInventorySnapshot, ESPMode::ThreadSafe> Snapshot;
+
+	TWeakObjectPtr<AActor> WorldItem;
+	FRockItemStack WorldItemStack;
+
+	FVector Location = FVector::ZeroVector;
+};
+
+/** Returns how much the requester wants the item, <= 0 skips it. Runs on worker threads, so it must only read its inputs */
+using FRockLootScoreFunction = TFunction<float(const FRockItemStack& Item, const FRockLootSource& Source)>;
+
+/** One requester (e.g. a bot) asking for its best K items among the sources */
+struct ROCKINVENTORYRUNTIME_API FRockLootScoringRequest
+{
+	FRockLootScoreFunction ScoreFunction;
+
+	/**
+	 * Optional, evaluated like URockInventory::ForEachSlot. World items only see the ItemPredicate.
+	 * The predicates run on worker threads as well
+	 */
+	FRockInventoryQuery Filter;
+
+	FVector Location = FVector::ZeroVector;
+	/** Sources further away are skipped. 0 for no limit */
+	float MaxDistance = 0.0f;
+
+	/** K */
+	int32 MaxResults = 8;
+};
+
+USTRUCT(BlueprintType)
+struct ROCKINVENTORYRUNTIME_API FRockLootCandidate
+{
+	GENERATED_BODY()
+
+	/** Index into the sources passed to ScoreLoot */
+	UPROPERTY(BlueprintReadOnly)
+	int32 SourceIndex = INDEX_NONE;
+
+	/** Invalid for world items */
+	UPROPERTY(BlueprintReadOnly)
+	FRockInventorySlotHandle SlotHandle;
+
+	UPROPERTY(BlueprintReadOnly)
+	FRockItemStackHandle ItemHandle;
+
+	UPROPERTY(BlueprintReadOnly)
+	float Score = 0.0f;
+};
+
+namespace RockLootScoring
+{
+	/**
+	 * Scores every item of every source for every request on worker threads, and returns each request's best MaxResults candidates,
+	 * highest score first (OutResults[RequestIndex]). Ties keep source order, so the result is deterministic.
+	 * Blocks until done, and can be called from a worker too: the sources are copies, the inventories may keep changing meanwhile.
+	 */
+	ROCKINVENTORYRUNTIME_API void ScoreLoot(
+		TConstArrayView<FRockLootSource> Sources, TConstArrayView<FRockLootScoringRequest> Requests, TArray<TArray<FRockLootCandidate>>& OutResults);
+
+	/** ItemValue per kilogram, the density that matters for a weight limited inventory. The stack size doesn't change it */
+	ROCKINVENTORYRUNTIME_API FRockLootScoreFunction ValuePerWeight();
+
+	/** Sum of the weights of the tags the item has (URockItemDefinition::GetAllTags, parent tags match), times the stack count if bPerUnit */
+	ROCKINVENTORYRUNTIME_API FRockLootScoreFunction TagNeed(TMap<FGameplayTag, float> TagWeights, bool bPerUnit = false);
+}
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
+#include "Transactions/Core/RockTransactionRateLimiter.h"
 #include "RockInventoryDeveloperSettings.generated.h"
 
 
@@ -33,9 +34,129 @@ public:
 	UPROPERTY(EditDefaultsOnly, Config, Category = "RockInventory|Visuals")
 	TSoftObjectPtr<UStaticMesh> FallbackWorldItemMesh;
 
+	// Cell size of the grid URockWorldItemGridSubsystem sorts world items into.
+	// Around the typical query radius works best: a query then only visits a handful of cells
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|World", meta = (ClampMin = "50", Units = "cm"))
+	float WorldItemGridCellSize = 1000.0f;
+
+	// Server side: periodically merge identical dropped world items lying close together into one actor,
+	// see URockWorldItemConsolidationSubsystem
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|World")
+	bool bEnableWorldItemConsolidation = false;
+
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|World", meta = (EditCondition = "bEnableWorldItemConsolidation", ClampMin = "0", Units = "cm"))
+	float WorldItemConsolidationRadius = 150.0f;
+
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|World", meta = (EditCondition = "bEnableWorldItemConsolidation", ClampMin = "0", Units = "s"))
+	float WorldItemConsolidationInterval = 1.0f;
+
+	// Candidates looked at per interval, the rest wait for the next one
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|World", meta = (EditCondition = "bEnableWorldItemConsolidation", ClampMin = "1"))
+	int32 MaxWorldItemConsolidationsPerInterval = 64;
+
+	// Server side: store resting world items as entries of a few ARockWorldItemCluster actors instead of one actor each,
+	// see URockWorldItemClusterSubsystem
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|World")
+	bool bEnableWorldItemClusters = false;
+
+	// Each cluster covers a square cell of this size. Larger means fewer actors, but more entries resent when one changes
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|World", meta = (EditCondition = "bEnableWorldItemClusters", ClampMin = "100", Units = "cm"))
+	float WorldItemClusterSize = 5000.0f;
+
+	// A promoted world item that comes to rest without physics (so no sleep event) goes back into its cluster after this long.
+	// Keeps items promoted for a loot that never happened from piling up as actors. 0 to keep them as actors
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|World", meta = (EditCondition = "bEnableWorldItemClusters", ClampMin = "0", Units = "s"))
+	float WorldItemClusterDemoteDelay = 30.0f;
+
+	// Measured from the cluster's center, so keep it well above WorldItemClusterSize
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|World", meta = (EditCondition = "bEnableWorldItemClusters", ClampMin = "0", Units = "cm"))
+	float WorldItemClusterNetCullDistance = 15000.0f;
+
+	// Frame time URockWorldItemSpawnSubsystem may spend spawning queued world items, at least one is spawned per frame
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|World", meta = (ClampMin = "0", Units = "ms"))
+	float WorldItemSpawnBudgetMs = 1.0f;
+
 	UPROPERTY(EditAnywhere, Config, Category = "Thumbnail")
 	ERockThumbnailMode ItemDefinitionThumbnailMode = ERockThumbnailMode::Default;
 
+	// Use the cooked item catalog (generated by the RockItemCatalog commandlet) to populate the item registry at startup.
+	// Falls back to scanning the asset manager if the catalog is missing, unreadable or its entry count disagrees with the asset manager.
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Registry")
+	bool bUseItemCatalog = true;
+
+	// Relative to the project Content directory. Remember to add the directory to DirectoriesToAlwaysStageAsUFS.
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Registry", meta = (EditCondition = "bUseItemCatalog"))
+	FString ItemCatalogPath = TEXT("RockInventory/ItemCatalog.bin");
+
+	// Server side autosave of tracked inventories. Changed inventories are captured on the game thread and
+	// serialized, compressed and written on background tasks.
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Persistence")
+	bool bEnableInventoryAutosave = false;
+
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Persistence", meta = (EditCondition = "bEnableInventoryAutosave", ClampMin = "0", Units = "s"))
+	float InventoryAutosaveInterval = 60.0f;
+
+	// Inventories encoded and written per background task.
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Persistence", meta = (ClampMin = "1"))
+	int32 InventoryAutosaveBatchSize = 32;
+
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Persistence")
+	bool bCompressInventorySnapshots = true;
+
+	// Server side write-ahead journal of inventory changes, replayed on top of the last snapshot after a crash.
+	// Transactions are only journaled by manager components with bJournalTransactions enabled.
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Persistence")
+	bool bEnableInventoryJournal = false;
+
+	// Relative to the project Saved directory. Holds the journal and the per inventory snapshots.
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Persistence")
+	FString InventoryPersistenceDirectory = TEXT("RockInventory");
+
+	// Flush the journal to disk after every record. Disabling trades durability of the last few records for throughput.
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Persistence", meta = (EditCondition = "bEnableInventoryJournal"))
+	bool bFlushJournalEveryRecord = true;
+
+	// Seconds between compactions (snapshot every journaled inventory, then truncate the journal). 0 disables the timer.
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Persistence", meta = (EditCondition = "bEnableInventoryJournal", ClampMin = "0", Units = "s"))
+	float JournalCompactionInterval = 300.0f;
+
+	// Compact early once the journal grows past this size.
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Persistence", meta = (EditCondition = "bEnableInventoryJournal", ClampMin = "1", Units = "KB"))
+	int32 JournalCompactionSizeKB = 8192;
+
+	// Server side token buckets per player controller, checked before any inventory work. Flooding clients get their
+	// requests rejected instead of burning server time.
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Networking")
+	bool bEnableTransactionRateLimiting = true;
+
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Networking", meta = (EditCondition = "bEnableTransactionRateLimiting"))
+	FRockTokenBucketConfig DefaultTransactionRateLimit;
+
+	// Request kinds that don't use the default limit
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Networking", meta = (EditCondition = "bEnableTransactionRateLimiting"))
+	TMap<ERockRateLimitedRequest, FRockTokenBucketConfig> TransactionRateLimitOverrides;
+
+	// Server side: run transaction RPCs from a queue with a per frame time budget instead of inline,
+	// see URockInventoryTransactionQueueSubsystem
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Networking")
+	bool bEnableTransactionQueue = false;
+
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Networking", meta = (EditCondition = "bEnableTransactionQueue", ClampMin = "0", Units = "ms"))
+	float TransactionQueueBudgetMs = 2.0f;
+
+	// Further transactions from the controller are rejected until the queue drains
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Networking", meta = (EditCondition = "bEnableTransactionQueue", ClampMin = "1"))
+	int32 MaxQueuedTransactionsPerController = 128;
+
+	// Queued transactions on unrelated inventories run concurrently on worker threads.
+	// Only moves, transfer all and sort without RuntimeInstances qualify, everything else stays on the game thread
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Networking", meta = (EditCondition = "bEnableTransactionQueue"))
+	bool bParallelTransactionExecution = false;
+
+	// Below this many independent groups a wave isn't worth the task overhead and runs on the game thread
+	UPROPERTY(EditAnywhere, Config, Category = "RockInventory|Networking", meta = (EditCondition = "bEnableTransactionQueue && bParallelTransactionExecution", ClampMin = "2"))
+	int32 MinParallelTransactionGroups = 4;
+
 #if WITH_EDITOR
 	// data validator
 	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
@@ -0,0 +1,106 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Inventory/RockInventorySlot.h"
+#include "Persistence/RockInventorySaveData.h"
+
+class IFileHandle;
+class URockInventory;
+
+/**
+ * One journal entry: after-images of every item stack and slot an inventory changed since its previous record.
+ * Replaying records in order on top of the inventory's last snapshot reproduces its latest state, and since records
+ * carry full after-images (not deltas) replaying one twice is harmless.
+ */
+struct ROCKINVENTORYRUNTIME_API FRockInventoryJournalRecord
+{
+	FGuid InventoryId;
+	uint64 Sequence = 0;
+	TArray<int32> ItemIndices;
+	TArray<FRockItemStackSaveData> Items;
+	TArray<FRockInventorySlotEntry> Slots;
+
+	bool IsEmpty() const { return Items.IsEmpty() && Slots.IsEmpty(); }
+
+	/** Consumes the inventory's changed indices and captures their current state. Game thread only */
+	static FRockInventoryJournalRecord Capture(URockInventory* Inventory);
+	void Serialize(FArchive& Ar);
+	/** Writes the after-images back into Inventory, marking them dirty and broadcasting. Game thread only */
+	bool Apply(URockInventory* Inventory) const;
+};
+
+struct ROCKINVENTORYRUNTIME_API FRockInventoryJournalStats
+{
+	int64 RecordsAppended = 0;
+	int64 BytesAppended = 0;
+	/** Capture + encode + write time spent in Append */
+	double AppendSeconds = 0.0;
+
+	double GetRecordsPerSecond() const { return AppendSeconds > 0.0 ? RecordsAppended / AppendSeconds : 0.0; }
+	double GetBytesPerSecond() const { return AppendSeconds > 0.0 ? BytesAppended / AppendSeconds : 0.0; }
+};
+
+/**
+ * Append-only write-ahead journal of inventory changes, meant to sit between (expensive) full snapshots.
+ *
+ * Layout: magic, version, then frames of [payload size][CRC32 of payload][payload]. A crash can leave the last frame
+ * partially written; readers stop at the first frame that is truncated or fails its CRC, and Open cuts that tail off
+ * so new records are never appended behind garbage.
+ *
+ * Not thread safe, owned and driven by the game thread (see URockInventoryPersistenceSubsystem).
+ */
+class ROCKINVENTORYRUNTIME_API FRockInventoryJournal
+{
+public:
+	static constexpr uint32 Magic = 0x524B4A4C; // 'RKJL'
+	static constexpr uint32 Version = 1;
+	static constexpr int64 HeaderSize = sizeof(uint32) * 2;
+
+	~FRockInventoryJournal();
+
+	/**
+	 * Opens (or creates) the journal for appending. Intact records already in the file are returned through
+	 * OutExistingRecords so the caller can recover from them. A file with an unreadable or newer header is moved aside
+	 * (<Filename>.rejected-<timestamp>) rather than overwritten, and Open fails if that isn't possible.
+	 * @param bInFlushEveryRecord - Flush to disk after every record. Slower, but a crash can only lose the record being written.
+	 */
+	bool Open(const FString& InFilename, bool bInFlushEveryRecord, TArray<FRockInventoryJournalRecord>* OutExistingRecords = nullptr);
+	void Close();
+	bool IsOpen() const { return FileHandle.IsValid(); }
+
+	/** Assigns the record its sequence number and appends it */
+	bool Append(FRockInventoryJournalRecord& Record);
+	/** Captures and appends everything Inventory changed since its last record, if anything. Returns false if the write failed */
+	bool AppendChanges(URockInventory* Inventory);
+	void Flush();
+
+	/** Truncates the journal back to its header. Only call once snapshots cover every record */
+	bool Reset();
+
+	int64 GetSize() const { return Size; }
+	int32 GetNumRecords() const { return NumRecords; }
+	const FString& GetFilename() const { return Filename; }
+	const FRockInventoryJournalStats& GetStats() const { return Stats; }
+
+	/**
+	 * Reads every intact record of a journal file.
+	 * @param OutValidSize - Byte offset where the intact data ends, anything after it is a torn or corrupt tail.
+	 * @return false if the file is missing or has an unknown header.
+	 */
+	static bool ReadRecords(const FString& InFilename, TArray<FRockInventoryJournalRecord>& OutRecords, int64& OutValidSize);
+
+private:
+	bool WriteHeader();
+
+	FString Filename;
+	TUniquePtr<IFileHandle> FileHandle;
+	/** Reused across appends so a record costs no allocation once warmed up */
+	TArray<uint8> FrameBuffer;
+	uint64 NextSequence = 1;
+	int64 Size = 0;
+	int32 NumRecords = 0;
+	bool bFlushEveryRecord = true;
+	FRockInventoryJournalStats Stats;
+};
@@ -0,0 +1,128 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Persistence/RockInventoryJournal.h"
+#include "Persistence/RockInventoryWriteBehindQueue.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RockInventoryPersistenceSubsystem.generated.h"
+
+class URockInventory;
+
+/**
+ * Server side persistence for inventories: per inventory snapshots written behind the game thread
+ * (FRockInventoryWriteBehindQueue) plus an optional append-only journal (FRockInventoryJournal) of the changes in between.
+ *
+ * - TrackInventory registers a top level inventory for autosave. Every autosave interval, the inventories that changed
+ *   since their last save are captured on the game thread and written in batches on background tasks.
+ * - JournalChanges appends whatever an inventory changed since its last record, the manager component calls it after
+ *   every executed transaction when bJournalTransactions is set.
+ * - RecoverInventory loads an inventory's snapshot and replays its journal records on top, nested inventories included.
+ * - Compact snapshots every changed inventory, waits for the writes and truncates the journal. It runs on a timer,
+ *   when the journal grows too large and on shutdown.
+ *
+ * Inventories are identified by their PersistentId, so the game is expected to restore that (through the save data)
+ * before calling RecoverInventory. URockInventoryComponent does both when its PersistentId is set before BeginPlay.
+ */
+UCLASS()
+class ROCKINVENTORYRUNTIME_API URockInventoryPersistenceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+public:
+	bool IsPersistenceEnabled() const { return WriteBehind.IsValid(); }
+	bool IsJournalEnabled() const { return Journal.IsOpen(); }
+
+	/** Starts autosaving the inventory (its top level inventory, to be precise) whenever it changes */
+	void TrackInventory(URockInventory* Inventory);
+
+	/** Appends the changes Inventory made since its last record. Cheap no-op if nothing changed */
+	bool JournalChanges(URockInventory* Inventory);
+
+	/**
+	 * Restores Inventory from its last snapshot (if any) and replays its pending journal records on top.
+	 * Blocks the game thread: pending snapshot writes are flushed and waited on first so the read can't see an older
+	 * snapshot, then the snapshot is read and decoded synchronously. Meant for load time, not for the middle of a match.
+	 * @return true if a snapshot or any journal record was applied.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "RockInventory|Persistence")
+	bool RecoverInventory(URockInventory* Inventory);
+
+	/** Queues a final snapshot if the inventory changed and stops tracking it, e.g. when its owner leaves the world */
+	void ReleaseInventory(URockInventory* Inventory);
+
+	/**
+	 * Tracks the inventory and snapshots it right away instead of at the next autosave, for changes a crash must not undo
+	 * (e.g. everything leaving in one go). With the journal open this compacts, so no older record can be replayed over
+	 * the new snapshot, and blocks until the snapshots are written.
+	 */
+	void SaveInventoryNow(URockInventory* Inventory);
+
+	/** Captures every tracked inventory that changed since its last save and hands them to the background writer */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "RockInventory|Persistence")
+	void Autosave();
+
+	/** Snapshots every changed inventory and truncates the journal once they are on disk. Records not yet recovered, or of inventories destroyed without ReleaseInventory, are carried over */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "RockInventory|Persistence")
+	bool Compact();
+
+	/** Replaces the storage backend (file per inventory by default). In flight writes finish on the old one first */
+	void SetStorageBackend(TSharedRef<IRockInventoryStorageBackend, ESPMode::ThreadSafe> InBackend);
+
+	const FRockInventoryJournalStats& GetJournalStats() const { return Journal.GetStats(); }
+	FRockInventoryWriteBehindStats GetWriteBehindStats() const;
+	/** Game thread time spent capturing snapshots */
+	double GetCaptureSeconds() const { return CaptureSeconds; }
+
+	/** Journal records and snapshots belong to the top level inventory, which nested inventories are saved inline with */
+	static URockInventory* GetRootInventory(URockInventory* Inventory);
+	/** Changes whenever the inventory or any inventory nested in it changes */
+	static uint32 GetChangeFingerprint(const URockInventory* Inventory);
+	/** Adds the persistent ids of the inventory and every inventory nested in it */
+	static void GatherPersistentIds(const URockInventory* Inventory, TSet<FGuid>& OutIds);
+
+private:
+	struct FTrackedInventory
+	{
+		TWeakObjectPtr<URockInventory> Inventory;
+		/** Fingerprint at the last capture */
+		uint32 SavedFingerprint = 0;
+		bool bSaved = false;
+	};
+
+	/** Replays the pending records of Inventory and then of its nested inventories */
+	bool ApplyPendingRecords(URockInventory* Inventory);
+	/** Captures and enqueues every dirty tracked inventory. Returns how many were captured */
+	int32 CaptureDirtyInventories();
+	void CaptureInventory(URockInventory* Inventory, FTrackedInventory& Tracked);
+	/** Moves the journal records no tracked inventory covers into PendingRecords, so compaction keeps them. False if the journal can't be read back */
+	bool CarryOverUntrackedRecords();
+
+	FRockInventoryJournal Journal;
+	TUniquePtr<FRockInventoryWriteBehindQueue> WriteBehind;
+	FString PersistenceDirectory;
+	int64 CompactionSizeBytes = 0;
+	int32 BatchSize = 32;
+	bool bCompressSnapshots = true;
+	double CaptureSeconds = 0.0;
+
+	/** Records read back at startup, keyed by inventory and kept in sequence order until their inventory is recovered */
+	TMap<FGuid, TArray<FRockInventoryJournalRecord>> PendingRecords;
+
+	/** Top level inventories to snapshot when they change */
+	TMap<FGuid, FTrackedInventory> TrackedInventories;
+	/** A tracked inventory was destroyed without ReleaseInventory since the last compaction, its records have no snapshot */
+	bool bLostTrackedInventory = false;
+
+	FTimerHandle AutosaveTimerHandle;
+	FTimerHandle CompactionTimerHandle;
+};
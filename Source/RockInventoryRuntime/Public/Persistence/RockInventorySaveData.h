@@ -0,0 +1,91 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Inventory/RockInventorySectionInfo.h"
+#include "Inventory/RockInventorySlot.h"
+
+class URockInventory;
+class URockItemInstance;
+
+/** Bump when the binary layout changes. Readers accept any version up to LatestVersion. */
+enum class ERockInventorySaveVersion : uint32
+{
+	Initial = 1,
+	// Inventory PersistentId, so journal records can be matched to their snapshot
+	PersistentId,
+
+	// -----<new versions can be added above this line>-----
+	VersionPlusOne,
+	LatestVersion = VersionPlusOne - 1
+};
+
+/** ItemIds repeat across stacks, so stacks reference them by index into a table written once per blob */
+struct ROCKINVENTORYRUNTIME_API FRockSaveNameTable
+{
+	TArray<FName> Names;
+	TMap<FName, int32> Lookup;
+
+	int32 Add(FName Name);
+	void Serialize(FArchive& Ar);
+};
+
+/** Plain-data copy of one item stack, safe to hold and encode off the game thread */
+struct ROCKINVENTORYRUNTIME_API FRockItemStackSaveData
+{
+	FName ItemId;
+	int32 StackCount = 0;
+	int32 CustomValue1 = 0;
+	int32 CustomValue2 = 0;
+	uint8 Generation = 0;
+	bool bValid = false;
+	bool bInitialized = false;
+
+	/** Runtime instance class and its pre-serialized state (see URockItemInstance::SerializeSaveData), empty if none */
+	FSoftClassPath InstanceClass;
+	TArray<uint8> InstanceState;
+};
+
+/**
+ * Compact, versioned binary snapshot of a URockInventory: sections, slots, item stacks, custom values,
+ * runtime instance state and (through the instances) nested inventories.
+ *
+ * Saving is split in two so the expensive part can run anywhere:
+ *  - Capture() copies the inventory into plain data. Game thread only, since it touches runtime instances.
+ *  - Serialize() encodes/decodes that data. Thread safe.
+ *  - Restore() bulk-writes decoded data back into an inventory in a single pass. Game thread only.
+ *
+ * Layout: magic, version, inventory id, sections (tagged), slots (item index + flags), an ItemId table, then items referencing it.
+ * Item handles are not stored; they are rebuilt from each item's index and generation.
+ */
+struct ROCKINVENTORYRUNTIME_API FRockInventorySaveData
+{
+	static constexpr uint32 Magic = 0x524B4956; // 'RKIV'
+
+	/** The inventory's PersistentId. Restoring applies it too, so a snapshot should only be loaded into one inventory at a time */
+	FGuid InventoryId;
+	TArray<FRockInventorySectionInfo> Sections;
+	TArray<FRockInventorySlotEntry> Slots;
+	TArray<FRockItemStackSaveData> Items;
+
+	static FRockInventorySaveData Capture(const URockInventory* Inventory);
+	bool Serialize(FArchive& Ar);
+	/** Replaces the entire contents of Inventory. Returns false (leaving it untouched) if the data doesn't fit it */
+	bool Restore(URockInventory* Inventory) const;
+
+	/** Convenience: Capture + Serialize into bytes */
+	static bool SaveInventory(const URockInventory* Inventory, TArray<uint8>& OutBytes);
+	/** Convenience: Serialize from bytes + Restore */
+	static bool LoadInventory(URockInventory* Inventory, TConstArrayView<uint8> Bytes);
+
+	/** Captures an item stack. Used by the save format itself and by anything journaling individual stacks */
+	static FRockItemStackSaveData CaptureItem(const FRockItemStack& ItemStack);
+	/** Items must have been added to NameTable before saving, and the table read before loading */
+	static void SerializeItem(FArchive& Ar, FRockItemStackSaveData& Item, FRockSaveNameTable& NameTable);
+	/**
+	 * Rebuilds the live item stack at Index, including its runtime instance. Does not mark dirty or broadcast.
+	 * Returns false if the stack had to be dropped (unknown ItemId); the slot is left empty in that case.
+	 */
+	static bool RestoreItem(URockInventory* Inventory, int32 Index, const FRockItemStackSaveData& Item);
+};
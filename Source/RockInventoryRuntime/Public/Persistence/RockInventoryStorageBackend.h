@@ -0,0 +1,43 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** One persisted inventory blob, as produced by FRockInventoryWriteBehindQueue::EncodeBlob */
+struct FRockInventoryStorageRecord
+{
+	FGuid InventoryId;
+	TArray<uint8> Bytes;
+};
+
+/**
+ * Where persisted inventory blobs end up (a file per inventory, a single local database file, ...).
+ * Written to from background tasks, so implementations must be thread safe.
+ */
+class ROCKINVENTORYRUNTIME_API IRockInventoryStorageBackend
+{
+public:
+	virtual ~IRockInventoryStorageBackend() = default;
+
+	/** Writes a batch of records, each one entirely or not at all. Returns how many were written */
+	virtual int32 WriteBatch(TConstArrayView<FRockInventoryStorageRecord> Records) = 0;
+	virtual bool Read(const FGuid& InventoryId, TArray<uint8>& OutBytes) = 0;
+	virtual bool Remove(const FGuid& InventoryId) = 0;
+};
+
+/** One file per inventory, named after its PersistentId. Files are written next to their target and renamed into place */
+class ROCKINVENTORYRUNTIME_API FRockInventoryFileStorageBackend : public IRockInventoryStorageBackend
+{
+public:
+	explicit FRockInventoryFileStorageBackend(const FString& InDirectory);
+
+	virtual int32 WriteBatch(TConstArrayView<FRockInventoryStorageRecord> Records) override;
+	virtual bool Read(const FGuid& InventoryId, TArray<uint8>& OutBytes) override;
+	virtual bool Remove(const FGuid& InventoryId) override;
+
+	FString GetFilename(const FGuid& InventoryId) const;
+
+private:
+	FString Directory;
+};
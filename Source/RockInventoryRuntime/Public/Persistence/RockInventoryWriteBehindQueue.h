@@ -0,0 +1,71 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Persistence/RockInventorySaveData.h"
+#include "Persistence/RockInventoryStorageBackend.h"
+#include "Tasks/Task.h"
+#include <atomic>
+
+struct FRockInventoryWriteBehindStats
+{
+	int64 InventoriesWritten = 0;
+	int64 BytesWritten = 0;
+	int64 FailedWrites = 0;
+	/** Encode + compress + write time, summed over every background task */
+	double BackgroundSeconds = 0.0;
+
+	double GetBytesPerSecond() const { return BackgroundSeconds > 0.0 ? BytesWritten / BackgroundSeconds : 0.0; }
+};
+
+/**
+ * Moves inventory saving off the game thread.
+ *
+ * The game thread only captures (FRockInventorySaveData::Capture, a plain data copy) and enqueues. Submit hands the
+ * queue to background tasks in batches, which encode, compress and write through the storage backend.
+ * Batches of one Submit run in parallel (an inventory is only ever in one of them), while a Submit waits for the
+ * previous one so an older snapshot can never overwrite a newer one.
+ */
+class ROCKINVENTORYRUNTIME_API FRockInventoryWriteBehindQueue
+{
+public:
+	explicit FRockInventoryWriteBehindQueue(TSharedRef<IRockInventoryStorageBackend, ESPMode::ThreadSafe> InBackend);
+	~FRockInventoryWriteBehindQueue();
+
+	/** Queues a captured snapshot, replacing a not yet submitted one of the same inventory. Game thread only */
+	void Enqueue(FRockInventorySaveData&& SaveData);
+	/** Starts writing everything queued, BatchSize inventories per background task. Game thread only */
+	void Submit(int32 BatchSize, bool bCompress);
+	/** Blocks until every submitted write has finished */
+	void WaitForCompletion();
+
+	int32 GetNumQueued() const { return Queued.Num(); }
+	bool HasWritesInFlight() const;
+	FRockInventoryWriteBehindStats GetStats() const;
+
+	IRockInventoryStorageBackend& GetBackend() const { return *Backend; }
+	/** Waits for in flight writes before swapping, so nothing lands in the old backend afterwards */
+	void SetBackend(TSharedRef<IRockInventoryStorageBackend, ESPMode::ThreadSafe> InBackend);
+
+	/** Serializes (and optionally compresses) save data into a storage blob. Thread safe */
+	static bool EncodeBlob(FRockInventorySaveData& SaveData, bool bCompress, TArray<uint8>& OutBytes);
+	/** Turns a storage blob back into FRockInventorySaveData bytes, accepting both compressed and raw blobs. Fails on an implausible uncompressed size */
+	static bool DecodeBlob(TConstArrayView<uint8> Bytes, TArray<uint8>& OutSaveBytes);
+
+private:
+	using FSaveDataRef = TSharedRef<FRockInventorySaveData, ESPMode::ThreadSafe>;
+
+	void WriteBatch(TConstArrayView<FSaveDataRef> Batch, bool bCompress);
+
+	TSharedRef<IRockInventoryStorageBackend, ESPMode::ThreadSafe> Backend;
+
+	TArray<FSaveDataRef> Queued;
+	TMap<FGuid, int32> QueuedIndices;
+	TArray<UE::Tasks::FTask> InFlight;
+
+	std::atomic<int64> InventoriesWritten{0};
+	std::atomic<int64> BytesWritten{0};
+	std::atomic<int64> FailedWrites{0};
+	std::atomic<uint64> BackgroundCycles{0};
+};
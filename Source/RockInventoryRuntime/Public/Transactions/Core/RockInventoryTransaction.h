@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Inventory/RockSlotHandle.h"
 #include "UObject/Object.h"
 
 #include "RockInventoryTransaction.generated.h"
@@ -21,4 +22,33 @@ struct ROCKINVENTORYRUNTIME_API FRockItemTransactionBase
 	int32 TransactionID = 0;
 
 	void GenerateNewHandle();
+
+	/** Shared part of the transactions' NetSerialize: the instigator reference and a packed transaction id */
+	void NetSerializeBase(FArchive& Ar, UPackageMap* Map);
 };
+
+/**
+ * Compact wire encoding helpers for the transaction structs' NetSerialize.
+ * Transactions are small and sent often, so ids, counts and slot indices are variable length encoded
+ * (most take a single byte) and repeated object references are sent once.
+ */
+namespace RockTransactionNet
+{
+	/** Slot indices are small and non negative, or INDEX_NONE. One byte below 127 slots */
+	ROCKINVENTORYRUNTIME_API void SerializeSlotHandle(FArchive& Ar, FRockInventorySlotHandle& SlotHandle);
+	/** Counts where anything below 0 means 'unset' (e.g. MoveCount) */
+	ROCKINVENTORYRUNTIME_API void SerializeOptionalCount(FArchive& Ar, int32& Count);
+	/** An object the receiver can't resolve loads as null, which the transaction's CanExecute then rejects */
+	ROCKINVENTORYRUNTIME_API void SerializeObject(FArchive& Ar, UPackageMap* Map, UClass* ObjectClass, UObject*& Object);
+
+	template <typename T>
+	void SerializeObject(FArchive& Ar, UPackageMap* Map, TObjectPtr<T>& Object)
+	{
+		UObject* RawObject = Object.Get();
+		SerializeObject(Ar, Map, T::StaticClass(), RawObject);
+		if (Ar.IsLoading())
+		{
+			Object = Cast<T>(RawObject);
+		}
+	}
+}
@@ -0,0 +1,74 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StructUtils/InstancedStruct.h"
+#include "RockInventoryTransactionBatch.generated.h"
+
+UENUM(BlueprintType)
+enum class ERockTransactionExecuteResult : uint8
+{
+	/** CanExecute failed, nothing was touched */
+	Rejected,
+	/** Executed, but the transaction itself failed */
+	Failed,
+	Succeeded,
+};
+
+/**
+ * An ordered list of transactions sent to the server in a single RPC (URockInventoryManagerComponent::ExecuteTransactionBatch).
+ * Entries are executed in order. Supported entries: FRockMoveItemTransaction, FRockLootWorldItemTransaction, FRockDropItemTransaction,
+ * FRockTransferAllTransaction, FRockSortInventoryTransaction.
+ */
+USTRUCT(BlueprintType)
+struct ROCKINVENTORYRUNTIME_API FRockInventoryTransactionBatch
+{
+	GENERATED_BODY()
+
+	/** Assigned by ExecuteTransactionBatch when left at 0, echoed back in the result */
+	UPROPERTY(BlueprintReadOnly)
+	int32 BatchID = 0;
+
+	/**
+	 * All or nothing: the first failing entry rolls back every entry executed before it.
+	 * Only undoable transactions (moves) are allowed in an atomic batch.
+	 * When false, every entry is executed independently and failures are reported per entry.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bAtomic = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FInstancedStruct> Transactions;
+
+	template <typename TransactionT>
+	void Add(const TransactionT& Transaction)
+	{
+		Transactions.Add(FInstancedStruct::Make(Transaction));
+	}
+
+	int32 Num() const { return Transactions.Num(); }
+	bool IsEmpty() const { return Transactions.IsEmpty(); }
+};
+
+/** The single consolidated answer to a batch */
+USTRUCT(BlueprintType)
+struct ROCKINVENTORYRUNTIME_API FRockInventoryTransactionBatchResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 BatchID = 0;
+
+	/** Every entry succeeded (and for an atomic batch: everything was applied) */
+	UPROPERTY(BlueprintReadOnly)
+	bool bSuccess = false;
+
+	/** Atomic batch that failed and was rolled back. FailedIndices holds the entry that caused it */
+	UPROPERTY(BlueprintReadOnly)
+	bool bRolledBack = false;
+
+	/** Indices into FRockInventoryTransactionBatch::Transactions that were rejected or failed. Usually empty, so cheap to send */
+	UPROPERTY(BlueprintReadOnly)
+	TArray<int32> FailedIndices;
+};
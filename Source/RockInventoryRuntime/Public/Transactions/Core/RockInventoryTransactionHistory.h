@@ -0,0 +1,78 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StructUtils/InstancedStruct.h"
+#include "RockInventoryTransactionHistory.generated.h"
+
+USTRUCT()
+struct ROCKINVENTORYRUNTIME_API FRockInventoryTransactionRecord
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FInstancedStruct Command;
+	// TODO: Rewrite to try and use this?
+	// TInstancedStruct<FRockItemTransactionBase> Command;
+
+	UPROPERTY()
+	FInstancedStruct Undo;
+
+	template <typename CommandT, typename UndoT>
+	void Set(const CommandT& Cmd, const UndoT& UndoData)
+	{
+		Command.InitializeAs<CommandT>(Cmd);
+		Undo.InitializeAs<UndoT>(UndoData);
+	}
+
+	bool ExecuteUndo();
+
+	void Reset();
+	/** Approximate memory held by this record, used for the history budget */
+	int32 GetAllocatedSize() const;
+};
+
+/**
+ * Bounded transaction history: a ring buffer over a fixed size array, so adding past the capacity drops the oldest
+ * record in O(1) instead of shifting every record down.
+ * Besides the record count, the history is bounded by a memory budget. Records are dropped oldest first until
+ * both hold, so memory stays flat no matter how many transactions a player makes.
+ */
+USTRUCT()
+struct ROCKINVENTORYRUNTIME_API FRockInventoryTransactionHistory
+{
+	GENERATED_BODY()
+
+	/** Resizes the buffer, keeping the newest records that still fit */
+	void Configure(int32 InCapacity, int32 InBudgetBytes);
+
+	void Add(FRockInventoryTransactionRecord&& Record);
+	/** Drops every record newer than Index (the redo tail). INDEX_NONE drops everything */
+	void TruncateAfter(int32 Index);
+	void Reset();
+
+	int32 Num() const { return Count; }
+	bool IsEmpty() const { return Count == 0; }
+	int32 GetCapacity() const { return Records.Num(); }
+	int64 GetUsedBytes() const { return UsedBytes; }
+
+	/** 0 is the oldest record */
+	FRockInventoryTransactionRecord& operator[](int32 Index);
+	const FRockInventoryTransactionRecord& operator[](int32 Index) const;
+
+private:
+	void PopOldest();
+	void PopNewest();
+	int32 ToStorageIndex(int32 Index) const { return (Head + Index) % Records.Num(); }
+
+	/** Always exactly capacity long, unused entries are empty records */
+	UPROPERTY()
+	TArray<FRockInventoryTransactionRecord> Records;
+
+	/** Storage index of the oldest record */
+	int32 Head = 0;
+	int32 Count = 0;
+	int32 BudgetBytes = 0;
+	int64 UsedBytes = 0;
+};
@@ -0,0 +1,139 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StructUtils/InstancedStruct.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RockInventoryTransactionQueueSubsystem.generated.h"
+
+class URockInventory;
+class URockInventoryManagerComponent;
+
+USTRUCT(BlueprintType)
+struct ROCKINVENTORYRUNTIME_API FRockTransactionQueueStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 Processed = 0;
+
+	/** Waves executed on worker threads (bParallelTransactionExecution) */
+	UPROPERTY(BlueprintReadOnly)
+	int64 ParallelWaves = 0;
+
+	/** Turned away because the controller's queue was full, or dropped because its manager went away */
+	UPROPERTY(BlueprintReadOnly)
+	int64 Dropped = 0;
+
+	/** Most transactions waiting at once */
+	UPROPERTY(BlueprintReadOnly)
+	int32 MaxQueued = 0;
+
+	/** Longest time between a transaction arriving and executing */
+	UPROPERTY(BlueprintReadOnly)
+	double MaxQueueLatencySeconds = 0.0;
+
+	/** Longest time spent processing the queue in a single frame */
+	UPROPERTY(BlueprintReadOnly)
+	double MaxFrameSeconds = 0.0;
+};
+
+/**
+ * Optional server side queue for the manager components' transaction RPCs (bEnableTransactionQueue).
+ * Instead of running inline in the RPC handler, transactions are executed in Tick until the per frame budget is used,
+ * so a burst (everyone looting at the end of a raid) is spread over a few frames instead of spiking one.
+ *
+ * - Each controller has its own FIFO, and the queue takes one transaction per controller in turn.
+ * - Transactions touching the same inventory always run in arrival order, across controllers too.
+ * - The oldest transaction always runs, even over budget, so the queue can't stall.
+ *
+ * With bParallelTransactionExecution, each pass over the controllers first collects a wave: per controller, the leading transactions
+ * that may run off the game thread (URockInventoryManagerComponent::CanExecuteOffGameThread), as long as no other controller's group
+ * claimed their inventories. The groups touch disjoint inventories and run concurrently on worker threads; their replication dirtying,
+ * delegate broadcasts, history and client answers are then applied on the game thread, group by group in round robin order.
+ *
+ * A transaction batch is queued as a single entry over all the inventories its transactions touch, and runs on the game thread.
+ * Slot status and resync requests aren't queued.
+ */
+UCLASS()
+class ROCKINVENTORYRUNTIME_API URockInventoryTransactionQueueSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+public:
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return NumQueued > 0; }
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	bool IsEnabled() const { return bEnabled; }
+
+	/** False if the controller already has too many transactions waiting, the caller answers the client */
+	bool Enqueue(URockInventoryManagerComponent* Manager, FInstancedStruct&& Transaction);
+
+	/** Executes queued transactions until BudgetSeconds is used up. Returns how many ran */
+	int32 ProcessQueue(double InBudgetSeconds);
+
+	int32 GetNumQueued() const { return NumQueued; }
+
+	UFUNCTION(BlueprintCallable, Category = "RockInventory|Transactions")
+	FRockTransactionQueueStats GetStats() const { return Stats; }
+
+	UFUNCTION(BlueprintCallable, Category = "RockInventory|Transactions")
+	void ResetStats() { Stats = FRockTransactionQueueStats(); }
+
+private:
+	struct FQueuedTransaction
+	{
+		FInstancedStruct Transaction;
+		TArray<TWeakObjectPtr<URockInventory>, TInlineAllocator<2>> Inventories;
+		uint64 Sequence = 0;
+		double EnqueueTime = 0.0;
+	};
+
+	struct FControllerQueue
+	{
+		TWeakObjectPtr<URockInventoryManagerComponent> Manager;
+		TArray<FQueuedTransaction> Pending;
+	};
+
+	/** Transactions of a single controller on inventories no other group of the wave touches */
+	struct FParallelGroup;
+
+	/** True when no older transaction on any of its inventories is still waiting */
+	bool CanExecute(const FQueuedTransaction& Entry) const;
+	void ReleaseInventoryOrder(const FQueuedTransaction& Entry);
+	/** Pops the entry, returns false if it doesn't have to run anymore (its manager is gone) */
+	bool PopForExecution(FControllerQueue& Queue, FQueuedTransaction& OutEntry);
+
+	/** Collects and runs a wave of independent groups (see the class comment). Returns how many transactions ran */
+	int32 ProcessParallelWave();
+
+	TArray<FControllerQueue> Queues;
+	/** Round robin position in Queues */
+	int32 NextQueue = 0;
+
+	/** Sequences of the waiting transactions per inventory, oldest first */
+	TMap<TWeakObjectPtr<URockInventory>, TArray<uint64, TInlineAllocator<4>>> InventoryOrder;
+
+	uint64 NextSequence = 1;
+	int32 NumQueued = 0;
+
+	bool bEnabled = false;
+	double BudgetSeconds = 0.002;
+	int32 MaxQueuedPerController = 128;
+	bool bParallelExecution = false;
+	int32 MinParallelGroups = 4;
+
+	FRockTransactionQueueStats Stats;
+};
@@ -0,0 +1,88 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RockTransactionRateLimiter.generated.h"
+
+/** What a client asks the server to do, each kind is limited separately */
+UENUM(BlueprintType)
+enum class ERockRateLimitedRequest : uint8
+{
+	MoveItem,
+	LootWorldItem,
+	DropItem,
+	TransferAllItems,
+	SortInventory,
+	// Costs one token per transaction in the batch
+	TransactionBatch,
+	// Register and release
+	SlotStatus,
+	Resync,
+
+	Count UMETA(Hidden)
+};
+ENUM_RANGE_BY_COUNT(ERockRateLimitedRequest, ERockRateLimitedRequest::Count);
+
+USTRUCT(BlueprintType)
+struct ROCKINVENTORYRUNTIME_API FRockTokenBucketConfig
+{
+	GENERATED_BODY()
+
+	FRockTokenBucketConfig() = default;
+	FRockTokenBucketConfig(float InTokensPerSecond, float InBurstSize)
+		: TokensPerSecond(InTokensPerSecond), BurstSize(InBurstSize)
+	{
+	}
+
+	/** Sustained requests per second */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float TokensPerSecond = 20.0f;
+
+	/** Requests that can be made at once after being idle */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1"))
+	float BurstSize = 40.0f;
+};
+
+/** Requests the rate limiter turned away, per kind */
+USTRUCT(BlueprintType)
+struct ROCKINVENTORYRUNTIME_API FRockRateLimitStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 TotalRejected = 0;
+
+	/** Indexed by ERockRateLimitedRequest */
+	UPROPERTY(BlueprintReadOnly)
+	TArray<int64> RejectedByRequest;
+};
+
+/**
+ * Token buckets for a single controller, one per ERockRateLimitedRequest.
+ * Checked first thing in the server RPCs so a flooding client costs a few float operations per request.
+ */
+struct ROCKINVENTORYRUNTIME_API FRockTransactionRateLimiter
+{
+	/** Reads the limits from URockInventoryDeveloperSettings */
+	void Configure();
+
+	/** Takes Cost tokens if the bucket has them. Nothing is taken on failure */
+	bool TryConsume(ERockRateLimitedRequest Request, double Now, float Cost = 1.0f);
+
+	void GetStats(FRockRateLimitStats& OutStats) const;
+
+	bool IsEnabled() const { return bEnabled; }
+
+private:
+	struct FBucket
+	{
+		FRockTokenBucketConfig Config;
+		float Tokens = 0.0f;
+		double LastRefillTime = -1.0;
+		int64 Rejected = 0;
+	};
+	TStaticArray<FBucket, static_cast<int32>(ERockRateLimitedRequest::Count)> Buckets;
+	int64 TotalRejected = 0;
+	bool bEnabled = false;
+};
@@ -6,6 +6,7 @@
 #include "Enums/RockItemOrientation.h"
 #include "Inventory/RockSlotHandle.h"
 #include "Transactions/Core/RockInventoryTransaction.h"
+#include "World/RockWorldItemSpawnSubsystem.h"
 #include "RockDropItemTransaction.generated.h"
 
 class URockInventory;
@@ -19,9 +20,9 @@ struct FRockDropItemUndoTransaction
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	bool bSuccess = false;
 
-	// Place this item
+	// Place this item, queued in URockWorldItemSpawnSubsystem (GetSpawnedActor once it exists)
 	UPROPERTY()
-	TWeakObjectPtr<AActor> SpawnedItemStack = nullptr;
+	FRockWorldItemSpawnHandle SpawnHandle;
 	// In this inventory
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TObjectPtr<URockInventory> TargetInventory = nullptr;
@@ -77,4 +78,16 @@ struct ROCKINVENTORYRUNTIME_API FRockDropItemTransaction : public FRockItemTrans
 	
 	FVector FindThrowDirection(const AController* Controller) const;
 	FVector FindSafeDropLocation(const AController* Controller, const FVector& DesiredDropLocation) const;
+
+	/** Compact wire encoding, see RockTransactionNet */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template <>
+struct TStructOpsTypeTraits<FRockDropItemTransaction> : public TStructOpsTypeTraitsBase2<FRockDropItemTransaction>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
 };
@@ -47,4 +47,16 @@ struct ROCKINVENTORYRUNTIME_API FRockLootWorldItemTransaction : public FRockItem
 	bool CanExecute() const;
 	FRockLootWorldItemUndoTransaction Execute();
 	bool AttemptPredict() const;
+
+	/** Compact wire encoding, see RockTransactionNet */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template <>
+struct TStructOpsTypeTraits<FRockLootWorldItemTransaction> : public TStructOpsTypeTraitsBase2<FRockLootWorldItemTransaction>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
 };
@@ -29,21 +29,13 @@ struct ROCKINVENTORYRUNTIME_API FRockMoveItemUndoTransaction : public FRockItemT
 	FRockInventorySlotHandle TargetSlotHandle;
 
 	///////////////////////////////////////////////////////////////////////////
-	/** Original state of the source item before the move */
+	// Fingerprints (FRockItemStack::GetFingerprint) of the source and target items after the move.
+	// Undo is only safe while both are unchanged, and a fingerprint is all it takes to tell
 	UPROPERTY()
-	FRockItemStack OriginalSourceItem;
+	uint32 PostMoveSourceFingerprint = 0;
 
-	/** Original state of the target item before the move */
 	UPROPERTY()
-	FRockItemStack OriginalTargetItem;
-
-	/** State of the source item after the move */
-	UPROPERTY()
-	FRockItemStack PostMoveSourceItem;
-
-	/** State of the target item after the move */
-	UPROPERTY()
-	FRockItemStack PostMoveTargetItem;
+	uint32 PostMoveTargetFingerprint = 0;
 
 	// Undo is always custom move type.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
@@ -85,4 +77,16 @@ struct ROCKINVENTORYRUNTIME_API FRockMoveItemTransaction : public FRockItemTrans
 	FRockMoveItemUndoTransaction Execute() const;
 	bool CanExecute() const;
 	bool AttemptPredict() const;
+
+	/** Compact wire encoding, see RockTransactionNet */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template <>
+struct TStructOpsTypeTraits<FRockMoveItemTransaction> : public TStructOpsTypeTraitsBase2<FRockMoveItemTransaction>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
 };
@@ -0,0 +1,56 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Inventory/RockInventorySortParams.h"
+#include "Transactions/Core/RockInventoryTransaction.h"
+#include "RockSortInventoryTransaction.generated.h"
+
+class URockInventory;
+
+USTRUCT(BlueprintType)
+struct ROCKINVENTORYRUNTIME_API FRockSortInventoryUndoTransaction
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bSuccess = false;
+
+	// Consolidating stacks isn't reversible
+	bool CanUndo() const { return false; }
+	bool Undo() const { return false; }
+};
+
+// Sorts and compacts an inventory on the server in one go, instead of a move per item
+USTRUCT(BlueprintType)
+struct ROCKINVENTORYRUNTIME_API FRockSortInventoryTransaction : public FRockItemTransactionBase
+{
+	GENERATED_BODY()
+	FRockSortInventoryTransaction();
+
+	FRockSortInventoryTransaction(AController* InInstigator, URockInventory* InInventory,
+		const FRockInventorySortParams& InSortParams = FRockInventorySortParams());
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TObjectPtr<URockInventory> Inventory = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FRockInventorySortParams SortParams;
+
+	bool CanExecute() const;
+	FRockSortInventoryUndoTransaction Execute() const;
+	bool AttemptPredict() const;
+
+	/** Compact wire encoding, see RockTransactionNet */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template <>
+struct TStructOpsTypeTraits<FRockSortInventoryTransaction> : public TStructOpsTypeTraitsBase2<FRockSortInventoryTransaction>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
@@ -0,0 +1,62 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Inventory/RockSlotHandle.h"
+#include "Transactions/Core/RockInventoryTransaction.h"
+#include "RockTransferAllTransaction.generated.h"
+
+class URockInventory;
+
+USTRUCT(BlueprintType)
+struct ROCKINVENTORYRUNTIME_API FRockTransferAllUndoTransaction
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bSuccess = false;
+
+	// Number of items (not stacks) moved
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 MovedCount = 0;
+
+	// Source slots that still hold an item which didn't (fully) fit
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FRockInventorySlotHandle> LeftoverSlots;
+
+	// A transfer touches too many slots to undo safely
+	bool CanUndo() const { return false; }
+	bool Undo() const { return false; }
+};
+
+// Moves everything from one inventory to another, e.g. 'take all' from a loot crate or a corpse
+USTRUCT(BlueprintType)
+struct ROCKINVENTORYRUNTIME_API FRockTransferAllTransaction : public FRockItemTransactionBase
+{
+	GENERATED_BODY()
+	FRockTransferAllTransaction();
+
+	FRockTransferAllTransaction(AController* InInstigator, URockInventory* InSourceInventory, URockInventory* InTargetInventory);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TObjectPtr<URockInventory> SourceInventory = nullptr;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TObjectPtr<URockInventory> TargetInventory = nullptr;
+
+	bool CanExecute() const;
+	FRockTransferAllUndoTransaction Execute() const;
+	bool AttemptPredict() const;
+
+	/** Compact wire encoding, see RockTransactionNet */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template <>
+struct TStructOpsTypeTraits<FRockTransferAllTransaction> : public TStructOpsTypeTraitsBase2<FRockTransferAllTransaction>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
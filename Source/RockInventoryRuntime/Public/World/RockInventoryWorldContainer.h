@@ -0,0 +1,46 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "RockInventoryWorldContainer.generated.h"
+
+class URockInventory;
+class URockInventoryComponent;
+struct FRockItemDelta;
+
+/**
+ * A world actor holding a whole inventory, e.g. what a player leaves behind on death.
+ * Created by URockInventoryComponent::DropInventoryAsContainer, which hands the inventory object itself over
+ * instead of spawning a world item per stack. Its contents are taken out with the regular inventory transactions (move, transfer all).
+ */
+UCLASS(PrioritizeCategories = "RockInventory")
+class ROCKINVENTORYRUNTIME_API ARockInventoryWorldContainer : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ARockInventoryWorldContainer(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "RockInventory")
+	TObjectPtr<UStaticMeshComponent> StaticMeshComponent;
+
+	/** Receives the dropped inventory. Its InventoryConfig is only used when the container is spawned or placed on its own */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "RockInventory")
+	TObjectPtr<URockInventoryComponent> InventoryComponent;
+
+	UFUNCTION(BlueprintCallable, Category = "RockInventory")
+	URockInventory* GetInventory() const;
+
+protected:
+	virtual void BeginPlay() override;
+
+	/** Server: destroy the container once the last item was taken out */
+	UPROPERTY(EditDefaultsOnly, Category = "RockInventory")
+	bool bDestroyWhenEmpty = true;
+
+	UFUNCTION()
+	void OnInventoryItemChanged(const FRockItemDelta& ItemDelta);
+	void DestroyIfEmpty();
+};
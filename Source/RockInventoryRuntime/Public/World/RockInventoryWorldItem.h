@@ -34,6 +34,30 @@ public:
 	void ApplyItemVisuals();
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Keeps URockWorldItemGridSubsystem up to date, e.g. while a thrown item is simulating */
+	void OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	/** Server: once a thrown item comes to rest, hand it over to URockWorldItemClusterSubsystem if enabled, otherwise go to rest */
+	UFUNCTION()
+	void OnStaticMeshSleep(UPrimitiveComponent* SleepingComponent, FName BoneName);
+	UFUNCTION()
+	void OnStaticMeshWake(UPrimitiveComponent* WakingComponent, FName BoneName);
+
+	/**
+	 * Server: stop ticking and go dormant (if bDormantWhenResting) until the ItemStack changes or it's moved again.
+	 * With world item clusters, also hands the item back to its cluster after WorldItemClusterDemoteDelay.
+	 */
+	void EnterRest();
+	/** Server: tick and replicate continuously, e.g. while thrown */
+	void ExitRest();
+	FTimerHandle DemoteTimerHandle;
+	void DemoteToCluster();
+
+	/** A resting item only costs the net driver something when its ItemStack changes. Disable if subclasses replicate more */
+	UPROPERTY(EditDefaultsOnly, Category = "RockInventory")
+	bool bDormantWhenResting = true;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RockInventory")
 	int32 ItemSeed = 0;
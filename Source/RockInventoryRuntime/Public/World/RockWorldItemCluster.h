@@ -0,0 +1,127 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Iris/ReplicationState/IrisFastArraySerializer.h"
+#include "Item/RockItemStack.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "UObject/ObjectKey.h"
+#include "RockWorldItemCluster.generated.h"
+
+class ARockWorldItemCluster;
+class UInstancedStaticMeshComponent;
+class URockItemDefinition;
+
+/** One world item without an actor of its own, see ARockWorldItemCluster */
+USTRUCT()
+struct ROCKINVENTORYRUNTIME_API FRockWorldItemClusterEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	/** Stable for the lifetime of the entry, unlike its index */
+	UPROPERTY()
+	int32 EntryId = INDEX_NONE;
+
+	/** Never has a RuntimeInstance, those items stay actors */
+	UPROPERTY()
+	FRockItemStack ItemStack;
+
+	UPROPERTY()
+	FVector_NetQuantize10 Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	FTransform GetTransform() const { return FTransform(Rotation, Location); }
+
+	void PreReplicatedRemove(const struct FRockWorldItemClusterEntryList& InArraySerializer);
+	void PostReplicatedAdd(const struct FRockWorldItemClusterEntryList& InArraySerializer);
+	void PostReplicatedChange(const struct FRockWorldItemClusterEntryList& InArraySerializer);
+};
+
+USTRUCT()
+struct ROCKINVENTORYRUNTIME_API FRockWorldItemClusterEntryList : public FIrisFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FRockWorldItemClusterEntry> Items;
+
+	UPROPERTY(NotReplicated)
+	TObjectPtr<ARockWorldItemCluster> Owner = nullptr;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FRockWorldItemClusterEntry, FRockWorldItemClusterEntryList>(Items, DeltaParms, *this);
+	}
+};
+
+template <>
+struct TStructOpsTypeTraits<FRockWorldItemClusterEntryList> : public TStructOpsTypeTraitsBase2<FRockWorldItemClusterEntryList>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/**
+ * Holds the resting world items of one grid cell as plain entries instead of one actor each, see URockWorldItemClusterSubsystem.
+ * The entries replicate as a fast array on a single, dormant actor, and are drawn with one instanced static mesh component
+ * per item definition (not on dedicated servers).
+ *
+ * Entries can't be looted directly: the server promotes them back into a regular world item actor first
+ * (URockWorldItemClusterSubsystem::PromoteItem, or URockInventoryManagerComponent::LootClusteredWorldItem from a client).
+ */
+UCLASS(NotBlueprintable, NotPlaceable)
+class ROCKINVENTORYRUNTIME_API ARockWorldItemCluster : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ARockWorldItemCluster(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Server. Returns the new entry's id */
+	int32 AddEntry(const FRockItemStack& ItemStack, const FTransform& Transform);
+	/** Server. False if there is no such entry (anymore) */
+	bool RemoveEntry(int32 EntryId, FRockItemStack& OutItemStack, FTransform& OutTransform);
+
+	const FRockWorldItemClusterEntry* FindEntry(int32 EntryId) const;
+	TConstArrayView<FRockWorldItemClusterEntry> GetEntries() const { return Entries.Items; }
+	int32 GetNumEntries() const { return Entries.Items.Num(); }
+
+	/** The entry an instance of one of our components stands for, e.g. from a trace's hit Component and Item. INDEX_NONE if none */
+	UFUNCTION(BlueprintCallable, Category = "RockInventory|World")
+	int32 GetEntryIdForInstance(const UPrimitiveComponent* Component, int32 InstanceIndex) const;
+
+private:
+	friend struct FRockWorldItemClusterEntry;
+
+	struct FInstanceRef
+	{
+		UInstancedStaticMeshComponent* Component = nullptr;
+		int32 InstanceIndex = INDEX_NONE;
+	};
+
+	void AddVisual(const FRockWorldItemClusterEntry& Entry);
+	void RemoveVisual(int32 EntryId);
+	UInstancedStaticMeshComponent* FindOrCreateComponent(const URockItemDefinition* Definition, UStaticMesh* Mesh);
+	bool HasVisuals() const;
+
+	UPROPERTY(Replicated)
+	FRockWorldItemClusterEntryList Entries;
+
+	int32 NextEntryId = 0;
+
+	/** Keeps the instanced components alive, the maps below point into it */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UInstancedStaticMeshComponent>> MeshComponents;
+
+	TMap<TObjectKey<URockItemDefinition>, UInstancedStaticMeshComponent*> ComponentByDefinition;
+	/** Per component, the entry id of each instance */
+	TMap<const UPrimitiveComponent*, TArray<int32>> EntryIdsByComponent;
+	TMap<int32, FInstanceRef> InstanceByEntryId;
+};
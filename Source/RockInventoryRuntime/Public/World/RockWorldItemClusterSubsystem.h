@@ -0,0 +1,91 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RockWorldItemClusterSubsystem.generated.h"
+
+class ARockWorldItemCluster;
+struct FRockItemStack;
+
+/** A clustered entry found by URockWorldItemClusterSubsystem::FindItemsInRadius */
+struct FRockWorldItemClusterHit
+{
+	ARockWorldItemCluster* Cluster = nullptr;
+	int32 EntryId = INDEX_NONE;
+	double DistanceSquared = 0.0;
+};
+
+/**
+ * Opt-in (bEnableWorldItemClusters) actorless representation for world items at rest.
+ * Instead of a ticking, replicating actor per item, resting items are stored as entries of an ARockWorldItemCluster,
+ * one per WorldItemClusterSize cell, so thousands of dropped items cost a few actors.
+ *
+ * Items become real actors again (the definition's world item class) when something needs one: a player looting it,
+ * an area loot, or gameplay about to apply forces (PromoteItemsInRadius). Actors that come to rest are turned back into entries
+ * (DemoteWorldItem). Items with a RuntimeInstance always stay actors.
+ *
+ * The entries are not in URockWorldItemGridSubsystem, which only knows actors. Server only, the clusters replicate themselves.
+ */
+UCLASS()
+class ROCKINVENTORYRUNTIME_API URockWorldItemClusterSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+public:
+	/** True on the server when bEnableWorldItemClusters is set */
+	bool IsEnabled() const;
+
+	/** Stores the item as an entry of the cluster covering the location. False if it has to stay an actor */
+	bool AddItem(const FRockItemStack& ItemStack, const FTransform& Transform);
+
+	/**
+	 * Replaces the entry with a world item actor at the same transform, and returns it. nullptr if the entry is gone.
+	 * Spawns right away, bypassing the spawn queue, for callers that need the actor now (looting it)
+	 */
+	AActor* PromoteItem(ARockWorldItemCluster* Cluster, int32 EntryId);
+
+	/**
+	 * Promotes the entries within Radius of Center, e.g. before an explosion. The actors are queued in
+	 * URockWorldItemSpawnSubsystem so a large pile is spread over frames; until spawned an item is neither an entry
+	 * nor an actor, and one that fails to spawn goes back to its cluster. Returns how many were queued
+	 * @param MaxItems - Nearest first, 0 for all of them
+	 * @param OnPromoted - Called with each actor as it spawns, e.g. to apply the explosion's force to it
+	 */
+	int32 PromoteItemsInRadius(const FVector& Center, float Radius, int32 MaxItems = 0, TFunction<void(AActor*)> OnPromoted = nullptr);
+
+	UFUNCTION(BlueprintCallable, Category = "RockInventory|World", meta = (DisplayName = "Promote Items In Radius"))
+	int32 K2_PromoteItemsInRadius(const FVector& Center, float Radius, int32 MaxItems = 0);
+
+	/** Entries within Radius of Center, nearest first and at most MaxItems (0 for all). Nothing is promoted */
+	void FindItemsInRadius(const FVector& Center, float Radius, int32 MaxItems, TArray<FRockWorldItemClusterHit>& OutHits) const;
+
+	/**
+	 * Turns a world item actor back into an entry and destroys it.
+	 * False if it should stay an actor: not lootable, has a RuntimeInstance, or is still moving.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "RockInventory|World")
+	bool DemoteWorldItem(AActor* WorldItem);
+
+	/** Items currently stored as entries */
+	int32 GetNumItems() const;
+
+private:
+	FIntPoint GetCell(const FVector& Location) const;
+	ARockWorldItemCluster* FindOrSpawnCluster(const FVector& Location);
+
+	UPROPERTY(Transient)
+	TMap<FIntPoint, TObjectPtr<ARockWorldItemCluster>> Clusters;
+
+	bool bEnabled = false;
+	float ClusterSize = 5000.0f;
+};
@@ -0,0 +1,62 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RockWorldItemConsolidationSubsystem.generated.h"
+
+/**
+ * Opt-in (bEnableWorldItemConsolidation), server only. Merges identical world items lying within WorldItemConsolidationRadius
+ * of each other into one actor, so repeated drops or a death drop don't leave dozens of actors of the same stack.
+ *
+ * World items are candidates when they begin play. Every WorldItemConsolidationInterval a limited number of candidates
+ * absorb the stackable items around them (CanStackWith, up to MaxStackCount), nearest first. Emptied items are destroyed,
+ * so no quantity is lost. Items still moving (awake physics) wait for a later pass, and items with a RuntimeInstance are left alone.
+ * Neighbours are found through URockWorldItemGridSubsystem.
+ */
+UCLASS()
+class ROCKINVENTORYRUNTIME_API URockWorldItemConsolidationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+public:
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return bEnabled && Candidates.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	bool IsEnabled() const { return bEnabled; }
+
+	/** Queues a world item (any IRockLootableInterface actor) to absorb its identical neighbours on the next pass */
+	void AddCandidate(AActor* WorldItem);
+
+	/** Runs a pass right away. Returns how many actors were merged away */
+	int32 ConsolidateCandidates(int32 MaxCandidates);
+
+	/** World items destroyed because their whole stack was merged into a neighbour */
+	int64 GetNumMergedActors() const { return NumMergedActors; }
+
+private:
+	/** Moves what fits from the neighbours into WorldItem. Returns how many neighbours were emptied, or INDEX_NONE to retry later */
+	int32 Consolidate(AActor* WorldItem);
+
+	TArray<TWeakObjectPtr<AActor>> Candidates;
+
+	bool bEnabled = false;
+	float Radius = 150.0f;
+	float Interval = 1.0f;
+	int32 MaxPerInterval = 64;
+	float TimeUntilNextPass = 0.0f;
+
+	int64 NumMergedActors = 0;
+};
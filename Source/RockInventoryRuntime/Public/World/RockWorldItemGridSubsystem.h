@@ -0,0 +1,66 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "RockWorldItemGridSubsystem.generated.h"
+
+/**
+ * Uniform grid (on X/Y) of the lootable world items, for "what's near me" queries that don't scale with the number of items in the world.
+ * ARockInventoryWorldItemBase registers itself on BeginPlay, follows its root component when it moves and unregisters on EndPlay.
+ * Other IRockLootableInterface actors can do the same through Register/Update/UnregisterWorldItem.
+ *
+ * Runs on server and clients alike, each sees the items that exist locally.
+ */
+UCLASS()
+class ROCKINVENTORYRUNTIME_API URockWorldItemGridSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+public:
+	void RegisterWorldItem(AActor* WorldItem);
+	void UnregisterWorldItem(AActor* WorldItem);
+	/** Picks up the actor's new location. Cheap when it stays in the same cell */
+	void UpdateWorldItem(AActor* WorldItem);
+
+	/** World items within Radius of Center, nearest first */
+	UFUNCTION(BlueprintCallable, Category = "RockInventory|World")
+	void QueryRadius(const FVector& Center, float Radius, TArray<AActor*>& OutWorldItems) const;
+
+	/** World items inside the box, in no particular order */
+	UFUNCTION(BlueprintCallable, Category = "RockInventory|World")
+	void QueryBox(const FBox& Box, TArray<AActor*>& OutWorldItems) const;
+
+	int32 GetNumWorldItems() const { return EntryIndexByActor.Num(); }
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FVector Location = FVector::ZeroVector;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+	};
+
+	FIntPoint GetCell(const FVector& Location) const;
+	void AddToCell(int32 EntryIndex);
+	void RemoveFromCell(int32 EntryIndex);
+
+	/** Calls Visitor for every live entry in the cells overlapping Bounds (X/Y only) */
+	void ForEachEntryInBounds(const FBox& Bounds, const TFunctionRef<void(const FEntry&)>& Visitor) const;
+
+	TSparseArray<FEntry> Entries;
+	TMap<TObjectKey<AActor>, int32> EntryIndexByActor;
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	float CellSize = 1000.0f;
+};
@@ -0,0 +1,129 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Item/RockItemStack.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RockWorldItemSpawnSubsystem.generated.h"
+
+/** Refers to a spawn queued in URockWorldItemSpawnSubsystem, valid before the actor exists */
+USTRUCT(BlueprintType)
+struct ROCKINVENTORYRUNTIME_API FRockWorldItemSpawnHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Id = 0;
+
+	bool IsValid() const { return Id != 0; }
+	bool operator==(const FRockWorldItemSpawnHandle& Other) const { return Id == Other.Id; }
+};
+
+UENUM(BlueprintType)
+enum class ERockWorldItemSpawnState : uint8
+{
+	/** Invalid or cancelled handle, or the spawned actor is gone again */
+	None,
+	Pending,
+	Spawned,
+};
+
+/**
+ * Server side queue for world item spawns, so a burst (loot explosion, bulk drop, destroyed container) is spread over frames
+ * instead of spawning everything in one. Each frame spawns queued items until WorldItemSpawnBudgetMs is used up, at least one,
+ * nearest to a player first.
+ *
+ * QueueSpawn returns a handle right away: it tells whether the item is still pending, where and what it will be,
+ * and the actor once spawned. Drops (FRockDropItemTransaction), cluster promotions (PromoteItemsInRadius) and dropped
+ * inventory containers go through here. Only callers that need the actor in the same frame, like looting a clustered
+ * item, still spawn directly.
+ */
+UCLASS()
+class ROCKINVENTORYRUNTIME_API URockWorldItemSpawnSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+public:
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return Pending.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/**
+	 * Queues a world item (the definition's world item class) for spawning, thrown with Impulse if non zero.
+	 * OnSpawned is called with the actor, or nullptr if it failed to spawn. Returns an invalid handle on clients.
+	 */
+	FRockWorldItemSpawnHandle QueueSpawn(const FRockItemStack& ItemStack, const FTransform& Transform,
+		const FVector& Impulse = FVector::ZeroVector, TFunction<void(AActor*)>&& OnSpawned = nullptr);
+
+	/**
+	 * Queues any other actor, e.g. a world container. OnBeforeFinish runs between SpawnActorDeferred and FinishSpawning,
+	 * to set the actor up before its BeginPlay. OnSpawned as for QueueSpawn.
+	 */
+	FRockWorldItemSpawnHandle QueueActorSpawn(TSubclassOf<AActor> ActorClass, const FTransform& Transform,
+		TFunction<void(AActor*)>&& OnBeforeFinish, TFunction<void(AActor*)>&& OnSpawned = nullptr);
+
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "RockInventory|World", meta = (DisplayName = "Queue World Item Spawn", AutoCreateRefTerm = "Impulse"))
+	FRockWorldItemSpawnHandle K2_QueueSpawn(const FRockItemStack& ItemStack, const FTransform& Transform, const FVector& Impulse);
+
+	UFUNCTION(BlueprintCallable, Category = "RockInventory|World")
+	ERockWorldItemSpawnState GetSpawnState(const FRockWorldItemSpawnHandle& Handle) const;
+
+	/** nullptr until spawned */
+	UFUNCTION(BlueprintCallable, Category = "RockInventory|World")
+	AActor* GetSpawnedActor(const FRockWorldItemSpawnHandle& Handle) const;
+
+	/** What and where a pending spawn will be. False if it isn't pending */
+	UFUNCTION(BlueprintCallable, Category = "RockInventory|World")
+	bool GetPendingSpawn(const FRockWorldItemSpawnHandle& Handle, FRockItemStack& OutItemStack, FTransform& OutTransform) const;
+
+	/** Removes a pending spawn and hands its item back, so it isn't lost. False if it isn't pending */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "RockInventory|World")
+	bool CancelSpawn(const FRockWorldItemSpawnHandle& Handle, FRockItemStack& OutItemStack);
+
+	/** Spawns everything still pending now, regardless of the budget */
+	void FlushPendingSpawns();
+
+	int32 GetNumPendingSpawns() const { return Pending.Num(); }
+
+private:
+	struct FPendingSpawn
+	{
+		int32 Id = 0;
+		/** Empty for QueueActorSpawn */
+		FRockItemStack ItemStack;
+		/** The definition's world item class if unset */
+		TSubclassOf<AActor> ActorClass;
+		FTransform Transform;
+		FVector Impulse = FVector::ZeroVector;
+		TFunction<void(AActor*)> OnBeforeFinish;
+		TFunction<void(AActor*)> OnSpawned;
+		/** Distance to the nearest player this frame, squared */
+		double Priority = 0.0;
+	};
+
+	AActor* SpawnNow(FPendingSpawn& Spawn);
+	void UpdatePriorities();
+	void PurgeSpawned();
+
+	/** In queue order, re-sorted by priority each frame */
+	TArray<FPendingSpawn> Pending;
+	/** Finished spawns, until their actor is gone */
+	TMap<int32, TWeakObjectPtr<AActor>> Spawned;
+	int32 PurgeThreshold = 1024;
+
+	int32 LastId = 0;
+	double BudgetSeconds = 0.001;
+	/** Set while Tick spawns, when Pending must not shift */
+	bool bSpawning = false;
+};
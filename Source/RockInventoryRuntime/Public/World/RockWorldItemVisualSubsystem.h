@@ -0,0 +1,76 @@
+// Copyright 2025 Broken Rock Studios LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "RockWorldItemVisualSubsystem.generated.h"
+
+class UStaticMesh;
+class URockItemDefinition;
+struct FStreamableHandle;
+
+/**
+ * Streams the meshes (and material overrides) world items are drawn with, shared per item definition.
+ * A burst of world items spawning in one frame, e.g. a crate breaking open, costs one streaming request for all of their definitions
+ * instead of one per actor, and definitions already loaded are answered right away.
+ * Nothing is loaded synchronously, including FallbackWorldItemMesh.
+ *
+ * Loaded visuals stay resident for the lifetime of the world, so later spawns of the same definition are free.
+ */
+UCLASS()
+class ROCKINVENTORYRUNTIME_API URockWorldItemVisualSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End UWorldSubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return PendingDefinitions.Num() > 0; }
+	virtual bool IsTickableInEditor() const override { return true; }
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/**
+	 * Calls OnLoaded with the definition's ItemMesh, or FallbackWorldItemMesh if it has none (or Definition is nullptr),
+	 * once it and the definition's material overrides are loaded. Right away if they already are, otherwise at the end of the frame.
+	 * The callback is dropped if Owner is gone by then. The mesh is nullptr if it failed to load.
+	 */
+	void RequestVisuals(const URockItemDefinition* Definition, const UObject* Owner, TFunction<void(UStaticMesh*)>&& OnLoaded);
+
+	/** Issues the streaming request for everything requested so far now, instead of at the end of the frame */
+	void FlushPendingRequests();
+
+	/** Streaming requests issued so far, each covering every definition requested since the previous one */
+	int32 GetNumStreamingRequests() const { return NumStreamingRequests; }
+
+private:
+	struct FWaiter
+	{
+		TWeakObjectPtr<const UObject> Owner;
+		TFunction<void(UStaticMesh*)> OnLoaded;
+	};
+
+	struct FDefinitionVisuals
+	{
+		TSoftObjectPtr<UStaticMesh> Mesh;
+		TArray<FSoftObjectPath> Paths;
+		TArray<FWaiter> Waiters;
+		/** Shared by every definition of the same batch (own one if already resident), keeps the assets loaded */
+		TSharedPtr<FStreamableHandle> Handle;
+		bool bLoaded = false;
+		bool bRequested = false;
+	};
+
+	FDefinitionVisuals& FindOrAddVisuals(const URockItemDefinition* Definition);
+	void OnBatchLoaded(TArray<TObjectKey<URockItemDefinition>> Definitions);
+
+	TMap<TObjectKey<URockItemDefinition>, FDefinitionVisuals> Visuals;
+	TArray<TObjectKey<URockItemDefinition>> PendingDefinitions;
+	int32 NumStreamingRequests = 0;
+};